@@ -0,0 +1,28 @@
+﻿#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace h323_26::asn1 {
+
+    // Значение BIT STRING: биты подряд, начиная со старшего бита первого октета.
+    // Неиспользуемые младшие биты последнего октета — нули (декодер их обнуляет).
+    struct BitStringValue {
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        std::pmr::vector<std::byte> octets;
+        size_t bits = 0;
+
+        BitStringValue() = default;
+        explicit BitStringValue(allocator_type alloc) : octets(alloc) {}
+        BitStringValue(std::pmr::vector<std::byte> contents, size_t count) : octets(std::move(contents)), bits(count) {}
+
+        [[nodiscard]] bool test(size_t index) const {
+            return index < bits && ((static_cast<unsigned>(octets[index / 8]) >> (7 - index % 8)) & 1) != 0;
+        }
+
+        bool operator==(const BitStringValue&) const = default;
+    };
+
+} // namespace h323_26::asn1
@@ -0,0 +1,61 @@
+﻿#pragma once
+#include <h323_26/core/octet_kernels.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace h323_26::asn1 {
+
+    // Невладеющее представление BMPString поверх символов в исходной датаграмме
+    // (UCS-2, по 2 октета, старший первым). Символы не перекодируются заранее:
+    // сравнение со строкой UTF-8 идет посимвольно, UTF-8 собирается только в to_string().
+    class BmpStringView {
+    public:
+        BmpStringView() = default;
+
+        // units — проверенные символы BMPString (четное число октетов, без суррогатов)
+        constexpr explicit BmpStringView(std::span<const std::byte> units) : units_(units) {}
+
+        // Число символов
+        [[nodiscard]] constexpr size_t size() const { return units_.size() / 2; }
+        [[nodiscard]] constexpr bool empty() const { return units_.empty(); }
+
+        // Исходные октеты символов (без PER-длины)
+        [[nodiscard]] constexpr std::span<const std::byte> bytes() const { return units_; }
+
+        constexpr uint16_t operator[](size_t i) const {
+            return static_cast<uint16_t>((static_cast<uint16_t>(units_[2 * i]) << 8) | static_cast<uint16_t>(units_[2 * i + 1]));
+        }
+
+        // Сравнение со строкой UTF-8 без перекодирования и аллокаций
+        [[nodiscard]] constexpr bool equals(std::string_view utf8) const {
+            size_t pos = 0;
+            for (size_t i = 0; i < size(); ++i) {
+                if (pos >= utf8.size() || core::next_bmp_char(utf8, pos) != (*this)[i]) return false;
+            }
+            return pos == utf8.size();
+        }
+
+        // Перекодирует в UTF-8 (для перехода к владеющим типам)
+        [[nodiscard]] std::pmr::string to_string(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) const {
+            std::pmr::string out(mr);
+            out.resize_and_overwrite(size() * 3, [&](char* data, size_t) {
+                size_t written = core::octet_kernels().utf16be_to_utf8(units_.data(), size(), data);
+                return written == core::Utf16Invalid ? 0 : written;
+            });
+            return out;
+        }
+
+        friend constexpr bool operator==(const BmpStringView& lhs, const BmpStringView& rhs) {
+            return std::ranges::equal(lhs.units_, rhs.units_);
+        }
+
+    private:
+        std::span<const std::byte> units_;
+    };
+
+} // namespace h323_26::asn1
@@ -0,0 +1,216 @@
+﻿#pragma once
+#include <h323_26/asn1/oid_view.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace h323_26::asn1 {
+
+    // Компактный идентификатор известного OID. unknown — OID вне реестра
+    // (его дуги хранятся в InternedOid целиком).
+    enum class OidId : uint8_t {
+        unknown,
+
+        // H.225.0 protocolIdentifier {itu-t(0) recommendation(0) h(8) 2250 version(0) v}
+        h225_v1,
+        h225_v2,
+        h225_v3,
+        h225_v4,
+        h225_v5,
+        h225_v6,
+        h225_v7,
+
+        // H.245 protocolIdentifier {itu-t(0) recommendation(0) h(8) 245 version(0) v}
+        h245_v2,
+        h245_v3,
+        h245_v4,
+        h245_v5,
+        h245_v6,
+        h245_v7,
+        h245_v8,
+        h245_v9,
+        h245_v10,
+        h245_v11,
+        h245_v12,
+        h245_v13,
+
+        // H.235.1 (бывш. H.235 Annex D), OID "A", "T" и "U" версий 2 и 3
+        // {itu-t(0) recommendation(0) h(8) 235 version(0) v n}
+        h235_v2_a,
+        h235_v2_t,
+        h235_v2_u,
+        h235_v3_a,
+        h235_v3_t,
+        h235_v3_u
+    };
+
+    // Запись реестра: дуги и BER-содержимое, посчитанное при компиляции
+    struct WellKnownOid {
+        OidId id;
+        std::string_view name;
+        std::span<const uint32_t> arcs;
+        std::span<const std::byte> ber;
+    };
+
+    namespace detail {
+
+        constexpr size_t base128_octets(uint32_t arc) {
+            return arc == 0 ? 1 : (static_cast<size_t>(std::bit_width(arc)) + 6) / 7;
+        }
+
+        // OID из параметров шаблона: дуги и их BER-кодировка живут в статической памяти
+        template <uint32_t First, uint32_t Second, uint32_t... Rest>
+        struct OidLiteral {
+            static_assert(First <= 2 && Second < 40, "First OID arcs must fit one octet");
+
+            static constexpr std::array<uint32_t, 2 + sizeof...(Rest)> arcs = { First, Second, Rest... };
+
+            static constexpr size_t ber_size = (size_t{ 1 } + ... + base128_octets(Rest));
+
+            static constexpr std::array<std::byte, ber_size> ber = [] {
+                std::array<std::byte, ber_size> out{};
+                size_t pos = 0;
+                out[pos++] = static_cast<std::byte>(First * 40 + Second);
+                for (uint32_t arc : std::array<uint32_t, sizeof...(Rest)>{ Rest... }) {
+                    for (size_t k = base128_octets(arc); k-- > 0;) {
+                        out[pos++] = static_cast<std::byte>(((arc >> (7 * k)) & 0x7F) | (k != 0 ? 0x80 : 0));
+                    }
+                }
+                return out;
+            }();
+        };
+
+        template <OidId Id, uint32_t... Arcs>
+        constexpr WellKnownOid well_known(std::string_view name) {
+            using literal = OidLiteral<Arcs...>;
+            return WellKnownOid{ Id, name, literal::arcs, literal::ber };
+        }
+
+    } // namespace detail
+
+    // Реестр стандартных идентификаторов H.225.0 / H.245 / H.235.
+    // Порядок записей совпадает с OidId, поэтому поиск по ID — индекс в массиве.
+    class OidRegistry {
+    public:
+        static constexpr std::array entries = {
+            detail::well_known<OidId::h225_v1, 0, 0, 8, 2250, 0, 1>("H.225.0 v1"),
+            detail::well_known<OidId::h225_v2, 0, 0, 8, 2250, 0, 2>("H.225.0 v2"),
+            detail::well_known<OidId::h225_v3, 0, 0, 8, 2250, 0, 3>("H.225.0 v3"),
+            detail::well_known<OidId::h225_v4, 0, 0, 8, 2250, 0, 4>("H.225.0 v4"),
+            detail::well_known<OidId::h225_v5, 0, 0, 8, 2250, 0, 5>("H.225.0 v5"),
+            detail::well_known<OidId::h225_v6, 0, 0, 8, 2250, 0, 6>("H.225.0 v6"),
+            detail::well_known<OidId::h225_v7, 0, 0, 8, 2250, 0, 7>("H.225.0 v7"),
+            detail::well_known<OidId::h245_v2, 0, 0, 8, 245, 0, 2>("H.245 v2"),
+            detail::well_known<OidId::h245_v3, 0, 0, 8, 245, 0, 3>("H.245 v3"),
+            detail::well_known<OidId::h245_v4, 0, 0, 8, 245, 0, 4>("H.245 v4"),
+            detail::well_known<OidId::h245_v5, 0, 0, 8, 245, 0, 5>("H.245 v5"),
+            detail::well_known<OidId::h245_v6, 0, 0, 8, 245, 0, 6>("H.245 v6"),
+            detail::well_known<OidId::h245_v7, 0, 0, 8, 245, 0, 7>("H.245 v7"),
+            detail::well_known<OidId::h245_v8, 0, 0, 8, 245, 0, 8>("H.245 v8"),
+            detail::well_known<OidId::h245_v9, 0, 0, 8, 245, 0, 9>("H.245 v9"),
+            detail::well_known<OidId::h245_v10, 0, 0, 8, 245, 0, 10>("H.245 v10"),
+            detail::well_known<OidId::h245_v11, 0, 0, 8, 245, 0, 11>("H.245 v11"),
+            detail::well_known<OidId::h245_v12, 0, 0, 8, 245, 0, 12>("H.245 v12"),
+            detail::well_known<OidId::h245_v13, 0, 0, 8, 245, 0, 13>("H.245 v13"),
+            detail::well_known<OidId::h235_v2_a, 0, 0, 8, 235, 0, 2, 1>("H.235 v2 A"),
+            detail::well_known<OidId::h235_v2_t, 0, 0, 8, 235, 0, 2, 5>("H.235 v2 T"),
+            detail::well_known<OidId::h235_v2_u, 0, 0, 8, 235, 0, 2, 6>("H.235 v2 U"),
+            detail::well_known<OidId::h235_v3_a, 0, 0, 8, 235, 0, 3, 1>("H.235 v3 A"),
+            detail::well_known<OidId::h235_v3_t, 0, 0, 8, 235, 0, 3, 5>("H.235 v3 T"),
+            detail::well_known<OidId::h235_v3_u, 0, 0, 8, 235, 0, 3, 6>("H.235 v3 U"),
+        };
+
+        // Запись по ID; для OidId::unknown — nullptr
+        static constexpr const WellKnownOid* find(OidId id) {
+            size_t index = static_cast<size_t>(id);
+            return index == 0 || index > entries.size() ? nullptr : &entries[index - 1];
+        }
+
+        // Поиск по BER-содержимому из датаграммы: сравнение длины и memcmp
+        static OidId match(std::span<const std::byte> ber);
+
+        // Поиск по развернутому списку дуг
+        static OidId match(std::span<const uint32_t> arcs);
+    };
+
+    static_assert(std::ranges::all_of(std::views::iota(size_t{ 0 }, OidRegistry::entries.size()),
+        [](size_t i) { return static_cast<size_t>(OidRegistry::entries[i].id) == i + 1; }),
+        "OidRegistry entries must follow OidId order");
+
+    // OBJECT IDENTIFIER с интернированием: известный OID хранится как OidId (без аллокаций,
+    // кодируется готовыми байтами реестра), неизвестный — собственным вектором дуг.
+    // Интернированный OID можно создать и закодировать при компиляции.
+    class InternedOid {
+    public:
+        constexpr InternedOid() = default;
+
+        constexpr explicit InternedOid(OidId id) : id_(OidRegistry::find(id) ? id : OidId::unknown) {}
+
+        InternedOid(std::initializer_list<uint32_t> arcs)
+            : InternedOid(std::span<const uint32_t>(arcs.begin(), arcs.size())) {}
+
+        explicit InternedOid(std::span<const uint32_t> arcs, std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+            : id_(OidRegistry::match(arcs))
+        {
+            if (id_ == OidId::unknown) arcs_.emplace(arcs.begin(), arcs.end(), mr);
+        }
+
+        explicit InternedOid(const OidView& view, std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+            : id_(OidRegistry::match(view.bytes()))
+        {
+            if (id_ == OidId::unknown) arcs_.emplace(view.begin(), view.end(), mr);
+        }
+
+        // Новое значение из кодировки. Вектор дуг неизвестного OID переиспользуется:
+        // его емкость сохраняется и для следующего неизвестного OID
+        void assign(const OidView& view, std::pmr::memory_resource* mr = std::pmr::get_default_resource()) {
+            id_ = OidRegistry::match(view.bytes());
+            if (id_ != OidId::unknown) {
+                if (arcs_) arcs_->clear();
+            }
+            else if (arcs_) {
+                arcs_->assign(view.begin(), view.end());
+            }
+            else {
+                arcs_.emplace(view.begin(), view.end(), mr);
+            }
+        }
+
+        // OidId::unknown, если OID не из реестра
+        [[nodiscard]] constexpr OidId id() const { return id_; }
+        [[nodiscard]] constexpr bool interned() const { return id_ != OidId::unknown; }
+
+        [[nodiscard]] constexpr std::span<const uint32_t> arcs() const {
+            if (auto entry = OidRegistry::find(id_)) return entry->arcs;
+            if (arcs_) return *arcs_;
+            return {};
+        }
+
+        [[nodiscard]] constexpr auto begin() const { return arcs().begin(); }
+        [[nodiscard]] constexpr auto end() const { return arcs().end(); }
+        [[nodiscard]] constexpr size_t size() const { return arcs().size(); }
+        [[nodiscard]] constexpr bool empty() const { return arcs().empty(); }
+        constexpr uint32_t operator[](size_t i) const { return arcs()[i]; }
+
+        friend constexpr bool operator==(const InternedOid& lhs, const InternedOid& rhs) {
+            if (lhs.interned() || rhs.interned()) return lhs.id_ == rhs.id_;
+            return std::ranges::equal(lhs.arcs(), rhs.arcs());
+        }
+
+    private:
+        OidId id_ = OidId::unknown;
+        // Только для OID вне реестра; пустой optional не обращается к memory_resource,
+        // поэтому интернированный OID — литеральный тип
+        std::optional<std::pmr::vector<uint32_t>> arcs_;
+    };
+
+} // namespace h323_26::asn1
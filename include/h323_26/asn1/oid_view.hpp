@@ -0,0 +1,126 @@
+﻿#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace h323_26::asn1 {
+
+    // Невладеющее представление OBJECT IDENTIFIER поверх BER-содержимого в исходной датаграмме.
+    // Дуги не разбираются заранее: итератор декодирует base-128 по мере обхода.
+    class OidView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = uint32_t;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            uint32_t operator*() const { return arc_; }
+
+            iterator& operator++() {
+                advance();
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto copy = *this;
+                advance();
+                return copy;
+            }
+
+            bool operator==(const iterator& other) const {
+                return pos_ == other.pos_ && first_ == other.first_;
+            }
+
+        private:
+            friend class OidView;
+
+            iterator(std::span<const std::byte> bytes, size_t pos) : bytes_(bytes), pos_(pos) {
+                if (pos_ < bytes_.size()) {
+                    // Первый байт: X*40 + Y даёт сразу две дуги
+                    arc_ = static_cast<uint32_t>(bytes_[0]) / 40;
+                    first_ = true;
+                } else {
+                    pos_ = bytes_.size();
+                }
+            }
+
+            void advance() {
+                if (first_) {
+                    // Вторая дуга из того же байта: позиция та же, меняется только фаза
+                    arc_ = static_cast<uint32_t>(bytes_[0]) % 40;
+                    first_ = false;
+                    next_ = 1;
+                    return;
+                }
+                pos_ = next_;
+                if (pos_ >= bytes_.size()) {
+                    pos_ = bytes_.size();
+                    return;
+                }
+                uint32_t value = 0;
+                uint8_t b;
+                do {
+                    b = static_cast<uint8_t>(bytes_[next_++]);
+                    value = (value << 7) | (b & 0x7F);
+                } while (b & 0x80);
+                arc_ = value;
+            }
+
+            std::span<const std::byte> bytes_;
+            size_t pos_ = 0;     // Начало текущей дуги (0 — первые две дуги)
+            size_t next_ = 0;    // Начало следующей дуги
+            uint32_t arc_ = 0;
+            bool first_ = false; // Текущая дуга — X из первого байта; end() — pos_ == size и false
+        };
+
+        OidView() = default;
+
+        // bytes — проверенное BER-содержимое (последний байт без бита продолжения)
+        constexpr explicit OidView(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+        iterator begin() const { return iterator(bytes_, 0); }
+        iterator end() const { return iterator(bytes_, bytes_.size()); }
+
+        // Количество дуг без декодирования значений
+        [[nodiscard]] size_t size() const {
+            if (bytes_.empty()) return 0;
+            auto terminal = std::ranges::count_if(bytes_.subspan(1), [](std::byte b) {
+                return (static_cast<uint8_t>(b) & 0x80) == 0;
+            });
+            return 2 + static_cast<size_t>(terminal);
+        }
+
+        [[nodiscard]] constexpr bool empty() const { return bytes_.empty(); }
+
+        // Исходные BER-байты (без PER-длины)
+        [[nodiscard]] constexpr std::span<const std::byte> bytes() const { return bytes_; }
+
+        // Сравнение с развернутым списком дуг без аллокаций
+        [[nodiscard]] bool equals(std::span<const uint32_t> arcs) const {
+            return std::ranges::equal(*this, arcs);
+        }
+
+        // Материализует дуги в вектор (для перехода к владеющим типам)
+        [[nodiscard]] std::pmr::vector<uint32_t> to_vector(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) const {
+            std::pmr::vector<uint32_t> arcs(mr);
+            arcs.reserve(size());
+            arcs.assign(begin(), end());
+            return arcs;
+        }
+
+        friend bool operator==(const OidView& lhs, const OidView& rhs) {
+            return std::ranges::equal(lhs.bytes_, rhs.bytes_);
+        }
+
+    private:
+        std::span<const std::byte> bytes_;
+    };
+
+} // namespace h323_26::asn1
@@ -1,14 +1,34 @@
 ﻿#pragma once
+#include <h323_26/asn1/bit_string.hpp>
+#include <h323_26/asn1/per_variant.hpp>
 #include <h323_26/core/bit_reader.hpp>
+#include <h323_26/asn1/oid_view.hpp>
+#include <h323_26/core/octet_stream.hpp>
+#include <algorithm>
+#include <array>
 #include <concepts>
 #include <string>
+#include <string_view>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
 namespace h323_26::asn1 {
 
-    class PerDecoder {
+    // Один определитель длины X.691: либо вся длина (last), либо полный фрагмент m * 16K,
+    // за которым после содержимого следует следующий определитель
+    struct LengthFragment {
+        size_t length;
+        bool last;
+    };
+
+    // Декодер PER для варианта Variant (Aligned или Unaligned). Определения — в per_decoder.cpp,
+    // где оба варианта инстанцируются явно.
+    template <PerVariant Variant>
+    class BasicPerDecoder {
     public:
+        using variant = Variant;
+
         // Декодирование числа в заданном диапазоне [min, max]
         // Это база для H.225.0
         static Result<uint64_t> decode_constrained_integer(
@@ -30,17 +50,142 @@ namespace h323_26::asn1 {
         // Читает бит расширения (Extension Marker)
         static Result<bool> decode_extension_marker(core::BitReader& reader);
 
-        // Декодирование индекса CHOICE (выбор из n вариантов)
+        // Normally small non-negative whole number (индексы дополнений CHOICE и т.п.)
+        static Result<uint64_t> decode_normally_small_number(core::BitReader& reader);
+
+        // Декодирование индекса CHOICE (выбор из n корневых вариантов).
+        // Для варианта из дополнений возвращает num_options + номер дополнения.
         static Result<uint32_t> decode_choice_index(core::BitReader& reader, uint32_t num_options, bool extensible);
 
-        // Декодирование определителя длины (Length Determinant)
+        // Декодирование определителя длины (Length Determinant) без фрагментации.
+        // Фрагментированная длина (от 16K) — ошибка: ее содержимое разбирает decode_octet_stream.
         static Result<size_t> decode_length_determinant(core::BitReader& reader);
 
-        // Декодирование строки IA5String (ASCII)
-        static Result<std::string> decode_ia5_string(core::BitReader& reader, std::optional<size_t> fixed_size = std::nullopt);
+        // Очередной определитель длины, включая фрагменты 16K/32K/48K/64K
+        static Result<LengthFragment> decode_length_fragment(core::BitReader& reader);
+
+        // Длина + октеты, в том числе фрагментированные. Куски отдаются в sink по мере
+        // разбора (в ALIGNED — без промежуточного буфера). Возвращает общую длину.
+        template <core::OctetSink S>
+        static Result<size_t> decode_octet_stream(core::BitReader& reader, S& sink);
+
+        // Декодирование строки IA5String (ASCII), символ — Variant::ia5_char_bits бит
+        // Память под результат берется из mr (например, monotonic_buffer_resource на одну датаграмму)
+        static Result<std::pmr::string> decode_ia5_string(
+            core::BitReader& reader,
+            std::optional<size_t> fixed_size = std::nullopt,
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+        // Копирующее чтение OCTET STRING в обоих вариантах: длина (или fixed_size) + октеты.
+        // Невыровненное содержимое (UNALIGNED, короткие фиксированные строки) сдвигается
+        // векторным ядром core::OctetKernels::copy_shifted
+        static Result<std::pmr::vector<std::byte>> decode_octet_string(
+            core::BitReader& reader,
+            std::optional<size_t> fixed_size = std::nullopt,
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+        // BIT STRING: длина в битах (или fixed_bits) + биты с произвольной позиции
+        static Result<BitStringValue> decode_bit_string(
+            core::BitReader& reader,
+            std::optional<size_t> fixed_bits = std::nullopt,
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+        // BMPString в UTF-8: символы по 16 бит перекодируются векторным ядром
+        static Result<std::pmr::string> decode_bmp_string(
+            core::BitReader& reader,
+            std::optional<size_t> fixed_size = std::nullopt,
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+        // Содержимое без длины с текущей позиции — для кодеков схемы, которые сами читают
+        // длину и выравнивание: count символов BMPString (в UTF-8) или bits бит BIT STRING
+        // дописываются в конец out. Для BIT STRING out.bits должно быть кратно 8.
+        static Result<void> decode_bmp_chars(core::BitReader& reader, size_t count, std::pmr::string& out);
+        static Result<void> decode_bit_contents(core::BitReader& reader, size_t bits, BitStringValue& out);
 
         // Декодирование object identifier (OID)
-        static Result<std::vector<uint32_t>> decode_oid(core::BitReader& reader);
+        static Result<std::pmr::vector<uint32_t>> decode_oid(
+            core::BitReader& reader,
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+        // Те же строки, OCTET STRING, BIT STRING и OID с записью в существующий объект:
+        // out очищается, но сохраняет емкость и memory_resource, поэтому повторное
+        // декодирование в тот же объект не выделяет память, пока содержимое в нем помещается.
+        // При ошибке out остается корректным объектом с неопределенным содержимым.
+        static Result<void> decode_ia5_string_into(
+            std::pmr::string& out,
+            core::BitReader& reader,
+            std::optional<size_t> fixed_size = std::nullopt);
+        static Result<void> decode_octet_string_into(
+            std::pmr::vector<std::byte>& out,
+            core::BitReader& reader,
+            std::optional<size_t> fixed_size = std::nullopt);
+        static Result<void> decode_bit_string_into(
+            BitStringValue& out,
+            core::BitReader& reader,
+            std::optional<size_t> fixed_bits = std::nullopt);
+        static Result<void> decode_bmp_string_into(
+            std::pmr::string& out,
+            core::BitReader& reader,
+            std::optional<size_t> fixed_size = std::nullopt);
+        static Result<void> decode_oid_into(std::pmr::vector<uint32_t>& out, core::BitReader& reader);
+
+        // Варианты без копирования: результат ссылается на буфер reader'а
+        // и живет не дольше исходной датаграммы. Только ALIGNED: в UNALIGNED
+        // содержимое не выровнено по октету. Строки фиксированной длины до 2 октетов
+        // не выравниваются и в ALIGNED — для них view возможен лишь на границе октета.
+        static Result<std::string_view> decode_ia5_string_view(core::BitReader& reader, std::optional<size_t> fixed_size = std::nullopt)
+            requires (Variant::aligned);
+        static Result<std::span<const std::byte>> decode_octet_string_view(core::BitReader& reader, std::optional<size_t> fixed_size = std::nullopt)
+            requires (Variant::aligned);
+        static Result<OidView> decode_oid_view(core::BitReader& reader)
+            requires (Variant::aligned);
+
+        // Open type: содержимое вложенной кодировки (например, варианта CHOICE из дополнений)
+        static Result<std::span<const std::byte>> decode_open_type(core::BitReader& reader)
+            requires (Variant::aligned);
+
+    private:
+        static void octet_align(core::BitReader& reader) {
+            if constexpr (Variant::aligned) reader.align_to_byte();
+        }
     };
 
+    // H.225.0 RAS и сигнализация вызова используют ALIGNED PER
+    using PerDecoder = BasicPerDecoder<Aligned>;
+    using UnalignedPerDecoder = BasicPerDecoder<Unaligned>;
+
+    extern template class BasicPerDecoder<Aligned>;
+    extern template class BasicPerDecoder<Unaligned>;
+
+    template <PerVariant Variant>
+    template <core::OctetSink S>
+    Result<size_t> BasicPerDecoder<Variant>::decode_octet_stream(core::BitReader& reader, S& sink) {
+        size_t total = 0;
+        for (;;) {
+            auto fragment = decode_length_fragment(reader);
+            if (!fragment) return std::unexpected(fragment.error());
+
+            if constexpr (Variant::aligned) {
+                if (fragment->length > 0) {
+                    // Октеты выровнены — отдаем окно прямо в датаграмму
+                    auto chunk = reader.view_bytes(fragment->length);
+                    if (!chunk) return std::unexpected(chunk.error());
+                    if (auto res = sink.write(*chunk); !res) return std::unexpected(res.error());
+                }
+            }
+            else {
+                // Невыровненные октеты сдвигаются через небольшой буфер
+                std::array<std::byte, 256> buffer;
+                for (size_t left = fragment->length; left > 0;) {
+                    auto chunk = std::span(buffer).first(std::min(left, buffer.size()));
+                    if (auto res = reader.read_bytes(chunk); !res) return std::unexpected(res.error());
+                    if (auto res = sink.write(chunk); !res) return std::unexpected(res.error());
+                    left -= chunk.size();
+                }
+            }
+            total += fragment->length;
+            if (fragment->last) return total;
+        }
+    }
+
 } // namespace h323_26::asn1
@@ -1,28 +1,599 @@
 ﻿#pragma once
+#include <h323_26/asn1/per_variant.hpp>
+#include <h323_26/core/bit_counter.hpp>
+#include <h323_26/core/bit_sink.hpp>
 #include <h323_26/core/bit_writer.hpp>
+#include <h323_26/core/fixed_bit_writer.hpp>
+#include <h323_26/core/octet_kernels.hpp>
+#include <h323_26/core/octet_stream.hpp>
+#include <algorithm>
+#include <bit>
+#include <span>
 #include <string_view>
 
 namespace h323_26::asn1 {
 
-    class PerEncoder {
+    // Кодировщик PER для варианта Variant (Aligned или Unaligned). Выравнивание и ширина
+    // символов выбираются через if constexpr — выбор варианта ничего не стоит во время выполнения.
+    // Все методы обобщены по приемнику битов (core::BitSink) и определены ниже как constexpr:
+    // с core::StaticBitWriter кодирование выполняется при компиляции, с BitWriter,
+    // FixedBitWriter и BitCounter (подсчет размера без записи) — во время выполнения.
+    template <PerVariant Variant>
+    class BasicPerEncoder {
     public:
-        static Result<void> encode_constrained_integer(core::BitWriter& writer, uint64_t value, uint64_t min, uint64_t max);
+        using variant = Variant;
 
-        // Кодирование расширяемого целого
-        static Result<void> encode_extensible_constrained_integer(core::BitWriter& writer, uint64_t value, uint64_t min, uint64_t max);
+        // Размер фрагмента X.691 (10.9.3.8): длины от 16K передаются блоками по 16K..64K
+        static constexpr size_t FragmentSize = 16384;
+
+        // Constrained whole number (X.691, 10.5.7): в ALIGNED диапазоны больше 255 выравниваются
+        template <core::BitSink W>
+        static constexpr Result<void> encode_constrained_integer(W& writer, uint64_t value, uint64_t min, uint64_t max);
+
+        // Кодирование расширяемого целого: вне корня — unconstrained whole number (X.691, 13.1)
+        template <core::BitSink W>
+        static constexpr Result<void> encode_extensible_constrained_integer(W& writer, uint64_t value, uint64_t min, uint64_t max);
 
         // Кодирование маркера расширения (1 бит)
-        static Result<void> encode_extension_marker(core::BitWriter& writer, bool extended);
+        template <core::BitSink W>
+        static constexpr Result<void> encode_extension_marker(W& writer, bool extended);
 
         // Кодирование преамбулы SEQUENCE (n бит)
-        static Result<void> encode_sequence_preamble(core::BitWriter& writer, uint64_t preamble, size_t count);
+        template <core::BitSink W>
+        static constexpr Result<void> encode_sequence_preamble(W& writer, uint64_t preamble, size_t count);
+
+        // Normally small non-negative whole number: 7 бит для 0..63, иначе длинная форма
+        template <core::BitSink W>
+        static constexpr Result<void> encode_normally_small_number(W& writer, uint64_t value);
+
+        // Кодирование индекса CHOICE. index >= num_options — вариант из дополнений
+        template <core::BitSink W>
+        static constexpr Result<void> encode_choice_index(W& writer, uint32_t index, uint32_t num_options, bool extensible);      
+
+        // Определитель длины без фрагментации: до 16383 включительно (в ALIGNED — с границы октета)
+        template <core::BitSink W>
+        static constexpr Result<void> encode_length_determinant(W& writer, size_t length);
+
+        // Длина + октеты (в ALIGNED выровненные); от 16K — фрагментами по 16K/32K/48K/64K
+        template <core::BitSink W>
+        static constexpr Result<void> encode_octet_string(W& writer, std::span<const std::byte> contents);
+
+        // То же, но содержимое берется из источника кусками и целиком в памяти не собирается
+        template <core::BitSink W, core::OctetSource S>
+        static constexpr Result<void> encode_octet_stream(W& writer, S& source);
+
+        // Длина + символы по Variant::ia5_char_bits бит. В UNALIGNED символ вне 0..127
+        // не помещается в 7 бит — это ошибка; в ALIGNED октет символа пишется как есть
+        template <core::BitSink W>
+        static constexpr Result<void> encode_ia5_string(W& writer, std::string_view value);
+
+        // BMPString из UTF-8: длина в символах + символы по 16 бит (UCS-2, старший октет первым).
+        // Неверный UTF-8 и символы вне BMP — ошибка
+        template <core::BitSink W>
+        static constexpr Result<void> encode_bmp_string(W& writer, std::string_view utf8);
+
+        // Только символы BMPString: длину и выравнивание пишет вызывающая сторона (кодеки схемы)
+        template <core::BitSink W>
+        static constexpr Result<void> encode_bmp_chars(W& writer, std::string_view utf8);
+
+        // BIT STRING: длина в битах + bits бит из octets, начиная со старшего бита первого октета
+        template <core::BitSink W>
+        static constexpr Result<void> encode_bit_string(W& writer, std::span<const std::byte> octets, size_t bits);
+
+        // Только биты содержимого BIT STRING
+        template <core::BitSink W>
+        static constexpr Result<void> encode_bit_contents(W& writer, std::span<const std::byte> octets, size_t bits);
+        template <core::BitSink W>
+        static constexpr Result<void> encode_oid(W& writer, std::span<const uint32_t> nodes);
+
+        // Open type: определитель длины + октеты уже готовой кодировки
+        template <core::BitSink W>
+        static constexpr Result<void> encode_open_type(W& writer, std::span<const std::byte> contents);
+
+        // Все символы принадлежат алфавиту IA5 (0..127)
+        static constexpr bool is_ia5(std::string_view value) {
+            unsigned char bits = 0;
+            for (char c : value) bits |= static_cast<unsigned char>(c);
+            return bits < 128;
+        }
+
+        // Число символов BMPString в строке UTF-8
+        static constexpr Result<size_t> bmp_length(std::string_view utf8) {
+            size_t count = 0;
+            for (size_t pos = 0; pos < utf8.size(); ++count) {
+                if (core::next_bmp_char(utf8, pos) == core::InvalidBmpChar) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "BMPString character is not valid UTF-8 within the BMP" });
+                }
+            }
+            return count;
+        }
+
+        // Точные размеры кодировок в битах, без записи. start_bit — позиция в потоке,
+        // с которой начнется кодирование: от нее зависит число бит выравнивания.
+        // Значения должны удовлетворять ограничениям (иначе кодировщик вернет ошибку).
+
+        static constexpr size_t constrained_integer_bits(uint64_t value, uint64_t min, uint64_t max, size_t start_bit = 0) {
+            switch (constrained_integer_form<Variant>(min, max)) {
+            case IntegerForm::empty:      return 0;
+            case IntegerForm::bit_field:  return static_cast<size_t>(std::bit_width(max - min));
+            case IntegerForm::one_octet:  return pad(start_bit) + 8 - start_bit;
+            case IntegerForm::two_octets: return pad(start_bit) + 16 - start_bit;
+            case IntegerForm::indefinite: break;
+            }
+            size_t end = start_bit + static_cast<size_t>(std::bit_width(value_octets(max - min) - 1));
+            return pad(end) + value_octets(value - min) * 8 - start_bit;
+        }
+
+        static constexpr size_t extensible_constrained_integer_bits(uint64_t value, uint64_t min, uint64_t max, size_t start_bit = 0) {
+            if (value >= min && value <= max) return 1 + constrained_integer_bits(value, min, max, start_bit + 1);
+            return 1 + octets_field_bits(unconstrained_octets(value), start_bit + 1);
+        }
+
+        static constexpr size_t normally_small_number_bits(uint64_t value, size_t start_bit = 0) {
+            if (value <= 63) return 7;
+            return 1 + octets_field_bits(value_octets(value), start_bit + 1);
+        }
+
+        static constexpr size_t choice_index_bits(uint32_t index, uint32_t num_options, bool extensible, size_t start_bit = 0) {
+            size_t marker = extensible ? 1 : 0;
+            if (extensible && index >= num_options) {
+                return 1 + normally_small_number_bits(index - num_options, start_bit + 1);
+            }
+            if (num_options <= 1) return marker;
+            return marker + constrained_integer_bits(index, 0, num_options - 1, start_bit + marker);
+        }
+
+        // Определитель длины без фрагментации (length < 16K)
+        static constexpr size_t length_determinant_bits(size_t length, size_t start_bit = 0) {
+            return pad(start_bit) + (length < 128 ? 8 : 16) - start_bit;
+        }
+
+        // Длина + октеты, с учетом фрагментации от 16K
+        static constexpr size_t octet_string_bits(size_t length, size_t start_bit = 0) {
+            return string_bits(length, 8, start_bit);
+        }
 
-        // Кодирование индекса CHOICE
-        static Result<void> encode_choice_index(core::BitWriter& writer, uint32_t index, uint32_t num_options, bool extensible);      
+        static constexpr size_t ia5_string_bits(size_t length, size_t start_bit = 0) {
+            return string_bits(length, Variant::ia5_char_bits, start_bit);
+        }
 
-        static Result<void> encode_length_determinant(core::BitWriter& writer, size_t length);
-        static Result<void> encode_ia5_string(core::BitWriter& writer, std::string_view value);
-        static Result<void> encode_oid(core::BitWriter& writer, const std::vector<uint32_t>& nodes);
+        // length — число символов BMPString / бит BIT STRING
+        static constexpr size_t bmp_string_bits(size_t length, size_t start_bit = 0) {
+            return string_bits(length, 16, start_bit);
+        }
+
+        static constexpr size_t bit_string_bits(size_t length, size_t start_bit = 0) {
+            return string_bits(length, 1, start_bit);
+        }
+
+        // Число октетов BER-содержимого OID: первый октет X*40 + Y, затем дуги в base-128
+        static constexpr size_t oid_content_octets(std::span<const uint32_t> nodes) {
+            if (nodes.size() < 2) return 0;
+            size_t octets = 1;
+            for (size_t i = 2; i < nodes.size(); ++i) octets += base128_octets(nodes[i]);
+            return octets;
+        }
+
+        static constexpr size_t oid_bits(std::span<const uint32_t> nodes, size_t start_bit = 0) {
+            return octet_string_bits(oid_content_octets(nodes), start_bit);
+        }
+
+    private:
+        // Позиция после выравнивания; в UNALIGNED выравнивания нет
+        static constexpr size_t pad(size_t bit) {
+            if constexpr (Variant::aligned) return (bit + 7) / 8 * 8;
+            else return bit;
+        }
+
+        template <core::BitSink W>
+        static constexpr void octet_align(W& writer) {
+            if constexpr (Variant::aligned) writer.align_to_byte();
+        }
+
+        // Определитель длины + n октетов значения (semi-constrained и unconstrained whole number)
+        static constexpr size_t octets_field_bits(size_t octets, size_t start_bit) {
+            size_t end = start_bit + length_determinant_bits(octets, start_bit);
+            return pad(end) + octets * 8 - start_bit;
+        }
+
+        // Октеты дополнительного кода неотрицательного значения: старший бит — знак
+        static constexpr size_t unconstrained_octets(uint64_t value) {
+            return static_cast<size_t>(std::bit_width(value)) / 8 + 1;
+        }
+
+        // Длина + length элементов по unit_bits бит, с фрагментацией от 16K
+        static constexpr size_t string_bits(size_t length, size_t unit_bits, size_t start_bit) {
+            size_t end = start_bit;
+            while (length >= FragmentSize) {
+                size_t chunk = std::min<size_t>(4, length / FragmentSize) * FragmentSize;
+                end = pad(pad(end) + 8) + chunk * unit_bits;
+                length -= chunk;
+            }
+            end += length_determinant_bits(length, end);
+            if (length != 0) end = pad(end) + length * unit_bits;
+            return end - start_bit;
+        }
+
+        static constexpr size_t base128_octets(uint32_t arc) {
+            return arc == 0 ? 1 : (static_cast<size_t>(std::bit_width(arc)) + 6) / 7;
+        }
+
+        // Заголовок полного фрагмента: 11 + множитель m (1..4)
+        template <core::BitSink W>
+        static constexpr Result<void> encode_fragment_header(W& writer, size_t multiplier);
+
+        // Символы строки по одному: UNALIGNED (7 бит) и константное вычисление
+        template <core::BitSink W>
+        static constexpr Result<void> encode_chars(W& writer, std::string_view value);
+
+        template <core::BitSink W, core::OctetSource S>
+        static constexpr Result<void> copy_octets(W& writer, S& source, size_t count);
+
+        // count символов UTF-8 с позиции pos по 16 бит, до четырех за одну запись
+        template <core::BitSink W>
+        static constexpr Result<void> write_bmp_units(W& writer, std::string_view utf8, size_t& pos, size_t count);
     };
 
+    // H.225.0 RAS и сигнализация вызова используют ALIGNED PER
+    using PerEncoder = BasicPerEncoder<Aligned>;
+    using UnalignedPerEncoder = BasicPerEncoder<Unaligned>;
+
+    template <PerVariant Variant>
+    template <core::BitSink W, core::OctetSource S>
+    constexpr Result<void> BasicPerEncoder<Variant>::copy_octets(W& writer, S& source, size_t count) {
+        while (count > 0) {
+            auto chunk = source.next(count);
+            if (chunk.empty()) {
+                return std::unexpected(Error{ ErrorCode::EndOfStream, "Octet source ended before its declared length" });
+            }
+            if (auto res = writer.write_bytes(chunk); !res) return res;
+            count -= chunk.size();
+        }
+        return {};
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_fragment_header(W& writer, size_t multiplier) {
+        octet_align(writer);
+        return writer.write_bits(0xC0 | multiplier, 8);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W, core::OctetSource S>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_octet_stream(W& writer, S& source) {
+        // Полные фрагменты: 11 + множитель m (1..4), затем m * 16K октетов
+        while (source.remaining() >= FragmentSize) {
+            size_t multiplier = std::min<size_t>(4, source.remaining() / FragmentSize);
+            if (auto res = encode_fragment_header(writer, multiplier); !res) return res;
+
+            octet_align(writer);
+            if (auto res = copy_octets(writer, source, multiplier * FragmentSize); !res) return res;
+        }
+
+        // Остаток (< 16K, возможно 0) — обычным определителем длины
+        size_t tail = source.remaining();
+        if (auto res = encode_length_determinant(writer, tail); !res) return res;
+        if (tail == 0) return {};
+
+        octet_align(writer);
+        return copy_octets(writer, source, tail);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_constrained_integer(W& writer, uint64_t value, uint64_t min, uint64_t max) {
+        if (max < min) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Max < Min in integer constraint" });
+        }
+        if (value < min || value > max) {
+            return std::unexpected(Error{
+                ErrorCode::InvalidConstraint,
+                "Value is out of ASN.1 constrained range"
+                });
+        }
+
+        // В PER записывается смещение от минимального значения
+        uint64_t offset = value - min;
+
+        switch (constrained_integer_form<Variant>(min, max)) {
+        case IntegerForm::empty:
+            // Диапазон из одного значения (например, INTEGER (5..5)) — 0 бит
+            return {};
+        case IntegerForm::bit_field:
+            return writer.write_bits(offset, std::bit_width(max - min));
+        case IntegerForm::one_octet:
+            writer.align_to_byte();
+            return writer.write_bits(offset, 8);
+        case IntegerForm::two_octets:
+            writer.align_to_byte();
+            return writer.write_bits(offset, 16);
+        case IntegerForm::indefinite:
+            break;
+        }
+
+        // Диапазон больше 64K: число октетов (1..n) как constrained whole number, затем октеты
+        size_t octets = value_octets(offset);
+        size_t max_octets = value_octets(max - min);
+        if (auto res = writer.write_bits(octets - 1, std::bit_width(max_octets - 1)); !res) return res;
+        writer.align_to_byte();
+        return writer.write_bits(offset, octets * 8);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_extension_marker(W& writer, bool extended) {
+        return writer.write_bits(extended ? 1 : 0, 1);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_sequence_preamble(W& writer, uint64_t preamble, size_t count) {
+        if (count == 0) return {};
+        return writer.write_bits(preamble, count);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_normally_small_number(W& writer, uint64_t value) {
+        if (value <= 63) {
+            // Бит 0 + 6 бит значения
+            return writer.write_bits(value, 7);
+        }
+
+        // Бит 1 + semi-constrained whole number: минимальное число октетов, затем сами октеты
+        size_t octets = value_octets(value);
+        if (auto res = writer.write_bits(1, 1); !res) return res;
+        if (auto res = encode_length_determinant(writer, octets); !res) return res;
+        octet_align(writer);
+        return writer.write_bits(value, octets * 8);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_choice_index(W& writer, uint32_t index, uint32_t num_options, bool extensible) {
+        if (extensible) {
+            // Сначала пишем бит: расширенный это выбор или нет
+            bool is_addition = index >= num_options;
+            auto res = encode_extension_marker(writer, is_addition);
+            if (!res) return res;
+
+            // Вариант из дополнений: номер дополнения, тело пойдет как open type
+            if (is_addition) return encode_normally_small_number(writer, index - num_options);
+        }
+        else if (index >= num_options) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "CHOICE index is out of range" });
+        }
+
+        if (num_options <= 1) return {};
+
+        // Корневой индекс — constrained whole number 0..n-1
+        return encode_constrained_integer(writer, index, 0, num_options - 1);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_extensible_constrained_integer(W& writer, uint64_t value, uint64_t min, uint64_t max) {
+        if (value >= min && value <= max) {
+            // Значение в базовом диапазоне: бит 0 + само число
+            auto res = encode_extension_marker(writer, false);
+            if (!res) return res;
+            return encode_constrained_integer(writer, value, min, max);
+        }
+
+        // Значение вне корня: бит 1 + unconstrained whole number — определитель длины
+        // и минимальное число октетов дополнительного кода (старший бит — знак)
+        auto res = encode_extension_marker(writer, true);
+        if (!res) return res;
+
+        size_t octets = unconstrained_octets(value);
+        if (auto res_len = encode_length_determinant(writer, octets); !res_len) return res_len;
+        octet_align(writer);
+        if (octets > sizeof(uint64_t)) {
+            // Значение со старшим битом: ведущий нулевой октет знака
+            if (auto res_sign = writer.write_bits(0, 8); !res_sign) return res_sign;
+            octets = sizeof(uint64_t);
+        }
+        return writer.write_bits(value, octets * 8);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_length_determinant(W& writer, size_t length) {
+        octet_align(writer);
+        if (length < 128) {
+            // Стандарт X.691: бит 0 + 7 бит значения. Итого 8 бит.
+            return writer.write_bits(static_cast<uint64_t>(length), 8);
+        }
+        if (length < FragmentSize) {
+            // Биты 10 + 14 бит значения. Итого 16 бит.
+            return writer.write_bits(0x8000 | static_cast<uint64_t>(length), 16);
+        }
+        // 16K и больше передаются только фрагментами вместе с содержимым (encode_octet_stream)
+        return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length of 16K or more requires fragmentation" });
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_ia5_string(W& writer, std::string_view value) {
+        if constexpr (Variant::aligned) {
+            // Символ занимает октет — строка пишется как октеты одним копированием.
+            // При компиляции байтовое представление строки (as_bytes) недоступно.
+            if !consteval {
+                return encode_octet_string(writer, std::as_bytes(std::span(value)));
+            }
+        }
+        else if (!is_ia5(value)) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "IA5String character is out of 0..127" });
+        }
+        return encode_chars(writer, value);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::write_bmp_units(W& writer, std::string_view utf8, size_t& pos, size_t count) {
+        uint64_t word = 0;
+        size_t held = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t c = core::next_bmp_char(utf8, pos);
+            if (c == core::InvalidBmpChar) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "BMPString character is not valid UTF-8 within the BMP" });
+            }
+            word = (word << 16) | c;
+            if (++held == 4) {
+                if (auto res = writer.write_bits(word, 64); !res) return res;
+                word = 0;
+                held = 0;
+            }
+        }
+        if (held == 0) return {};
+        return writer.write_bits(word, held * 16);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_bmp_chars(W& writer, std::string_view utf8) {
+        size_t pos = 0;
+        auto count = bmp_length(utf8);
+        if (!count) return std::unexpected(count.error());
+        return write_bmp_units(writer, utf8, pos, *count);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_bmp_string(W& writer, std::string_view utf8) {
+        auto count = bmp_length(utf8);
+        if (!count) return std::unexpected(count.error());
+
+        // Фрагменты считаются в символах, как у IA5String
+        size_t pos = 0;
+        size_t left = *count;
+        while (left >= FragmentSize) {
+            size_t multiplier = std::min<size_t>(4, left / FragmentSize);
+            if (auto res = encode_fragment_header(writer, multiplier); !res) return res;
+
+            octet_align(writer);
+            if (auto res = write_bmp_units(writer, utf8, pos, multiplier * FragmentSize); !res) return res;
+            left -= multiplier * FragmentSize;
+        }
+
+        if (auto res = encode_length_determinant(writer, left); !res) return res;
+        if (left == 0) return {};
+
+        octet_align(writer);
+        return write_bmp_units(writer, utf8, pos, left);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_bit_contents(W& writer, std::span<const std::byte> octets, size_t bits) {
+        if (octets.size() < (bits + 7) / 8) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "BIT STRING has fewer octets than bits" });
+        }
+        if (auto res = writer.write_bytes(octets.first(bits / 8)); !res) return res;
+        if (size_t rest = bits % 8; rest != 0) {
+            return writer.write_bits(static_cast<uint64_t>(octets[bits / 8]) >> (8 - rest), rest);
+        }
+        return {};
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_bit_string(W& writer, std::span<const std::byte> octets, size_t bits) {
+        if (octets.size() < (bits + 7) / 8) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "BIT STRING has fewer octets than bits" });
+        }
+
+        // Длина и фрагменты — в битах; полный фрагмент кратен 8, поэтому каждый начинается с октета
+        while (bits >= FragmentSize) {
+            size_t multiplier = std::min<size_t>(4, bits / FragmentSize);
+            if (auto res = encode_fragment_header(writer, multiplier); !res) return res;
+
+            octet_align(writer);
+            size_t chunk = multiplier * FragmentSize;
+            if (auto res = writer.write_bytes(octets.first(chunk / 8)); !res) return res;
+            octets = octets.subspan(chunk / 8);
+            bits -= chunk;
+        }
+
+        if (auto res = encode_length_determinant(writer, bits); !res) return res;
+        if (bits == 0) return {};
+
+        octet_align(writer);
+        return encode_bit_contents(writer, octets, bits);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_oid(W& writer, std::span<const uint32_t> nodes) {
+        if (nodes.size() < 2) return std::unexpected(Error{ ErrorCode::InvalidConstraint, "OID must have at least 2 nodes" });
+
+        // Первые две дуги декодер читает из одного октета X*40 + Y
+        if (nodes[0] > 2 || nodes[1] >= 40) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "First OID arcs must be X.Y with X <= 2 and Y < 40" });
+        }
+
+        // Длина BER-содержимого известна заранее, поэтому OID пишется за один проход
+        // прямо в приемник, без промежуточного буфера
+        if (auto res = encode_length_determinant(writer, oid_content_octets(nodes)); !res) return res;
+        octet_align(writer);
+
+        if (auto res = writer.write_bits(nodes[0] * 40 + nodes[1], 8); !res) return res;
+
+        for (size_t i = 2; i < nodes.size(); ++i) {
+            uint32_t val = nodes[i];
+            size_t n = base128_octets(val);
+
+            // Группы по 7 бит от старших к младшим, бит продолжения у всех, кроме последней;
+            // дуга (до 5 октетов) уходит одной записью
+            uint64_t word = 0;
+            for (size_t k = n; k-- > 0;) {
+                uint64_t group = (val >> (7 * k)) & 0x7F;
+                word = (word << 8) | group | (k != 0 ? 0x80 : 0);
+            }
+            if (auto res = writer.write_bits(word, n * 8); !res) return res;
+        }
+        return {};
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_octet_string(W& writer, std::span<const std::byte> contents) {
+        core::SpanOctetSource source(contents);
+        return encode_octet_stream(writer, source);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_open_type(W& writer, std::span<const std::byte> contents) {
+        return encode_octet_string(writer, contents);
+    }
+
+    template <PerVariant Variant>
+    template <core::BitSink W>
+    constexpr Result<void> BasicPerEncoder<Variant>::encode_chars(W& writer, std::string_view value) {
+        constexpr size_t char_bits = Variant::ia5_char_bits;
+
+        // Фрагменты считаются в символах так же, как в октетах у OCTET STRING
+        while (value.size() >= FragmentSize) {
+            size_t multiplier = std::min<size_t>(4, value.size() / FragmentSize);
+            if (auto res = encode_fragment_header(writer, multiplier); !res) return res;
+
+            octet_align(writer);
+            for (char c : value.substr(0, multiplier * FragmentSize)) {
+                if (auto res = writer.write_bits(static_cast<uint8_t>(c), char_bits); !res) return res;
+            }
+            value.remove_prefix(multiplier * FragmentSize);
+        }
+
+        if (auto res = encode_length_determinant(writer, value.size()); !res) return res;
+        if (value.empty()) return {};
+
+        octet_align(writer);
+        for (char c : value) {
+            if (auto res = writer.write_bits(static_cast<uint8_t>(c), char_bits); !res) return res;
+        }
+        return {};
+    }
+
 } // namespace h323_26::asn1
@@ -0,0 +1,52 @@
+﻿#pragma once
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace h323_26::asn1 {
+
+    // Варианты PER (X.691). Выбираются параметром шаблона кодировщика и декодера,
+    // поэтому решения о выравнивании и ширине символов принимаются при компиляции.
+    //
+    // ALIGNED — H.225.0 и H.245: определители длины, содержимое строк и целые
+    // с диапазоном больше 255 начинаются с границы октета, символ IA5String — 8 бит.
+    struct Aligned {
+        static constexpr bool aligned = true;
+        static constexpr size_t ia5_char_bits = 8;
+    };
+
+    // UNALIGNED — минимальное число бит без какого-либо выравнивания, символ IA5String — 7 бит
+    struct Unaligned {
+        static constexpr bool aligned = false;
+        static constexpr size_t ia5_char_bits = 7;
+    };
+
+    template <typename V>
+    concept PerVariant = std::same_as<V, Aligned> || std::same_as<V, Unaligned>;
+
+    // Форма constrained whole number (X.691, 10.5.7) для диапазона min..max
+    enum class IntegerForm : uint8_t {
+        empty,       // диапазон из одного значения: 0 бит
+        bit_field,   // минимальное число бит без выравнивания
+        one_octet,   // ALIGNED, диапазон 256: выровненный октет
+        two_octets,  // ALIGNED, диапазон 257..64K: два выровненных октета
+        indefinite   // ALIGNED, диапазон больше 64K: число октетов, затем выровненные октеты
+    };
+
+    template <PerVariant Variant>
+    constexpr IntegerForm constrained_integer_form(uint64_t min, uint64_t max) {
+        uint64_t span = max - min; // диапазон - 1, без переполнения для 0..2^64-1
+        if (span == 0) return IntegerForm::empty;
+        if (!Variant::aligned || span < 255) return IntegerForm::bit_field;
+        if (span == 255) return IntegerForm::one_octet;
+        if (span <= 65535) return IntegerForm::two_octets;
+        return IntegerForm::indefinite;
+    }
+
+    // Минимальное число октетов для неотрицательного значения (не меньше одного)
+    constexpr size_t value_octets(uint64_t value) {
+        return value == 0 ? 1 : (static_cast<size_t>(std::bit_width(value)) + 7) / 8;
+    }
+
+} // namespace h323_26::asn1
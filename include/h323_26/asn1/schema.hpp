@@ -0,0 +1,1800 @@
+﻿#pragma once
+#include <h323_26/asn1/bit_string.hpp>
+#include <h323_26/asn1/bmp_string_view.hpp>
+#include <h323_26/asn1/per_decoder.hpp>
+#include <h323_26/asn1/per_encoder.hpp>
+#include <h323_26/asn1/oid_registry.hpp>
+#include <h323_26/asn1/oid_view.hpp>
+#include <h323_26/core/bit_counter.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <h323_26/core/bit_sink.hpp>
+#include <h323_26/core/fixed_bit_writer.hpp>
+#include <h323_26/core/octet_kernels.hpp>
+#include <h323_26/core/static_bit_writer.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Декларативное описание ASN.1-типов для PER.
+//
+// Одно описание (Sequence<...>) дает и кодировщик, и декодер: ширины полей, размер
+// преамбулы и положение битов OPTIONAL вычисляются при компиляции, а сам код
+// разворачивается в линейную последовательность вызовов без лямбд и промежуточных
+// структур. Порядок полей в описании совпадает с порядком членов структуры —
+// декодер собирает результат агрегатной инициализацией T{ field0, field1, ... }.
+//
+// Схема кодирует ALIGNED PER (как требуют H.225.0 и H.245): выравнивание каждого поля
+// известно из его ограничений и разрешается при компиляции через if constexpr.
+//
+// Каждый кодек реализует:
+//     template <core::BitSink W, typename V> static constexpr Result<void> encode_value(W&, const V&);
+//     template <typename V> static Result<V> decode_value(core::BitReader&, DecodeContext);
+//     static Result<void> skip_value(core::BitReader&);  // пропуск без построения значения
+//
+// Кодеки фиксированной формы (без длин и индексов, от которых зависит размер) дополнительно
+// объявляют верхнюю границу кодировки вместе с битами выравнивания и декодер без проверок границ:
+//     static constexpr size_t max_bits;
+//     template <typename V> static Result<V> decode_unchecked(core::BitReader&, DecodeContext);
+// SEQUENCE один раз сверяет сумму max_bits ведущих полей с bits_left() и читает их через
+// decode_unchecked; проверки значений (диапазоны, индексы) остаются на месте.
+//
+// Кодеки, значения которых владеют памятью (строки, векторы, SEQUENCE, CHOICE), умеют
+// декодировать в уже существующий объект, сохраняя емкость его строк и векторов:
+//     static Result<void> decode_into(V&, core::BitReader&, DecodeContext);
+// Для остальных detail::decode_into присваивает результат decode_value.
+
+namespace h323_26::asn1 {
+
+    // Верхняя граница для SIZE без ограничения
+    inline constexpr size_t Unbounded = std::numeric_limits<size_t>::max();
+
+    // Признак расширяемости типа ("...")
+    inline constexpr bool Extensible = true;
+    inline constexpr bool NotExtensible = false;
+
+    // Вариант PER всех кодеков схемы
+    using SchemaVariant = Aligned;
+
+    // Состояние, общее для всего дерева декодирования одной датаграммы
+    struct DecodeContext {
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource();
+    };
+
+    namespace detail {
+
+        template <typename M>
+        struct member_pointer_traits;
+
+        template <typename C, typename M>
+        struct member_pointer_traits<M C::*> {
+            using class_type = C;
+            using member_type = M;
+        };
+
+        template <typename T>
+        inline constexpr bool is_optional_v = false;
+
+        template <typename T>
+        inline constexpr bool is_optional_v<std::optional<T>> = true;
+
+        // Один и тот же указатель на член (типы указателей могут различаться)
+        template <auto A, auto B>
+        constexpr bool same_member() {
+            if constexpr (std::same_as<decltype(A), decltype(B)>) return A == B;
+            else return false;
+        }
+
+        // Количество бит для индекса из n вариантов
+        constexpr size_t index_bits(size_t n) {
+            return n <= 1 ? 0 : static_cast<size_t>(std::bit_width(n - 1));
+        }
+
+        // Граница кодировки кодека фиксированной формы; Unbounded — размер зависит от данных
+        template <typename Codec>
+        constexpr size_t max_bits_of() {
+            if constexpr (requires { Codec::max_bits; }) return Codec::max_bits;
+            else return Unbounded;
+        }
+
+        // Декодирование в существующий объект: decode_into кодека, если он пишет в V на месте,
+        // иначе присваивание результата decode_value
+        template <typename Codec, typename V>
+        Result<void> decode_into(V& out, core::BitReader& reader, DecodeContext ctx) {
+            if constexpr (requires { Codec::decode_into(out, reader, ctx); }) {
+                return Codec::decode_into(out, reader, ctx);
+            }
+            else {
+                auto value = Codec::template decode_value<V>(reader, ctx);
+                if (!value) return std::unexpected(value.error());
+                out = std::move(*value);
+                return {};
+            }
+        }
+
+    } // namespace detail
+
+    // SIZE(Lo..Hi) для строк и SEQUENCE OF:
+    //   Lo == Hi < 64K — длина не передается;
+    //   Hi < 64K       — длина как constrained whole number (Lo..Hi);
+    //   иначе          — общий определитель длины.
+    // Содержимое выравнивается, кроме фиксированного размером до 16 бит (до 2 октетов,
+    // одного символа BMPString, 16 бит BIT STRING).
+    template <size_t Lo, size_t Hi>
+    struct Size {
+        static_assert(Lo <= Hi, "SIZE lower bound exceeds upper bound");
+
+        static constexpr bool constrained = Hi != Unbounded && Hi < 65536;
+        static constexpr bool fixed = constrained && Lo == Hi;
+        static constexpr size_t length_bits = constrained ? static_cast<size_t>(std::bit_width(Hi - Lo)) : 0;
+        static constexpr IntegerForm length_form = constrained_integer_form<SchemaVariant>(Lo, constrained ? Hi : Lo);
+        template <size_t UnitBits>
+        static constexpr bool aligned_units = SchemaVariant::aligned && !(fixed && Hi * UnitBits <= 16);
+        static constexpr bool aligned_contents = aligned_units<8>;
+
+        template <core::BitSink W>
+        static constexpr Result<void> encode_length(W& writer, size_t length) {
+            if (length < Lo || length > Hi) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+            }
+            if constexpr (fixed) {
+                return {};
+            }
+            else if constexpr (constrained) {
+                return PerEncoder::encode_constrained_integer(writer, length, Lo, Hi);
+            }
+            else {
+                return PerEncoder::encode_length_determinant(writer, length);
+            }
+        }
+
+        static Result<size_t> decode_length(core::BitReader& reader) {
+            if constexpr (fixed) {
+                return Lo;
+            }
+            else {
+                size_t length = 0;
+                if constexpr (constrained && length_form == IntegerForm::bit_field) {
+                    auto raw = reader.read_bits(length_bits);
+                    if (!raw) return std::unexpected(raw.error());
+                    length = Lo + static_cast<size_t>(*raw);
+                }
+                else if constexpr (constrained) {
+                    // Диапазон длин от 256: выровненные октеты
+                    auto raw = PerDecoder::decode_constrained_integer(reader, Lo, Hi);
+                    if (!raw) return std::unexpected(raw.error());
+                    length = static_cast<size_t>(*raw);
+                }
+                else {
+                    auto raw = PerDecoder::decode_length_determinant(reader);
+                    if (!raw) return std::unexpected(raw.error());
+                    length = *raw;
+                }
+                if (length < Lo || length > Hi) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+                }
+                return length;
+            }
+        }
+
+        // Длина + октеты. Без верхней границы длина может быть
+        // фрагментирована (от 16K) — тогда содержимое идет кусками между определителями.
+        template <core::BitSink W>
+        static constexpr Result<void> encode_octets(W& writer, std::span<const std::byte> bytes) {
+            if constexpr (!fixed && !constrained) {
+                if (bytes.size() < Lo) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+                }
+                return PerEncoder::encode_octet_string(writer, bytes);
+            }
+            else {
+                if (auto res = encode_length(writer, bytes.size()); !res) return res;
+                if (bytes.empty()) return {};
+
+                if constexpr (aligned_contents) writer.align_to_byte();
+                return writer.write_bytes(bytes);
+            }
+        }
+
+        // То же для символов строки при константном вычислении, где as_bytes недоступен
+        template <core::BitSink W>
+        static constexpr Result<void> encode_chars(W& writer, std::string_view text) {
+            if constexpr (!fixed && !constrained) {
+                if (text.size() < Lo) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+                }
+                return PerEncoder::encode_ia5_string(writer, text);
+            }
+            else {
+                if (auto res = encode_length(writer, text.size()); !res) return res;
+                if (text.empty()) return {};
+
+                if constexpr (aligned_contents) writer.align_to_byte();
+                for (char c : text) {
+                    if (auto res = writer.write_bits(static_cast<uint8_t>(c), 8); !res) return res;
+                }
+                return {};
+            }
+        }
+
+        // Окно на октеты содержимого уже прочитанной длины (только выровненное содержимое)
+        static Result<std::span<const std::byte>> view_octets(core::BitReader& reader, size_t length) {
+            static_assert(aligned_contents, "Unaligned short strings cannot be viewed");
+            if (length == 0) return std::span<const std::byte>{};
+            reader.align_to_byte();
+            return reader.view_bytes(length);
+        }
+
+        // Копирующее чтение октетов в конец контейнера
+        template <typename Container>
+        static Result<void> decode_octets(core::BitReader& reader, Container& out) {
+            core::AppendOctetSink sink(out);
+            if constexpr (!fixed && !constrained) {
+                auto total = PerDecoder::decode_octet_stream(reader, sink);
+                if (!total) return std::unexpected(total.error());
+                if (*total < Lo) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+                }
+                return {};
+            }
+            else {
+                auto length = decode_length(reader);
+                if (!length) return std::unexpected(length.error());
+                if (*length == 0) return {};
+
+                if constexpr (aligned_contents) {
+                    reader.align_to_byte();
+                    auto bytes = reader.view_bytes(*length);
+                    if (!bytes) return std::unexpected(bytes.error());
+                    return sink.write(*bytes);
+                }
+                else {
+                    // Не больше 2 октетов с произвольной позиции
+                    std::array<std::byte, 2> bytes;
+                    auto chunk = std::span(bytes).first(*length);
+                    if (auto res = reader.read_bytes(chunk); !res) return res;
+                    return sink.write(chunk);
+                }
+            }
+        }
+
+        // Пропуск строки из октетов: длина + (выравнивание) + содержимое
+        static Result<void> skip_octets(core::BitReader& reader) {
+            if constexpr (!fixed && !constrained) {
+                core::DiscardOctetSink sink;
+                auto total = PerDecoder::decode_octet_stream(reader, sink);
+                if (!total) return std::unexpected(total.error());
+                return {};
+            }
+            else {
+                auto length = decode_length(reader);
+                if (!length) return std::unexpected(length.error());
+                if (*length == 0) return {};
+
+                if constexpr (aligned_contents) reader.align_to_byte();
+                return reader.skip_bits(*length * 8);
+            }
+        }
+
+        // Пропуск содержимого из элементов по UnitBits бит (символы BMPString, биты BIT STRING)
+        template <size_t UnitBits>
+        static Result<void> skip_units(core::BitReader& reader) {
+            if constexpr (!fixed && !constrained) {
+                for (;;) {
+                    auto fragment = PerDecoder::decode_length_fragment(reader);
+                    if (!fragment) return std::unexpected(fragment.error());
+                    if (auto res = reader.skip_bits(fragment->length * UnitBits); !res) return res;
+                    if (fragment->last) return {};
+                }
+            }
+            else {
+                auto length = decode_length(reader);
+                if (!length) return std::unexpected(length.error());
+                if (*length == 0) return {};
+
+                if constexpr (aligned_units<UnitBits>) reader.align_to_byte();
+                return reader.skip_bits(*length * UnitBits);
+            }
+        }
+    };
+
+    // INTEGER (Min..Max): смещение от Min. До 256 значений — bit_width(Max - Min) бит
+    // без выравнивания, до 64K — выровненные 1..2 октета, больше — число октетов и октеты
+    template <uint64_t Min, uint64_t Max>
+    struct Integer {
+        static_assert(Min <= Max, "INTEGER lower bound exceeds upper bound");
+
+        static constexpr size_t bits = static_cast<size_t>(std::bit_width(Max - Min));
+        static constexpr IntegerForm form = constrained_integer_form<SchemaVariant>(Min, Max);
+
+        // Ширина поля в формах фиксированного размера (без бит выравнивания)
+        static constexpr size_t field_bits =
+            form == IntegerForm::one_octet ? 8 : form == IntegerForm::two_octets ? 16 : bits;
+
+        // Число октетов длины в indefinite-форме зависит от значения
+        static constexpr size_t max_bits = form == IntegerForm::indefinite ? Unbounded
+            : form == IntegerForm::bit_field || form == IntegerForm::empty ? field_bits : 7 + field_bits;
+
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& value) {
+            auto raw = static_cast<uint64_t>(value);
+            if (raw < Min || raw > Max) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Value is out of ASN.1 constrained range" });
+            }
+            if constexpr (form == IntegerForm::empty) {
+                return {};
+            }
+            else if constexpr (form == IntegerForm::indefinite) {
+                return PerEncoder::encode_constrained_integer(writer, raw, Min, Max);
+            }
+            else {
+                if constexpr (form != IntegerForm::bit_field) writer.align_to_byte();
+                return writer.write_bits(raw - Min, field_bits);
+            }
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext) {
+            if constexpr (form == IntegerForm::empty) {
+                return static_cast<V>(Min);
+            }
+            else if constexpr (form == IntegerForm::indefinite) {
+                auto value = PerDecoder::decode_constrained_integer(reader, Min, Max);
+                if (!value) return std::unexpected(value.error());
+                return static_cast<V>(*value);
+            }
+            else {
+                if constexpr (form != IntegerForm::bit_field) reader.align_to_byte();
+                auto raw = reader.read_bits(field_bits);
+                if (!raw) return std::unexpected(raw.error());
+                if (*raw > Max - Min) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Decoded value exceeds max constraint" });
+                }
+                return static_cast<V>(Min + *raw);
+            }
+        }
+
+        template <typename V>
+        static Result<V> decode_unchecked(core::BitReader& reader, DecodeContext) {
+            static_assert(form != IntegerForm::indefinite, "Indefinite-length INTEGER has no fixed shape");
+            if constexpr (form == IntegerForm::empty) {
+                return static_cast<V>(Min);
+            }
+            else {
+                if constexpr (form != IntegerForm::bit_field) reader.align_to_byte();
+                uint64_t raw = reader.read_bits_unchecked(field_bits);
+                if (raw > Max - Min) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Decoded value exceeds max constraint" });
+                }
+                return static_cast<V>(Min + raw);
+            }
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            if constexpr (form == IntegerForm::indefinite) {
+                auto value = PerDecoder::decode_constrained_integer(reader, Min, Max);
+                if (!value) return std::unexpected(value.error());
+                return {};
+            }
+            else {
+                if constexpr (form != IntegerForm::bit_field && form != IntegerForm::empty) reader.align_to_byte();
+                return reader.skip_bits(field_bits);
+            }
+        }
+    };
+
+    // BOOLEAN (1 бит)
+    struct Boolean {
+        static constexpr size_t max_bits = 1;
+
+        template <core::BitSink W>
+        static constexpr Result<void> encode_value(W& writer, bool value) {
+            return writer.write_bits(value ? 1 : 0, 1);
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext) {
+            auto bit = reader.read_bits(1);
+            if (!bit) return std::unexpected(bit.error());
+            return static_cast<V>(*bit == 1);
+        }
+
+        template <typename V>
+        static Result<V> decode_unchecked(core::BitReader& reader, DecodeContext) {
+            return static_cast<V>(reader.read_bits_unchecked(1) == 1);
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            return reader.skip_bits(1);
+        }
+    };
+
+    // ENUMERATED или CHOICE из одних NULL (например, rejectReason): только индекс варианта
+    template <size_t RootCount, bool Ext = Extensible>
+    struct Enumerated {
+        static constexpr size_t bits = detail::index_bits(RootCount);
+        static constexpr size_t max_bits = bits + (Ext ? 1 : 0);
+
+        static_assert(RootCount <= 255, "Index of more than 255 values would be octet-aligned");
+
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& value) {
+            auto index = static_cast<uint64_t>(value);
+            if (index >= RootCount) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Enumeration index is out of range" });
+            }
+            // Маркер расширения (0) и индекс пишутся одним вызовом
+            return writer.write_bits(index, bits + (Ext ? 1 : 0));
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext) {
+            auto raw = reader.read_bits(max_bits);
+            if (!raw) return std::unexpected(raw.error());
+            return to_index<V>(*raw);
+        }
+
+        template <typename V>
+        static Result<V> decode_unchecked(core::BitReader& reader, DecodeContext) {
+            if constexpr (max_bits == 0) {
+                return static_cast<V>(0);
+            }
+            else {
+                return to_index<V>(reader.read_bits_unchecked(max_bits));
+            }
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            auto index = decode_value<uint64_t>(reader, DecodeContext{});
+            if (!index) return std::unexpected(index.error());
+            return {};
+        }
+
+    private:
+        template <typename V>
+        static Result<V> to_index(uint64_t raw) {
+            if (Ext && (raw >> bits) != 0) {
+                return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Extension enumerations not implemented yet" });
+            }
+            uint64_t index = bits == 0 ? 0 : (raw & ((1ULL << bits) - 1));
+            if (index >= RootCount) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Enumeration index is out of range" });
+            }
+            return static_cast<V>(index);
+        }
+    };
+
+    // Алфавит строки, символ которой в ALIGNED занимает октет
+    enum class CharacterSet : uint8_t { ia5, printable };
+
+    // IA5String / PrintableString с необязательным SIZE(Lo..Hi). Символы — октеты (ALIGNED,
+    // как в PerEncoder); символ вне алфавита отвергается и при кодировании, и при декодировании.
+    // Декодирует в std::pmr::string (из арены контекста) или в std::string_view на датаграмму.
+    template <CharacterSet Set, size_t Lo, size_t Hi>
+    struct RestrictedString {
+        using size_type = Size<Lo, Hi>;
+
+        // Проверка алфавита: векторное ядро во время выполнения, посимвольно — при компиляции
+        static constexpr bool permitted(std::string_view text) {
+            if consteval {
+                if constexpr (Set == CharacterSet::ia5) return PerEncoder::is_ia5(text);
+                else return std::ranges::all_of(text, core::is_printable_char);
+            }
+            else {
+                const auto& kernels = core::octet_kernels();
+                if constexpr (Set == CharacterSet::ia5) return kernels.is_ia5(text.data(), text.size());
+                else return kernels.is_printable(text.data(), text.size());
+            }
+        }
+
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& value) {
+            std::string_view text(value);
+            if (!permitted(text)) return alphabet_error();
+            if consteval {
+                return size_type::encode_chars(writer, text);
+            }
+            else {
+                return size_type::encode_octets(writer, std::as_bytes(std::span(text)));
+            }
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            if constexpr (std::same_as<V, std::string_view>) {
+                // View возможен только для непрерывного (нефрагментированного) содержимого
+                auto length = size_type::decode_length(reader);
+                if (!length) return std::unexpected(length.error());
+                auto bytes = size_type::view_octets(reader, *length);
+                if (!bytes) return std::unexpected(bytes.error());
+                std::string_view text(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+                if (!permitted(text)) return alphabet_error();
+                return text;
+            }
+            else {
+                std::pmr::string text(ctx.mr);
+                if (auto res = decode_into(text, reader, ctx); !res) return std::unexpected(res.error());
+                if constexpr (std::same_as<V, std::pmr::string>) {
+                    return text;
+                }
+                else {
+                    return V(std::string_view(text));
+                }
+            }
+        }
+
+        static Result<void> decode_into(std::pmr::string& out, core::BitReader& reader, DecodeContext) {
+            out.clear();
+            if (auto res = size_type::decode_octets(reader, out); !res) return res;
+            if (!permitted(out)) return alphabet_error();
+            return {};
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            return size_type::skip_octets(reader);
+        }
+
+    private:
+        static constexpr std::unexpected<Error> alphabet_error() {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Character is outside the permitted alphabet" });
+        }
+    };
+
+    template <size_t Lo = 0, size_t Hi = Unbounded>
+    using IA5String = RestrictedString<CharacterSet::ia5, Lo, Hi>;
+
+    template <size_t Lo = 0, size_t Hi = Unbounded>
+    using PrintableString = RestrictedString<CharacterSet::printable, Lo, Hi>;
+
+    // BMPString с необязательным SIZE(Lo..Hi): символы по 16 бит (UCS-2, старший октет первым).
+    // В программе значение — UTF-8: кодируется из всего, что приводится к std::string_view,
+    // декодируется в std::pmr::string (из арены контекста) или тип, конструируемый из
+    // std::string_view. Перекодирование при декодировании — векторное.
+    // Без перекодирования — BmpStringView на символы датаграммы (только SIZE с верхней
+    // границей: содержимое тогда непрерывно и выровнено).
+    template <size_t Lo = 0, size_t Hi = Unbounded>
+    struct BMPString {
+        using size_type = Size<Lo, Hi>;
+
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& value) {
+            if constexpr (std::same_as<V, BmpStringView>) {
+                static_assert(size_type::constrained, "BmpStringView needs a SIZE upper bound");
+                if (auto res = size_type::encode_length(writer, value.size()); !res) return res;
+                if (value.empty()) return {};
+
+                if constexpr (size_type::template aligned_units<16>) writer.align_to_byte();
+                return writer.write_bytes(value.bytes());
+            }
+            else {
+                return encode_text(writer, std::string_view(value));
+            }
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            // Строка UTF-8 собирается во временном буфере: view на нее повис бы
+            static_assert(!std::same_as<V, std::string_view>, "BMPString is not UTF-8 on the wire: decode to BmpStringView");
+
+            if constexpr (std::same_as<V, BmpStringView>) {
+                static_assert(size_type::constrained && size_type::template aligned_units<16>,
+                    "Only a bounded, aligned BMPString can be viewed");
+                auto length = size_type::decode_length(reader);
+                if (!length) return std::unexpected(length.error());
+                if (*length == 0) return BmpStringView{};
+
+                reader.align_to_byte();
+                auto units = reader.view_bytes(*length * 2);
+                if (!units) return std::unexpected(units.error());
+                for (size_t i = 0; i < units->size(); i += 2) {
+                    if ((static_cast<uint8_t>((*units)[i]) & 0xF8) == 0xD8) {
+                        return std::unexpected(Error{ ErrorCode::InvalidConstraint, "BMPString character is a UTF-16 surrogate" });
+                    }
+                }
+                return BmpStringView(*units);
+            }
+            else {
+                std::pmr::string text(ctx.mr);
+                if (auto res = decode_into(text, reader, ctx); !res) return std::unexpected(res.error());
+
+                if constexpr (std::same_as<V, std::pmr::string>) {
+                    return text;
+                }
+                else {
+                    return V(std::string_view(text));
+                }
+            }
+        }
+
+        static Result<void> decode_into(std::pmr::string& out, core::BitReader& reader, DecodeContext) {
+            if constexpr (!size_type::fixed && !size_type::constrained) {
+                if (auto res = PerDecoder::decode_bmp_string_into(out, reader); !res) return res;
+                // Символов столько, сколько октетов UTF-8 не являются продолжением
+                if (static_cast<size_t>(std::ranges::count_if(out, [](char c) { return (c & 0xC0) != 0x80; })) < Lo) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+                }
+                return {};
+            }
+            else {
+                out.clear();
+                auto length = size_type::decode_length(reader);
+                if (!length) return std::unexpected(length.error());
+                if (*length == 0) return {};
+
+                if constexpr (size_type::template aligned_units<16>) reader.align_to_byte();
+                return PerDecoder::decode_bmp_chars(reader, *length, out);
+            }
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            return size_type::template skip_units<16>(reader);
+        }
+
+    private:
+        // Символы UTF-8: длина в символах, затем по 16 бит на символ
+        template <core::BitSink W>
+        static constexpr Result<void> encode_text(W& writer, std::string_view text) {
+            auto count = PerEncoder::bmp_length(text);
+            if (!count) return std::unexpected(count.error());
+
+            if constexpr (!size_type::fixed && !size_type::constrained) {
+                if (*count < Lo) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+                }
+                return PerEncoder::encode_bmp_string(writer, text);
+            }
+            else {
+                if (auto res = size_type::encode_length(writer, *count); !res) return res;
+                if (*count == 0) return {};
+
+                if constexpr (size_type::template aligned_units<16>) writer.align_to_byte();
+                return PerEncoder::encode_bmp_chars(writer, text);
+            }
+        }
+    };
+
+    // BIT STRING с необязательным SIZE(Lo..Hi) в битах поверх BitStringValue.
+    // Фиксированные до 16 бит не выравниваются; содержимое со сдвигом копируется векторным ядром.
+    template <size_t Lo = 0, size_t Hi = Unbounded>
+    struct BitString {
+        using size_type = Size<Lo, Hi>;
+
+        static constexpr size_t max_bits = !size_type::fixed ? Unbounded
+            : (size_type::template aligned_units<1> && Lo > 0 ? 7 : 0) + Lo;
+
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& value) {
+            std::span<const std::byte> octets(value.octets);
+            if constexpr (!size_type::fixed && !size_type::constrained) {
+                if (value.bits < Lo) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+                }
+                return PerEncoder::encode_bit_string(writer, octets, value.bits);
+            }
+            else {
+                if (auto res = size_type::encode_length(writer, value.bits); !res) return res;
+                if (value.bits == 0) return {};
+
+                if constexpr (size_type::template aligned_units<1>) writer.align_to_byte();
+                return PerEncoder::encode_bit_contents(writer, octets, value.bits);
+            }
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            static_assert(std::same_as<V, BitStringValue>, "BIT STRING decodes into BitStringValue");
+
+            BitStringValue value{ BitStringValue::allocator_type(ctx.mr) };
+            if (auto res = decode_into(value, reader, ctx); !res) return std::unexpected(res.error());
+            return value;
+        }
+
+        static Result<void> decode_into(BitStringValue& out, core::BitReader& reader, DecodeContext) {
+            if constexpr (!size_type::fixed && !size_type::constrained) {
+                if (auto res = PerDecoder::decode_bit_string_into(out, reader); !res) return res;
+                if (out.bits < Lo) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length is out of SIZE constraint" });
+                }
+                return {};
+            }
+            else {
+                out.octets.clear();
+                out.bits = 0;
+                auto length = size_type::decode_length(reader);
+                if (!length) return std::unexpected(length.error());
+                if (*length == 0) return {};
+
+                if constexpr (size_type::template aligned_units<1>) reader.align_to_byte();
+                return PerDecoder::decode_bit_contents(reader, *length, out);
+            }
+        }
+
+        // Биты фиксированной строки копируются тем же read_bytes, что и в decode_value
+        template <typename V>
+        static Result<V> decode_unchecked(core::BitReader& reader, DecodeContext ctx) {
+            static_assert(size_type::fixed, "Only fixed-size BIT STRING has a fixed shape");
+            return decode_value<V>(reader, ctx);
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            return size_type::template skip_units<1>(reader);
+        }
+    };
+
+    // OCTET STRING с необязательным SIZE(Lo..Hi). Декодирует в std::span на датаграмму,
+    // std::array<std::byte, N> (фиксированный размер) или std::pmr::vector<std::byte>
+    template <size_t Lo = 0, size_t Hi = Unbounded>
+    struct OctetString {
+        using size_type = Size<Lo, Hi>;
+
+        // Фиксированная длина не передается: выравнивание и Lo октетов
+        static constexpr size_t max_bits = !size_type::fixed ? Unbounded
+            : (size_type::aligned_contents && Lo > 0 ? 7 : 0) + Lo * 8;
+
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& value) {
+            return size_type::encode_octets(writer, std::span<const std::byte>(value));
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            if constexpr (std::same_as<V, std::pmr::vector<std::byte>>) {
+                V value(ctx.mr);
+                if (auto res = size_type::decode_octets(reader, value); !res) return std::unexpected(res.error());
+                return value;
+            }
+            else {
+                auto length = size_type::decode_length(reader);
+                if (!length) return std::unexpected(length.error());
+
+                if constexpr (std::same_as<V, std::span<const std::byte>>) {
+                    return size_type::view_octets(reader, *length);
+                }
+                else {
+                    // Хранилище фиксированного размера (std::array)
+                    V value{};
+                    if (std::span<std::byte>(value).size() != *length) {
+                        return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Length does not match fixed-size storage" });
+                    }
+                    if (*length == 0) return value;
+
+                    if constexpr (size_type::aligned_contents) reader.align_to_byte();
+                    if (auto res = reader.read_bytes(value); !res) return std::unexpected(res.error());
+                    return value;
+                }
+            }
+        }
+
+        static Result<void> decode_into(std::pmr::vector<std::byte>& out, core::BitReader& reader, DecodeContext) {
+            out.clear();
+            return size_type::decode_octets(reader, out);
+        }
+
+        // Октеты читаются тем же memcpy/view, что и в decode_value: их проверка
+        // границ — одна на всю строку, а не на каждое чтение
+        template <typename V>
+        static Result<V> decode_unchecked(core::BitReader& reader, DecodeContext ctx) {
+            static_assert(size_type::fixed, "Only fixed-size OCTET STRING has a fixed shape");
+            return decode_value<V>(reader, ctx);
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            return size_type::skip_octets(reader);
+        }
+    };
+
+    // OBJECT IDENTIFIER: владеющий вектор дуг, InternedOid или OidView на датаграмму
+    struct ObjectIdentifier {
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& value) {
+            if constexpr (std::same_as<V, OidView>) {
+                // BER-содержимое уже готово — пишем как есть
+                return PerEncoder::encode_octet_string(writer, value.bytes());
+            }
+            else if constexpr (std::same_as<V, InternedOid>) {
+                const WellKnownOid* entry = OidRegistry::find(value.id());
+                if (!entry) return PerEncoder::encode_oid(writer, value.arcs());
+
+                // Известный OID: длина (< 128, один выровненный октет) и готовые байты реестра
+                if (auto res = PerEncoder::encode_length_determinant(writer, entry->ber.size()); !res) return res;
+                return writer.write_bytes(entry->ber);
+            }
+            else {
+                return PerEncoder::encode_oid(writer, std::span<const uint32_t>(value));
+            }
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            if constexpr (std::same_as<V, OidView>) {
+                return PerDecoder::decode_oid_view(reader);
+            }
+            else if constexpr (std::same_as<V, InternedOid>) {
+                // Выровненное содержимое сравнивается с реестром; дуги разбираются
+                // и копируются в ctx.mr только для неизвестного OID
+                auto view = PerDecoder::decode_oid_view(reader);
+                if (!view) return std::unexpected(view.error());
+                return InternedOid(*view, ctx.mr);
+            }
+            else {
+                return PerDecoder::decode_oid(reader, ctx.mr);
+            }
+        }
+
+        static Result<void> decode_into(std::pmr::vector<uint32_t>& out, core::BitReader& reader, DecodeContext) {
+            return PerDecoder::decode_oid_into(out, reader);
+        }
+
+        static Result<void> decode_into(InternedOid& out, core::BitReader& reader, DecodeContext ctx) {
+            auto view = PerDecoder::decode_oid_view(reader);
+            if (!view) return std::unexpected(view.error());
+            out.assign(*view, ctx.mr);
+            return {};
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            return Size<0, Unbounded>::skip_octets(reader);
+        }
+    };
+
+    // Дополнения SEQUENCE после "...": битовая карта присутствия и по open type на каждое
+    // присутствующее дополнение. При разборе сообщения содержимое не декодируется —
+    // сохраняются только ссылки на октеты датаграммы (длина прочитана, тело пропущено),
+    // а конкретное дополнение декодируется при обращении к нему через get().
+    class ExtensionAdditions {
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        ExtensionAdditions() = default;
+        explicit ExtensionAdditions(allocator_type alloc) : entries_(alloc) {}
+
+        // Число дополнений в битовой карте (включая отсутствующие)
+        [[nodiscard]] size_t size() const { return entries_.size(); }
+        [[nodiscard]] bool empty() const { return entries_.empty(); }
+
+        [[nodiscard]] bool has(size_t index) const {
+            return index < entries_.size() && !entries_[index].empty();
+        }
+
+        // Содержимое open type дополнения (пусто, если его нет)
+        [[nodiscard]] std::span<const std::byte> raw(size_t index) const {
+            return has(index) ? entries_[index] : std::span<const std::byte>{};
+        }
+
+        // Задает готовую кодировку дополнения. Буфер не копируется и должен
+        // жить до конца кодирования сообщения.
+        void set_raw(size_t index, std::span<const std::byte> contents) {
+            if (index >= entries_.size()) entries_.resize(index + 1);
+            entries_[index] = contents;
+        }
+
+        // Декодирует дополнение с номером index кодеком Codec; nullopt, если его нет
+        template <typename Codec, typename V>
+        Result<std::optional<V>> get(size_t index, DecodeContext ctx = {}) const {
+            if (!has(index)) return std::optional<V>{};
+
+            core::BitReader reader(entries_[index]);
+            auto value = Codec::template decode_value<V>(reader, ctx);
+            if (!value) return std::unexpected(value.error());
+            return std::optional<V>(std::move(*value));
+        }
+
+        template <core::BitSink W>
+        Result<void> encode(W& writer) const {
+            // Битовая карта: число дополнений - 1 (normally small), затем по биту на каждое
+            if (auto res = PerEncoder::encode_normally_small_number(writer, entries_.size() - 1); !res) return res;
+            for (size_t i = 0; i < entries_.size(); i += 64) {
+                size_t count = std::min<size_t>(64, entries_.size() - i);
+                uint64_t bits = 0;
+                for (size_t j = 0; j < count; ++j) {
+                    bits = (bits << 1) | (entries_[i + j].empty() ? 0 : 1);
+                }
+                if (auto res = writer.write_bits(bits, count); !res) return res;
+            }
+
+            for (const auto& contents : entries_) {
+                if (contents.empty()) continue;
+                if (auto res = PerEncoder::encode_open_type(writer, contents); !res) return res;
+            }
+            return {};
+        }
+
+        // Удаляет все дополнения, сохраняя память под их список
+        void clear() { entries_.clear(); }
+
+        static Result<ExtensionAdditions> decode(core::BitReader& reader, std::pmr::memory_resource* mr) {
+            ExtensionAdditions additions{ allocator_type(mr) };
+            if (auto res = decode_into(additions, reader); !res) return std::unexpected(res.error());
+            return additions;
+        }
+
+        static Result<void> decode_into(ExtensionAdditions& out, core::BitReader& reader) {
+            out.entries_.clear();
+            return for_each_addition(reader, [&](size_t count) { out.entries_.resize(count); },
+                [&](size_t index, std::span<const std::byte> contents) { out.entries_[index] = contents; });
+        }
+
+        // Пропускает дополнения, которые тип не хранит: читаются только длины
+        static Result<void> skip(core::BitReader& reader) {
+            return for_each_addition(reader, [](size_t) {}, [](size_t, std::span<const std::byte>) {});
+        }
+
+    private:
+        template <typename OnCount, typename OnAddition>
+        static Result<void> for_each_addition(core::BitReader& reader, OnCount&& on_count, OnAddition&& on_addition) {
+            auto last = PerDecoder::decode_normally_small_number(reader);
+            if (!last) return std::unexpected(last.error());
+            if (*last >= reader.bits_left()) {
+                return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+            }
+
+            size_t count = static_cast<size_t>(*last) + 1;
+            on_count(count);
+
+            // Битовую карту читаем целиком до open type'ов, по 64 бита за раз
+            core::BitReader bitmap = reader;
+            if (auto res = reader.skip_bits(count); !res) return res;
+
+            for (size_t i = 0; i < count; i += 64) {
+                size_t chunk = std::min<size_t>(64, count - i);
+                uint64_t bits = *bitmap.read_bits(chunk);
+                for (size_t j = 0; j < chunk; ++j) {
+                    if (((bits >> (chunk - 1 - j)) & 1) == 0) continue;
+                    auto contents = PerDecoder::decode_open_type(reader);
+                    if (!contents) return std::unexpected(contents.error());
+                    on_addition(i + j, *contents);
+                }
+            }
+            return {};
+        }
+
+        std::pmr::vector<std::span<const std::byte>> entries_;
+    };
+
+    // Привязка члена ExtensionAdditions к дополнениям SEQUENCE (последнее поле описания).
+    // Наличие передается битом расширения в заголовке SEQUENCE.
+    struct Additions {
+        template <core::BitSink W>
+        static constexpr Result<void> encode_value(W& writer, const ExtensionAdditions& value) {
+            return value.encode(writer);
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            return ExtensionAdditions::decode(reader, ctx.mr);
+        }
+
+        static Result<void> decode_into(ExtensionAdditions& out, core::BitReader& reader, DecodeContext) {
+            return ExtensionAdditions::decode_into(out, reader);
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            return ExtensionAdditions::skip(reader);
+        }
+    };
+
+    // Положение поля в готовой кодировке: смещение от начала потока и ширина в битах
+    // (вместе с битами выравнивания перед выровненным содержимым)
+    struct FieldLocation {
+        size_t bit_offset = 0;
+        size_t bit_width = 0;
+        bool present = false;
+    };
+
+    // OPTIONAL-обертка для поля: член структуры имеет тип std::optional<V>,
+    // наличие передается битом в преамбуле SEQUENCE
+    template <typename Codec>
+    struct Optional {
+        using codec = Codec;
+    };
+
+    // Привязка кодека к члену структуры
+    template <auto Member, typename Codec>
+    struct Field {
+        using owner_type = typename detail::member_pointer_traits<decltype(Member)>::class_type;
+        using value_type = typename detail::member_pointer_traits<decltype(Member)>::member_type;
+        using codec = Codec;
+        static constexpr auto member = Member;
+        static constexpr bool is_optional = false;
+        static constexpr bool is_additions = false;
+
+        template <core::BitSink W>
+        static constexpr Result<void> encode(W& writer, const owner_type& obj) {
+            return Codec::encode_value(writer, obj.*Member);
+        }
+
+        static constexpr bool present(const owner_type&) { return true; }
+
+        static Result<value_type> decode(core::BitReader& reader, DecodeContext ctx, bool) {
+            return Codec::template decode_value<value_type>(reader, ctx);
+        }
+
+        static Result<value_type> decode_unchecked(core::BitReader& reader, DecodeContext ctx, bool) {
+            return Codec::template decode_unchecked<value_type>(reader, ctx);
+        }
+
+        static Result<void> decode_into(owner_type& obj, core::BitReader& reader, DecodeContext ctx, bool) {
+            return detail::decode_into<Codec>(obj.*Member, reader, ctx);
+        }
+
+        static Result<void> decode_unchecked_into(owner_type& obj, core::BitReader& reader, DecodeContext ctx, bool) {
+            auto value = Codec::template decode_unchecked<value_type>(reader, ctx);
+            if (!value) return std::unexpected(value.error());
+            obj.*Member = std::move(*value);
+            return {};
+        }
+
+        static Result<void> skip(core::BitReader& reader, bool) {
+            return Codec::skip_value(reader);
+        }
+    };
+
+    template <auto Member, typename Codec>
+    struct Field<Member, Optional<Codec>> {
+        using owner_type = typename detail::member_pointer_traits<decltype(Member)>::class_type;
+        using value_type = typename detail::member_pointer_traits<decltype(Member)>::member_type;
+        using codec = Codec;
+        static constexpr auto member = Member;
+        static constexpr bool is_optional = true;
+        static constexpr bool is_additions = false;
+
+        static_assert(detail::is_optional_v<value_type>, "OPTIONAL field must be a std::optional member");
+
+        template <core::BitSink W>
+        static constexpr Result<void> encode(W& writer, const owner_type& obj) {
+            const auto& value = obj.*Member;
+            if (!value) return {};
+            return Codec::encode_value(writer, *value);
+        }
+
+        static constexpr bool present(const owner_type& obj) { return (obj.*Member).has_value(); }
+
+        static Result<value_type> decode(core::BitReader& reader, DecodeContext ctx, bool is_present) {
+            if (!is_present) return value_type{};
+            auto value = Codec::template decode_value<typename value_type::value_type>(reader, ctx);
+            if (!value) return std::unexpected(value.error());
+            return value_type(std::move(*value));
+        }
+
+        static Result<value_type> decode_unchecked(core::BitReader& reader, DecodeContext ctx, bool is_present) {
+            if (!is_present) return value_type{};
+            auto value = Codec::template decode_unchecked<typename value_type::value_type>(reader, ctx);
+            if (!value) return std::unexpected(value.error());
+            return value_type(std::move(*value));
+        }
+
+        // Присутствующее значение перезаписывается на месте; отсутствующее поле освобождает его
+        static Result<void> decode_into(owner_type& obj, core::BitReader& reader, DecodeContext ctx, bool is_present) {
+            auto& value = obj.*Member;
+            if (!is_present) {
+                value.reset();
+                return {};
+            }
+            if (value) return detail::decode_into<Codec>(*value, reader, ctx);
+
+            auto decoded = Codec::template decode_value<typename value_type::value_type>(reader, ctx);
+            if (!decoded) return std::unexpected(decoded.error());
+            value.emplace(std::move(*decoded));
+            return {};
+        }
+
+        static Result<void> decode_unchecked_into(owner_type& obj, core::BitReader& reader, DecodeContext ctx, bool is_present) {
+            auto value = decode_unchecked(reader, ctx, is_present);
+            if (!value) return std::unexpected(value.error());
+            obj.*Member = std::move(*value);
+            return {};
+        }
+
+        static Result<void> skip(core::BitReader& reader, bool is_present) {
+            if (!is_present) return {};
+            return Codec::skip_value(reader);
+        }
+    };
+
+    template <auto Member>
+    struct Field<Member, Additions> {
+        using owner_type = typename detail::member_pointer_traits<decltype(Member)>::class_type;
+        using value_type = typename detail::member_pointer_traits<decltype(Member)>::member_type;
+        using codec = Additions;
+        static constexpr auto member = Member;
+        static constexpr bool is_optional = false;
+        static constexpr bool is_additions = true;
+
+        static_assert(std::same_as<value_type, ExtensionAdditions>, "Additions field must be an ExtensionAdditions member");
+
+        template <core::BitSink W>
+        static constexpr Result<void> encode(W& writer, const owner_type& obj) {
+            const auto& value = obj.*Member;
+            if (value.empty()) return {};
+            return value.encode(writer);
+        }
+
+        static constexpr bool present(const owner_type& obj) { return !(obj.*Member).empty(); }
+
+        static Result<value_type> decode(core::BitReader& reader, DecodeContext ctx, bool is_present) {
+            if (!is_present) return ExtensionAdditions{ ExtensionAdditions::allocator_type(ctx.mr) };
+            return ExtensionAdditions::decode(reader, ctx.mr);
+        }
+
+        static Result<void> decode_into(owner_type& obj, core::BitReader& reader, DecodeContext, bool is_present) {
+            if (!is_present) {
+                (obj.*Member).clear();
+                return {};
+            }
+            return ExtensionAdditions::decode_into(obj.*Member, reader);
+        }
+
+        static Result<void> skip(core::BitReader& reader, bool is_present) {
+            if (!is_present) return {};
+            return ExtensionAdditions::skip(reader);
+        }
+    };
+
+    // SEQUENCE { Fields... [, ...] }
+    template <typename T, bool Ext, typename... Fields>
+    struct Sequence {
+        static constexpr bool extensible = Ext;
+        static constexpr size_t field_count = sizeof...(Fields);
+        static constexpr size_t optional_count = (size_t{ Fields::is_optional } + ... + 0);
+        static constexpr size_t preamble_bits = optional_count;
+
+        // Маркер расширения + преамбула читаются и пишутся одним обращением к потоку
+        static constexpr size_t header_bits = (Ext ? 1 : 0) + preamble_bits;
+
+        static constexpr bool has_additions = (Fields::is_additions || ... || false);
+
+        static_assert(optional_count <= 63, "Too many optional fields");
+        static_assert(!has_additions || Ext, "Extension additions require an extensible SEQUENCE");
+
+        // Ведущие поля фиксированной формы (отсутствующие OPTIONAL занимают 0 бит, то есть
+        // не больше своей границы) и граница заголовка вместе с ними
+        static constexpr size_t prefix_fields = [] {
+            constexpr size_t bounds[] = { detail::max_bits_of<typename Fields::codec>()..., Unbounded };
+            size_t i = 0;
+            while (i < field_count && bounds[i] != Unbounded) ++i;
+            return i;
+        }();
+
+        static constexpr size_t prefix_bits = [] {
+            constexpr size_t bounds[] = { detail::max_bits_of<typename Fields::codec>()..., Unbounded };
+            size_t total = header_bits;
+            for (size_t i = 0; i < prefix_fields; ++i) total += bounds[i];
+            return total;
+        }();
+
+        // Нерасширяемая SEQUENCE из одних полей фиксированной формы сама имеет фиксированную форму
+        static constexpr size_t max_bits = !Ext && prefix_fields == field_count ? prefix_bits : Unbounded;
+
+        // Позиция поля с указателем на член Member в описании
+        template <auto Member>
+        static constexpr size_t field_index = [] {
+            constexpr bool matches[] = { detail::same_member<Fields::member, Member>()..., false };
+            size_t i = 0;
+            while (i < field_count && !matches[i]) ++i;
+            return i;
+        }();
+
+    private:
+        using fields_tuple = std::tuple<Fields...>;
+
+        template <size_t I>
+        using field_at = std::tuple_element_t<I, fields_tuple>;
+
+    public:
+        // Кодек поля Member (для OPTIONAL — кодек значения внутри std::optional)
+        template <auto Member>
+        using field_codec = typename field_at<field_index<Member>>::codec;
+
+    private:
+
+        // Номер бита преамбулы для каждого поля (число OPTIONAL перед ним)
+        static constexpr std::array<size_t, field_count + 1> optional_slots = [] {
+            std::array<size_t, field_count + 1> slots{};
+            constexpr bool flags[] = { Fields::is_optional..., false };
+            size_t slot = 0;
+            for (size_t i = 0; i < field_count; ++i) {
+                slots[i] = slot;
+                if (flags[i]) ++slot;
+            }
+            return slots;
+        }();
+
+        static_assert(!has_additions || field_at<field_count - 1>::is_additions, "Additions field must be the last one");
+
+        // Маска заголовка: первое OPTIONAL-поле — старший бит преамбулы,
+        // дополнения — бит расширения над ней
+        template <size_t I>
+        static constexpr uint64_t presence_bit() {
+            if constexpr (field_at<I>::is_additions) {
+                return 1ULL << preamble_bits;
+            }
+            else if constexpr (!field_at<I>::is_optional) {
+                return 0;
+            }
+            else {
+                return 1ULL << (optional_count - 1 - optional_slots[I]);
+            }
+        }
+
+        template <size_t... I>
+        static constexpr uint64_t build_preamble(const T& obj, std::index_sequence<I...>) {
+            return ((field_at<I>::present(obj) ? presence_bit<I>() : 0) | ... | 0ULL);
+        }
+
+        // Заголовок целиком: бит расширения (если есть) над битами преамбулы
+        static Result<uint64_t> read_preamble(core::BitReader& reader) {
+            if constexpr (header_bits > 0) {
+                return reader.read_bits(header_bits);
+            }
+            else {
+                return 0;
+            }
+        }
+
+        static bool has_extension_bit(uint64_t header) {
+            return Ext && ((header >> preamble_bits) & 1) != 0;
+        }
+
+        template <size_t I>
+        static bool is_present(uint64_t preamble) {
+            if constexpr (field_at<I>::is_optional || field_at<I>::is_additions) return (preamble & presence_bit<I>()) != 0;
+            else return true;
+        }
+
+        // Дополнения, для которых в типе нет члена: только длины и пропуск
+        static Result<void> skip_unheld_additions(core::BitReader& reader, uint64_t header) {
+            if constexpr (Ext && !has_additions) {
+                if (has_extension_bit(header)) return ExtensionAdditions::skip(reader);
+            }
+            return {};
+        }
+
+        template <size_t... I>
+        static Result<void> skip_fields(core::BitReader& reader, uint64_t preamble, std::index_sequence<I...>) {
+            Result<void> res{};
+            (void)(((res = field_at<I>::skip(reader, is_present<I>(preamble))).has_value()) && ...);
+            return res;
+        }
+
+        template <size_t... I>
+        static Result<void> locate_fields(core::BitCounter& counter, const T& obj,
+            std::array<FieldLocation, field_count>& out, std::index_sequence<I...>)
+        {
+            Result<void> res{};
+            auto locate_one = [&]<size_t J>(std::integral_constant<size_t, J>) {
+                out[J].bit_offset = counter.bit_offset();
+                out[J].present = field_at<J>::present(obj);
+                res = field_at<J>::encode(counter, obj);
+                out[J].bit_width = counter.bit_offset() - out[J].bit_offset;
+                return res.has_value();
+            };
+            (void)(locate_one(std::integral_constant<size_t, I>{}) && ...);
+            return res;
+        }
+
+        // Поля до Hoisted уже покрыты одной проверкой bits_left() и читаются без проверок границ
+        template <size_t I, size_t Hoisted, typename... Done>
+        static Result<T> decode_fields(core::BitReader& reader, DecodeContext ctx, uint64_t preamble, Done&&... done) {
+            if constexpr (I == field_count) {
+                return T{ std::move(done)... };
+            }
+            else if constexpr (I < Hoisted) {
+                auto value = field_at<I>::decode_unchecked(reader, ctx, is_present<I>(preamble));
+                if (!value) return std::unexpected(value.error());
+                return decode_fields<I + 1, Hoisted>(reader, ctx, preamble, std::move(done)..., std::move(*value));
+            }
+            else {
+                auto value = field_at<I>::decode(reader, ctx, is_present<I>(preamble));
+                if (!value) return std::unexpected(value.error());
+                return decode_fields<I + 1, Hoisted>(reader, ctx, preamble, std::move(done)..., std::move(*value));
+            }
+        }
+
+        // То же поверх существующего объекта: каждое поле перезаписывается на месте
+        template <size_t Hoisted, size_t... I>
+        static Result<void> decode_fields_into(T& out, core::BitReader& reader, DecodeContext ctx,
+            uint64_t preamble, std::index_sequence<I...>)
+        {
+            Result<void> res{};
+            auto decode_one = [&]<size_t J>(std::integral_constant<size_t, J>) {
+                if constexpr (J < Hoisted) res = field_at<J>::decode_unchecked_into(out, reader, ctx, is_present<J>(preamble));
+                else res = field_at<J>::decode_into(out, reader, ctx, is_present<J>(preamble));
+                return res.has_value();
+            };
+            (void)(decode_one(std::integral_constant<size_t, I>{}) && ...);
+            return res;
+        }
+
+        // Заголовок: при hoisted граница префикса уже проверена, и он читается без проверок
+        static Result<uint64_t> read_header(core::BitReader& reader, bool hoisted) {
+            if (!hoisted) return read_preamble(reader);
+            if constexpr (header_bits > 0) return reader.read_bits_unchecked(header_bits);
+            else return 0;
+        }
+
+    public:
+        template <core::BitSink W>
+        static constexpr Result<void> encode(W& writer, const T& obj) {
+            if constexpr (header_bits > 0) {
+                // Маркер расширения выставляется, только если есть дополнения
+                uint64_t header = build_preamble(obj, std::index_sequence_for<Fields...>{});
+                if (auto res = writer.write_bits(header, header_bits); !res) return res;
+            }
+
+            Result<void> res{};
+            (void)(((res = Fields::encode(writer, obj)).has_value()) && ...);
+            return res;
+        }
+
+        static Result<T> decode(core::BitReader& reader, std::pmr::memory_resource* mr = std::pmr::get_default_resource()) {
+            return decode_value<T>(reader, DecodeContext{ mr });
+        }
+
+        // Интерфейс кодека — для вложенных SEQUENCE
+        template <core::BitSink W>
+        static constexpr Result<void> encode_value(W& writer, const T& obj) {
+            return encode(writer, obj);
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            static_assert(std::same_as<V, T>, "Sequence codec decodes only its own type");
+
+            // Заголовок и префикс фиксированной формы проверяются одним сравнением. Если поток
+            // короче prefix_bits, поля читаются с проверками — ошибка та же, что и без подъема
+            const bool hoisted = prefix_bits > 0 && reader.bits_left() >= prefix_bits;
+            auto header = read_header(reader, hoisted);
+            if (!header) return std::unexpected(header.error());
+
+            auto value = hoisted ? decode_fields<0, prefix_fields>(reader, ctx, *header)
+                                 : decode_fields<0, 0>(reader, ctx, *header);
+            if (!value) return value;
+            if (auto res = skip_unheld_additions(reader, *header); !res) return std::unexpected(res.error());
+            return value;
+        }
+
+        // Декодирование в существующий объект: строки и векторы полей сохраняют емкость,
+        // поэтому повторный разбор похожего сообщения в тот же объект не выделяет память.
+        // Новые значения (впервые присутствующие OPTIONAL, добавившиеся элементы) берут память
+        // из ctx.mr. При ошибке out остается корректным, но частично перезаписанным.
+        static Result<void> decode_into(T& out, core::BitReader& reader, DecodeContext ctx) {
+            const bool hoisted = prefix_bits > 0 && reader.bits_left() >= prefix_bits;
+            auto header = read_header(reader, hoisted);
+            if (!header) return std::unexpected(header.error());
+
+            constexpr auto fields = std::index_sequence_for<Fields...>{};
+            auto res = hoisted ? decode_fields_into<prefix_fields>(out, reader, ctx, *header, fields)
+                               : decode_fields_into<0>(out, reader, ctx, *header, fields);
+            if (!res) return res;
+            return skip_unheld_additions(reader, *header);
+        }
+
+        static Result<void> decode_into(T& out, core::BitReader& reader, std::pmr::memory_resource* mr = std::pmr::get_default_resource()) {
+            return decode_into(out, reader, DecodeContext{ mr });
+        }
+
+        // Вложенная SEQUENCE фиксированной формы: границу уже проверил охватывающий тип
+        template <typename V>
+        static Result<V> decode_unchecked(core::BitReader& reader, DecodeContext ctx) {
+            static_assert(max_bits != Unbounded, "SEQUENCE has no fixed shape");
+            uint64_t header = 0;
+            if constexpr (header_bits > 0) header = reader.read_bits_unchecked(header_bits);
+            return decode_fields<0, field_count>(reader, ctx, header);
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            auto preamble = read_preamble(reader);
+            if (!preamble) return std::unexpected(preamble.error());
+            if (auto res = skip_fields(reader, *preamble, std::index_sequence_for<Fields...>{}); !res) return res;
+            return skip_unheld_additions(reader, *preamble);
+        }
+
+        // Положение каждого поля в кодировке obj, если она начинается с бита start_bit.
+        // Один проход подсчета без записи; отсутствующие OPTIONAL-поля имеют ширину 0.
+        static Result<std::array<FieldLocation, field_count>> locate(const T& obj, size_t start_bit = 0) {
+            std::array<FieldLocation, field_count> locations{};
+            core::BitCounter counter(start_bit);
+            counter.add_bits(header_bits);
+            if (auto res = locate_fields(counter, obj, locations, std::index_sequence_for<Fields...>{}); !res) {
+                return std::unexpected(res.error());
+            }
+            return locations;
+        }
+
+        // Неглубокий разбор: пропускает поля перед Member и декодирует только его в V
+        // (например, std::string_view — без выделений). nullopt, если OPTIONAL-поле отсутствует.
+        template <auto Member, typename V>
+        static Result<std::optional<V>> decode_field(core::BitReader& reader, DecodeContext ctx = {}) {
+            constexpr size_t I = field_index<Member>;
+            static_assert(I < field_count, "Member is not described in the schema");
+
+            auto preamble = read_preamble(reader);
+            if (!preamble) return std::unexpected(preamble.error());
+            if (auto res = skip_fields(reader, *preamble, std::make_index_sequence<I>{}); !res) {
+                return std::unexpected(res.error());
+            }
+            if (!is_present<I>(*preamble)) return std::optional<V>{};
+
+            auto value = field_at<I>::codec::template decode_value<V>(reader, ctx);
+            if (!value) return std::unexpected(value.error());
+            return std::optional<V>(std::move(*value));
+        }
+    };
+
+    // Максимальный размер вложенной кодировки open type при кодировании
+    inline constexpr size_t OpenTypeScratchSize = 2048;
+
+    // CHOICE { Root..., ...[, Additions...] } поверх std::variant с тем же порядком вариантов.
+    // Первые RootCount вариантов — корень, остальные — дополнения (передаются как open type).
+    template <bool Ext, size_t RootCount, typename... Alternatives>
+    struct BasicChoice {
+        static_assert(RootCount <= sizeof...(Alternatives), "Root exceeds alternative list");
+        static_assert(Ext || RootCount == sizeof...(Alternatives), "Additions require an extensible CHOICE");
+
+        static constexpr size_t root_count = RootCount;
+        static constexpr size_t alternative_count = sizeof...(Alternatives);
+        static constexpr size_t index_bits = detail::index_bits(root_count);
+        static constexpr size_t header_bits = (Ext ? 1 : 0) + index_bits;
+
+        // Маркер и индекс пишутся одним полем, пока индекс не выравнивается
+        static_assert(root_count <= 255, "Index of more than 255 alternatives would be octet-aligned");
+
+    private:
+        template <size_t I>
+        using alternative_at = std::tuple_element_t<I, std::tuple<Alternatives...>>;
+
+        template <typename V, size_t I>
+        static Result<V> decode_alternative_at(core::BitReader& reader, DecodeContext ctx) {
+            using A = std::variant_alternative_t<I, V>;
+            if constexpr (I < root_count) {
+                auto value = alternative_at<I>::template decode_value<A>(reader, ctx);
+                if (!value) return std::unexpected(value.error());
+                return V(std::in_place_index<I>, std::move(*value));
+            }
+            else {
+                // Дополнение: тело завернуто в open type и читается отдельным reader'ом
+                auto contents = PerDecoder::decode_open_type(reader);
+                if (!contents) return std::unexpected(contents.error());
+
+                core::BitReader inner(*contents);
+                auto value = alternative_at<I>::template decode_value<A>(inner, ctx);
+                if (!value) return std::unexpected(value.error());
+                return V(std::in_place_index<I>, std::move(*value));
+            }
+        }
+
+        // Таблица переходов по индексу варианта: стоимость выбора не зависит от числа вариантов
+        template <typename V, size_t... I>
+        static constexpr auto make_decode_table(std::index_sequence<I...>) {
+            using Fn = Result<V>(*)(core::BitReader&, DecodeContext);
+            return std::array<Fn, alternative_count>{ &decode_alternative_at<V, I>... };
+        }
+
+        // Тот же вариант перезаписывается на месте, другой строится заново и заменяет прежний
+        template <typename V, size_t I>
+        static Result<void> decode_body_into(V& out, core::BitReader& reader, DecodeContext ctx) {
+            if (auto* held = std::get_if<I>(&out)) return detail::decode_into<alternative_at<I>>(*held, reader, ctx);
+
+            auto value = alternative_at<I>::template decode_value<std::variant_alternative_t<I, V>>(reader, ctx);
+            if (!value) return std::unexpected(value.error());
+            out.template emplace<I>(std::move(*value));
+            return {};
+        }
+
+        template <typename V, size_t I>
+        static Result<void> decode_alternative_into_at(V& out, core::BitReader& reader, DecodeContext ctx) {
+            if constexpr (I < root_count) {
+                return decode_body_into<V, I>(out, reader, ctx);
+            }
+            else {
+                auto contents = PerDecoder::decode_open_type(reader);
+                if (!contents) return std::unexpected(contents.error());
+
+                core::BitReader inner(*contents);
+                return decode_body_into<V, I>(out, inner, ctx);
+            }
+        }
+
+        template <typename V, size_t... I>
+        static constexpr auto make_decode_into_table(std::index_sequence<I...>) {
+            using Fn = Result<void>(*)(V&, core::BitReader&, DecodeContext);
+            return std::array<Fn, alternative_count>{ &decode_alternative_into_at<V, I>... };
+        }
+
+        template <size_t I>
+        static Result<void> skip_alternative_at(core::BitReader& reader) {
+            if constexpr (I < root_count) {
+                return alternative_at<I>::skip_value(reader);
+            }
+            else {
+                auto contents = PerDecoder::decode_open_type(reader);
+                if (!contents) return std::unexpected(contents.error());
+                return {};
+            }
+        }
+
+        template <size_t... I>
+        static constexpr auto make_skip_table(std::index_sequence<I...>) {
+            using Fn = Result<void>(*)(core::BitReader&);
+            return std::array<Fn, alternative_count>{ &skip_alternative_at<I>... };
+        }
+
+        template <size_t I, core::BitSink W, typename A>
+        static Result<void> encode_alternative_at(W& writer, const A& value) {
+            if constexpr (I < root_count) {
+                // Маркер расширения (0) и индекс — одним обращением
+                if (auto res = writer.write_bits(I, header_bits); !res) return res;
+                return alternative_at<I>::encode_value(writer, value);
+            }
+            else if constexpr (std::same_as<W, core::BitCounter>) {
+                // Подсчет размера: вложенная кодировка тоже только считается
+                core::BitCounter inner;
+                if (auto res = alternative_at<I>::encode_value(inner, value); !res) return res;
+                size_t octets = std::max<size_t>(1, inner.byte_size());
+                if (octets > OpenTypeScratchSize) {
+                    return std::unexpected(Error{ ErrorCode::BufferOverflow, "Open type exceeds scratch buffer" });
+                }
+
+                if (auto res = PerEncoder::encode_choice_index(writer, static_cast<uint32_t>(I), static_cast<uint32_t>(root_count), true); !res) return res;
+                writer.add_bits(PerEncoder::octet_string_bits(octets, writer.bit_offset()));
+                return {};
+            }
+            else {
+                std::array<std::byte, OpenTypeScratchSize> scratch;
+                core::FixedBitWriter inner(scratch);
+                if (auto res = alternative_at<I>::encode_value(inner, value); !res) return res;
+                // Пустая вложенная кодировка передается одним нулевым октетом
+                if (inner.data().empty()) (void)inner.write_bits(0, 8);
+
+                if (auto res = PerEncoder::encode_choice_index(writer, static_cast<uint32_t>(I), static_cast<uint32_t>(root_count), true); !res) return res;
+                return PerEncoder::encode_open_type(writer, inner.data());
+            }
+        }
+
+        template <size_t I, core::BitSink W, typename V>
+        static Result<void> encode_entry(W& writer, const V& value) {
+            return encode_alternative_at<I>(writer, *std::get_if<I>(&value));
+        }
+
+        // Индекс CHOICE — это индекс варианта std::variant, выбор кодировщика тоже по таблице
+        template <core::BitSink W, typename V, size_t... I>
+        static constexpr auto make_encode_table(std::index_sequence<I...>) {
+            using Fn = Result<void>(*)(W&, const V&);
+            return std::array<Fn, alternative_count>{ &encode_entry<I, W, V>... };
+        }
+
+    public:
+        // Индекс варианта (сквозной) после маркера и корневого индекса / номера дополнения
+        static Result<size_t> decode_index(core::BitReader& reader) {
+            if (reader.bits_left() < header_bits) {
+                return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+            }
+            if constexpr (header_bits == 0) {
+                return 0;
+            }
+            else {
+                // Маркер и корневой индекс — одним чтением после единственной проверки границ;
+                // при выставленном маркере индекс не передается, и курсор сдвигается только на бит маркера
+                uint64_t header = reader.peek_bits_unchecked(header_bits);
+                if (Ext && (header >> index_bits) != 0) {
+                    reader.skip_bits_unchecked(1);
+                    auto addition = PerDecoder::decode_normally_small_number(reader);
+                    if (!addition) return std::unexpected(addition.error());
+                    return root_count + static_cast<size_t>(*addition);
+                }
+                reader.skip_bits_unchecked(header_bits);
+
+                uint64_t index = index_bits == 0 ? 0 : (header & ((1ULL << index_bits) - 1));
+                if (index >= root_count) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "CHOICE index is out of range" });
+                }
+                return static_cast<size_t>(index);
+            }
+        }
+
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& value) {
+            static_assert(std::variant_size_v<V> == alternative_count, "CHOICE must list every variant alternative");
+            static constexpr auto table = make_encode_table<W, V>(std::index_sequence_for<Alternatives...>{});
+
+            if (value.valueless_by_exception()) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "CHOICE holds no value" });
+            }
+            return table[value.index()](writer, value);
+        }
+
+        // Декодирует тело по уже прочитанному индексу (сквозному: дополнения идут после корня)
+        template <typename V>
+        static Result<V> decode_alternative(size_t index, core::BitReader& reader, DecodeContext ctx) {
+            static constexpr auto table = make_decode_table<V>(std::index_sequence_for<Alternatives...>{});
+
+            if (index >= alternative_count) {
+                // Неизвестное дополнение: пропускаем open type, но представить его не можем
+                if (auto skipped = PerDecoder::decode_open_type(reader); !skipped) return std::unexpected(skipped.error());
+                return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Unknown CHOICE extension addition" });
+            }
+            return table[index](reader, ctx);
+        }
+
+        // То же в существующий std::variant (см. decode_body_into)
+        template <typename V>
+        static Result<void> decode_alternative_into(size_t index, V& out, core::BitReader& reader, DecodeContext ctx) {
+            static constexpr auto table = make_decode_into_table<V>(std::index_sequence_for<Alternatives...>{});
+
+            if (index >= alternative_count) {
+                if (auto skipped = PerDecoder::decode_open_type(reader); !skipped) return std::unexpected(skipped.error());
+                return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Unknown CHOICE extension addition" });
+            }
+            return table[index](out, reader, ctx);
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            auto index = decode_index(reader);
+            if (!index) return std::unexpected(index.error());
+            return decode_alternative<V>(*index, reader, ctx);
+        }
+
+        template <typename V>
+        static Result<void> decode_into(V& out, core::BitReader& reader, DecodeContext ctx) {
+            auto index = decode_index(reader);
+            if (!index) return std::unexpected(index.error());
+            return decode_alternative_into(*index, out, reader, ctx);
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            static constexpr auto table = make_skip_table(std::index_sequence_for<Alternatives...>{});
+
+            auto index = decode_index(reader);
+            if (!index) return std::unexpected(index.error());
+            if (*index >= alternative_count) {
+                // Неизвестное дополнение пропускается целиком
+                auto skipped = PerDecoder::decode_open_type(reader);
+                if (!skipped) return std::unexpected(skipped.error());
+                return {};
+            }
+            return table[*index](reader);
+        }
+    };
+
+    template <bool Ext, typename... Alternatives>
+    using Choice = BasicChoice<Ext, sizeof...(Alternatives), Alternatives...>;
+
+    template <size_t RootCount, typename... Alternatives>
+    using ExtendedChoice = BasicChoice<Extensible, RootCount, Alternatives...>;
+
+    // SEQUENCE OF Codec с SIZE(Lo..Hi) поверх std::pmr::vector
+    template <typename Codec, size_t Lo = 0, size_t Hi = Unbounded>
+    struct SequenceOf {
+        using size_type = Size<Lo, Hi>;
+
+        // Резерв под длину с провода: ей нельзя верить, пока элементы не прочитаны.
+        // Непустой элемент занимает хотя бы бит, поэтому больше bits_left() элементов
+        // во входе нет (элементам нулевой длины резерва просто не хватит).
+        static size_t reserve_bound(size_t length, const core::BitReader& reader) {
+            return std::min(length, reader.bits_left());
+        }
+
+        template <core::BitSink W, typename V>
+        static constexpr Result<void> encode_value(W& writer, const V& values) {
+            if (auto res = size_type::encode_length(writer, values.size()); !res) return res;
+            for (const auto& value : values) {
+                if (auto res = Codec::encode_value(writer, value); !res) return res;
+            }
+            return {};
+        }
+
+        template <typename V>
+        static Result<V> decode_value(core::BitReader& reader, DecodeContext ctx) {
+            auto length = size_type::decode_length(reader);
+            if (!length) return std::unexpected(length.error());
+
+            V values(ctx.mr);
+            values.reserve(reserve_bound(*length, reader));
+            for (size_t i = 0; i < *length; ++i) {
+                auto value = Codec::template decode_value<typename V::value_type>(reader, ctx);
+                if (!value) return std::unexpected(value.error());
+                values.push_back(std::move(*value));
+            }
+            return values;
+        }
+
+        // Имеющиеся элементы перезаписываются на месте, лишние удаляются, недостающие достраиваются
+        template <typename V>
+        static Result<void> decode_into(V& values, core::BitReader& reader, DecodeContext ctx) {
+            auto length = size_type::decode_length(reader);
+            if (!length) return std::unexpected(length.error());
+
+            if (values.size() > *length) values.erase(values.begin() + static_cast<std::ptrdiff_t>(*length), values.end());
+            // Емкость остается у сообщения пула на все следующие датаграммы потока
+            values.reserve(reserve_bound(*length, reader));
+            for (auto& value : values) {
+                if (auto res = detail::decode_into<Codec>(value, reader, ctx); !res) return res;
+            }
+            while (values.size() < *length) {
+                auto value = Codec::template decode_value<typename V::value_type>(reader, ctx);
+                if (!value) return std::unexpected(value.error());
+                values.push_back(std::move(*value));
+            }
+            return {};
+        }
+
+        static Result<void> skip_value(core::BitReader& reader) {
+            auto length = size_type::decode_length(reader);
+            if (!length) return std::unexpected(length.error());
+            for (size_t i = 0; i < *length; ++i) {
+                if (auto res = Codec::skip_value(reader); !res) return res;
+            }
+            return {};
+        }
+    };
+
+    // Точный размер кодировки значения в битах: кодировщик прогоняется через
+    // core::BitCounter, поэтому результат совпадает с настоящей записью бит в бит.
+    // start_bit — позиция, с которой значение будет записано (влияет на выравнивание).
+    template <typename Codec, typename V>
+    constexpr Result<size_t> encoded_bits(const V& value, size_t start_bit = 0) {
+        core::BitCounter counter(start_bit);
+        if (auto res = Codec::encode_value(counter, value); !res) return std::unexpected(res.error());
+        return counter.bit_size();
+    }
+
+    // Кодировка, вычисленная при компиляции. Encode — constexpr-вызываемый объект
+    // (auto& writer) -> Result<void>; размер берется из прохода через BitCounter,
+    // результат — std::array<std::byte, N> ровно по размеру кодировки.
+    template <auto Encode>
+    consteval auto encode_static() {
+        constexpr Result<size_t> bits = []() -> Result<size_t> {
+            core::BitCounter counter;
+            if (auto res = Encode(counter); !res) return std::unexpected(res.error());
+            return counter.bit_size();
+        }();
+        static_assert(bits.has_value(), "Constant message violates its ASN.1 constraints");
+
+        core::StaticBitWriter<(*bits + 7) / 8> writer;
+        (void)Encode(writer);
+        return writer.bytes();
+    }
+
+} // namespace h323_26::asn1
+
+// Статические decode/encode сообщения, делегирующие его Schema
+#define H323_26_SCHEMA_CODEC(Type)                                                   \
+    static ::h323_26::Result<Type> decode(                                           \
+        ::h323_26::core::BitReader& reader,                                          \
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource())            \
+    {                                                                                \
+        return Schema::decode(reader, mr);                                           \
+    }                                                                                \
+                                                                                     \
+    /* Декодирует в существующий объект, сохраняя емкость его строк и векторов */    \
+    static ::h323_26::Result<void> decode_into(                                      \
+        Type& out,                                                                   \
+        ::h323_26::core::BitReader& reader,                                          \
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource())            \
+    {                                                                                \
+        return Schema::decode_into(out, reader, mr);                                 \
+    }                                                                                \
+                                                                                     \
+    template <::h323_26::core::BitSink W>                                            \
+    ::h323_26::Result<void> encode(W& writer) const {                                \
+        return Schema::encode(writer, *this);                                        \
+    }                                                                                \
+                                                                                     \
+    /* Размер кодировки в октетах, если писать с начала буфера */                    \
+    ::h323_26::Result<size_t> encoded_size() const {                                \
+        auto bits = ::h323_26::asn1::encoded_bits<Schema>(*this);                    \
+        if (!bits) return std::unexpected(bits.error());                             \
+        return (*bits + 7) / 8;                                                      \
+    }
@@ -0,0 +1,49 @@
+﻿#pragma once
+#include <h323_26/core/error.hpp>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace h323_26::core {
+
+    // Приемник, который ничего не пишет, а только считает биты.
+    // Тот же кодировщик, прогнанный через BitCounter, дает точный размер кодировки:
+    // по нему растущий буфер резервируется один раз, а слот датаграммы проверяется заранее.
+    class BitCounter {
+    public:
+        // start_bit — позиция, с которой начнется настоящая запись
+        // (выравнивание зависит от нее, поэтому размер считается от той же точки)
+        constexpr explicit BitCounter(size_t start_bit = 0) : start_(start_bit), bit_offset_(start_bit) {}
+
+        constexpr Result<void> write_bits(uint64_t, size_t count) {
+            if (count > 64) return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Max 64 bits" });
+            bit_offset_ += count;
+            return {};
+        }
+
+        constexpr Result<void> write_bytes(std::span<const std::byte> bytes) {
+            bit_offset_ += bytes.size() * 8;
+            return {};
+        }
+
+        constexpr void align_to_byte() { bit_offset_ = (bit_offset_ + 7) / 8 * 8; }
+
+        // Учитывает count бит, содержимое которых не важно (например, готовый open type)
+        constexpr void add_bits(size_t count) { bit_offset_ += count; }
+
+        constexpr void clear() { bit_offset_ = start_; }
+
+        // Бит, записанных с начальной позиции
+        [[nodiscard]] constexpr size_t bit_size() const { return bit_offset_ - start_; }
+
+        // Октетов, которые займет поток с нулевой позиции до конца записи
+        [[nodiscard]] constexpr size_t byte_size() const { return (bit_offset_ + 7) / 8; }
+
+        [[nodiscard]] constexpr size_t bit_offset() const { return bit_offset_; }
+
+    private:
+        size_t start_;
+        size_t bit_offset_;
+    };
+
+} // namespace h323_26::core
@@ -2,7 +2,9 @@
 
 #include <h323_26/core/error.hpp>
 
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <span>
 #include <cstddef>
 
@@ -21,14 +23,77 @@ namespace h323_26::core {
         // Skips N bits
         Result<void> skip_bits(size_t count);
 
+        // Copies out.size() octets into out. Byte-aligned runs are a single memcpy,
+        // unaligned runs go through the vectorised shifted-copy kernel (octet_kernels.hpp).
+        Result<void> read_bytes(std::span<std::byte> out);
+
+        // Returns a view of the next `count` octets without copying them.
+        // The cursor must be byte-aligned; the view borrows the reader's buffer.
+        Result<std::span<const std::byte>> view_bytes(size_t count);
+
         // Aligns the cursor to the next byte boundary (crucial for some H.323 fields)
-        void align_to_byte();
+        void align_to_byte() {
+            bit_offset_ = (bit_offset_ + 7) & ~size_t{ 7 };
+        }
 
         [[nodiscard]] size_t bits_left() const {
             return (data_.size() * 8) - bit_offset_;
         }
 
+        [[nodiscard]] size_t bit_offset() const { return bit_offset_; }
+
+        // Unchecked accessors for a region already validated against bits_left() once
+        // (see asn1::Sequence): no range checks, no std::expected, fully inline.
+        // The caller guarantees 1 <= count <= 64 and count <= bits_left().
+        [[nodiscard]] uint64_t peek_bits_unchecked(size_t count) const {
+            return peek_unchecked(count);
+        }
+
+        uint64_t read_bits_unchecked(size_t count) {
+            uint64_t value = peek_unchecked(count);
+            bit_offset_ += count;
+            return value;
+        }
+
+        // The caller guarantees count <= bits_left()
+        void skip_bits_unchecked(size_t count) { bit_offset_ += count; }
+
     private:
+        // Big-endian 64-bit window starting at byte_idx, zero-padded past the end
+        uint64_t load_window(size_t byte_idx) const {
+            uint64_t word = 0;
+            if (byte_idx + 8 <= data_.size()) {
+                // Fast path: a whole 64-bit word inside the buffer
+                std::memcpy(&word, data_.data() + byte_idx, sizeof(word));
+                if constexpr (std::endian::native == std::endian::little) {
+                    word = std::byteswap(word);
+                }
+                return word;
+            }
+
+            // Buffer tail: gather the remaining (< 8) bytes, the rest stays zero
+            for (size_t i = 0; byte_idx + i < data_.size(); ++i) {
+                word |= static_cast<uint64_t>(data_[byte_idx + i]) << (56 - 8 * i);
+            }
+            return word;
+        }
+
+        // Top `count` bits at the cursor (1..64). Caller guarantees count <= bits_left()
+        uint64_t peek_unchecked(size_t count) const {
+            size_t byte_idx = bit_offset_ / 8;
+            size_t shift = bit_offset_ % 8;
+
+            // MSB-aligned window: the first unread bit becomes bit 63
+            uint64_t window = load_window(byte_idx) << shift;
+
+            // 64 bits at a non-zero shift do not fit one window and need a ninth byte
+            if (shift + count > 64) {
+                window |= static_cast<uint64_t>(data_[byte_idx + 8]) >> (8 - shift);
+            }
+
+            return window >> (64 - count);
+        }
+
         std::span<const std::byte> data_;
         size_t bit_offset_ = 0; // Global bit offset from the start
     };
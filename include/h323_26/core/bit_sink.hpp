@@ -0,0 +1,20 @@
+﻿#pragma once
+#include <h323_26/core/error.hpp>
+#include <concepts>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace h323_26::core {
+
+    // Приемник битового потока для PER-кодировщика.
+    // Реализации: BitWriter (растущий вектор), FixedBitWriter (буфер вызывающей стороны),
+    // BitCounter (только подсчет размера) и StaticBitWriter (кодирование при компиляции).
+    template <typename W>
+    concept BitSink = requires(W& writer, uint64_t value, size_t count, std::span<const std::byte> bytes) {
+        { writer.write_bits(value, count) } -> std::same_as<Result<void>>;
+        { writer.write_bytes(bytes) } -> std::same_as<Result<void>>;
+        { writer.align_to_byte() } -> std::same_as<void>;
+    };
+
+} // namespace h323_26::core
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <h323_26/core/error.hpp>
 #include <vector>
+#include <span>
 #include <cstdint>
 #include <cstddef>
 
@@ -13,15 +14,34 @@ namespace h323_26::core {
         // Пишет n бит (до 64)
         Result<void> write_bits(uint64_t value, size_t count);
 
+        // Пишет последовательность октетов. На границе байта — один memcpy,
+        // иначе по 8 байт за раз через write_bits
+        Result<void> write_bytes(std::span<const std::byte> bytes);
+
         // Выравнивает по границе байта (дописывает нули)
         void align_to_byte();
 
+        // Резервирует место под n байт, чтобы кодирование сообщения не вызывало реаллокаций
+        void reserve(size_t bytes) { buffer_.reserve(bytes); }
+
+        // Сбрасывает содержимое, сохраняя выделенную память для следующего сообщения
+        void clear() {
+            buffer_.clear();
+            bit_offset_ = 0;
+        }
+
+        // Позиция записи в битах от начала буфера
+        [[nodiscard]] size_t bit_offset() const { return bit_offset_; }
+
         // Возвращает готовый буфер байтов
         const std::vector<std::byte>& data() const { return buffer_; }
 
     private:
+        // Запись, которая вместе с занятыми битами последнего байта помещается в 64 бита
+        void put_bits(uint64_t value, size_t count);
+
         std::vector<std::byte> buffer_;
-        size_t bit_offset_ = 0; // Текущий бит в последнем байте или общий счетчик
+        size_t bit_offset_ = 0; // Общий счетчик записанных бит
     };
 
 } // namespace h323_26::core
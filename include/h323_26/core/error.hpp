@@ -11,7 +11,8 @@ namespace h323_26 {
         InvalidConstraint, // Value exceeds ASN.1 range
         AlignmentError,    // Failed to align to byte boundary
         BufferOverflow,
-        UnsupportedFeature
+        UnsupportedFeature,
+        IoError            // Socket or system call failed (transport)
     };
 
     struct Error {
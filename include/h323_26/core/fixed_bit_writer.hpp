@@ -0,0 +1,45 @@
+﻿#pragma once
+#include <h323_26/core/error.hpp>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace h323_26::core {
+
+    // Писатель поверх чужого буфера (например, слот пула датаграмм для sendmmsg).
+    // Никогда не выделяет память: при нехватке места возвращает ErrorCode::BufferOverflow,
+    // а уже записанные данные остаются нетронутыми.
+    class FixedBitWriter {
+    public:
+        explicit FixedBitWriter(std::span<std::byte> buffer) : buffer_(buffer) {}
+
+        // Пишет n бит (до 64)
+        Result<void> write_bits(uint64_t value, size_t count);
+
+        // Пишет последовательность октетов (memcpy на границе байта)
+        Result<void> write_bytes(std::span<const std::byte> bytes);
+
+        // Выравнивает по границе байта (хвостовой байт уже дополнен нулями)
+        void align_to_byte() { bit_offset_ = byte_size() * 8; }
+
+        // Начинает новое сообщение с начала того же буфера
+        void clear() { bit_offset_ = 0; }
+
+        // Записанные байты (последний может быть заполнен частично)
+        std::span<const std::byte> data() const { return buffer_.first(byte_size()); }
+
+        [[nodiscard]] size_t capacity() const { return buffer_.size(); }
+
+        [[nodiscard]] size_t bit_offset() const { return bit_offset_; }
+
+    private:
+        [[nodiscard]] size_t byte_size() const { return (bit_offset_ + 7) / 8; }
+
+        // Запись, которая вместе с занятыми битами последнего байта помещается в 64 бита
+        void put_bits(uint64_t value, size_t count);
+
+        std::span<std::byte> buffer_;
+        size_t bit_offset_ = 0;
+    };
+
+} // namespace h323_26::core
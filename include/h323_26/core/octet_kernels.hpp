@@ -0,0 +1,77 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace h323_26::core {
+
+    // Реализация ядер: выбирается один раз по возможностям процессора
+    enum class KernelSet : uint8_t { scalar, sse2, avx2 };
+
+    // Результат utf16be_to_utf8 для строки с суррогатом (вне BMPString)
+    inline constexpr size_t Utf16Invalid = std::numeric_limits<size_t>::max();
+
+    // Символ алфавита PrintableString: A-Z a-z 0-9 пробел ' ( ) + , - . / : = ?
+    constexpr bool is_printable_char(char c) {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')
+            || (c >= '\'' && c <= ')') || (c >= '+' && c <= '/')
+            || c == ' ' || c == ':' || c == '=' || c == '?';
+    }
+
+    // Символ UTF-8 из BMP (1..3 октета), начиная с text[pos]; pos сдвигается за него.
+    // InvalidBmpChar — неверная последовательность, суррогат или символ вне BMP
+    inline constexpr uint32_t InvalidBmpChar = 0xFFFFFFFF;
+
+    constexpr uint32_t next_bmp_char(std::string_view text, size_t& pos) {
+        auto octet = [&](size_t i) { return static_cast<uint32_t>(static_cast<unsigned char>(text[i])); };
+        auto continuation = [&](size_t i) { return i < text.size() && (octet(i) & 0xC0) == 0x80; };
+
+        uint32_t lead = octet(pos);
+        if (lead < 0x80) {
+            pos += 1;
+            return lead;
+        }
+        if (lead >= 0xC2 && lead < 0xE0 && continuation(pos + 1)) {
+            uint32_t c = ((lead & 0x1F) << 6) | (octet(pos + 1) & 0x3F);
+            pos += 2;
+            return c;
+        }
+        if (lead >= 0xE0 && lead < 0xF0 && continuation(pos + 1) && continuation(pos + 2)) {
+            uint32_t c = ((lead & 0x0F) << 12) | ((octet(pos + 1) & 0x3F) << 6) | (octet(pos + 2) & 0x3F);
+            // Избыточная форма и суррогаты не допускаются
+            if (c < 0x800 || (c >= 0xD800 && c <= 0xDFFF)) return InvalidBmpChar;
+            pos += 3;
+            return c;
+        }
+        return InvalidBmpChar;
+    }
+
+    // Массовые операции над октетами строк: копирование со сдвигом, проверка алфавита,
+    // перекодирование BMPString. На x86-64 — SSE2 (есть всегда) или AVX2, если процессор
+    // его поддерживает; на остальных платформах — скалярные реализации.
+    struct OctetKernels {
+        KernelSet set;
+
+        // count октетов, начинающихся со сдвигом shift (1..7) бит от src:
+        // dst[i] = src[i] << shift | src[i + 1] >> (8 - shift). Из src читается count + 1 октет.
+        void (*copy_shifted)(std::byte* dst, const std::byte* src, size_t count, unsigned shift);
+
+        // Все октеты — символы IA5String (0..127)
+        bool (*is_ia5)(const char* data, size_t count);
+
+        // Все октеты — символы PrintableString
+        bool (*is_printable)(const char* data, size_t count);
+
+        // units символов UTF-16BE (по 2 октета) в UTF-8; в out должно быть 3 * units октетов.
+        // Возвращает число записанных октетов или Utf16Invalid
+        size_t (*utf16be_to_utf8)(const std::byte* src, size_t units, char* out);
+    };
+
+    // Лучшая реализация для этого процессора (определяется при первом вызове)
+    const OctetKernels& octet_kernels();
+
+    // Конкретная реализация — для тестов и замеров; nullptr, если процессор ее не поддерживает
+    const OctetKernels* octet_kernels(KernelSet set);
+
+} // namespace h323_26::core
@@ -0,0 +1,67 @@
+﻿#pragma once
+#include <h323_26/core/error.hpp>
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace h323_26::core {
+
+    // Источник октетов для потокового кодирования: отдает содержимое кусками,
+    // не требуя держать его целиком в одном непрерывном буфере.
+    //   remaining() — сколько октетов осталось (нужно для выбора размера фрагмента);
+    //   next(max)   — следующий непустой кусок не длиннее max, живущий до следующего вызова.
+    template <typename S>
+    concept OctetSource = requires(S& source, size_t max) {
+        { source.remaining() } -> std::convertible_to<size_t>;
+        { source.next(max) } -> std::same_as<std::span<const std::byte>>;
+    };
+
+    // Приемник октетов для потокового декодирования: получает куски по мере разбора
+    // (куски ссылаются на датаграмму и живут только во время вызова)
+    template <typename S>
+    concept OctetSink = requires(S& sink, std::span<const std::byte> chunk) {
+        { sink.write(chunk) } -> std::same_as<Result<void>>;
+    };
+
+    // Источник поверх непрерывного буфера
+    class SpanOctetSource {
+    public:
+        constexpr explicit SpanOctetSource(std::span<const std::byte> data) : data_(data) {}
+
+        [[nodiscard]] constexpr size_t remaining() const { return data_.size(); }
+
+        constexpr std::span<const std::byte> next(size_t max) {
+            auto chunk = data_.first(std::min(max, data_.size()));
+            data_ = data_.subspan(chunk.size());
+            return chunk;
+        }
+
+    private:
+        std::span<const std::byte> data_;
+    };
+
+    // Приемник, дописывающий куски в конец контейнера (std::vector, std::pmr::string...)
+    template <typename Container>
+    class AppendOctetSink {
+    public:
+        explicit AppendOctetSink(Container& out) : out_(out) {}
+
+        Result<void> write(std::span<const std::byte> chunk) {
+            using value_type = typename Container::value_type;
+            auto first = reinterpret_cast<const value_type*>(chunk.data());
+            out_.insert(out_.end(), first, first + chunk.size());
+            return {};
+        }
+
+    private:
+        Container& out_;
+    };
+
+    // Приемник, который только считает длину (пропуск содержимого)
+    struct DiscardOctetSink {
+        Result<void> write(std::span<const std::byte>) { return {}; }
+    };
+
+} // namespace h323_26::core
@@ -0,0 +1,68 @@
+﻿#pragma once
+#include <h323_26/core/error.hpp>
+#include <algorithm>
+#include <array>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace h323_26::core {
+
+    // Писатель с собственным буфером фиксированного размера, пригодный для
+    // константного вычисления: сообщение, закодированное при компиляции,
+    // становится static constexpr std::array<std::byte, N>.
+    // Пишет по байту за раз без memcpy — во время выполнения предпочтительнее FixedBitWriter.
+    template <size_t N>
+    class StaticBitWriter {
+    public:
+        constexpr StaticBitWriter() = default;
+
+        // Пишет n бит (до 64)
+        constexpr Result<void> write_bits(uint64_t value, size_t count) {
+            if (count == 0) return {};
+            if (count > 64) return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Max 64 bits" });
+            if (count > N * 8 - bit_offset_) {
+                return std::unexpected(Error{ ErrorCode::BufferOverflow, "Static buffer is too small" });
+            }
+
+            if (count < 64) value &= (1ULL << count) - 1;
+
+            // Старшие биты значения дописываются в свободную часть текущего байта
+            while (count > 0) {
+                size_t free = 8 - bit_offset_ % 8;
+                size_t take = std::min(free, count);
+                auto chunk = static_cast<uint8_t>((value >> (count - take)) & ((1U << take) - 1));
+                buffer_[bit_offset_ / 8] |= static_cast<std::byte>(chunk << (free - take));
+                bit_offset_ += take;
+                count -= take;
+            }
+            return {};
+        }
+
+        constexpr Result<void> write_bytes(std::span<const std::byte> bytes) {
+            if (bytes.size() > (N * 8 - bit_offset_) / 8) {
+                return std::unexpected(Error{ ErrorCode::BufferOverflow, "Static buffer is too small" });
+            }
+            for (std::byte b : bytes) (void)write_bits(static_cast<uint64_t>(b), 8);
+            return {};
+        }
+
+        // Выравнивает по границе байта (хвост байта уже нулевой)
+        constexpr void align_to_byte() { bit_offset_ = (bit_offset_ + 7) / 8 * 8; }
+
+        [[nodiscard]] constexpr size_t bit_offset() const { return bit_offset_; }
+
+        // Записанные байты (последний может быть заполнен частично)
+        [[nodiscard]] constexpr std::span<const std::byte> data() const {
+            return std::span<const std::byte>(buffer_).first((bit_offset_ + 7) / 8);
+        }
+
+        // Весь буфер: при N, равном размеру кодировки, это и есть готовая датаграмма
+        [[nodiscard]] constexpr const std::array<std::byte, N>& bytes() const { return buffer_; }
+
+    private:
+        std::array<std::byte, N> buffer_{};
+        size_t bit_offset_ = 0;
+    };
+
+} // namespace h323_26::core
@@ -0,0 +1,119 @@
+﻿#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace h323_26::core {
+
+    // Иерархическое колесо таймеров (Varghese & Lauck): 6 уровней по 64 слота,
+    // уровень L отсчитывает шаги по 64^L тиков. Таймер лежит в двусвязном списке
+    // слота, узлы — в одном массиве с индексами вместо указателей, поэтому arm() и
+    // cancel() — O(1) без выделения памяти (пока хватает емкости). При переходе на
+    // новый слот уровня L его таймеры раскладываются по младшим уровням; пустые
+    // участки пропускаются по битовым картам занятости, а не тик за тиком.
+    //
+    // Таймер срабатывает в первом advance() после своего срока, с точностью до тика;
+    // раньше срока — никогда. Колесо не потокобезопасно: одно колесо на поток
+    // (например, на ядро RasServer).
+    class TimingWheel {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Снимок таймера; generation отличает его от следующих владельцев узла
+        struct TimerId {
+            uint32_t index = UINT32_MAX;
+            uint32_t generation = 0;
+
+            bool operator==(const TimerId&) const = default;
+        };
+
+        struct Config {
+            Clock::duration tick = std::chrono::milliseconds(10);
+            size_t capacity = 1024; // Узлы, выделяемые заранее; дальше массив растет
+        };
+
+        explicit TimingWheel(Clock::time_point now) : TimingWheel(Config{}, now) {}
+        TimingWheel(const Config& config, Clock::time_point now);
+
+        // Ставит таймер на deadline; payload возвращается в обработчик advance()
+        TimerId arm(Clock::time_point deadline, uint64_t payload);
+
+        // false — таймер уже сработал или снят
+        bool cancel(TimerId id);
+
+        // Переводит колесо на now и вызывает fn(payload) для каждого наступившего
+        // таймера. Из fn можно ставить и снимать таймеры. Возвращает число сработавших.
+        template <typename Fn>
+        size_t advance(Clock::time_point now, Fn&& fn) {
+            const uint64_t target = tick_of(now);
+            size_t fired = 0;
+            while (current_ < target) {
+                const uint64_t next = next_event();
+                if (next > target) {
+                    current_ = target;
+                    break;
+                }
+                current_ = next;
+                cascade();
+
+                // Узел освобождается до вызова fn: обработчик может сразу занять его снова
+                const size_t slot = current_ % slots;
+                while (heads_[slot] != nil) {
+                    const uint32_t index = heads_[slot];
+                    const uint64_t payload = nodes_[index].payload;
+                    release(index);
+                    ++fired;
+                    fn(payload);
+                }
+            }
+            return fired;
+        }
+
+        [[nodiscard]] size_t size() const { return size_; }
+
+        // Срок ближайшего события колеса (срабатывания или раскладки слота) —
+        // таймаут ожидания для цикла ввода-вывода; time_point::max(), если таймеров нет
+        [[nodiscard]] Clock::time_point next_wakeup() const;
+
+    private:
+        static constexpr size_t levels = 6;
+        static constexpr size_t slot_bits = 6;
+        static constexpr size_t slots = size_t{ 1 } << slot_bits;
+        static constexpr uint32_t nil = UINT32_MAX;
+        static constexpr uint64_t horizon = uint64_t{ 1 } << (levels * slot_bits); // Тиков в старшем блоке
+        static constexpr size_t overflow = levels * slots; // Список сроков за горизонтом
+
+        struct Node {
+            uint64_t deadline = 0; // В тиках
+            uint64_t payload = 0;
+            uint32_t prev = nil;
+            uint32_t next = nil;   // В свободном списке — следующий свободный
+            uint32_t generation = 0;
+            uint16_t slot = 0;     // level * slots + slot или overflow; для снятия за O(1)
+            bool armed = false;
+        };
+
+        uint64_t tick_of(Clock::time_point t) const;
+
+        void place(uint32_t index);
+        void unlink(uint32_t index);
+        void release(uint32_t index);
+        void replace_list(size_t list);
+        void cascade();
+        uint64_t next_event() const;
+
+        Clock::time_point origin_;
+        Clock::duration tick_;
+        uint64_t current_ = 0;
+        size_t size_ = 0;
+
+        std::vector<Node> nodes_;
+        uint32_t free_ = nil;
+        std::array<uint32_t, levels * slots + 1> heads_;
+        std::array<uint64_t, levels> occupied_{}; // Бит слота: список не пуст
+    };
+
+} // namespace h323_26::core
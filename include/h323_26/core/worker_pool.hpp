@@ -0,0 +1,64 @@
+﻿#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace h323_26::core {
+
+    // Фиксированный набор фоновых потоков для разбиения пакета работы на куски.
+    // parallel_for блокирует вызывающий поток до завершения всех кусков, а сам
+    // вызывающий поток тоже берет куски — при threads == 0 работа идет целиком в нем.
+    // Куски раздаются через атомарный счетчик, поэтому вызов не выделяет память.
+    //
+    // parallel_for вызывается из одного потока за раз; fn не должна бросать исключений.
+    class WorkerPool {
+    public:
+        explicit WorkerPool(size_t threads);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Сколько потоков участвует в parallel_for (фоновые + вызывающий)
+        [[nodiscard]] size_t concurrency() const { return threads_.size() + 1; }
+
+        // Вызывает fn(begin, end) для кусков [0, count) длиной не больше grain
+        template <typename F>
+        void parallel_for(size_t count, size_t grain, F&& fn) {
+            using Fn = std::remove_reference_t<F>;
+            auto* ctx = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+            run([](void* f, size_t begin, size_t end) { (*static_cast<Fn*>(f))(begin, end); }, ctx, count, grain);
+        }
+
+    private:
+        using Task = void (*)(void*, size_t, size_t);
+
+        void run(Task task, void* ctx, size_t count, size_t grain);
+        void work();
+        void worker_loop();
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        uint64_t generation_ = 0; // Номер текущего parallel_for
+        size_t busy_ = 0;         // Фоновые потоки, еще не закончившие текущий вызов
+        bool stop_ = false;
+
+        // Текущий вызов: пишется под mutex_ до увеличения generation_
+        Task task_ = nullptr;
+        void* ctx_ = nullptr;
+        size_t count_ = 0;
+        size_t grain_ = 1;
+        std::atomic<size_t> next_{ 0 };
+
+        std::vector<std::thread> threads_;
+    };
+
+} // namespace h323_26::core
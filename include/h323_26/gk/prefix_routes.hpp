@@ -0,0 +1,115 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras_types.hpp>
+#include <h323_26/core/error.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace h323_26::gk {
+
+    // Маршрутизация набранного номера (dialedDigits) по самому длинному префиксу.
+    //
+    // Префиксы лежат в плоском массиве узлов цифрового trie: у узла — маска детей по
+    // 13 символам dialedDigits ("0123456789#*,"), индекс первого ребенка и маршрут.
+    // Дети узла идут подряд, ребенок цифры c — first_child + popcount(маска младше c),
+    // а узлы разложены по уровням (BFS), так что верхние уровни занимают несколько
+    // кэш-линий. Узел — 12 байт; строк в таблице нет.
+    //
+    // Опубликованный trie неизменен. Изменения копятся (insert/erase) и в publish()
+    // сливаются с текущим содержимым в новый trie во втором буфере, который затем
+    // становится активным одной атомарной записью. Поиск не ждет писателя: он только
+    // отмечается в счетчике своего слота, а publish() перед перезаписью буфера ждет,
+    // пока из него уйдут читатели предыдущего поколения.
+    class PrefixRoutes {
+    public:
+        // Маршрут — номер зоны, соседнего привратника или записи RegistrationTable
+        using Route = uint32_t;
+        static constexpr Route no_route = UINT32_MAX;
+
+        struct Entry {
+            std::string_view prefix;
+            Route route;
+        };
+
+        struct Match {
+            Route route;
+            size_t length; // Длина совпавшего префикса
+        };
+
+        PrefixRoutes() = default;
+
+        PrefixRoutes(const PrefixRoutes&) = delete;
+        PrefixRoutes& operator=(const PrefixRoutes&) = delete;
+
+        // Полная замена таблицы (старт, перезагрузка конфигурации) без промежуточных
+        // структур: сортировка и построение за один проход. Повторный префикс — побеждает
+        // последний. Отложенные insert/erase отбрасываются.
+        Result<void> load(std::span<const Entry> entries);
+
+        // Точечные изменения; видны после publish()
+        Result<void> insert(std::string_view prefix, Route route);
+        Result<void> erase(std::string_view prefix);
+        void publish();
+
+        [[nodiscard]] std::optional<Match> lookup(std::string_view digits) const;
+
+        // H323-ID номером не является: nullopt
+        [[nodiscard]] std::optional<Match> lookup(const h225::AliasAddress& alias) const;
+
+        // Число префиксов в опубликованной таблице
+        [[nodiscard]] size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Node {
+            uint16_t children = 0;
+            uint32_t first_child = 0;
+            Route route = no_route;
+        };
+
+        // Префикс в пуле кодов цифр (writer-side)
+        struct Item {
+            uint32_t offset;
+            uint32_t length;
+            Route route;
+        };
+
+        // Порядок изменений совпадает с порядком детей в trie
+        struct CodeLess {
+            bool operator()(const std::string& a, const std::string& b) const;
+        };
+
+        struct alignas(64) ReaderSlot {
+            std::array<std::atomic<int64_t>, 2> active{};
+        };
+
+        static constexpr size_t reader_slots = 64;
+
+        static Result<void> check_prefix(std::string_view prefix, Route route);
+
+        void append_item(std::string_view prefix, Route route);
+        void collect_published();
+        void build(std::vector<Node>& nodes);
+        void swap_in(std::vector<Node>& nodes);
+
+        std::array<std::vector<Node>, 2> buffers_;
+        std::atomic<uint32_t> current_{ 0 };
+        std::atomic<size_t> size_{ 0 };
+        mutable std::array<ReaderSlot, reader_slots> readers_{};
+
+        // Состояние писателя
+        std::mutex writer_;
+        std::map<std::string, Route, CodeLess> pending_; // no_route — удаление
+        std::vector<uint8_t> pool_;
+        std::vector<Item> items_;
+    };
+
+} // namespace h323_26::gk
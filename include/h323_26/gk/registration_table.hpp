@@ -0,0 +1,155 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras_types.hpp>
+#include <h323_26/core/error.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace h323_26::gk {
+
+    using Clock = std::chrono::steady_clock;
+
+    // Ссылка на запись таблицы. generation меняется при каждой (пере)регистрации,
+    // поэтому ссылка на снятую или перерегистрированную конечную точку устаревает
+    struct EndpointRef {
+        uint32_t index = 0;
+        uint32_t generation = 0;
+
+        bool operator==(const EndpointRef&) const = default;
+    };
+
+    // Данные регистрации из RRQ
+    struct EndpointInfo {
+        h225::TransportAddress callSignalAddress;
+        h225::TransportAddress rasAddress;
+        uint32_t timeToLive = 0; // секунды
+    };
+
+    // Снимок записи, прочитанный без блокировок
+    struct Registration {
+        EndpointRef endpoint;
+        h225::TransportAddress callSignalAddress;
+        h225::TransportAddress rasAddress;
+        uint32_t timeToLive = 0;
+        uint32_t bandwidth = 0;  // Занятая полоса (ARQ/DRQ), в 100 бит/с
+        Clock::time_point expires;
+    };
+
+    // Таблица регистраций привратника: endpointIdentifier и псевдонимы -> адреса, TTL, полоса.
+    //
+    // Ключи не хранятся строками: в индексе лежит 128-битный отпечаток ключа
+    // (вид ключа + текст) и ссылка на запись — 24 байта на ключ. Индекс разбит на
+    // шарды с заголовком в отдельной кэш-линии; записи — массив фиксированной емкости,
+    // по кэш-линии на запись.
+    //
+    // Чтение (find_*) не берет блокировок: шарды и записи защищены seqlock, и читатель
+    // лишь повторяет чтение, если попал на запись. Писатели шарда сериализуются его
+    // мьютексом, писатели записи — собственным спин-замком записи, так что RRQ разных
+    // конечных точек почти не пересекаются.
+    //
+    // Перерегистрация увеличивает generation записи: ключи прежнего набора псевдонимов
+    // перестают совпадать и переиспользуются писателями, а новый набор становится виден
+    // разом — в момент записи нового generation.
+    class RegistrationTable {
+    public:
+        struct Config {
+            size_t endpoints = 1 << 18;      // Емкость (число записей)
+            size_t keys_per_endpoint = 3;    // endpointIdentifier + псевдонимы, для размера индекса
+            size_t shards = 256;             // Степень двойки
+        };
+
+        RegistrationTable() : RegistrationTable(Config{}) {}
+        explicit RegistrationTable(const Config& config);
+        ~RegistrationTable();
+
+        RegistrationTable(const RegistrationTable&) = delete;
+        RegistrationTable& operator=(const RegistrationTable&) = delete;
+
+        // RRQ: регистрирует конечную точку или обновляет ее запись и набор псевдонимов.
+        // Псевдоним, занятый другой конечной точкой, — InvalidConstraint (RRJ duplicateAlias),
+        // запись при этом не меняется. Нет места — BufferOverflow.
+        Result<EndpointRef> register_endpoint(
+            std::string_view endpointIdentifier,
+            std::span<const h225::AliasAddress> aliases,
+            const EndpointInfo& info,
+            Clock::time_point now);
+
+        // Легкая RRQ (keepAlive): продлевает регистрацию на timeToLive
+        Result<void> refresh(EndpointRef endpoint, Clock::time_point now);
+
+        // URQ: false, если такой конечной точки нет
+        bool unregister(std::string_view endpointIdentifier);
+
+        // Истечение timeToLive: снимает регистрацию, если ссылка еще действительна и срок
+        // наступил к now. Таймер, поставленный до refresh(), вернет false — его
+        // достаточно переставить на новый Registration::expires (см. core::TimingWheel).
+        bool expire(EndpointRef endpoint, Clock::time_point now);
+
+        // ARQ/DRQ: занимает (delta > 0) или освобождает (delta < 0) полосу конечной точки.
+        // Сумма выше limit — InvalidConstraint, полоса не меняется. Возвращает новую сумму.
+        Result<uint32_t> adjust_bandwidth(EndpointRef endpoint, int64_t delta, uint32_t limit);
+
+        // Поиск без блокировок
+        [[nodiscard]] std::optional<Registration> find_endpoint(std::string_view endpointIdentifier) const;
+        [[nodiscard]] std::optional<Registration> find_alias(const h225::AliasAddress& alias) const;
+        [[nodiscard]] std::optional<Registration> find(EndpointRef endpoint) const;
+
+        [[nodiscard]] size_t size() const { return size_.load(std::memory_order_relaxed); }
+        [[nodiscard]] size_t capacity() const { return capacity_; }
+
+    private:
+        struct Key {
+            uint64_t hash;  // 0 и 1 зарезервированы (пустой слот, удаленный)
+            uint64_t check; // Вторая половина отпечатка
+        };
+
+        struct KeySlot;
+        struct Shard;
+        struct Record;
+        struct RecordState;
+
+        static Key endpoint_key(std::string_view endpointIdentifier);
+        static Key alias_key(const h225::AliasAddress& alias);
+
+        Shard& shard_of(const Key& key) const;
+
+        std::optional<uint32_t> lookup_endpoint(const Key& key) const;
+        std::optional<Registration> lookup_alias(const Key& key) const;
+
+        RecordState read_record(uint32_t index) const;
+        void write_record(uint32_t index, const RecordState& state);
+        void lock_record(uint32_t index);
+        void unlock_record(uint32_t index);
+        bool is_stale(uint64_t meta) const;
+
+        std::optional<uint32_t> allocate_record();
+        void free_record(uint32_t index);
+
+        // Слоты индекса; шард уже захвачен вызывающим
+        Result<void> insert_locked(Shard& shard, const Key& key, uint64_t meta);
+        void erase_locked(Shard& shard, const Key& key, uint64_t meta);
+        bool erase_owner_locked(Shard& shard, uint64_t owner, uint32_t index);
+        void rebuild_locked(Shard& shard);
+
+        Result<void> insert_key(const Key& key, uint64_t meta);
+        void erase_key(const Key& key, uint64_t meta);
+
+        size_t capacity_;
+        size_t shard_mask_;
+        std::unique_ptr<Shard[]> shards_;
+        std::unique_ptr<Record[]> records_;
+
+        std::mutex free_lock_;
+        std::vector<uint32_t> free_;
+        std::atomic<size_t> size_{ 0 };
+    };
+
+} // namespace h323_26::gk
@@ -1,89 +1,492 @@
 ﻿#pragma once
 
+#include <h323_26/h225/ras_types.hpp>
+#include <h323_26/asn1/schema.hpp>
 #include <h323_26/asn1/per_decoder.hpp>
 #include <h323_26/asn1/per_encoder.hpp>
 #include <h323_26/core/bit_writer.hpp>
+#include <memory_resource>
 #include <optional>
 #include <string>
+#include <string_view>
 
 namespace h323_26::h225 {
 
+    namespace detail {
+
+        // Одна схема GRQ на владеющее и view-представление: раскладка совпадает по построению
+        template <typename Msg>
+        using GatekeeperRequestSchema = asn1::Sequence<Msg, asn1::Extensible,
+            asn1::Field<&Msg::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&Msg::protocolIdentifier, ProtocolIdentifier>,
+            asn1::Field<&Msg::gatekeeperIdentifier, asn1::Optional<GatekeeperIdentifier>>,
+            asn1::Field<&Msg::endpointAlias, asn1::Optional<asn1::IA5String<>>>>;
+
+    } // namespace detail
+
+    // Владеющие сообщения хранят строки и векторы в std::pmr-контейнерах:
+    // при декодировании через monotonic_buffer_resource все дерево одной датаграммы
+    // живет в арене и освобождается разом вместе с ней. protocolIdentifier —
+    // InternedOid: стандартные версии H.225.0 не требуют памяти вовсе.
     struct GatekeeperRequest {
-        uint16_t requestSeqNum;
-        std::vector<uint32_t> protocolIdentifier;
-        std::optional<std::string> endpointAlias;
-
-        static Result<GatekeeperRequest> decode(core::BitReader& reader) {
-            struct DecodeState {
-                uint16_t seq;
-                uint64_t preamble;
-                std::vector<uint32_t> oid;
-            };
+        uint16_t requestSeqNum = 0;
+        asn1::InternedOid protocolIdentifier{};
+        std::optional<std::pmr::string> gatekeeperIdentifier{};
+        std::optional<std::pmr::string> endpointAlias{};
 
-            return asn1::PerDecoder::decode_extension_marker(reader)
-                .and_then([&](bool) {
-                return asn1::PerDecoder::decode_sequence_preamble(reader, 1);
-                    })
-                .and_then([&](uint64_t preamble) {
-                return asn1::PerDecoder::decode_constrained_integer(reader, 1, 65535)
-                    .transform([preamble](uint64_t seq) {
-                    return std::pair{ static_cast<uint16_t>(seq), preamble };
-                        });
-                    })
-                .and_then([&](auto pair) {
-                return asn1::PerDecoder::decode_oid(reader)
-                    .transform([&pair](std::vector<uint32_t> oid) {
-                    return DecodeState{ pair.first, pair.second, std::move(oid) };
-                        });
-                    })
-                .and_then([&](DecodeState state) -> Result<GatekeeperRequest> {
-                std::optional<std::string> alias;
-                if (state.preamble == 1) {
-                    auto str_res = asn1::PerDecoder::decode_ia5_string(reader);
-                    if (!str_res) return std::unexpected(str_res.error());
-                    alias = std::move(*str_res);
-                }
-
-                return GatekeeperRequest{
-                    .requestSeqNum = state.seq,
-                    .protocolIdentifier = std::move(state.oid),
-                    .endpointAlias = std::move(alias)
-                };
-                    });
-        }
+        using Schema = detail::GatekeeperRequestSchema<GatekeeperRequest>;
+        H323_26_SCHEMA_CODEC(GatekeeperRequest)
+    };
 
-        Result<void> encode(core::BitWriter& writer) const {
-            // В SEQUENCE GatekeeperRequest:
-            // 1. Extension Marker (1 бит) - НЕТ в базовой части (ставим 0)
-            if (auto res = asn1::PerEncoder::encode_extension_marker(writer, false); !res) return res;
+    // Невладеющий вариант GRQ: строки и OID ссылаются на исходную датаграмму.
+    // Для сообщений, которые обрабатываются и отбрасываются в пределах одного запроса.
+    struct GatekeeperRequestView {
+        uint16_t requestSeqNum = 0;
+        asn1::OidView protocolIdentifier{};
+        std::optional<asn1::BmpStringView> gatekeeperIdentifier{};
+        std::optional<std::string_view> endpointAlias{};
 
-            // 2. Преамбула OPTIONAL полей. В v7 их много (12 штук!). 
-            // Если мы шлем только обязательные, надо записать 12 нулей (битовая маска).
-            if (auto res = asn1::PerEncoder::encode_sequence_preamble(writer, 0, 12); !res) return res;
+        using Schema = detail::GatekeeperRequestSchema<GatekeeperRequestView>;
 
-            // 3. requestSeqNum
-            if (auto res = asn1::PerEncoder::encode_constrained_integer(writer, requestSeqNum, 1, 65535); !res) return res;
+        static Result<GatekeeperRequestView> decode(core::BitReader& reader) {
+            return Schema::decode(reader);
+        }
 
-            // 4. protocolIdentifier (OID)
-            if (auto res = asn1::PerEncoder::encode_oid(writer, protocolIdentifier); !res) return res;
+        template <core::BitSink W>
+        Result<void> encode(W& writer) const {
+            return Schema::encode(writer, *this);
+        }
 
-            return {};
+        // Копирует данные в владеющий GatekeeperRequest (если сообщение нужно сохранить)
+        GatekeeperRequest to_owned(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) const {
+            auto copy = [mr](std::string_view v) { return std::pmr::string(v, mr); };
+            auto transcode = [mr](asn1::BmpStringView v) { return v.to_string(mr); };
+            return GatekeeperRequest{
+                .requestSeqNum = requestSeqNum,
+                .protocolIdentifier = asn1::InternedOid(protocolIdentifier, mr),
+                .gatekeeperIdentifier = gatekeeperIdentifier.transform(transcode),
+                .endpointAlias = endpointAlias.transform(copy)
+            };
         }
     };
 
-    // Заглушка для второго типа сообщения
     struct GatekeeperConfirm {
-        uint16_t requestSeqNum;
-        static Result<GatekeeperConfirm> decode(core::BitReader& reader) {
-            // Логика аналогична GRQ для этого примера
-            return GatekeeperRequest::decode(reader).transform([](auto grq) {
-                return GatekeeperConfirm{ grq.requestSeqNum };
-                });
-        }
+        uint16_t requestSeqNum = 0;
+        asn1::InternedOid protocolIdentifier{};
+        std::optional<std::pmr::string> gatekeeperIdentifier{};
+        TransportAddress rasAddress{};
 
-        Result<void> encode(core::BitWriter& writer) const {
-            return {};
-        }
+        using Schema = asn1::Sequence<GatekeeperConfirm, asn1::Extensible,
+            asn1::Field<&GatekeeperConfirm::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&GatekeeperConfirm::protocolIdentifier, ProtocolIdentifier>,
+            asn1::Field<&GatekeeperConfirm::gatekeeperIdentifier, asn1::Optional<GatekeeperIdentifier>>,
+            asn1::Field<&GatekeeperConfirm::rasAddress, TransportAddress::Schema>>;
+        H323_26_SCHEMA_CODEC(GatekeeperConfirm)
+    };
+
+    struct GatekeeperReject {
+        uint16_t requestSeqNum = 0;
+        asn1::InternedOid protocolIdentifier{};
+        std::optional<std::pmr::string> gatekeeperIdentifier{};
+        GatekeeperRejectReason rejectReason{};
+
+        using Schema = asn1::Sequence<GatekeeperReject, asn1::Extensible,
+            asn1::Field<&GatekeeperReject::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&GatekeeperReject::protocolIdentifier, ProtocolIdentifier>,
+            asn1::Field<&GatekeeperReject::gatekeeperIdentifier, asn1::Optional<GatekeeperIdentifier>>,
+            asn1::Field<&GatekeeperReject::rejectReason, GatekeeperRejectReasonCodec>>;
+        H323_26_SCHEMA_CODEC(GatekeeperReject)
+    };
+
+    struct RegistrationRequest {
+        uint16_t requestSeqNum = 0;
+        asn1::InternedOid protocolIdentifier{};
+        bool discoveryComplete = false;
+        TransportAddressList callSignalAddress{};
+        TransportAddressList rasAddress{};
+        std::optional<AliasList> terminalAlias{};
+        std::optional<std::pmr::string> gatekeeperIdentifier{};
+        std::optional<uint32_t> timeToLive{};
+        std::optional<std::pmr::string> endpointIdentifier{};
+        bool keepAlive = false;
+        asn1::ExtensionAdditions extensions{}; // featureSet, genericData, tokens... — по запросу
+
+        using Schema = asn1::Sequence<RegistrationRequest, asn1::Extensible,
+            asn1::Field<&RegistrationRequest::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&RegistrationRequest::protocolIdentifier, ProtocolIdentifier>,
+            asn1::Field<&RegistrationRequest::discoveryComplete, asn1::Boolean>,
+            asn1::Field<&RegistrationRequest::callSignalAddress, TransportAddressListCodec>,
+            asn1::Field<&RegistrationRequest::rasAddress, TransportAddressListCodec>,
+            asn1::Field<&RegistrationRequest::terminalAlias, asn1::Optional<AliasListCodec>>,
+            asn1::Field<&RegistrationRequest::gatekeeperIdentifier, asn1::Optional<GatekeeperIdentifier>>,
+            asn1::Field<&RegistrationRequest::timeToLive, asn1::Optional<TimeToLive>>,
+            asn1::Field<&RegistrationRequest::endpointIdentifier, asn1::Optional<EndpointIdentifier>>,
+            asn1::Field<&RegistrationRequest::keepAlive, asn1::Boolean>,
+            asn1::Field<&RegistrationRequest::extensions, asn1::Additions>>;
+        H323_26_SCHEMA_CODEC(RegistrationRequest)
+    };
+
+    struct RegistrationConfirm {
+        uint16_t requestSeqNum = 0;
+        asn1::InternedOid protocolIdentifier{};
+        TransportAddressList callSignalAddress{};
+        std::optional<AliasList> terminalAlias{};
+        std::optional<std::pmr::string> gatekeeperIdentifier{};
+        std::pmr::string endpointIdentifier{};
+        std::optional<uint32_t> timeToLive{};
+
+        using Schema = asn1::Sequence<RegistrationConfirm, asn1::Extensible,
+            asn1::Field<&RegistrationConfirm::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&RegistrationConfirm::protocolIdentifier, ProtocolIdentifier>,
+            asn1::Field<&RegistrationConfirm::callSignalAddress, TransportAddressListCodec>,
+            asn1::Field<&RegistrationConfirm::terminalAlias, asn1::Optional<AliasListCodec>>,
+            asn1::Field<&RegistrationConfirm::gatekeeperIdentifier, asn1::Optional<GatekeeperIdentifier>>,
+            asn1::Field<&RegistrationConfirm::endpointIdentifier, EndpointIdentifier>,
+            asn1::Field<&RegistrationConfirm::timeToLive, asn1::Optional<TimeToLive>>>;
+        H323_26_SCHEMA_CODEC(RegistrationConfirm)
+    };
+
+    struct RegistrationReject {
+        uint16_t requestSeqNum = 0;
+        asn1::InternedOid protocolIdentifier{};
+        RegistrationRejectReason rejectReason{};
+        std::optional<std::pmr::string> gatekeeperIdentifier{};
+
+        using Schema = asn1::Sequence<RegistrationReject, asn1::Extensible,
+            asn1::Field<&RegistrationReject::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&RegistrationReject::protocolIdentifier, ProtocolIdentifier>,
+            asn1::Field<&RegistrationReject::rejectReason, RegistrationRejectReasonCodec>,
+            asn1::Field<&RegistrationReject::gatekeeperIdentifier, asn1::Optional<GatekeeperIdentifier>>>;
+        H323_26_SCHEMA_CODEC(RegistrationReject)
+    };
+
+    struct UnregistrationRequest {
+        uint16_t requestSeqNum = 0;
+        TransportAddressList callSignalAddress{};
+        std::optional<AliasList> endpointAlias{};
+        std::optional<std::pmr::string> endpointIdentifier{};
+        std::optional<std::pmr::string> gatekeeperIdentifier{};
+
+        using Schema = asn1::Sequence<UnregistrationRequest, asn1::Extensible,
+            asn1::Field<&UnregistrationRequest::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&UnregistrationRequest::callSignalAddress, TransportAddressListCodec>,
+            asn1::Field<&UnregistrationRequest::endpointAlias, asn1::Optional<AliasListCodec>>,
+            asn1::Field<&UnregistrationRequest::endpointIdentifier, asn1::Optional<EndpointIdentifier>>,
+            asn1::Field<&UnregistrationRequest::gatekeeperIdentifier, asn1::Optional<GatekeeperIdentifier>>>;
+        H323_26_SCHEMA_CODEC(UnregistrationRequest)
+    };
+
+    struct UnregistrationConfirm {
+        uint16_t requestSeqNum = 0;
+
+        using Schema = asn1::Sequence<UnregistrationConfirm, asn1::Extensible,
+            asn1::Field<&UnregistrationConfirm::requestSeqNum, RequestSeqNum>>;
+        H323_26_SCHEMA_CODEC(UnregistrationConfirm)
+    };
+
+    struct UnregistrationReject {
+        uint16_t requestSeqNum = 0;
+        UnregRejectReason rejectReason{};
+
+        using Schema = asn1::Sequence<UnregistrationReject, asn1::Extensible,
+            asn1::Field<&UnregistrationReject::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&UnregistrationReject::rejectReason, UnregRejectReasonCodec>>;
+        H323_26_SCHEMA_CODEC(UnregistrationReject)
+    };
+
+    struct AdmissionRequest {
+        uint16_t requestSeqNum = 0;
+        CallType callType{};
+        std::pmr::string endpointIdentifier{};
+        std::optional<AliasList> destinationInfo{};
+        std::optional<TransportAddress> destCallSignalAddress{};
+        AliasList srcInfo{};
+        uint32_t bandWidth = 0;
+        uint16_t callReferenceValue = 0;
+        std::array<std::byte, 16> conferenceID{};
+        bool activeMC = false;
+        bool answerCall = false;
+        asn1::ExtensionAdditions extensions{};
+
+        using Schema = asn1::Sequence<AdmissionRequest, asn1::Extensible,
+            asn1::Field<&AdmissionRequest::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&AdmissionRequest::callType, CallTypeCodec>,
+            asn1::Field<&AdmissionRequest::endpointIdentifier, EndpointIdentifier>,
+            asn1::Field<&AdmissionRequest::destinationInfo, asn1::Optional<AliasListCodec>>,
+            asn1::Field<&AdmissionRequest::destCallSignalAddress, asn1::Optional<TransportAddress::Schema>>,
+            asn1::Field<&AdmissionRequest::srcInfo, AliasListCodec>,
+            asn1::Field<&AdmissionRequest::bandWidth, BandWidth>,
+            asn1::Field<&AdmissionRequest::callReferenceValue, CallReferenceValue>,
+            asn1::Field<&AdmissionRequest::conferenceID, ConferenceIdentifier>,
+            asn1::Field<&AdmissionRequest::activeMC, asn1::Boolean>,
+            asn1::Field<&AdmissionRequest::answerCall, asn1::Boolean>,
+            asn1::Field<&AdmissionRequest::extensions, asn1::Additions>>;
+        H323_26_SCHEMA_CODEC(AdmissionRequest)
+    };
+
+    struct AdmissionConfirm {
+        uint16_t requestSeqNum = 0;
+        uint32_t bandWidth = 0;
+        CallModel callModel{};
+        TransportAddress destCallSignalAddress{};
+        std::optional<uint16_t> irrFrequency{};
+
+        using Schema = asn1::Sequence<AdmissionConfirm, asn1::Extensible,
+            asn1::Field<&AdmissionConfirm::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&AdmissionConfirm::bandWidth, BandWidth>,
+            asn1::Field<&AdmissionConfirm::callModel, CallModelCodec>,
+            asn1::Field<&AdmissionConfirm::destCallSignalAddress, TransportAddress::Schema>,
+            asn1::Field<&AdmissionConfirm::irrFrequency, asn1::Optional<asn1::Integer<1, 65535>>>>;
+        H323_26_SCHEMA_CODEC(AdmissionConfirm)
+    };
+
+    struct AdmissionReject {
+        uint16_t requestSeqNum = 0;
+        AdmissionRejectReason rejectReason{};
+
+        using Schema = asn1::Sequence<AdmissionReject, asn1::Extensible,
+            asn1::Field<&AdmissionReject::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&AdmissionReject::rejectReason, AdmissionRejectReasonCodec>>;
+        H323_26_SCHEMA_CODEC(AdmissionReject)
+    };
+
+    struct BandwidthRequest {
+        uint16_t requestSeqNum = 0;
+        std::pmr::string endpointIdentifier{};
+        std::array<std::byte, 16> conferenceID{};
+        uint16_t callReferenceValue = 0;
+        uint32_t bandWidth = 0;
+
+        using Schema = asn1::Sequence<BandwidthRequest, asn1::Extensible,
+            asn1::Field<&BandwidthRequest::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&BandwidthRequest::endpointIdentifier, EndpointIdentifier>,
+            asn1::Field<&BandwidthRequest::conferenceID, ConferenceIdentifier>,
+            asn1::Field<&BandwidthRequest::callReferenceValue, CallReferenceValue>,
+            asn1::Field<&BandwidthRequest::bandWidth, BandWidth>>;
+        H323_26_SCHEMA_CODEC(BandwidthRequest)
+    };
+
+    struct BandwidthConfirm {
+        uint16_t requestSeqNum = 0;
+        uint32_t bandWidth = 0;
+
+        using Schema = asn1::Sequence<BandwidthConfirm, asn1::Extensible,
+            asn1::Field<&BandwidthConfirm::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&BandwidthConfirm::bandWidth, BandWidth>>;
+        H323_26_SCHEMA_CODEC(BandwidthConfirm)
+    };
+
+    struct BandwidthReject {
+        uint16_t requestSeqNum = 0;
+        BandRejectReason rejectReason{};
+        uint32_t allowedBandWidth = 0;
+
+        using Schema = asn1::Sequence<BandwidthReject, asn1::Extensible,
+            asn1::Field<&BandwidthReject::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&BandwidthReject::rejectReason, BandRejectReasonCodec>,
+            asn1::Field<&BandwidthReject::allowedBandWidth, BandWidth>>;
+        H323_26_SCHEMA_CODEC(BandwidthReject)
+    };
+
+    struct DisengageRequest {
+        uint16_t requestSeqNum = 0;
+        std::pmr::string endpointIdentifier{};
+        std::array<std::byte, 16> conferenceID{};
+        uint16_t callReferenceValue = 0;
+        DisengageReason disengageReason{};
+
+        using Schema = asn1::Sequence<DisengageRequest, asn1::Extensible,
+            asn1::Field<&DisengageRequest::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&DisengageRequest::endpointIdentifier, EndpointIdentifier>,
+            asn1::Field<&DisengageRequest::conferenceID, ConferenceIdentifier>,
+            asn1::Field<&DisengageRequest::callReferenceValue, CallReferenceValue>,
+            asn1::Field<&DisengageRequest::disengageReason, DisengageReasonCodec>>;
+        H323_26_SCHEMA_CODEC(DisengageRequest)
+    };
+
+    struct DisengageConfirm {
+        uint16_t requestSeqNum = 0;
+
+        using Schema = asn1::Sequence<DisengageConfirm, asn1::Extensible,
+            asn1::Field<&DisengageConfirm::requestSeqNum, RequestSeqNum>>;
+        H323_26_SCHEMA_CODEC(DisengageConfirm)
+    };
+
+    struct DisengageReject {
+        uint16_t requestSeqNum = 0;
+        DisengageRejectReason rejectReason{};
+
+        using Schema = asn1::Sequence<DisengageReject, asn1::Extensible,
+            asn1::Field<&DisengageReject::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&DisengageReject::rejectReason, DisengageRejectReasonCodec>>;
+        H323_26_SCHEMA_CODEC(DisengageReject)
+    };
+
+    struct LocationRequest {
+        uint16_t requestSeqNum = 0;
+        std::optional<std::pmr::string> endpointIdentifier{};
+        AliasList destinationInfo{};
+        TransportAddress replyAddress{};
+        asn1::ExtensionAdditions extensions{};
+
+        using Schema = asn1::Sequence<LocationRequest, asn1::Extensible,
+            asn1::Field<&LocationRequest::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&LocationRequest::endpointIdentifier, asn1::Optional<EndpointIdentifier>>,
+            asn1::Field<&LocationRequest::destinationInfo, AliasListCodec>,
+            asn1::Field<&LocationRequest::replyAddress, TransportAddress::Schema>,
+            asn1::Field<&LocationRequest::extensions, asn1::Additions>>;
+        H323_26_SCHEMA_CODEC(LocationRequest)
+    };
+
+    struct LocationConfirm {
+        uint16_t requestSeqNum = 0;
+        TransportAddress callSignalAddress{};
+        TransportAddress rasAddress{};
+
+        using Schema = asn1::Sequence<LocationConfirm, asn1::Extensible,
+            asn1::Field<&LocationConfirm::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&LocationConfirm::callSignalAddress, TransportAddress::Schema>,
+            asn1::Field<&LocationConfirm::rasAddress, TransportAddress::Schema>>;
+        H323_26_SCHEMA_CODEC(LocationConfirm)
+    };
+
+    struct LocationReject {
+        uint16_t requestSeqNum = 0;
+        LocationRejectReason rejectReason{};
+
+        using Schema = asn1::Sequence<LocationReject, asn1::Extensible,
+            asn1::Field<&LocationReject::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&LocationReject::rejectReason, LocationRejectReasonCodec>>;
+        H323_26_SCHEMA_CODEC(LocationReject)
+    };
+
+    struct InfoRequest {
+        uint16_t requestSeqNum = 0;
+        uint16_t callReferenceValue = 0;
+        std::optional<TransportAddress> replyAddress{};
+
+        using Schema = asn1::Sequence<InfoRequest, asn1::Extensible,
+            asn1::Field<&InfoRequest::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&InfoRequest::callReferenceValue, CallReferenceValue>,
+            asn1::Field<&InfoRequest::replyAddress, asn1::Optional<TransportAddress::Schema>>>;
+        H323_26_SCHEMA_CODEC(InfoRequest)
+    };
+
+    struct InfoRequestResponse {
+        uint16_t requestSeqNum = 0;
+        std::pmr::string endpointIdentifier{};
+        TransportAddress rasAddress{};
+        TransportAddressList callSignalAddress{};
+        std::optional<AliasList> endpointAlias{};
+
+        using Schema = asn1::Sequence<InfoRequestResponse, asn1::Extensible,
+            asn1::Field<&InfoRequestResponse::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&InfoRequestResponse::endpointIdentifier, EndpointIdentifier>,
+            asn1::Field<&InfoRequestResponse::rasAddress, TransportAddress::Schema>,
+            asn1::Field<&InfoRequestResponse::callSignalAddress, TransportAddressListCodec>,
+            asn1::Field<&InfoRequestResponse::endpointAlias, asn1::Optional<AliasListCodec>>>;
+        H323_26_SCHEMA_CODEC(InfoRequestResponse)
+    };
+
+    struct NonStandardMessage {
+        uint16_t requestSeqNum = 0;
+        NonStandardParameter nonStandardData{};
+
+        using Schema = asn1::Sequence<NonStandardMessage, asn1::Extensible,
+            asn1::Field<&NonStandardMessage::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&NonStandardMessage::nonStandardData, NonStandardParameter::Schema>>;
+        H323_26_SCHEMA_CODEC(NonStandardMessage)
+    };
+
+    struct UnknownMessageResponse {
+        uint16_t requestSeqNum = 0;
+
+        using Schema = asn1::Sequence<UnknownMessageResponse, asn1::Extensible,
+            asn1::Field<&UnknownMessageResponse::requestSeqNum, RequestSeqNum>>;
+        H323_26_SCHEMA_CODEC(UnknownMessageResponse)
+    };
+
+    // Дополнения RasMessage (после "...")
+
+    struct RequestInProgress {
+        uint16_t requestSeqNum = 0;
+        uint16_t delay = 0;
+
+        using Schema = asn1::Sequence<RequestInProgress, asn1::Extensible,
+            asn1::Field<&RequestInProgress::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&RequestInProgress::delay, asn1::Integer<1, 65535>>>;
+        H323_26_SCHEMA_CODEC(RequestInProgress)
+    };
+
+    struct ResourcesAvailableIndicate {
+        uint16_t requestSeqNum = 0;
+        asn1::InternedOid protocolIdentifier{};
+        std::pmr::string endpointIdentifier{};
+        bool almostOutOfResources = false;
+
+        using Schema = asn1::Sequence<ResourcesAvailableIndicate, asn1::Extensible,
+            asn1::Field<&ResourcesAvailableIndicate::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&ResourcesAvailableIndicate::protocolIdentifier, ProtocolIdentifier>,
+            asn1::Field<&ResourcesAvailableIndicate::endpointIdentifier, EndpointIdentifier>,
+            asn1::Field<&ResourcesAvailableIndicate::almostOutOfResources, asn1::Boolean>>;
+        H323_26_SCHEMA_CODEC(ResourcesAvailableIndicate)
+    };
+
+    struct ResourcesAvailableConfirm {
+        uint16_t requestSeqNum = 0;
+        asn1::InternedOid protocolIdentifier{};
+
+        using Schema = asn1::Sequence<ResourcesAvailableConfirm, asn1::Extensible,
+            asn1::Field<&ResourcesAvailableConfirm::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&ResourcesAvailableConfirm::protocolIdentifier, ProtocolIdentifier>>;
+        H323_26_SCHEMA_CODEC(ResourcesAvailableConfirm)
+    };
+
+    struct InfoRequestAck {
+        uint16_t requestSeqNum = 0;
+
+        using Schema = asn1::Sequence<InfoRequestAck, asn1::Extensible,
+            asn1::Field<&InfoRequestAck::requestSeqNum, RequestSeqNum>>;
+        H323_26_SCHEMA_CODEC(InfoRequestAck)
+    };
+
+    struct InfoRequestNak {
+        uint16_t requestSeqNum = 0;
+        InfoRequestNakReason nakReason{};
+
+        using Schema = asn1::Sequence<InfoRequestNak, asn1::Extensible,
+            asn1::Field<&InfoRequestNak::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&InfoRequestNak::nakReason, InfoRequestNakReasonCodec>>;
+        H323_26_SCHEMA_CODEC(InfoRequestNak)
+    };
+
+    struct ServiceControlIndication {
+        uint16_t requestSeqNum = 0;
+        std::optional<std::pmr::string> endpointIdentifier{};
+
+        using Schema = asn1::Sequence<ServiceControlIndication, asn1::Extensible,
+            asn1::Field<&ServiceControlIndication::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&ServiceControlIndication::endpointIdentifier, asn1::Optional<EndpointIdentifier>>>;
+        H323_26_SCHEMA_CODEC(ServiceControlIndication)
+    };
+
+    struct ServiceControlResponse {
+        uint16_t requestSeqNum = 0;
+        std::optional<ServiceControlResult> result{};
+
+        using Schema = asn1::Sequence<ServiceControlResponse, asn1::Extensible,
+            asn1::Field<&ServiceControlResponse::requestSeqNum, RequestSeqNum>,
+            asn1::Field<&ServiceControlResponse::result, asn1::Optional<ServiceControlResultCodec>>>;
+        H323_26_SCHEMA_CODEC(ServiceControlResponse)
+    };
+
+    // admissionConfirmSequence ::= SEQUENCE OF AdmissionConfirm (собственного requestSeqNum нет)
+    struct AdmissionConfirmSequence {
+        std::pmr::vector<AdmissionConfirm> confirms{};
+
+        using Schema = asn1::Sequence<AdmissionConfirmSequence, asn1::NotExtensible,
+            asn1::Field<&AdmissionConfirmSequence::confirms, asn1::SequenceOf<AdmissionConfirm::Schema, 1>>>;
+        H323_26_SCHEMA_CODEC(AdmissionConfirmSequence)
     };
 
 } // namespace h323_26::h225
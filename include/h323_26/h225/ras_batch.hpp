@@ -0,0 +1,87 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/core/worker_pool.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace h323_26::h225 {
+
+    // Заголовки пакета датаграмм в виде структуры массивов: i-й элемент каждого
+    // массива относится к i-й датаграмме. type и requestSeqNum имеют смысл только
+    // при status[i] == ErrorCode::Success; у admissionConfirmSequence номер равен 0.
+    struct RasBatchHeaders {
+        std::vector<ErrorCode> status;
+        std::vector<RasMessageType> type;
+        std::vector<uint16_t> requestSeqNum;
+
+        [[nodiscard]] size_t size() const { return status.size(); }
+
+        // Меняет размер всех массивов, сохраняя выделенную память
+        void resize(size_t count) {
+            status.resize(count);
+            type.resize(count);
+            requestSeqNum.resize(count);
+        }
+    };
+
+    // Разбор пакета датаграмм, принятых одним recvmmsg.
+    // Массивы заголовков и сообщения живут в декодере и переиспользуются от пакета
+    // к пакету: i-я датаграмма декодируется в i-е сообщение прошлого пакета через
+    // RasPDU::decode_into, так что при устойчивом трафике пакет не выделяет память.
+    // Результаты действительны до следующего вызова peek/decode (дополнения сообщений —
+    // см. message()).
+    //
+    // С пулом потоков пакет делится на куски по grain датаграмм; mr тогда должен быть
+    // потокобезопасным (ресурс по умолчанию или std::pmr::synchronized_pool_resource).
+    class RasBatchDecoder {
+    public:
+        using Datagrams = std::span<const std::span<const std::byte>>;
+
+        // Типичный пакет recvmmsg
+        static constexpr size_t default_batch = 64;
+
+        explicit RasBatchDecoder(
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource(),
+            core::WorkerPool* workers = nullptr,
+            size_t grain = 16);
+
+        // Неглубокий разбор каждой датаграммы (см. RasPDU::peek): только заголовки
+        const RasBatchHeaders& peek(Datagrams datagrams);
+
+        // Полный разбор: заголовки и сообщения
+        const RasBatchHeaders& decode(Datagrams datagrams);
+
+        [[nodiscard]] const RasBatchHeaders& headers() const { return headers_; }
+
+        // Сообщение i-й датаграммы последнего decode; nullptr, если она не разобрана
+        // или последним был peek (сообщения прошлого пакета к текущему не относятся).
+        // extensions у RRQ, ARQ и LRQ ссылаются на октеты датаграмм пакета: с ними можно
+        // работать, лишь пока живы и не перезаписаны спаны, переданные в decode
+        // (в RasServer — ячейки приема до следующего recvmmsg)
+        [[nodiscard]] const RasMessage* message(size_t i) const {
+            if (i >= decoded_ || i >= messages_.size() || headers_.status[i] != ErrorCode::Success || !messages_[i]) return nullptr;
+            return &*messages_[i];
+        }
+
+    private:
+        template <typename Fn>
+        void for_each_chunk(size_t count, Fn&& fn);
+
+        void peek_one(size_t i, std::span<const std::byte> datagram);
+        void decode_one(size_t i, std::span<const std::byte> datagram);
+
+        std::pmr::memory_resource* mr_;
+        core::WorkerPool* workers_;
+        size_t grain_;
+
+        RasBatchHeaders headers_;
+        std::vector<std::optional<RasMessage>> messages_;
+        size_t decoded_ = 0; // Датаграмм текущего пакета с сообщениями; 0 после peek
+    };
+
+} // namespace h323_26::h225
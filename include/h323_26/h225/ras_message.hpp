@@ -1,29 +1,209 @@
 ﻿#pragma once
 
 #include <h323_26/h225/ras.hpp>
+#include <h323_26/asn1/schema.hpp>
+#include <h323_26/asn1/per_decoder.hpp>
+#include <h323_26/core/fixed_bit_writer.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <variant>
 
 namespace h323_26::h225 {
 
-    using RasMessage = std::variant<GatekeeperRequest, GatekeeperConfirm>;
+    // RasMessage ::= CHOICE (H.225.0 v7): варианты std::variant идут в порядке ASN.1,
+    // поэтому индекс варианта и есть индекс CHOICE
+    using RasMessage = std::variant<
+        GatekeeperRequest,
+        GatekeeperConfirm,
+        GatekeeperReject,
+        RegistrationRequest,
+        RegistrationConfirm,
+        RegistrationReject,
+        UnregistrationRequest,
+        UnregistrationConfirm,
+        UnregistrationReject,
+        AdmissionRequest,
+        AdmissionConfirm,
+        AdmissionReject,
+        BandwidthRequest,
+        BandwidthConfirm,
+        BandwidthReject,
+        DisengageRequest,
+        DisengageConfirm,
+        DisengageReject,
+        LocationRequest,
+        LocationConfirm,
+        LocationReject,
+        InfoRequest,
+        InfoRequestResponse,
+        NonStandardMessage,
+        UnknownMessageResponse,
+        // ...
+        RequestInProgress,
+        ResourcesAvailableIndicate,
+        ResourcesAvailableConfirm,
+        InfoRequestAck,
+        InfoRequestNak,
+        ServiceControlIndication,
+        ServiceControlResponse,
+        AdmissionConfirmSequence>;
+
+    // Тип сообщения — индекс CHOICE RasMessage (совпадает с индексом варианта)
+    enum class RasMessageType : uint8_t {
+        gatekeeperRequest,
+        gatekeeperConfirm,
+        gatekeeperReject,
+        registrationRequest,
+        registrationConfirm,
+        registrationReject,
+        unregistrationRequest,
+        unregistrationConfirm,
+        unregistrationReject,
+        admissionRequest,
+        admissionConfirm,
+        admissionReject,
+        bandwidthRequest,
+        bandwidthConfirm,
+        bandwidthReject,
+        disengageRequest,
+        disengageConfirm,
+        disengageReject,
+        locationRequest,
+        locationConfirm,
+        locationReject,
+        infoRequest,
+        infoRequestResponse,
+        nonStandardMessage,
+        unknownMessageResponse,
+        requestInProgress,
+        resourcesAvailableIndicate,
+        resourcesAvailableConfirm,
+        infoRequestAck,
+        infoRequestNak,
+        serviceControlIndication,
+        serviceControlResponse,
+        admissionConfirmSequence
+    };
+
+    static_assert(static_cast<size_t>(RasMessageType::admissionConfirmSequence) + 1 == std::variant_size_v<RasMessage>,
+        "RasMessageType must enumerate every RasMessage alternative");
+
+    // Какое поле попало в RasHeader::identifier
+    enum class RasIdentifierKind : uint8_t { none, gatekeeperIdentifier, endpointIdentifier };
+
+    // Результат неглубокого разбора: только то, что нужно для классификации датаграммы
+    struct RasHeader {
+        RasMessageType type = RasMessageType::gatekeeperRequest;
+        std::optional<uint16_t> requestSeqNum{}; // У admissionConfirmSequence собственного номера нет
+        RasIdentifierKind identifierKind = RasIdentifierKind::none;
+        asn1::BmpStringView identifier{};        // Символы BMPString в датаграмме
+    };
+
+    namespace detail {
+
+        template <typename Variant>
+        struct RasChoiceFor;
+
+        template <typename... Messages>
+        struct RasChoiceFor<std::variant<Messages...>> {
+            using type = asn1::ExtendedChoice<25, typename Messages::Schema...>;
+        };
+
+    } // namespace detail
 
     struct RasPDU {
-        static Result<void> encode(core::BitWriter& writer, const RasMessage& msg) {
-            // 1. Кодируем индекс CHOICE. 
-            // В H.225.0 для RasMessage: GRQ - это индекс 3.
-            // Используем 33 варианта (как в базе v7), это даст 6 бит.
-            uint32_t index = 0;
-            if (std::holds_alternative<GatekeeperRequest>(msg)) index = 3;
-            else if (std::holds_alternative<GatekeeperConfirm>(msg)) index = 1;
-
-            // Пишем CHOICE index (extensible=true, num_options=33)
-            auto res = asn1::PerEncoder::encode_choice_index(writer, index, 33, true);
-            if (!res) return res;
-
-            // 2. Кодируем тело выбранного сообщения
-            return std::visit([&](auto&& arg) {
-                return arg.encode(writer);
-                }, msg);
+        using Choice = typename detail::RasChoiceFor<RasMessage>::type;
+
+        // Число вариантов в корне CHOICE (до маркера расширения)
+        static constexpr uint32_t root_count = static_cast<uint32_t>(Choice::root_count);
+
+        // Кодирует сообщение в любой core::BitSink: растущий BitWriter
+        // или FixedBitWriter поверх заранее выделенного слота датаграммы.
+        // Индекс CHOICE берется из индекса варианта, кодировщик — из таблицы.
+        template <core::BitSink W>
+        static Result<void> encode(W& writer, const RasMessage& msg) {
+            return Choice::encode_value(writer, msg);
+        }
+
+        // Кодирует корневой вариант Type из тела Body без std::variant. Body — сам тип
+        // варианта или литеральный тип с той же схемой (например, GatekeeperRequestView),
+        // поэтому функция пригодна и для константного вычисления (см. encode_static).
+        template <RasMessageType Type, core::BitSink W, typename Body>
+        static constexpr Result<void> encode_alternative(W& writer, const Body& body) {
+            constexpr auto index = static_cast<uint32_t>(Type);
+            static_assert(index < root_count, "Only root alternatives are encoded without an open type");
+            static_assert(Body::Schema::field_count == std::variant_alternative_t<index, RasMessage>::Schema::field_count,
+                "Body schema does not match the RasMessage alternative");
+
+            if (auto res = asn1::PerEncoder::encode_choice_index(writer, index, root_count, true); !res) return res;
+            return Body::Schema::encode(writer, body);
+        }
+
+        // Датаграмма, закодированная при компиляции: Make — constexpr-фабрика тела.
+        //     static constexpr auto grq = RasPDU::encode_static<RasMessageType::gatekeeperRequest,
+        //         [] { return GatekeeperRequest{ ... }; }>();
+        template <RasMessageType Type, auto Make>
+        static consteval auto encode_static() {
+            return asn1::encode_static<[](auto& writer) { return encode_alternative<Type>(writer, Make()); }>();
+        }
+
+        // Размер датаграммы в октетах. Растущему BitWriter его хватает для одного
+        // reserve() перед encode(); сам подсчет ничего не пишет и не выделяет память.
+        static Result<size_t> encoded_size(const RasMessage& msg) {
+            auto bits = asn1::encoded_bits<Choice>(msg);
+            if (!bits) return std::unexpected(bits.error());
+            return (*bits + 7) / 8;
+        }
+
+        // Кодирует сообщение в слот датаграммы, проверив размер до записи:
+        // если сообщение не помещается, слот не трогается и возвращается BufferOverflow.
+        // Возвращает число записанных октетов.
+        static Result<size_t> encode_into(std::span<std::byte> datagram, const RasMessage& msg) {
+            auto size = encoded_size(msg);
+            if (!size) return std::unexpected(size.error());
+            if (*size > datagram.size()) {
+                return std::unexpected(Error{ ErrorCode::BufferOverflow, "RAS message does not fit the datagram buffer" });
+            }
+
+            core::FixedBitWriter writer(datagram);
+            if (auto res = encode(writer, msg); !res) return std::unexpected(res.error());
+            return *size;
+        }
+
+        // Декодирует датаграмму целиком: индекс CHOICE, затем тело через таблицу
+        // декодеров, построенную при компиляции (стоимость выбора не зависит от числа вариантов)
+        static Result<RasMessage> decode(
+            core::BitReader& reader,
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        {
+            auto index = Choice::decode_index(reader);
+            if (!index) return std::unexpected(index.error());
+            return Choice::decode_alternative<RasMessage>(*index, reader, asn1::DecodeContext{ mr });
+        }
+
+        // Декодирует датаграмму в существующее сообщение. Если msg уже хранит сообщение
+        // того же типа, его строки и векторы перезаписываются с сохранением емкости;
+        // иначе тело строится заново из mr и заменяет прежнее (см. RasMessagePool)
+        static Result<void> decode_into(
+            RasMessage& msg,
+            core::BitReader& reader,
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        {
+            auto index = Choice::decode_index(reader);
+            if (!index) return std::unexpected(index.error());
+            return Choice::decode_alternative_into(*index, msg, reader, asn1::DecodeContext{ mr });
+        }
+
+        // Неглубокий разбор для I/O-потока: тип сообщения и requestSeqNum, а при
+        // with_identifier — первое из полей gatekeeperIdentifier/endpointIdentifier.
+        // Остальное тело не декодируется, память не выделяется.
+        static Result<RasHeader> peek(std::span<const std::byte> datagram, bool with_identifier = false);
+
+        static RasMessageType type_of(const RasMessage& msg) {
+            return static_cast<RasMessageType>(msg.index());
         }
     };
 
@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras_message.hpp>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <variant>
+
+namespace h323_26::h225 {
+
+    // Сообщения одного рабочего потока для разбора без выделения памяти.
+    // Пул хранит по одному RasMessage на тип и декодирует датаграмму в сообщение того же
+    // типа через RasPDU::decode_into: строки и векторы прошлого сообщения переиспользуются.
+    // Когда каждый вид сообщений встретился хотя бы раз, рабочий цикл перестает выделять
+    // память — пока строки не длиннее прежних, а списки не растут: лишние элементы
+    // укоротившегося списка освобождаются, и следующий длинный список строит их заново.
+    // Сообщение пула действительно до следующего decode того же типа. Исключение —
+    // extensions у RRQ, ARQ и LRQ: ExtensionAdditions не копирует дополнения, а ссылается
+    // на октеты датаграммы, поэтому get()/raw() и повторное кодирование с ними допустимы,
+    // лишь пока датаграмма жива и не перезаписана (буфер приема еще не отдан под новую).
+    //
+    // Пул не потокобезопасен: у каждого потока свой (см. local()).
+    class RasMessagePool {
+    public:
+        // Память под сообщения и их рост берется из mr: он должен пережить пул,
+        // поэтому арена одной датаграммы здесь не подходит
+        explicit RasMessagePool(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) : mr_(mr) {}
+
+        RasMessagePool(const RasMessagePool&) = delete;
+        RasMessagePool& operator=(const RasMessagePool&) = delete;
+
+        // Декодирует датаграмму в сообщение пула ее типа. При ошибке сообщение этого
+        // типа остается корректным, но с неопределенным содержимым
+        Result<RasMessage*> decode(std::span<const std::byte> datagram);
+
+        // Освобождает все сообщения вместе с их памятью
+        void clear();
+
+        // Пул текущего потока поверх ресурса по умолчанию на момент первого обращения
+        static RasMessagePool& local();
+
+    private:
+        std::pmr::memory_resource* mr_;
+        std::array<std::optional<RasMessage>, std::variant_size_v<RasMessage>> slots_;
+    };
+
+} // namespace h323_26::h225
@@ -0,0 +1,113 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/h225/ras_types.hpp>
+#include <h323_26/core/error.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace h323_26::h225 {
+
+    // Повтор запроса опознается по отправителю, типу и requestSeqNum
+    struct RasReplyKey {
+        TransportAddress source;
+        RasMessageType type;
+        uint16_t requestSeqNum;
+
+        bool operator==(const RasReplyKey&) const = default;
+    };
+
+    // Кэш закодированных ответов RAS на случай повторной передачи запроса (RRQ, ARQ...):
+    // на повтор отправляются сохраненные октеты, а сам запрос не декодируется и не
+    // обрабатывается заново. Достаточно заголовка RasPDU::peek.
+    //
+    // Емкость фиксирована: записи разложены по корзинам на 4 пути, ответ хранится в
+    // своем слоте арены (до max_reply октетов), при переполнении корзины вытесняется
+    // самый старый ответ. Ответ старше ttl не выдается: через 65536 запросов номер
+    // повторится уже у нового запроса.
+    //
+    // Не потокобезопасен: один кэш на ядро RasServer. Ядро ОС направляет датаграммы
+    // одного отправителя в один и тот же сокет SO_REUSEPORT, так что повтор всегда
+    // приходит в кэш своего ядра.
+    class RasReplyCache {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Config {
+            // Округляется вверх до степени двойки. Корзины по 4 пути теряют заметную долю
+            // ответов уже при половинном заполнении: емкость — с запасом в 2-4 раза
+            // к числу запросов ядра за ttl
+            size_t entries = 4096;
+            size_t max_reply = 512;                // Октетов, не больше UINT16_MAX; ответ длиннее не кэшируется
+            Clock::duration ttl = std::chrono::seconds(10);
+        };
+
+        struct Stats {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t stored = 0;
+            uint64_t evicted = 0;   // Вытеснены живые ответы
+        };
+
+        RasReplyCache() : RasReplyCache(Config{}) {}
+        explicit RasReplyCache(const Config& config);
+
+        RasReplyCache(const RasReplyCache&) = delete;
+        RasReplyCache& operator=(const RasReplyCache&) = delete;
+
+        // Ответ на повтор запроса; действителен до следующего store/encode.
+        // Считает попадания и промахи.
+        std::optional<std::span<const std::byte>> find(const RasReplyKey& key, Clock::time_point now);
+
+        // Сохраняет уже закодированный ответ (например, слот датаграммы RasServer).
+        // false — ответ длиннее max_reply и не сохранен.
+        bool store(const RasReplyKey& key, std::span<const std::byte> reply, Clock::time_point now);
+
+        // Кодирует ответ RasPDU::encode_into прямо в слот кэша и возвращает его октеты.
+        // Не помещается в max_reply — BufferOverflow, кэш не меняется.
+        Result<std::span<const std::byte>> encode(const RasReplyKey& key, const RasMessage& reply, Clock::time_point now);
+
+        void clear();
+
+        [[nodiscard]] const Stats& stats() const { return stats_; }
+        [[nodiscard]] size_t capacity() const { return slots_.size(); }
+
+        // Ключ запроса по его заголовку; у admissionConfirmSequence номера нет
+        static std::optional<RasReplyKey> key_of(const RasHeader& header, const TransportAddress& source);
+
+    private:
+        static constexpr size_t ways = 4;
+
+        struct Slot {
+            uint64_t address = 0;   // ip << 16 | port
+            uint32_t request = 0;   // type << 16 | requestSeqNum
+            uint16_t length = 0;
+            bool used = false;
+            Clock::time_point stored{};
+        };
+
+        static uint64_t address_of(const RasReplyKey& key);
+        static uint32_t request_of(const RasReplyKey& key);
+
+        size_t bucket_of(uint64_t address, uint32_t request) const;
+
+        // Слот для нового ответа key: тот же ключ, свободный, устаревший или самый старый
+        size_t claim(const RasReplyKey& key, Clock::time_point now);
+
+        std::span<std::byte> payload(size_t slot) {
+            return std::span(arena_).subspan(slot * max_reply_, max_reply_);
+        }
+
+        size_t max_reply_;
+        Clock::duration ttl_;
+        size_t bucket_mask_;
+        std::vector<Slot> slots_;
+        std::vector<std::byte> arena_;
+        Stats stats_;
+    };
+
+} // namespace h323_26::h225
@@ -0,0 +1,171 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/asn1/schema.hpp>
+#include <h323_26/core/fixed_bit_writer.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace h323_26::h225 {
+
+    namespace detail {
+
+        template <typename Message, typename Variant>
+        struct RasIndexOf;
+
+        template <typename Message, typename... Messages>
+        struct RasIndexOf<Message, std::variant<Messages...>> {
+            static constexpr size_t value = [] {
+                constexpr bool matches[] = { std::is_same_v<Message, Messages>... };
+                size_t i = 0;
+                while (i < sizeof...(Messages) && !matches[i]) ++i;
+                return i;
+            }();
+        };
+
+        // Переносит count бит из src в dst, начиная с бита dst_bit. В src биты лежат
+        // с той же позиции внутри первого байта (dst_bit % 8), поэтому сдвигов нет:
+        // маскируются только крайние байты, середина копируется memcpy
+        inline void splice_bits(std::span<std::byte> dst, size_t dst_bit, std::span<const std::byte> src, size_t count) {
+            if (count == 0) return;
+
+            const size_t phase = dst_bit % 8;
+            const size_t end = phase + count;
+            const size_t octets = (end + 7) / 8;
+            std::byte* out = dst.data() + dst_bit / 8;
+
+            auto merge = [](std::byte& target, std::byte value, uint8_t mask) {
+                target = (target & std::byte(~mask)) | (value & std::byte(mask));
+            };
+
+            const uint8_t head = static_cast<uint8_t>(0xFF >> phase);
+            const uint8_t tail = end % 8 == 0 ? 0xFF : static_cast<uint8_t>(0xFF << (8 - end % 8));
+
+            if (octets == 1) {
+                merge(out[0], src[0], head & tail);
+                return;
+            }
+            merge(out[0], src[0], head);
+            std::memcpy(out + 1, src.data() + 1, octets - 2);
+            merge(out[octets - 1], src[octets - 1], tail);
+        }
+
+    } // namespace detail
+
+    // Заранее закодированный ответ RAS (GCF/RCF/ACF/...). Сообщение кодируется один раз,
+    // положение каждого поля запоминается; новая датаграмма получается копированием
+    // шаблона (stamp) и перезаписью битовых диапазонов изменившихся полей (patch).
+    //
+    //     auto rcf = RasTemplate<RegistrationConfirm>::make(prototype);
+    //     auto size = rcf->stamp(slot);
+    //     rcf->patch<&RegistrationConfirm::requestSeqNum>(slot, rrq.requestSeqNum);
+    //
+    // Перезаписать можно любое присутствующее в прототипе поле, если новое значение
+    // кодируется той же шириной (целые, адреса, идентификаторы одинаковой длины);
+    // иначе patch возвращает InvalidConstraint и датаграмму не трогает.
+    template <typename Message>
+    class RasTemplate {
+    public:
+        using Schema = typename Message::Schema;
+
+        static constexpr size_t choice_index = detail::RasIndexOf<Message, RasMessage>::value;
+        static_assert(choice_index < std::variant_size_v<RasMessage>, "Message is not a RasMessage alternative");
+
+        // Наибольшая ширина перезаписываемого поля: идентификатор BMPString из 128 символов
+        // (256 октетов) с длиной, битами фазы и выравниванием
+        static constexpr size_t PatchScratchSize = 264;
+
+        static Result<RasTemplate> make(const Message& prototype) {
+            RasTemplate tpl;
+            RasMessage msg(std::in_place_index<choice_index>, prototype);
+
+            auto size = RasPDU::encoded_size(msg);
+            if (!size) return std::unexpected(size.error());
+            tpl.bytes_.resize(*size);
+            if (auto written = RasPDU::encode_into(tpl.bytes_, msg); !written) return std::unexpected(written.error());
+
+            // Тело корневого варианта идет сразу за заголовком CHOICE; тело дополнения —
+            // выровненное содержимое open type, которым датаграмма и заканчивается
+            size_t body_bit = RasPDU::Choice::header_bits;
+            if constexpr (choice_index >= RasPDU::root_count) {
+                auto bits = asn1::encoded_bits<Schema>(prototype);
+                if (!bits) return std::unexpected(bits.error());
+                size_t octets = std::max<size_t>(1, (*bits + 7) / 8);
+                body_bit = (*size - octets) * 8;
+            }
+
+            auto locations = Schema::locate(prototype, body_bit);
+            if (!locations) return std::unexpected(locations.error());
+            tpl.locations_ = *locations;
+            return tpl;
+        }
+
+        [[nodiscard]] std::span<const std::byte> bytes() const { return bytes_; }
+        [[nodiscard]] size_t size() const { return bytes_.size(); }
+
+        // Положение поля Member в шаблоне
+        template <auto Member>
+        [[nodiscard]] const asn1::FieldLocation& location() const {
+            return locations_[member_index<Member>()];
+        }
+
+        // Копирует шаблон в начало out; возвращает размер датаграммы
+        Result<size_t> stamp(std::span<std::byte> out) const {
+            if (out.size() < bytes_.size()) {
+                return std::unexpected(Error{ ErrorCode::BufferOverflow, "Datagram buffer is smaller than the template" });
+            }
+            std::memcpy(out.data(), bytes_.data(), bytes_.size());
+            return bytes_.size();
+        }
+
+        // Перезаписывает поле Member в датаграмме, полученной через stamp().
+        // Значение кодируется в маленький буфер с той же фазой выравнивания
+        // и переносится на место поля.
+        template <auto Member, typename V>
+        Result<void> patch(std::span<std::byte> datagram, const V& value) const {
+            const asn1::FieldLocation& loc = locations_[member_index<Member>()];
+            if (!loc.present) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Field is absent in the template" });
+            }
+            if (datagram.size() < bytes_.size()) {
+                return std::unexpected(Error{ ErrorCode::BufferOverflow, "Datagram buffer is smaller than the template" });
+            }
+
+            const size_t phase = loc.bit_offset % 8;
+            std::array<std::byte, PatchScratchSize> scratch{};
+            core::FixedBitWriter writer(scratch);
+            (void)writer.write_bits(0, phase);
+
+            using codec = typename Schema::template field_codec<Member>;
+            if (auto res = codec::encode_value(writer, value); !res) return res;
+            if (writer.bit_offset() - phase != loc.bit_width) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Patched value changes the field width" });
+            }
+
+            detail::splice_bits(datagram, loc.bit_offset, scratch, loc.bit_width);
+            return {};
+        }
+
+    private:
+        RasTemplate() = default;
+
+        template <auto Member>
+        static constexpr size_t member_index() {
+            constexpr size_t index = Schema::template field_index<Member>;
+            static_assert(index < Schema::field_count, "Member is not described in the schema");
+            return index;
+        }
+
+        std::vector<std::byte> bytes_;
+        std::array<asn1::FieldLocation, Schema::field_count> locations_{};
+    };
+
+} // namespace h323_26::h225
@@ -0,0 +1,93 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/h225/ras_types.hpp>
+#include <h323_26/core/timing_wheel.hpp>
+#include <h323_26/core/error.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace h323_26::h225 {
+
+    // Таймер и число повторов запроса RAS (H.225.0, приложение: по умолчанию 3 с и 2 повтора)
+    struct RasRetryPolicy {
+        std::chrono::milliseconds timeout{ 3000 };
+        unsigned retries = 2;
+    };
+
+    // Исходящие запросы RAS (URQ, IRQ, LRQ соседу...), ожидающие ответа: повтор по
+    // таймеру, RequestInProgress, ответ или отказ по исчерпании попыток.
+    //
+    // Запрос идентифицируется своим requestSeqNum: состояние лежит в массиве на 65536
+    // номеров, таймеры — в core::TimingWheel, так что send(), ответ и повтор — O(1).
+    // Датаграмма запроса копируется в буфер номера; буфер сохраняет емкость, поэтому
+    // после первого использования номера память не выделяется.
+    //
+    // Не потокобезопасен: один экземпляр на поток (например, на ядро RasServer —
+    // отправка через его RasSender, ответы из обработчика, poll() из RasTicker).
+    class RasTransactions {
+    public:
+        using Clock = core::TimingWheel::Clock;
+
+        // Отправка датаграммы; false — ошибка сокета (повтор по таймеру все равно будет)
+        using Send = std::function<bool(const TransportAddress& destination, std::span<const std::byte> datagram)>;
+
+        // Итог запроса: response — подтверждение или отказ, nullptr — ответа нет
+        // после всех повторов
+        using Complete = std::function<void(uint16_t requestSeqNum, const RasMessage* response)>;
+
+        RasTransactions(const RasRetryPolicy& policy, Send send, Complete complete, Clock::time_point now);
+
+        RasTransactions(const RasTransactions&) = delete;
+        RasTransactions& operator=(const RasTransactions&) = delete;
+
+        // Отправляет запрос типа request и ставит таймер. Номер, по которому еще ждут
+        // ответа, и сообщение без пары подтверждение/отказ — InvalidConstraint
+        Result<void> send(uint16_t requestSeqNum, RasMessageType request, const TransportAddress& destination,
+            std::span<const std::byte> datagram, Clock::time_point now);
+
+        // Сообщение от source. true — это ответ на ожидающий запрос: его подтверждение
+        // или отказ (RRQ — RCF/RRJ, IRQ — IRR...) завершают его, RequestInProgress
+        // переносит таймер на свой delay. Прочие сообщения с тем же номером и ответы
+        // с чужого адреса не трогают состояние.
+        bool on_response(const RasMessage& msg, const TransportAddress& source, Clock::time_point now);
+
+        // Снимает запрос без вызова Complete
+        bool cancel(uint16_t requestSeqNum);
+
+        // Повторы и отказы по наступившим таймерам
+        void poll(Clock::time_point now);
+
+        // Когда в следующий раз нужен poll(); time_point::max() — нечего ждать
+        [[nodiscard]] Clock::time_point next_wakeup() const { return wheel_.next_wakeup(); }
+
+        [[nodiscard]] size_t outstanding() const { return wheel_.size(); }
+
+        // requestSeqNum сообщения; у admissionConfirmSequence его нет
+        static std::optional<uint16_t> request_seq_num(const RasMessage& msg);
+
+    private:
+        struct Transaction {
+            core::TimingWheel::TimerId timer;
+            TransportAddress destination{};
+            RasMessageType request = RasMessageType::gatekeeperRequest;
+            unsigned attempts_left = 0;
+            bool active = false;
+            std::vector<std::byte> datagram;
+        };
+
+        void expire(uint16_t requestSeqNum, Clock::time_point now);
+
+        RasRetryPolicy policy_;
+        Send send_;
+        Complete complete_;
+        core::TimingWheel wheel_;
+        std::vector<Transaction> transactions_;
+    };
+
+} // namespace h323_26::h225
@@ -0,0 +1,124 @@
+﻿#pragma once
+
+#include <h323_26/asn1/schema.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Общие типы H.225.0, из которых собираются сообщения RAS.
+// Модели упрощены: в корень включены только поля, нужные гейткиперу,
+// альтернативы CHOICE ограничены наиболее употребительными.
+
+namespace h323_26::h225 {
+
+    using RequestSeqNum = asn1::Integer<1, 65535>;
+    using ProtocolIdentifier = asn1::ObjectIdentifier;
+    using GatekeeperIdentifier = asn1::BMPString<1, 128>;
+    using EndpointIdentifier = asn1::BMPString<1, 128>;
+    using BandWidth = asn1::Integer<0, 4294967295>;
+    using CallReferenceValue = asn1::Integer<0, 65535>;
+    using ConferenceIdentifier = asn1::OctetString<16, 16>;
+    using TimeToLive = asn1::Integer<1, 4294967295>;
+
+    // TransportAddress: только альтернатива ipAddress (IPv4 + порт)
+    struct TransportAddress {
+        std::array<std::byte, 4> ip{};
+        uint16_t port = 0;
+
+        using Schema = asn1::Sequence<TransportAddress, asn1::NotExtensible,
+            asn1::Field<&TransportAddress::ip, asn1::OctetString<4, 4>>,
+            asn1::Field<&TransportAddress::port, asn1::Integer<0, 65535>>>;
+
+        bool operator==(const TransportAddress&) const = default;
+    };
+
+    // AliasAddress ::= CHOICE { dialedDigits, h323-ID, ... }
+    struct DialedDigits {
+        std::pmr::string digits{};
+
+        using Schema = asn1::Sequence<DialedDigits, asn1::NotExtensible,
+            asn1::Field<&DialedDigits::digits, asn1::IA5String<1, 128>>>;
+
+        bool operator==(const DialedDigits&) const = default;
+    };
+
+    struct H323Id {
+        std::pmr::string name{}; // UTF-8; на проводе — BMPString
+
+        using Schema = asn1::Sequence<H323Id, asn1::NotExtensible,
+            asn1::Field<&H323Id::name, asn1::BMPString<1, 256>>>;
+
+        bool operator==(const H323Id&) const = default;
+    };
+
+    using AliasAddress = std::variant<DialedDigits, H323Id>;
+    using AliasAddressCodec = asn1::Choice<asn1::Extensible, DialedDigits::Schema, H323Id::Schema>;
+
+    using AliasList = std::pmr::vector<AliasAddress>;
+    using AliasListCodec = asn1::SequenceOf<AliasAddressCodec>;
+
+    using TransportAddressList = std::pmr::vector<TransportAddress>;
+    using TransportAddressListCodec = asn1::SequenceOf<TransportAddress::Schema>;
+
+    // NonStandardParameter: идентификатор — только альтернатива object
+    struct NonStandardParameter {
+        std::pmr::vector<uint32_t> nonStandardIdentifier{};
+        std::pmr::vector<std::byte> data{};
+
+        using Schema = asn1::Sequence<NonStandardParameter, asn1::NotExtensible,
+            asn1::Field<&NonStandardParameter::nonStandardIdentifier, asn1::ObjectIdentifier>,
+            asn1::Field<&NonStandardParameter::data, asn1::OctetString<>>>;
+    };
+
+    // Перечисления передаются индексом корня (CHOICE из NULL / ENUMERATED)
+    enum class CallType : uint8_t { pointToPoint, oneToN, nToOne, nToN };
+    using CallTypeCodec = asn1::Enumerated<4>;
+
+    enum class CallModel : uint8_t { direct, gatekeeperRouted };
+    using CallModelCodec = asn1::Enumerated<2>;
+
+    enum class DisengageReason : uint8_t { forcedDrop, normalDrop, undefinedReason };
+    using DisengageReasonCodec = asn1::Enumerated<3>;
+
+    enum class GatekeeperRejectReason : uint8_t {
+        resourceUnavailable, terminalExcluded, invalidRevision, undefinedReason
+    };
+    using GatekeeperRejectReasonCodec = asn1::Enumerated<4>;
+
+    enum class RegistrationRejectReason : uint8_t {
+        discoveryRequired, invalidRevision, invalidCallSignalAddress, invalidRASAddress,
+        duplicateAlias, invalidTerminalType, undefinedReason, transportNotSupported
+    };
+    using RegistrationRejectReasonCodec = asn1::Enumerated<8>;
+
+    enum class UnregRejectReason : uint8_t { notCurrentlyRegistered, callInProgress, undefinedReason };
+    using UnregRejectReasonCodec = asn1::Enumerated<3>;
+
+    enum class AdmissionRejectReason : uint8_t {
+        calledPartyNotRegistered, invalidPermission, requestDenied, undefinedReason,
+        callerNotRegistered, routeCallToGatekeeper, invalidEndpointIdentifier, resourceUnavailable
+    };
+    using AdmissionRejectReasonCodec = asn1::Enumerated<8>;
+
+    enum class BandRejectReason : uint8_t {
+        notBound, invalidConferenceID, invalidPermission, insufficientResources, invalidRevision, undefinedReason
+    };
+    using BandRejectReasonCodec = asn1::Enumerated<6>;
+
+    enum class DisengageRejectReason : uint8_t { notRegistered, requestToDropOther };
+    using DisengageRejectReasonCodec = asn1::Enumerated<2>;
+
+    enum class LocationRejectReason : uint8_t { notRegistered, invalidPermission, requestDenied, undefinedReason };
+    using LocationRejectReasonCodec = asn1::Enumerated<4>;
+
+    enum class InfoRequestNakReason : uint8_t { notRegistered, securityDenial, undefinedReason };
+    using InfoRequestNakReasonCodec = asn1::Enumerated<3>;
+
+    enum class ServiceControlResult : uint8_t { started, failed, stopped, notAvailable };
+    using ServiceControlResultCodec = asn1::Enumerated<4>;
+
+} // namespace h323_26::h225
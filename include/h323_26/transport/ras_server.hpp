@@ -0,0 +1,125 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras_batch.hpp>
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/h225/ras_reply_cache.hpp>
+#include <h323_26/h225/ras_transactions.hpp>
+#include <h323_26/h225/ras_types.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace h323_26::transport {
+
+    // Обработчик запросов одного ядра. Вызывается только из потока своего ядра,
+    // поэтому состояние ядра (регистрации, шаблоны ответов) живет в замыкании без
+    // блокировок. Ответ кодируется прямо в reply — слот исходящей датаграммы;
+    // возвращается его размер в октетах, 0 — ответа нет.
+    using RasHandler = std::function<size_t(
+        const h225::RasMessage& request,
+        const h225::TransportAddress& source,
+        std::span<std::byte> reply)>;
+
+    // Отправка с сокета ядра — исходящие запросы RAS (см. h225::RasTransactions).
+    // Вызывается только из потока своего ядра: из обработчика или RasTicker.
+    class RasSender {
+    public:
+        bool send(const h225::TransportAddress& destination, std::span<const std::byte> datagram) const;
+
+    private:
+        friend class RasServer;
+        explicit RasSender(int fd) : fd_(fd) {}
+
+        int fd_;
+    };
+
+    // Вызывается в потоке ядра после каждого пакета датаграмм и не реже периода
+    // опроса (~50 мс): здесь ядро продвигает свои таймеры (повторы, TTL)
+    using RasTicker = std::function<void(h225::RasTransactions::Clock::time_point now)>;
+
+    // Состояние ядра: обработчик запросов и, при необходимости, таймеры
+    struct RasShard {
+        RasHandler handler;
+        RasTicker tick;
+    };
+
+    struct RasServerConfig {
+        // Порт 0 — свободный порт выбирает ОС (см. RasServer::port())
+        h225::TransportAddress bind{ .ip = { std::byte{ 127 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 1 } }, .port = 1719 };
+        size_t threads = 0;                                    // 0 — по числу ядер
+        size_t batch = h225::RasBatchDecoder::default_batch;   // Датаграмм на recvmmsg/sendmmsg
+        bool pin_threads = true;                               // Поток i работает на ядре i
+        size_t reply_cache = 4096;                             // Ответов в кэше повторов ядра; 0 — без кэша
+        size_t max_cached_reply = 512;                         // Октетов; длинные ответы не кэшируются
+    };
+
+    // Счетчики ядра. Пишет только поток ядра, читать можно в любой момент
+    struct RasServerStats {
+        uint64_t batches = 0;   // Вызовы recvmmsg, вернувшие датаграммы
+        uint64_t received = 0;
+        uint64_t malformed = 0; // Не разобраны RasBatchDecoder
+        uint64_t sent = 0;
+        uint64_t cache_hits = 0;    // Повторы, получившие ответ из кэша без разбора
+        uint64_t cache_misses = 0;
+
+        RasServerStats& operator+=(const RasServerStats& other) {
+            batches += other.batches;
+            received += other.received;
+            malformed += other.malformed;
+            sent += other.sent;
+            cache_hits += other.cache_hits;
+            cache_misses += other.cache_misses;
+            return *this;
+        }
+    };
+
+    // UDP-интерфейс RAS (порт 1719): по сокету SO_REUSEPORT и потоку на ядро.
+    // Ядро ОС распределяет датаграммы между сокетами по хешу адресов, так что запросы
+    // одного клиента всегда попадают в один поток. Поток принимает пакет recvmmsg,
+    // разбирает его RasBatchDecoder, вызывает свой обработчик для каждого запроса и
+    // отправляет ответы одним sendmmsg. Общих блокировок на этом пути нет.
+    // Собственные запросы ядро отправляет через RasSender, повторяя их по таймеру.
+    // Ответы кэшируются (h225::RasReplyCache): повтор запроса клиентом получает
+    // прежний ответ по заголовку, без полного разбора и без вызова обработчика.
+    //
+    // Доступен только на Linux.
+    class RasServer {
+    public:
+        // Создает обработчик ядра shard; вызывается в start() до запуска потоков
+        using HandlerFactory = std::function<RasHandler(size_t shard)>;
+
+        // Создает состояние ядра shard с его RasSender
+        using ShardFactory = std::function<RasShard(size_t shard, RasSender sender)>;
+
+        static Result<std::unique_ptr<RasServer>> start(const RasServerConfig& config, const HandlerFactory& make_handler);
+        static Result<std::unique_ptr<RasServer>> start(const RasServerConfig& config, const ShardFactory& make_shard);
+
+        ~RasServer();
+
+        RasServer(const RasServer&) = delete;
+        RasServer& operator=(const RasServer&) = delete;
+
+        // Останавливает потоки (не дольше периода опроса, ~50 мс) и закрывает сокеты
+        void stop();
+
+        [[nodiscard]] uint16_t port() const { return port_; }
+        [[nodiscard]] size_t shards() const { return shards_.size(); }
+
+        [[nodiscard]] RasServerStats shard_stats(size_t shard) const;
+        [[nodiscard]] RasServerStats stats() const;
+
+    private:
+        struct Shard;
+
+        RasServer() = default;
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+        std::atomic<bool> stopping_{ false };
+        uint16_t port_ = 0;
+    };
+
+} // namespace h323_26::transport
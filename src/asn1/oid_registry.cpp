@@ -0,0 +1,22 @@
+﻿#include <h323_26/asn1/oid_registry.hpp>
+#include <cstring>
+
+namespace h323_26::asn1 {
+
+    OidId OidRegistry::match(std::span<const std::byte> ber) {
+        for (const auto& entry : entries) {
+            if (entry.ber.size() == ber.size() && std::memcmp(entry.ber.data(), ber.data(), ber.size()) == 0) {
+                return entry.id;
+            }
+        }
+        return OidId::unknown;
+    }
+
+    OidId OidRegistry::match(std::span<const uint32_t> arcs) {
+        for (const auto& entry : entries) {
+            if (std::ranges::equal(entry.arcs, arcs)) return entry.id;
+        }
+        return OidId::unknown;
+    }
+
+} // namespace h323_26::asn1
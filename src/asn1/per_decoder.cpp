@@ -1,11 +1,13 @@
 ﻿#include <h323_26/asn1/per_decoder.hpp>
+#include <h323_26/core/octet_kernels.hpp>
 #include <bit>
 #include <algorithm>
 
 namespace h323_26::asn1 {
 
-    // Вспомогательный метод (Normally Small Integer)
-    static Result<uint64_t> decode_normally_small_integer(core::BitReader& reader) {
+    // Normally small non-negative whole number (X.691, 10.6)
+    template <PerVariant Variant>
+    Result<uint64_t> BasicPerDecoder<Variant>::decode_normally_small_number(core::BitReader& reader) {
         auto bit = reader.read_bits(1);
         if (!bit) return std::unexpected(bit.error());
 
@@ -13,13 +15,20 @@ namespace h323_26::asn1 {
             // Если 0, то следующие 6 бит — это само число (0..63)
             return reader.read_bits(6);
         }
-        else {
-            // Если 1, то это "длинный" вариант (пока кинем ошибку или реализуем позже)
-            return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Long normally small integer not implemented" });
+
+        // Длинная форма: semi-constrained whole number — число октетов + октеты значения
+        auto length = decode_length_determinant(reader);
+        if (!length) return std::unexpected(length.error());
+        if (*length == 0 || *length > sizeof(uint64_t)) {
+            return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Normally small number does not fit 64 bits" });
         }
+
+        octet_align(reader);
+        return reader.read_bits(*length * 8);
     }
 
-    Result<uint64_t> PerDecoder::decode_constrained_integer(
+    template <PerVariant Variant>
+    Result<uint64_t> BasicPerDecoder<Variant>::decode_constrained_integer(
         core::BitReader& reader,
         uint64_t min,
         uint64_t max)
@@ -28,33 +37,50 @@ namespace h323_26::asn1 {
             return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Max < Min in integer constraint" });
         }
 
-        uint64_t range = max - min + 1;
-
-        // Если диапазон равен 1 (например, INTEGER (5..5)), число в потоке занимает 0 бит
-        if (range == 1) {
+        Result<uint64_t> raw_value = 0;
+        switch (constrained_integer_form<Variant>(min, max)) {
+        case IntegerForm::empty:
+            // Если диапазон равен 1 (например, INTEGER (5..5)), число в потоке занимает 0 бит
             return min;
+        case IntegerForm::bit_field:
+            // std::bit_width(max - min) дает количество бит для представления числа от 0 до range-1
+            raw_value = reader.read_bits(std::bit_width(max - min));
+            break;
+        case IntegerForm::one_octet:
+            reader.align_to_byte();
+            raw_value = reader.read_bits(8);
+            break;
+        case IntegerForm::two_octets:
+            reader.align_to_byte();
+            raw_value = reader.read_bits(16);
+            break;
+        case IntegerForm::indefinite: {
+            // Число октетов (1..n) как constrained whole number, затем выровненные октеты
+            size_t max_octets = value_octets(max - min);
+            auto octets = reader.read_bits(std::bit_width(max_octets - 1));
+            if (!octets) return std::unexpected(octets.error());
+            if (*octets + 1 > max_octets) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Integer length exceeds its range" });
+            }
+            reader.align_to_byte();
+            raw_value = reader.read_bits((*octets + 1) * 8);
+            break;
+        }
         }
-
-        // Вычисляем количество бит, необходимых для упаковки диапазона
-        // std::bit_width(range - 1) дает количество бит для представления числа от 0 до range-1
-        uint32_t bits_to_read = std::bit_width(range - 1);
-
-        auto raw_value = reader.read_bits(bits_to_read);
         if (!raw_value) {
             return std::unexpected(raw_value.error());
         }
 
         // В PER записывается смещение от минимального значения
-        uint64_t final_value = min + *raw_value;
-
-        if (final_value > max) {
+        if (*raw_value > max - min) {
             return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Decoded value exceeds max constraint" });
         }
 
-        return final_value;
+        return min + *raw_value;
     }
 
-    Result<uint64_t> PerDecoder::decode_extensible_constrained_integer(
+    template <PerVariant Variant>
+    Result<uint64_t> BasicPerDecoder<Variant>::decode_extensible_constrained_integer(
         core::BitReader& reader,
         uint64_t min,
         uint64_t max)
@@ -66,16 +92,34 @@ namespace h323_26::asn1 {
             // Мы в пределах известного диапазона
             return decode_constrained_integer(reader, min, max);
         }
-        else {
-            // Мы вышли за пределы (Extension bit = 1)
-            // В PER это обычно кодируется как "unconstrained" или "normally small"
-            // Для простоты сейчас реализуем чтение "Normally Small Integer" (X.691, 10.6)
-            // Это часто используется для индексов в таблицах расширений.
-            return decode_normally_small_integer(reader);
+
+        // Вне корня (X.691, 13.1): unconstrained whole number — длина + октеты дополнительного кода
+        auto length = decode_length_determinant(reader);
+        if (!length) return std::unexpected(length.error());
+        if (*length == 0 || *length > sizeof(uint64_t) + 1) {
+            return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Integer does not fit 64 bits" });
+        }
+
+        octet_align(reader);
+        auto sign = reader.peek_bits(1);
+        if (!sign) return std::unexpected(sign.error());
+        if (*sign != 0) {
+            return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Negative integers are not supported" });
+        }
+        if (*length > sizeof(uint64_t)) {
+            // Девятый октет допустим только как ведущий знаковый ноль
+            auto lead = reader.read_bits(8);
+            if (!lead) return std::unexpected(lead.error());
+            if (*lead != 0) {
+                return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Integer does not fit 64 bits" });
+            }
+            return reader.read_bits(64);
         }
+        return reader.read_bits(*length * 8);
     }
 
-    Result<uint64_t> PerDecoder::decode_sequence_preamble(core::BitReader& reader, size_t optional_count) {
+    template <PerVariant Variant>
+    Result<uint64_t> BasicPerDecoder<Variant>::decode_sequence_preamble(core::BitReader& reader, size_t optional_count) {
         if (optional_count == 0) return 0;
         if (optional_count > 64) {
             return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Too many optional fields" });
@@ -83,34 +127,55 @@ namespace h323_26::asn1 {
         return reader.read_bits(optional_count);
     }
 
-    Result<bool> PerDecoder::decode_extension_marker(core::BitReader& reader) {
+    template <PerVariant Variant>
+    Result<bool> BasicPerDecoder<Variant>::decode_extension_marker(core::BitReader& reader) {
         auto bit = reader.read_bits(1);
         if (!bit) return std::unexpected(bit.error());
         return *bit == 1;
     }
 
-    Result<uint32_t> PerDecoder::decode_choice_index(core::BitReader& reader, uint32_t num_options, bool extensible) {
+    template <PerVariant Variant>
+    Result<uint32_t> BasicPerDecoder<Variant>::decode_choice_index(core::BitReader& reader, uint32_t num_options, bool extensible) {
         if (extensible) {
             auto is_extended = reader.read_bits(1);
             if (!is_extended) return std::unexpected(is_extended.error());
             if (*is_extended) {
-                return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Extension choices not implemented yet" });
+                // Вариант из дополнений: его номер среди дополнений — normally small number.
+                // Возвращаем сквозной индекс (num_options + n); тело идет как open type.
+                auto addition = decode_normally_small_number(reader);
+                if (!addition) return std::unexpected(addition.error());
+                return static_cast<uint32_t>(num_options + *addition);
             }
         }
 
         if (num_options <= 1) return 0;
 
-        // Количество бит = log2(num_options)
-        uint32_t bits = std::bit_width(num_options - 1);
-        auto index = reader.read_bits(bits);
-        if (!index) return std::unexpected(index.error());
+        // Корневой индекс — constrained whole number 0..n-1.
+        // Индексы >= num_options заняты дополнениями — в корневом поле они недопустимы
+        auto index = decode_constrained_integer(reader, 0, num_options - 1);
+        if (!index) {
+            if (index.error().code != ErrorCode::InvalidConstraint) return std::unexpected(index.error());
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "CHOICE index is out of range" });
+        }
 
         return static_cast<uint32_t>(*index);
     }
 
-    Result<size_t> PerDecoder::decode_length_determinant(core::BitReader& reader) {
-        // В UNALIGNED PER для длин < 128 выравнивание не всегда нужно, 
-        // но для простоты и соответствия большинству полей H.225:
+    template <PerVariant Variant>
+    Result<size_t> BasicPerDecoder<Variant>::decode_length_determinant(core::BitReader& reader) {
+        auto fragment = decode_length_fragment(reader);
+        if (!fragment) return std::unexpected(fragment.error());
+        if (!fragment->last) {
+            return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Fragmented length where a single length is expected" });
+        }
+        return fragment->length;
+    }
+
+    template <PerVariant Variant>
+    Result<LengthFragment> BasicPerDecoder<Variant>::decode_length_fragment(core::BitReader& reader) {
+        // В ALIGNED определитель длины начинается с границы октета, в UNALIGNED — сразу
+        octet_align(reader);
+
         auto first_bit = reader.read_bits(1);
         if (!first_bit) return std::unexpected(first_bit.error());
 
@@ -118,7 +183,7 @@ namespace h323_26::asn1 {
             // Случай 1: длина 0..127 (7 бит)
             auto val = reader.read_bits(7);
             if (!val) return std::unexpected(val.error());
-            return static_cast<size_t>(*val);
+            return LengthFragment{ static_cast<size_t>(*val), true };
         }
 
         auto second_bit = reader.read_bits(1);
@@ -128,51 +193,262 @@ namespace h323_26::asn1 {
             // Случай 2: длина 128..16383 (14 бит)
             auto val = reader.read_bits(14);
             if (!val) return std::unexpected(val.error());
-            return static_cast<size_t>(*val);
+            return LengthFragment{ static_cast<size_t>(*val), true };
         }
 
-        return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Huge lengths (>16k) not implemented" });
+        // Случай 3: фрагмент — 6 бит множителя m (1..4), за ним m * 16K элементов
+        auto multiplier = reader.read_bits(6);
+        if (!multiplier) return std::unexpected(multiplier.error());
+        if (*multiplier < 1 || *multiplier > 4) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Fragment multiplier must be 1..4" });
+        }
+        return LengthFragment{ static_cast<size_t>(*multiplier) * 16384, false };
     }
 
-    Result<std::string> PerDecoder::decode_ia5_string(core::BitReader& reader, std::optional<size_t> fixed_size) {
-        size_t length = 0;
-        if (fixed_size) {
-            length = *fixed_size;
+    template <PerVariant Variant>
+    Result<void> BasicPerDecoder<Variant>::decode_ia5_string_into(
+        std::pmr::string& out,
+        core::BitReader& reader,
+        std::optional<size_t> fixed_size)
+    {
+        out.clear();
+        if constexpr (Variant::aligned) {
+            if (!fixed_size) {
+                // Символ — октет; длина из потока, возможно фрагментированная: собираем куски прямо в строку
+                core::AppendOctetSink sink(out);
+                if (auto total = decode_octet_stream(reader, sink); !total) return std::unexpected(total.error());
+                return {};
+            }
+
+            size_t length = *fixed_size;
+            if (length == 0) return {};
+
+            // Строка фиксированной длины до 16 бит не выравнивается
+            if (length > 2) reader.align_to_byte();
+
+            out.resize(length);
+            return reader.read_bytes(std::as_writable_bytes(std::span(out)));
         }
         else {
-            auto decoded_len = decode_length_determinant(reader);
-            if (!decoded_len) return std::unexpected(decoded_len.error());
-            length = *decoded_len;
+            // UNALIGNED: 7 бит на символ, без выравнивания
+            auto read_chars = [&](size_t count) -> Result<void> {
+                if (count > reader.bits_left() / Variant::ia5_char_bits) {
+                    return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+                }
+                out.reserve(out.size() + count);
+                for (size_t i = 0; i < count; ++i) {
+                    out.push_back(static_cast<char>(*reader.read_bits(Variant::ia5_char_bits)));
+                }
+                return {};
+            };
+
+            if (fixed_size) return read_chars(*fixed_size);
+            for (;;) {
+                auto fragment = decode_length_fragment(reader);
+                if (!fragment) return std::unexpected(fragment.error());
+                if (auto chars = read_chars(fragment->length); !chars) return chars;
+                if (fragment->last) return {};
+            }
+        }
+    }
+
+    template <PerVariant Variant>
+    Result<std::pmr::string> BasicPerDecoder<Variant>::decode_ia5_string(
+        core::BitReader& reader,
+        std::optional<size_t> fixed_size,
+        std::pmr::memory_resource* mr)
+    {
+        std::pmr::string res(mr);
+        if (auto chars = decode_ia5_string_into(res, reader, fixed_size); !chars) return std::unexpected(chars.error());
+        return res;
+    }
+
+    template <PerVariant Variant>
+    Result<std::pmr::vector<std::byte>> BasicPerDecoder<Variant>::decode_octet_string(
+        core::BitReader& reader,
+        std::optional<size_t> fixed_size,
+        std::pmr::memory_resource* mr)
+    {
+        std::pmr::vector<std::byte> res(mr);
+        if (auto bytes = decode_octet_string_into(res, reader, fixed_size); !bytes) return std::unexpected(bytes.error());
+        return res;
+    }
+
+    template <PerVariant Variant>
+    Result<void> BasicPerDecoder<Variant>::decode_octet_string_into(
+        std::pmr::vector<std::byte>& out,
+        core::BitReader& reader,
+        std::optional<size_t> fixed_size)
+    {
+        out.clear();
+        if (!fixed_size) {
+            core::AppendOctetSink sink(out);
+            if (auto total = decode_octet_stream(reader, sink); !total) return std::unexpected(total.error());
+            return {};
+        }
+
+        // Фиксированные 1..2 октета не выравниваются
+        if (*fixed_size > 2) octet_align(reader);
+        out.resize(*fixed_size);
+        return reader.read_bytes(out);
+    }
+
+    template <PerVariant Variant>
+    Result<void> BasicPerDecoder<Variant>::decode_bit_contents(core::BitReader& reader, size_t bits, BitStringValue& out) {
+        if (bits > reader.bits_left()) {
+            return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+        }
+
+        // Целые октеты — одним read_bytes (со сдвигом — векторное ядро), хвост — старшими битами октета
+        size_t offset = out.octets.size();
+        size_t rest = bits % 8;
+        out.octets.resize(offset + (bits + 7) / 8);
+        (void)reader.read_bytes(std::span(out.octets).subspan(offset, bits / 8));
+        if (rest != 0) {
+            out.octets.back() = static_cast<std::byte>(*reader.read_bits(rest) << (8 - rest));
+        }
+        out.bits += bits;
+        return {};
+    }
+
+    template <PerVariant Variant>
+    Result<BitStringValue> BasicPerDecoder<Variant>::decode_bit_string(
+        core::BitReader& reader,
+        std::optional<size_t> fixed_bits,
+        std::pmr::memory_resource* mr)
+    {
+        BitStringValue res{ BitStringValue::allocator_type(mr) };
+        if (auto bits = decode_bit_string_into(res, reader, fixed_bits); !bits) return std::unexpected(bits.error());
+        return res;
+    }
+
+    template <PerVariant Variant>
+    Result<void> BasicPerDecoder<Variant>::decode_bit_string_into(
+        BitStringValue& out,
+        core::BitReader& reader,
+        std::optional<size_t> fixed_bits)
+    {
+        out.octets.clear();
+        out.bits = 0;
+        if (fixed_bits) {
+            // До 16 бит — без выравнивания
+            if (*fixed_bits > 16) octet_align(reader);
+            return decode_bit_contents(reader, *fixed_bits, out);
         }
 
-        if (length == 0) return "";
+        for (;;) {
+            auto fragment = decode_length_fragment(reader);
+            if (!fragment) return std::unexpected(fragment.error());
+            if (fragment->length > 0) {
+                octet_align(reader);
+                if (auto bits = decode_bit_contents(reader, fragment->length, out); !bits) return bits;
+            }
+            if (fragment->last) return {};
+        }
+    }
+
+    template <PerVariant Variant>
+    Result<void> BasicPerDecoder<Variant>::decode_bmp_chars(core::BitReader& reader, size_t count, std::pmr::string& out) {
+        if (count > reader.bits_left() / 16) {
+            return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+        }
 
-        // IA5String символы занимают 7 бит в UNALIGNED PER, 
-        // НО если строка длинная или не ограничена, они часто пакуются в 8-битные октеты.
-        // Для H.225 Alias обычно используются 8-битные выровненные октеты.
-        reader.align_to_byte();
+        const auto& kernels = core::octet_kernels();
+        auto transcode = [&](std::span<const std::byte> units) -> Result<void> {
+            // Не больше 3 октетов UTF-8 на символ; лишнее отрезается тем же вызовом
+            bool valid = true;
+            size_t offset = out.size();
+            out.resize_and_overwrite(offset + units.size() / 2 * 3, [&](char* data, size_t) {
+                size_t written = kernels.utf16be_to_utf8(units.data(), units.size() / 2, data + offset);
+                if (written == core::Utf16Invalid) {
+                    valid = false;
+                    return offset;
+                }
+                return offset + written;
+            });
+            if (!valid) {
+                return std::unexpected(Error{ ErrorCode::InvalidConstraint, "BMPString character is a UTF-16 surrogate" });
+            }
+            return {};
+        };
 
-        std::string res;
-        res.reserve(length);
-        for (size_t i = 0; i < length; ++i) {
-            auto ch = reader.read_bits(8);
-            if (!ch) return std::unexpected(ch.error());
-            res.push_back(static_cast<char>(*ch));
+        if (reader.bit_offset() % 8 == 0) {
+            // Выровненные символы перекодируются прямо из датаграммы
+            return transcode(*reader.view_bytes(count * 2));
         }
+
+        // Со сдвигом — через небольшой буфер
+        std::array<std::byte, 512> buffer;
+        for (size_t left = count; left > 0;) {
+            auto chunk = std::span(buffer).first(std::min(left, buffer.size() / 2) * 2);
+            (void)reader.read_bytes(chunk);
+            if (auto res = transcode(chunk); !res) return res;
+            left -= chunk.size() / 2;
+        }
+        return {};
+    }
+
+    template <PerVariant Variant>
+    Result<std::pmr::string> BasicPerDecoder<Variant>::decode_bmp_string(
+        core::BitReader& reader,
+        std::optional<size_t> fixed_size,
+        std::pmr::memory_resource* mr)
+    {
+        std::pmr::string res(mr);
+        if (auto chars = decode_bmp_string_into(res, reader, fixed_size); !chars) return std::unexpected(chars.error());
         return res;
     }
 
-    Result<std::vector<uint32_t>> PerDecoder::decode_oid(core::BitReader& reader) {
+    template <PerVariant Variant>
+    Result<void> BasicPerDecoder<Variant>::decode_bmp_string_into(
+        std::pmr::string& out,
+        core::BitReader& reader,
+        std::optional<size_t> fixed_size)
+    {
+        out.clear();
+        if (fixed_size) {
+            // Один символ (16 бит) не выравнивается
+            if (*fixed_size > 1) octet_align(reader);
+            return decode_bmp_chars(reader, *fixed_size, out);
+        }
+
+        for (;;) {
+            auto fragment = decode_length_fragment(reader);
+            if (!fragment) return std::unexpected(fragment.error());
+            if (fragment->length > 0) {
+                octet_align(reader);
+                if (auto chars = decode_bmp_chars(reader, fragment->length, out); !chars) return chars;
+            }
+            if (fragment->last) return {};
+        }
+    }
+
+    template <PerVariant Variant>
+    Result<std::pmr::vector<uint32_t>> BasicPerDecoder<Variant>::decode_oid(core::BitReader& reader, std::pmr::memory_resource* mr) {
+        std::pmr::vector<uint32_t> nodes(mr);
+        if (auto arcs = decode_oid_into(nodes, reader); !arcs) return std::unexpected(arcs.error());
+        return nodes;
+    }
+
+    template <PerVariant Variant>
+    Result<void> BasicPerDecoder<Variant>::decode_oid_into(std::pmr::vector<uint32_t>& nodes, core::BitReader& reader) {
+        nodes.clear();
         auto length_res = decode_length_determinant(reader);
         if (!length_res) return std::unexpected(length_res.error());
 
         size_t len = *length_res;
-        if (len == 0) return std::vector<uint32_t>{};
+        if (len == 0) return {};
 
-        // OID всегда выровнен по байту в PER
-        reader.align_to_byte();
+        // В ALIGNED содержимое выровнено (курсор уже на границе после длины)
+        octet_align(reader);
 
-        std::vector<uint32_t> nodes;
+        // Длина приходит с провода: до резерва сверяем ее с остатком входа
+        if (len > reader.bits_left() / 8) {
+            return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+        }
+        // Дуг не больше, чем байт + 1: резервируем сразу, чтобы арена не копила
+        // брошенные при росте вектора блоки
+        nodes.reserve(len + 1);
         // Первый байт: X*40 + Y
         auto first_byte_res = reader.read_bits(8);
         if (!first_byte_res) return std::unexpected(first_byte_res.error());
@@ -194,7 +470,66 @@ namespace h323_26::asn1 {
             } while (b & 0x80); // Пока 8-й бит равен 1
             nodes.push_back(node_val);
         }
-        return nodes;
+        return {};
     }
 
+    template <PerVariant Variant>
+    Result<std::span<const std::byte>> BasicPerDecoder<Variant>::decode_octet_string_view(core::BitReader& reader, std::optional<size_t> fixed_size)
+        requires (Variant::aligned)
+    {
+        size_t length = 0;
+        if (fixed_size) {
+            length = *fixed_size;
+            // Фиксированные 1..2 октета не выравниваются
+            if (length > 2) reader.align_to_byte();
+        }
+        else {
+            auto decoded_len = decode_length_determinant(reader);
+            if (!decoded_len) return std::unexpected(decoded_len.error());
+            length = *decoded_len;
+        }
+
+        if (length == 0) return std::span<const std::byte>{};
+
+        // Октеты лежат выровненными — отдаем окно прямо в датаграмму
+        return reader.view_bytes(length);
+    }
+
+    template <PerVariant Variant>
+    Result<std::span<const std::byte>> BasicPerDecoder<Variant>::decode_open_type(core::BitReader& reader)
+        requires (Variant::aligned)
+    {
+        // Open type (X.691, 10.2): определитель длины + выровненные октеты вложенной кодировки
+        return decode_octet_string_view(reader);
+    }
+
+    template <PerVariant Variant>
+    Result<std::string_view> BasicPerDecoder<Variant>::decode_ia5_string_view(core::BitReader& reader, std::optional<size_t> fixed_size)
+        requires (Variant::aligned)
+    {
+        // Та же раскладка, что и в decode_ia5_string: длина + выровненные 8-битные символы
+        auto bytes = decode_octet_string_view(reader, fixed_size);
+        if (!bytes) return std::unexpected(bytes.error());
+
+        return std::string_view(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+    }
+
+    template <PerVariant Variant>
+    Result<OidView> BasicPerDecoder<Variant>::decode_oid_view(core::BitReader& reader)
+        requires (Variant::aligned)
+    {
+        auto bytes = decode_octet_string_view(reader);
+        if (!bytes) return std::unexpected(bytes.error());
+
+        // Последняя дуга должна завершаться байтом без бита продолжения,
+        // иначе итератор OidView вышел бы за пределы содержимого
+        if (!bytes->empty() && (static_cast<uint8_t>(bytes->back()) & 0x80)) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Truncated OID arc" });
+        }
+        return OidView(*bytes);
+    }
+
+    template class BasicPerDecoder<Aligned>;
+    template class BasicPerDecoder<Unaligned>;
+
 } // namespace h323_26::asn1
@@ -1,44 +1,64 @@
 ﻿#include <h323_26/core/bit_reader.hpp>
-#include <algorithm>
+#include <h323_26/core/octet_kernels.hpp>
+#include <cstring>
 
 namespace h323_26::core {
 
     Result<uint64_t> BitReader::read_bits(size_t count) {
+        auto value = peek_bits(count);
+        if (value) bit_offset_ += count;
+        return value;
+    }
+
+    Result<uint64_t> BitReader::peek_bits(size_t count) const {
         if (count > 64) {
             return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Max 64 bits" });
         }
         if (count > bits_left()) {
             return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
         }
+        if (count == 0) return 0;
 
-        uint64_t result = 0;
-
-        while (count > 0) {
-            size_t byte_idx = bit_offset_ / 8;
-            size_t bit_in_byte_offset = bit_offset_ % 8;
-            size_t bits_to_read_in_current_byte = std::min(count, 8 - bit_in_byte_offset);
-
-            // Достаем нужные биты из текущего байта
-            uint8_t byte = static_cast<uint8_t>(data_[byte_idx]);
-            uint8_t mask = (1 << bits_to_read_in_current_byte) - 1;
-            uint8_t shift = 8 - bit_in_byte_offset - bits_to_read_in_current_byte;
+        return peek_unchecked(count);
+    }
 
-            uint64_t val = (byte >> shift) & mask;
+    Result<void> BitReader::skip_bits(size_t count) {
+        if (count > bits_left()) {
+            return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+        }
+        bit_offset_ += count;
+        return {};
+    }
 
-            // Сдвигаем результат и добавляем новые биты
-            result = (result << bits_to_read_in_current_byte) | val;
+    Result<void> BitReader::read_bytes(std::span<std::byte> out) {
+        if (out.size() > bits_left() / 8) {
+            return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+        }
+        if (out.empty()) return {};
 
-            bit_offset_ += bits_to_read_in_current_byte;
-            count -= bits_to_read_in_current_byte;
+        if (bit_offset_ % 8 == 0) {
+            std::memcpy(out.data(), data_.data() + bit_offset_ / 8, out.size());
+            bit_offset_ += out.size() * 8;
+            return {};
         }
 
-        return result;
+        // Невыровненный поток: сдвиг октетов векторным ядром (SSE2/AVX2 или скалярным)
+        octet_kernels().copy_shifted(out.data(), data_.data() + bit_offset_ / 8, out.size(), bit_offset_ % 8);
+        bit_offset_ += out.size() * 8;
+        return {};
     }
 
-    void BitReader::align_to_byte() {
+    Result<std::span<const std::byte>> BitReader::view_bytes(size_t count) {
         if (bit_offset_ % 8 != 0) {
-            bit_offset_ += (8 - (bit_offset_ % 8));
+            return std::unexpected(Error{ ErrorCode::AlignmentError, "View requires byte-aligned cursor" });
         }
+        if (count > bits_left() / 8) {
+            return std::unexpected(Error{ ErrorCode::EndOfStream, "Not enough bits" });
+        }
+
+        auto view = data_.subspan(bit_offset_ / 8, count);
+        bit_offset_ += count * 8;
+        return view;
     }
 
 } // namespace h323_26
@@ -1,7 +1,26 @@
 ﻿#include <h323_26/core/bit_writer.hpp>
+#include <bit>
+#include <cstring>
 
 namespace h323_26::core {
 
+    void BitWriter::put_bits(uint64_t value, size_t count) {
+        size_t byte_idx = bit_offset_ / 8;
+        size_t used = bit_offset_ % 8;
+
+        bit_offset_ += count;
+        buffer_.resize((bit_offset_ + 7) / 8);
+
+        // Собираем 64-битное слово: занятые биты текущего байта + новое значение (MSB first)
+        uint64_t word = (static_cast<uint64_t>(buffer_[byte_idx]) << 56) | (value << (64 - used - count));
+        if constexpr (std::endian::native == std::endian::little) {
+            word = std::byteswap(word);
+        }
+
+        // Сбрасываем слово в буфер одним копированием
+        std::memcpy(buffer_.data() + byte_idx, &word, buffer_.size() - byte_idx);
+    }
+
     Result<void> BitWriter::write_bits(uint64_t value, size_t count) {
         if (count == 0) return {};
         if (count > 64) return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Max 64 bits" });
@@ -9,36 +28,44 @@ namespace h323_26::core {
         // Маскируем значение, чтобы не было мусора выше count
         if (count < 64) value &= (1ULL << count) - 1;
 
-        for (size_t i = 0; i < count; ++i) {
-            size_t byte_idx = bit_offset_ / 8;
-            size_t bit_in_byte = bit_offset_ % 8;
-
-            // Если буфер закончился, добавляем новый байт
-            if (byte_idx >= buffer_.size()) {
-                buffer_.push_back(std::byte{ 0 });
-            }
+        if (bit_offset_ % 8 + count > 64) {
+            // Не помещается в одно слово вместе с хвостом байта: старшие биты, затем младшие 32
+            put_bits(value >> 32, count - 32);
+            put_bits(value & 0xFFFFFFFFULL, 32);
+        }
+        else {
+            put_bits(value, count);
+        }
+        return {};
+    }
 
-            // Вытаскиваем нужный бит из value (начиная с MSB для ASN.1)
-            uint64_t bit = (value >> (count - 1 - i)) & 1;
+    Result<void> BitWriter::write_bytes(std::span<const std::byte> bytes) {
+        if (bit_offset_ % 8 == 0) {
+            buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+            bit_offset_ += bytes.size() * 8;
+            return {};
+        }
 
-            if (bit) {
-                uint8_t shift = 7 - bit_in_byte;
-                buffer_[byte_idx] |= static_cast<std::byte>(1 << shift);
+        // Без точного reserve: resize в put_bits растит буфер геометрически,
+        // а резерв ровно под вызов перевыделял бы его на каждом write_bytes
+        size_t i = 0;
+        for (; i + 8 <= bytes.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            if constexpr (std::endian::native == std::endian::little) {
+                word = std::byteswap(word);
             }
-            bit_offset_++;
+            (void)write_bits(word, 64);
+        }
+        for (; i < bytes.size(); ++i) {
+            put_bits(static_cast<uint64_t>(bytes[i]), 8);
         }
         return {};
     }
 
     void BitWriter::align_to_byte() {
-        if (bit_offset_ % 8 != 0) {
-            bit_offset_ += (8 - (bit_offset_ % 8));
-            // ГАРАНТИРУЕМ, что вектор расширился до этого байта
-            size_t needed_bytes = (bit_offset_ + 7) / 8;
-            while (buffer_.size() < needed_bytes) {
-                buffer_.push_back(std::byte{ 0 });
-            }
-        }
+        // Хвостовой байт уже лежит в буфере (дополненный нулями) — достаточно сдвинуть счетчик
+        bit_offset_ = buffer_.size() * 8;
     }
 
 } // namespace h323_26::core
@@ -0,0 +1,72 @@
+﻿#include <h323_26/core/fixed_bit_writer.hpp>
+#include <bit>
+#include <cstring>
+
+namespace h323_26::core {
+
+    void FixedBitWriter::put_bits(uint64_t value, size_t count) {
+        size_t byte_idx = bit_offset_ / 8;
+        size_t used = bit_offset_ % 8;
+
+        bit_offset_ += count;
+
+        // Байт с занятыми битами уже наш; новые байты перезаписываются целиком,
+        // поэтому буфер вызывающей стороны не нужно предварительно обнулять
+        uint64_t word = value << (64 - used - count);
+        if (used != 0) {
+            word |= static_cast<uint64_t>(buffer_[byte_idx]) << 56;
+        }
+        if constexpr (std::endian::native == std::endian::little) {
+            word = std::byteswap(word);
+        }
+        std::memcpy(buffer_.data() + byte_idx, &word, byte_size() - byte_idx);
+    }
+
+    Result<void> FixedBitWriter::write_bits(uint64_t value, size_t count) {
+        if (count == 0) return {};
+        if (count > 64) return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Max 64 bits" });
+        if ((bit_offset_ + count + 7) / 8 > buffer_.size()) {
+            return std::unexpected(Error{ ErrorCode::BufferOverflow, "Output buffer is full" });
+        }
+
+        if (count < 64) value &= (1ULL << count) - 1;
+
+        if (bit_offset_ % 8 + count > 64) {
+            put_bits(value >> 32, count - 32);
+            put_bits(value & 0xFFFFFFFFULL, 32);
+        }
+        else {
+            put_bits(value, count);
+        }
+        return {};
+    }
+
+    Result<void> FixedBitWriter::write_bytes(std::span<const std::byte> bytes) {
+        if ((bit_offset_ + bytes.size() * 8 + 7) / 8 > buffer_.size()) {
+            return std::unexpected(Error{ ErrorCode::BufferOverflow, "Output buffer is full" });
+        }
+        if (bytes.empty()) return {};
+
+        if (bit_offset_ % 8 == 0) {
+            std::memcpy(buffer_.data() + bit_offset_ / 8, bytes.data(), bytes.size());
+            bit_offset_ += bytes.size() * 8;
+            return {};
+        }
+
+        size_t i = 0;
+        for (; i + 8 <= bytes.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            if constexpr (std::endian::native == std::endian::little) {
+                word = std::byteswap(word);
+            }
+            put_bits(word >> 32, 32);
+            put_bits(word & 0xFFFFFFFFULL, 32);
+        }
+        for (; i < bytes.size(); ++i) {
+            put_bits(static_cast<uint64_t>(bytes[i]), 8);
+        }
+        return {};
+    }
+
+} // namespace h323_26::core
@@ -0,0 +1,294 @@
+﻿#include <h323_26/core/octet_kernels.hpp>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define H323_26_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define H323_26_TARGET_AVX2
+#else
+#define H323_26_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace h323_26::core {
+
+    namespace {
+
+        constexpr std::array<bool, 256> PrintableTable = [] {
+            std::array<bool, 256> table{};
+            for (size_t c = 0; c < 128; ++c) table[c] = is_printable_char(static_cast<char>(c));
+            return table;
+        }();
+
+        // ---------------- Скалярные реализации (и хвосты векторных) ----------------
+
+        void copy_shifted_scalar(std::byte* dst, const std::byte* src, size_t count, unsigned shift) {
+            for (size_t i = 0; i < count; ++i) {
+                auto hi = static_cast<unsigned>(src[i]) << shift;
+                auto lo = static_cast<unsigned>(src[i + 1]) >> (8 - shift);
+                dst[i] = static_cast<std::byte>(hi | lo);
+            }
+        }
+
+        bool is_ia5_scalar(const char* data, size_t count) {
+            unsigned char bits = 0;
+            for (size_t i = 0; i < count; ++i) bits |= static_cast<unsigned char>(data[i]);
+            return bits < 128;
+        }
+
+        bool is_printable_scalar(const char* data, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (!PrintableTable[static_cast<unsigned char>(data[i])]) return false;
+            }
+            return true;
+        }
+
+        size_t utf16be_to_utf8_scalar(const std::byte* src, size_t units, char* out) {
+            char* start = out;
+            for (size_t i = 0; i < units; ++i) {
+                auto unit = static_cast<uint32_t>((static_cast<unsigned>(src[2 * i]) << 8) | static_cast<unsigned>(src[2 * i + 1]));
+                if (unit < 0x80) {
+                    *out++ = static_cast<char>(unit);
+                }
+                else if (unit < 0x800) {
+                    *out++ = static_cast<char>(0xC0 | (unit >> 6));
+                    *out++ = static_cast<char>(0x80 | (unit & 0x3F));
+                }
+                else if (unit >= 0xD800 && unit <= 0xDFFF) {
+                    return Utf16Invalid;
+                }
+                else {
+                    *out++ = static_cast<char>(0xE0 | (unit >> 12));
+                    *out++ = static_cast<char>(0x80 | ((unit >> 6) & 0x3F));
+                    *out++ = static_cast<char>(0x80 | (unit & 0x3F));
+                }
+            }
+            return static_cast<size_t>(out - start);
+        }
+
+        constexpr OctetKernels ScalarKernels{
+            KernelSet::scalar, &copy_shifted_scalar, &is_ia5_scalar, &is_printable_scalar, &utf16be_to_utf8_scalar
+        };
+
+#ifdef H323_26_KERNELS_X86
+
+        // ---------------- SSE2: 16 октетов за шаг ----------------
+
+        void copy_shifted_sse2(std::byte* dst, const std::byte* src, size_t count, unsigned shift) {
+            // Сдвиг по октетам через 16-битные сдвиги и маску: биты, перешедшие из соседнего октета, отсекаются
+            const __m128i left = _mm_cvtsi32_si128(static_cast<int>(shift));
+            const __m128i right = _mm_cvtsi32_si128(static_cast<int>(8 - shift));
+            const __m128i hi_mask = _mm_set1_epi8(static_cast<char>(0xFF << shift));
+            const __m128i lo_mask = _mm_set1_epi8(static_cast<char>(0xFF >> (8 - shift)));
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 1));
+                __m128i hi = _mm_and_si128(_mm_sll_epi16(cur, left), hi_mask);
+                __m128i lo = _mm_and_si128(_mm_srl_epi16(next, right), lo_mask);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(hi, lo));
+            }
+            copy_shifted_scalar(dst + i, src + i, count - i, shift);
+        }
+
+        bool is_ia5_sse2(const char* data, size_t count) {
+            __m128i bits = _mm_setzero_si128();
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                bits = _mm_or_si128(bits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+            }
+            return _mm_movemask_epi8(bits) == 0 && is_ia5_scalar(data + i, count - i);
+        }
+
+        // Октеты lo..hi (как знаковые: октеты от 0x80 отрицательны и в диапазоны не попадают)
+        inline __m128i in_range_sse2(__m128i x, char lo, char hi) {
+            return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                _mm_cmplt_epi8(x, _mm_set1_epi8(static_cast<char>(hi + 1))));
+        }
+
+        bool is_printable_sse2(const char* data, size_t count) {
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                __m128i ok = _mm_or_si128(in_range_sse2(x, 'A', 'Z'), in_range_sse2(x, 'a', 'z'));
+                ok = _mm_or_si128(ok, in_range_sse2(x, '0', '9'));
+                ok = _mm_or_si128(ok, in_range_sse2(x, '\'', ')'));
+                ok = _mm_or_si128(ok, in_range_sse2(x, '+', '/'));
+                ok = _mm_or_si128(ok, _mm_cmpeq_epi8(x, _mm_set1_epi8(' ')));
+                ok = _mm_or_si128(ok, _mm_cmpeq_epi8(x, _mm_set1_epi8(':')));
+                ok = _mm_or_si128(ok, _mm_cmpeq_epi8(x, _mm_set1_epi8('=')));
+                ok = _mm_or_si128(ok, _mm_cmpeq_epi8(x, _mm_set1_epi8('?')));
+                if (_mm_movemask_epi8(ok) != 0xFFFF) return false;
+            }
+            return is_printable_scalar(data + i, count - i);
+        }
+
+        // Блоки по 16 символов из ASCII упаковываются в 16 октетов; прочие — скалярно
+        size_t utf16be_to_utf8_sse2(const std::byte* src, size_t units, char* out) {
+            // В 16-битной ячейке (little-endian загрузка) старший октет символа — младшие 8 бит
+            const __m128i non_ascii = _mm_set1_epi16(static_cast<short>(0x80FF));
+            char* start = out;
+            size_t i = 0;
+            while (i + 16 <= units) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i + 16));
+                __m128i wide = _mm_and_si128(_mm_or_si128(a, b), non_ascii);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(wide, _mm_setzero_si128())) == 0xFFFF) {
+                    __m128i packed = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+                    out += 16;
+                }
+                else {
+                    size_t written = utf16be_to_utf8_scalar(src + 2 * i, 16, out);
+                    if (written == Utf16Invalid) return Utf16Invalid;
+                    out += written;
+                }
+                i += 16;
+            }
+            size_t written = utf16be_to_utf8_scalar(src + 2 * i, units - i, out);
+            if (written == Utf16Invalid) return Utf16Invalid;
+            return static_cast<size_t>(out - start) + written;
+        }
+
+        constexpr OctetKernels Sse2Kernels{
+            KernelSet::sse2, &copy_shifted_sse2, &is_ia5_sse2, &is_printable_sse2, &utf16be_to_utf8_sse2
+        };
+
+        // ---------------- AVX2: 32 октета за шаг ----------------
+
+        H323_26_TARGET_AVX2 void copy_shifted_avx2(std::byte* dst, const std::byte* src, size_t count, unsigned shift) {
+            const __m128i left = _mm_cvtsi32_si128(static_cast<int>(shift));
+            const __m128i right = _mm_cvtsi32_si128(static_cast<int>(8 - shift));
+            const __m256i hi_mask = _mm256_set1_epi8(static_cast<char>(0xFF << shift));
+            const __m256i lo_mask = _mm256_set1_epi8(static_cast<char>(0xFF >> (8 - shift)));
+
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32) {
+                __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 1));
+                __m256i hi = _mm256_and_si256(_mm256_sll_epi16(cur, left), hi_mask);
+                __m256i lo = _mm256_and_si256(_mm256_srl_epi16(next, right), lo_mask);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(hi, lo));
+            }
+            _mm256_zeroupper();
+            copy_shifted_sse2(dst + i, src + i, count - i, shift);
+        }
+
+        H323_26_TARGET_AVX2 bool is_ia5_avx2(const char* data, size_t count) {
+            __m256i bits = _mm256_setzero_si256();
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32) {
+                bits = _mm256_or_si256(bits, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            }
+            bool ascii = _mm256_movemask_epi8(bits) == 0;
+            _mm256_zeroupper();
+            return ascii && is_ia5_sse2(data + i, count - i);
+        }
+
+        H323_26_TARGET_AVX2 inline __m256i in_range_avx2(__m256i x, char lo, char hi) {
+            return _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), x));
+        }
+
+        H323_26_TARGET_AVX2 bool is_printable_avx2(const char* data, size_t count) {
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32) {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i ok = _mm256_or_si256(in_range_avx2(x, 'A', 'Z'), in_range_avx2(x, 'a', 'z'));
+                ok = _mm256_or_si256(ok, in_range_avx2(x, '0', '9'));
+                ok = _mm256_or_si256(ok, in_range_avx2(x, '\'', ')'));
+                ok = _mm256_or_si256(ok, in_range_avx2(x, '+', '/'));
+                ok = _mm256_or_si256(ok, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')));
+                ok = _mm256_or_si256(ok, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(':')));
+                ok = _mm256_or_si256(ok, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('=')));
+                ok = _mm256_or_si256(ok, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('?')));
+                if (_mm256_movemask_epi8(ok) != -1) return false;
+            }
+            _mm256_zeroupper();
+            return is_printable_sse2(data + i, count - i);
+        }
+
+        H323_26_TARGET_AVX2 size_t utf16be_to_utf8_avx2(const std::byte* src, size_t units, char* out) {
+            const __m256i non_ascii = _mm256_set1_epi16(static_cast<short>(0x80FF));
+            char* start = out;
+            size_t i = 0;
+            while (i + 32 <= units) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i + 32));
+                __m256i wide = _mm256_and_si256(_mm256_or_si256(a, b), non_ascii);
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(wide, _mm256_setzero_si256())) == -1) {
+                    // packus работает по 128-битным половинам — восстанавливаем порядок четвертей
+                    __m256i packed = _mm256_packus_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+                    packed = _mm256_permute4x64_epi64(packed, 0xD8);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+                    out += 32;
+                }
+                else {
+                    // Переход к коду SSE без vzeroupper стоит сотни тактов на каждом вызове
+                    _mm256_zeroupper();
+                    size_t written = utf16be_to_utf8_sse2(src + 2 * i, 32, out);
+                    if (written == Utf16Invalid) return Utf16Invalid;
+                    out += written;
+                }
+                i += 32;
+            }
+            _mm256_zeroupper();
+            size_t written = utf16be_to_utf8_sse2(src + 2 * i, units - i, out);
+            if (written == Utf16Invalid) return Utf16Invalid;
+            return static_cast<size_t>(out - start) + written;
+        }
+
+        constexpr OctetKernels Avx2Kernels{
+            KernelSet::avx2, &copy_shifted_avx2, &is_ia5_avx2, &is_printable_avx2, &utf16be_to_utf8_avx2
+        };
+
+        bool cpu_has_avx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+            __cpuid(info, 1);
+            // OSXSAVE и AVX: регистры YMM сохраняются ОС
+            if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+            if ((_xgetbv(0) & 0x6) != 0x6) return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+
+#endif // H323_26_KERNELS_X86
+
+    } // namespace
+
+    const OctetKernels* octet_kernels(KernelSet set) {
+        switch (set) {
+        case KernelSet::scalar:
+            return &ScalarKernels;
+#ifdef H323_26_KERNELS_X86
+        case KernelSet::sse2:
+            return &Sse2Kernels;
+        case KernelSet::avx2:
+            return cpu_has_avx2() ? &Avx2Kernels : nullptr;
+#endif
+        default:
+            return nullptr;
+        }
+    }
+
+    const OctetKernels& octet_kernels() {
+        static const OctetKernels& selected = []() -> const OctetKernels& {
+            for (auto set : { KernelSet::avx2, KernelSet::sse2 }) {
+                if (const auto* kernels = octet_kernels(set)) return *kernels;
+            }
+            return ScalarKernels;
+        }();
+        return selected;
+    }
+
+} // namespace h323_26::core
@@ -0,0 +1,137 @@
+﻿#include <h323_26/core/timing_wheel.hpp>
+#include <algorithm>
+#include <bit>
+
+namespace h323_26::core {
+
+    TimingWheel::TimingWheel(const Config& config, Clock::time_point now)
+        : origin_(now), tick_(std::max(config.tick, Clock::duration{ 1 })) {
+        heads_.fill(nil);
+        nodes_.reserve(config.capacity);
+    }
+
+    uint64_t TimingWheel::tick_of(Clock::time_point t) const {
+        if (t <= origin_) return 0;
+        return static_cast<uint64_t>((t - origin_) / tick_);
+    }
+
+    TimingWheel::TimerId TimingWheel::arm(Clock::time_point deadline, uint64_t payload) {
+        uint32_t index = free_;
+        if (index != nil) {
+            free_ = nodes_[index].next;
+        }
+        else {
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+
+        // Срок округляется вверх до тика и не раньше следующего тика: таймер не
+        // сработает досрочно и не попадет в уже пройденный слот
+        Node& node = nodes_[index];
+        uint64_t ticks = 0;
+        if (deadline > origin_) {
+            const auto span = deadline - origin_;
+            ticks = static_cast<uint64_t>(span / tick_) + (span % tick_ != Clock::duration::zero() ? 1 : 0);
+        }
+        node.deadline = std::max(ticks, current_ + 1);
+        node.payload = payload;
+        node.armed = true;
+        place(index);
+        ++size_;
+        return TimerId{ index, node.generation };
+    }
+
+    bool TimingWheel::cancel(TimerId id) {
+        if (id.index >= nodes_.size()) return false;
+        Node& node = nodes_[id.index];
+        if (!node.armed || node.generation != id.generation) return false;
+        release(id.index);
+        return true;
+    }
+
+    void TimingWheel::place(uint32_t index) {
+        Node& node = nodes_[index];
+
+        // Уровень — старшая группа бит, в которой срок расходится с текущим тиком:
+        // все старшие группы совпадают, поэтому слот гарантированно впереди.
+        // Срок за пределами 64^6 тиков ждет в списке overflow до смены старшего блока
+        const uint64_t diff = node.deadline ^ current_;
+        const size_t level = diff == 0 ? 0 : (std::bit_width(diff) - 1) / slot_bits;
+        size_t list = overflow;
+        if (level < levels) {
+            const size_t slot = (node.deadline >> (level * slot_bits)) % slots;
+            list = level * slots + slot;
+            occupied_[level] |= uint64_t{ 1 } << slot;
+        }
+
+        node.slot = static_cast<uint16_t>(list);
+        node.prev = nil;
+        node.next = heads_[list];
+        if (node.next != nil) nodes_[node.next].prev = index;
+        heads_[list] = index;
+    }
+
+    void TimingWheel::unlink(uint32_t index) {
+        Node& node = nodes_[index];
+        if (node.prev != nil) nodes_[node.prev].next = node.next;
+        else heads_[node.slot] = node.next;
+        if (node.next != nil) nodes_[node.next].prev = node.prev;
+        if (heads_[node.slot] == nil && node.slot != overflow) occupied_[node.slot / slots] &= ~(uint64_t{ 1 } << (node.slot % slots));
+    }
+
+    void TimingWheel::release(uint32_t index) {
+        unlink(index);
+        Node& node = nodes_[index];
+        node.armed = false;
+        ++node.generation;
+        node.next = free_;
+        free_ = index;
+        --size_;
+    }
+
+    void TimingWheel::replace_list(size_t list) {
+        uint32_t index = heads_[list];
+        heads_[list] = nil;
+        if (list != overflow) occupied_[list / slots] &= ~(uint64_t{ 1 } << (list % slots));
+        while (index != nil) {
+            const uint32_t next = nodes_[index].next;
+            place(index);
+            index = next;
+        }
+    }
+
+    void TimingWheel::cascade() {
+        // Сверху вниз: таймер, спустившийся с уровня L на границе, сразу же
+        // раскладывается и уровнем ниже
+        if ((current_ & (horizon - 1)) == 0) replace_list(overflow);
+        for (size_t level = levels - 1; level > 0; --level) {
+            const size_t shift = level * slot_bits;
+            if (current_ & ((uint64_t{ 1 } << shift) - 1)) continue;
+            replace_list(level * slots + (current_ >> shift) % slots);
+        }
+    }
+
+    uint64_t TimingWheel::next_event() const {
+        // На каждом уровне — ближайший занятый слот впереди текущего; его начало
+        // и есть момент раскладки (или срабатывания на уровне 0)
+        uint64_t best = UINT64_MAX;
+        if (heads_[overflow] != nil) best = (current_ & ~(horizon - 1)) + horizon;
+        for (size_t level = 0; level < levels; ++level) {
+            const size_t shift = level * slot_bits;
+            const size_t position = (current_ >> shift) % slots;
+            const uint64_t ahead = position + 1 < slots ? occupied_[level] & (~uint64_t{ 0 } << (position + 1)) : 0;
+            if (ahead == 0) continue;
+
+            const uint64_t block = current_ >> (shift + slot_bits) << (shift + slot_bits);
+            best = std::min(best, block | (static_cast<uint64_t>(std::countr_zero(ahead)) << shift));
+        }
+        return best;
+    }
+
+    TimingWheel::Clock::time_point TimingWheel::next_wakeup() const {
+        const uint64_t next = next_event();
+        if (next == UINT64_MAX) return Clock::time_point::max();
+        return origin_ + tick_ * static_cast<int64_t>(next);
+    }
+
+} // namespace h323_26::core
@@ -0,0 +1,78 @@
+﻿#include <h323_26/core/worker_pool.hpp>
+#include <algorithm>
+
+namespace h323_26::core {
+
+    WorkerPool::WorkerPool(size_t threads) {
+        threads_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) thread.join();
+    }
+
+    void WorkerPool::run(Task task, void* ctx, size_t count, size_t grain) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+
+        // Делить не с кем или нечего: куски по порядку без синхронизации
+        if (threads_.empty() || count <= grain) {
+            for (size_t begin = 0; begin < count; begin += grain) {
+                task(ctx, begin, std::min(begin + grain, count));
+            }
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            task_ = task;
+            ctx_ = ctx;
+            count_ = count;
+            grain_ = grain;
+            next_.store(0, std::memory_order_relaxed);
+            busy_ = threads_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        work();
+
+        // Результаты фоновых потоков видны после их отметки под mutex_
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return busy_ == 0; });
+    }
+
+    void WorkerPool::work() {
+        for (;;) {
+            size_t begin = next_.fetch_add(grain_, std::memory_order_relaxed);
+            if (begin >= count_) return;
+            task_(ctx_, begin, std::min(begin + grain_, count_));
+        }
+    }
+
+    void WorkerPool::worker_loop() {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+
+            work();
+
+            std::lock_guard lock(mutex_);
+            if (--busy_ == 0) done_.notify_one();
+        }
+    }
+
+} // namespace h323_26::core
@@ -0,0 +1,252 @@
+﻿#include <h323_26/gk/prefix_routes.hpp>
+#include <algorithm>
+#include <bit>
+#include <thread>
+#include <variant>
+
+namespace h323_26::gk {
+
+    namespace {
+
+        constexpr uint8_t not_a_digit = 0xFF;
+
+        // Символы dialedDigits: цифры -> 0..9, '#' -> 10, '*' -> 11, ',' -> 12
+        constexpr std::array<uint8_t, 256> digit_codes = [] {
+            std::array<uint8_t, 256> codes{};
+            codes.fill(not_a_digit);
+            for (int c = 0; c < 10; ++c) codes['0' + c] = static_cast<uint8_t>(c);
+            codes['#'] = 10;
+            codes['*'] = 11;
+            codes[','] = 12;
+            return codes;
+        }();
+
+        constexpr char digit_chars[] = "0123456789#*,";
+
+        uint8_t code_of(char c) {
+            return digit_codes[static_cast<unsigned char>(c)];
+        }
+
+        // Слот счетчиков читателей для текущего потока
+        size_t reader_slot() {
+            static std::atomic<size_t> next{ 0 };
+            thread_local const size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+            return slot;
+        }
+
+    } // namespace
+
+    bool PrefixRoutes::CodeLess::operator()(const std::string& a, const std::string& b) const {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+            [](char x, char y) { return code_of(x) < code_of(y); });
+    }
+
+    Result<void> PrefixRoutes::check_prefix(std::string_view prefix, Route route) {
+        if (route == no_route) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Route value is reserved" });
+        }
+        if (!std::ranges::all_of(prefix, [](char c) { return code_of(c) != not_a_digit; })) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Prefix is not a dialedDigits string" });
+        }
+        return {};
+    }
+
+    std::optional<PrefixRoutes::Match> PrefixRoutes::lookup(std::string_view digits) const {
+        std::atomic<int64_t>* counters = readers_[reader_slot() % reader_slots].active.data();
+
+        for (;;) {
+            const uint32_t current = current_.load(std::memory_order_seq_cst);
+            counters[current].fetch_add(1, std::memory_order_seq_cst);
+            if (current_.load(std::memory_order_seq_cst) != current) {
+                // publish() успел переключить буфер: этот мог уже начать перестраиваться
+                counters[current].fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            std::optional<Match> best;
+            const auto& nodes = buffers_[current];
+            if (!nodes.empty()) {
+                const Node* node = &nodes[0];
+                if (node->route != no_route) best = Match{ node->route, 0 };
+                for (size_t i = 0; i < digits.size(); ++i) {
+                    const uint8_t code = code_of(digits[i]);
+                    if (code == not_a_digit || !((node->children >> code) & 1)) break;
+                    const unsigned rank = std::popcount(static_cast<unsigned>(node->children) & ((1u << code) - 1));
+                    node = &nodes[node->first_child + rank];
+                    if (node->route != no_route) best = Match{ node->route, i + 1 };
+                }
+            }
+
+            counters[current].fetch_sub(1, std::memory_order_release);
+            return best;
+        }
+    }
+
+    std::optional<PrefixRoutes::Match> PrefixRoutes::lookup(const h225::AliasAddress& alias) const {
+        if (const auto* digits = std::get_if<h225::DialedDigits>(&alias)) return lookup(digits->digits);
+        return std::nullopt;
+    }
+
+    void PrefixRoutes::append_item(std::string_view prefix, Route route) {
+        items_.push_back(Item{ static_cast<uint32_t>(pool_.size()), static_cast<uint32_t>(prefix.size()), route });
+        for (char c : prefix) pool_.push_back(code_of(c));
+    }
+
+    Result<void> PrefixRoutes::load(std::span<const Entry> entries) {
+        for (const Entry& entry : entries) {
+            if (auto res = check_prefix(entry.prefix, entry.route); !res) return res;
+        }
+
+        std::lock_guard lock(writer_);
+        pending_.clear();
+        pool_.clear();
+        items_.clear();
+        items_.reserve(entries.size());
+        for (const Entry& entry : entries) append_item(entry.prefix, entry.route);
+
+        // Устойчивая сортировка: из повторов остается последний
+        auto codes = [this](const Item& item) {
+            return std::span<const uint8_t>(pool_.data() + item.offset, item.length);
+        };
+        std::ranges::stable_sort(items_, [&](const Item& a, const Item& b) {
+            return std::ranges::lexicographical_compare(codes(a), codes(b));
+        });
+        auto last = std::unique(items_.rbegin(), items_.rend(), [&](const Item& a, const Item& b) {
+            return std::ranges::equal(codes(a), codes(b));
+        });
+        items_.erase(items_.begin(), last.base());
+
+        const uint32_t next = 1 - current_.load(std::memory_order_relaxed);
+        build(buffers_[next]);
+        swap_in(buffers_[next]);
+        return {};
+    }
+
+    Result<void> PrefixRoutes::insert(std::string_view prefix, Route route) {
+        if (auto res = check_prefix(prefix, route); !res) return res;
+        std::lock_guard lock(writer_);
+        pending_.insert_or_assign(std::string(prefix), route);
+        return {};
+    }
+
+    Result<void> PrefixRoutes::erase(std::string_view prefix) {
+        if (auto res = check_prefix(prefix, 0); !res) return res;
+        std::lock_guard lock(writer_);
+        pending_.insert_or_assign(std::string(prefix), no_route);
+        return {};
+    }
+
+    void PrefixRoutes::collect_published() {
+        // Обход в глубину по возрастанию кодов дает префиксы уже отсортированными
+        pool_.clear();
+        items_.clear();
+        const auto& nodes = buffers_[current_.load(std::memory_order_relaxed)];
+        if (nodes.empty()) return;
+
+        struct Frame { uint32_t node; uint8_t next_code; };
+        std::vector<Frame> stack{ Frame{ 0, 0 } };
+        std::vector<uint8_t> path;
+        if (nodes[0].route != no_route) items_.push_back(Item{ 0, 0, nodes[0].route });
+
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            const Node& node = nodes[frame.node];
+            uint8_t code = frame.next_code;
+            while (code < 16 && !((node.children >> code) & 1)) ++code;
+            if (code >= 16) {
+                stack.pop_back();
+                if (!path.empty()) path.pop_back();
+                continue;
+            }
+
+            frame.next_code = static_cast<uint8_t>(code + 1);
+            const unsigned rank = std::popcount(static_cast<unsigned>(node.children) & ((1u << code) - 1));
+            const uint32_t child = node.first_child + rank;
+            path.push_back(code);
+            if (nodes[child].route != no_route) {
+                items_.push_back(Item{ static_cast<uint32_t>(pool_.size()), static_cast<uint32_t>(path.size()), nodes[child].route });
+                pool_.insert(pool_.end(), path.begin(), path.end());
+            }
+            stack.push_back(Frame{ child, 0 });
+        }
+    }
+
+    void PrefixRoutes::publish() {
+        std::lock_guard lock(writer_);
+        if (pending_.empty()) return;
+
+        collect_published();
+
+        // Слияние двух отсортированных последовательностей: опубликованной и изменений
+        std::vector<Item> merged;
+        merged.reserve(items_.size() + pending_.size());
+        auto codes = [this](const Item& item) {
+            return std::span<const uint8_t>(pool_.data() + item.offset, item.length);
+        };
+
+        auto published = items_.begin();
+        for (const auto& [prefix, route] : pending_) {
+            const auto change = static_cast<uint32_t>(pool_.size());
+            for (char c : prefix) pool_.push_back(code_of(c));
+            std::span<const uint8_t> key(pool_.data() + change, prefix.size());
+
+            while (published != items_.end() && std::ranges::lexicographical_compare(codes(*published), key)) {
+                merged.push_back(*published++);
+            }
+            if (published != items_.end() && std::ranges::equal(codes(*published), key)) ++published;
+            if (route != no_route) merged.push_back(Item{ change, static_cast<uint32_t>(prefix.size()), route });
+        }
+        merged.insert(merged.end(), published, items_.end());
+        items_ = std::move(merged);
+        pending_.clear();
+
+        const uint32_t next = 1 - current_.load(std::memory_order_relaxed);
+        build(buffers_[next]);
+        swap_in(buffers_[next]);
+    }
+
+    void PrefixRoutes::build(std::vector<Node>& nodes) {
+        const uint32_t next = static_cast<uint32_t>(&nodes - buffers_.data());
+
+        // Буфер мог остаться активным у читателей прошлого поколения: ждем их ухода
+        for (;;) {
+            int64_t inside = 0;
+            for (const auto& slot : readers_) inside += slot.active[next].load(std::memory_order_seq_cst);
+            if (inside == 0) break;
+            std::this_thread::yield();
+        }
+
+        // Уровни строятся по очереди задач: узел получает своих детей одним блоком
+        struct Task { uint32_t lo, hi, depth, node; };
+        std::vector<Task> tasks;
+        tasks.reserve(pool_.size() + 1);
+        nodes.clear();
+        nodes.reserve(pool_.size() + 1);
+        nodes.emplace_back();
+        tasks.push_back(Task{ 0, static_cast<uint32_t>(items_.size()), 0, 0 });
+
+        for (size_t t = 0; t < tasks.size(); ++t) {
+            auto [lo, hi, depth, index] = tasks[t];
+            Node node;
+            if (lo < hi && items_[lo].length == depth) node.route = items_[lo++].route;
+
+            node.first_child = static_cast<uint32_t>(nodes.size());
+            while (lo < hi) {
+                const uint8_t code = pool_[items_[lo].offset + depth];
+                uint32_t end = lo;
+                while (end < hi && pool_[items_[end].offset + depth] == code) ++end;
+                node.children |= static_cast<uint16_t>(1u << code);
+                tasks.push_back(Task{ lo, end, depth + 1, static_cast<uint32_t>(nodes.size()) });
+                nodes.emplace_back();
+                lo = end;
+            }
+            nodes[index] = node;
+        }
+        size_.store(items_.size(), std::memory_order_relaxed);
+    }
+
+    void PrefixRoutes::swap_in(std::vector<Node>& nodes) {
+        current_.store(static_cast<uint32_t>(&nodes - buffers_.data()), std::memory_order_seq_cst);
+    }
+
+} // namespace h323_26::gk
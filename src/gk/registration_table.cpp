@@ -0,0 +1,629 @@
+﻿#include <h323_26/gk/registration_table.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <thread>
+#include <variant>
+
+namespace h323_26::gk {
+
+    namespace {
+
+        constexpr uint64_t empty_slot = 0;
+        constexpr uint64_t deleted_slot = 1;
+
+        // meta слота индекса: индекс записи и generation набора ключей.
+        // generation 0 — ключ endpointIdentifier: он удаляется явно и не устаревает
+        constexpr uint64_t make_meta(uint32_t index, uint32_t generation) {
+            return (static_cast<uint64_t>(generation) << 32) | index;
+        }
+        constexpr uint32_t index_of(uint64_t meta) { return static_cast<uint32_t>(meta); }
+        constexpr uint32_t generation_of(uint64_t meta) { return static_cast<uint32_t>(meta >> 32); }
+
+        constexpr uint32_t next_generation(uint32_t generation) {
+            return generation + 1 == 0 ? 1 : generation + 1;
+        }
+
+        // generation a старше b (по модулю 2^32)
+        constexpr bool older(uint32_t a, uint32_t b) {
+            return static_cast<int32_t>(b - a) > 0;
+        }
+
+        uint64_t pack_address(const h225::TransportAddress& address) {
+            uint32_t ip = 0;
+            std::memcpy(&ip, address.ip.data(), sizeof(ip));
+            return (static_cast<uint64_t>(ip) << 16) | address.port;
+        }
+
+        h225::TransportAddress unpack_address(uint64_t word) {
+            h225::TransportAddress address{ .ip = {}, .port = static_cast<uint16_t>(word) };
+            const auto ip = static_cast<uint32_t>(word >> 16);
+            std::memcpy(address.ip.data(), &ip, sizeof(ip));
+            return address;
+        }
+
+        uint64_t fmix64(uint64_t x) {
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ULL;
+            x ^= x >> 33;
+            return x;
+        }
+
+        // Две независимые 64-битные свертки за один проход по тексту
+        void hash_text(char kind, std::string_view text, uint64_t& a, uint64_t& b) {
+            a = 0x9E3779B97F4A7C15ULL ^ (static_cast<uint64_t>(static_cast<unsigned char>(kind)) << 56) ^ text.size();
+            b = 0xC2B2AE3D27D4EB4FULL + (static_cast<uint64_t>(static_cast<unsigned char>(kind)) << 48) + text.size();
+
+            auto mix = [&](uint64_t word) {
+                a = std::rotl((a ^ word) * 0x87c37b91114253d5ULL, 31);
+                b = std::rotl((b + word) * 0x4cf5ad432745937fULL, 27) ^ a;
+            };
+
+            size_t i = 0;
+            for (; i + 8 <= text.size(); i += 8) {
+                uint64_t word;
+                std::memcpy(&word, text.data() + i, sizeof(word));
+                mix(word);
+            }
+            if (i < text.size()) {
+                uint64_t word = 0;
+                std::memcpy(&word, text.data() + i, text.size() - i);
+                mix(word);
+            }
+            a = fmix64(a);
+            b = fmix64(b + a);
+        }
+
+        // Снимок данных под seqlock: fn повторяется, пока версия не совпадет до и после
+        template <typename Fn>
+        auto read_consistent(const std::atomic<uint32_t>& version, Fn&& fn) {
+            for (;;) {
+                const uint32_t before = version.load(std::memory_order_acquire);
+                if (before & 1) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                auto value = fn();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (version.load(std::memory_order_relaxed) == before) return value;
+            }
+        }
+
+        // Запись под seqlock; писатели уже сериализованы внешним замком
+        class WriteSection {
+        public:
+            explicit WriteSection(std::atomic<uint32_t>& version)
+                : version_(version), start_(version.load(std::memory_order_relaxed)) {
+                version_.store(start_ + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+            ~WriteSection() { version_.store(start_ + 2, std::memory_order_release); }
+
+            WriteSection(const WriteSection&) = delete;
+            WriteSection& operator=(const WriteSection&) = delete;
+
+        private:
+            std::atomic<uint32_t>& version_;
+            uint32_t start_;
+        };
+
+        constexpr auto relaxed = std::memory_order_relaxed;
+
+    } // namespace
+
+    // Отпечаток ключа и ссылка на запись: 24 байта, читаются атомарно по словам
+    struct RegistrationTable::KeySlot {
+        std::atomic<uint64_t> hash{ empty_slot };
+        std::atomic<uint64_t> check{ 0 };
+        std::atomic<uint64_t> meta{ 0 };
+    };
+
+    struct alignas(64) RegistrationTable::Shard {
+        std::atomic<uint32_t> version{ 0 }; // seqlock слотов
+        uint32_t used = 0;                  // Непустые слоты, включая удаленные; под lock
+        size_t mask = 0;
+        std::unique_ptr<KeySlot[]> slots;
+        std::mutex lock;
+    };
+
+    // Запись — одна кэш-линия: seqlock, спин-замок писателей и шесть слов данных
+    struct alignas(64) RegistrationTable::Record {
+        std::atomic<uint32_t> version{ 0 };
+        std::atomic<uint32_t> writer{ 0 };
+        std::atomic<uint64_t> owner{ 0 };       // hash ключа endpointIdentifier
+        std::atomic<uint64_t> state{ 0 };       // generation | live << 32
+        std::atomic<uint64_t> call_signal{ 0 };
+        std::atomic<uint64_t> ras{ 0 };
+        std::atomic<int64_t> expires{ 0 };      // Clock::duration от эпохи часов
+        std::atomic<uint64_t> limits{ 0 };      // timeToLive << 32 | bandwidth
+    };
+
+    struct RegistrationTable::RecordState {
+        uint64_t owner = 0;
+        uint32_t generation = 0;
+        bool live = false;
+        h225::TransportAddress callSignalAddress{};
+        h225::TransportAddress rasAddress{};
+        Clock::duration expires{ 0 };
+        uint32_t timeToLive = 0;
+        uint32_t bandwidth = 0;
+
+        Registration snapshot(uint32_t index) const {
+            return Registration{
+                .endpoint = { index, generation },
+                .callSignalAddress = callSignalAddress,
+                .rasAddress = rasAddress,
+                .timeToLive = timeToLive,
+                .bandwidth = bandwidth,
+                .expires = Clock::time_point(expires)
+            };
+        }
+    };
+
+    RegistrationTable::RegistrationTable(const Config& config)
+        : capacity_(config.endpoints),
+          shard_mask_(std::bit_ceil(std::max<size_t>(config.shards, 1)) - 1),
+          shards_(std::make_unique<Shard[]>(shard_mask_ + 1)),
+          records_(std::make_unique<Record[]>(config.endpoints)) {
+        // Заполнение индекса не выше половины: короткие цепочки проб и запас под
+        // ключи перерегистраций, пока старые не переиспользованы
+        const size_t keys = config.endpoints * std::max<size_t>(config.keys_per_endpoint, 1);
+        const size_t slots = std::bit_ceil(std::max<size_t>(keys * 2 / (shard_mask_ + 1), 16));
+        for (size_t i = 0; i <= shard_mask_; ++i) {
+            shards_[i].mask = slots - 1;
+            shards_[i].slots = std::make_unique<KeySlot[]>(slots);
+        }
+
+        free_.reserve(capacity_);
+        for (size_t i = capacity_; i > 0; --i) free_.push_back(static_cast<uint32_t>(i - 1));
+    }
+
+    RegistrationTable::~RegistrationTable() = default;
+
+    RegistrationTable::Key RegistrationTable::endpoint_key(std::string_view endpointIdentifier) {
+        Key key{};
+        hash_text('E', endpointIdentifier, key.hash, key.check);
+        if (key.hash <= deleted_slot) key.hash += 2;
+        return key;
+    }
+
+    RegistrationTable::Key RegistrationTable::alias_key(const h225::AliasAddress& alias) {
+        Key key{};
+        std::visit([&](const auto& value) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(value)>, h225::DialedDigits>) {
+                hash_text('D', value.digits, key.hash, key.check);
+            }
+            else {
+                hash_text('H', value.name, key.hash, key.check);
+            }
+        }, alias);
+        if (key.hash <= deleted_slot) key.hash += 2;
+        return key;
+    }
+
+    RegistrationTable::Shard& RegistrationTable::shard_of(const Key& key) const {
+        // Старшие биты выбирают шард, младшие — начало пробы внутри него
+        return shards_[(key.hash >> 40) & shard_mask_];
+    }
+
+    RegistrationTable::RecordState RegistrationTable::read_record(uint32_t index) const {
+        const Record& record = records_[index];
+        return read_consistent(record.version, [&record]() -> RecordState {
+            const uint64_t state = record.state.load(relaxed);
+            const uint64_t limits = record.limits.load(relaxed);
+            return RecordState{
+                .owner = record.owner.load(relaxed),
+                .generation = static_cast<uint32_t>(state),
+                .live = ((state >> 32) & 1) != 0,
+                .callSignalAddress = unpack_address(record.call_signal.load(relaxed)),
+                .rasAddress = unpack_address(record.ras.load(relaxed)),
+                .expires = Clock::duration(record.expires.load(relaxed)),
+                .timeToLive = static_cast<uint32_t>(limits >> 32),
+                .bandwidth = static_cast<uint32_t>(limits)
+            };
+        });
+    }
+
+    void RegistrationTable::write_record(uint32_t index, const RecordState& state) {
+        Record& record = records_[index];
+        WriteSection section(record.version);
+        record.owner.store(state.owner, relaxed);
+        record.state.store(state.generation | (static_cast<uint64_t>(state.live) << 32), relaxed);
+        record.call_signal.store(pack_address(state.callSignalAddress), relaxed);
+        record.ras.store(pack_address(state.rasAddress), relaxed);
+        record.expires.store(state.expires.count(), relaxed);
+        record.limits.store((static_cast<uint64_t>(state.timeToLive) << 32) | state.bandwidth, relaxed);
+    }
+
+    void RegistrationTable::lock_record(uint32_t index) {
+        auto& writer = records_[index].writer;
+        while (writer.exchange(1, std::memory_order_acquire) != 0) {
+            while (writer.load(relaxed) != 0) std::this_thread::yield();
+        }
+    }
+
+    void RegistrationTable::unlock_record(uint32_t index) {
+        records_[index].writer.store(0, std::memory_order_release);
+    }
+
+    bool RegistrationTable::is_stale(uint64_t meta) const {
+        const uint32_t generation = generation_of(meta);
+        if (generation == 0) return false;
+        if (index_of(meta) >= capacity_) return true;
+        return older(generation, read_record(index_of(meta)).generation);
+    }
+
+    std::optional<uint32_t> RegistrationTable::allocate_record() {
+        std::lock_guard lock(free_lock_);
+        if (free_.empty()) return std::nullopt;
+        uint32_t index = free_.back();
+        free_.pop_back();
+        return index;
+    }
+
+    void RegistrationTable::free_record(uint32_t index) {
+        std::lock_guard lock(free_lock_);
+        free_.push_back(index);
+    }
+
+    std::optional<uint32_t> RegistrationTable::lookup_endpoint(const Key& key) const {
+        const Shard& shard = shard_of(key);
+        return read_consistent(shard.version, [&]() -> std::optional<uint32_t> {
+            for (size_t i = key.hash & shard.mask, n = 0; n <= shard.mask; ++n, i = (i + 1) & shard.mask) {
+                const KeySlot& slot = shard.slots[i];
+                const uint64_t hash = slot.hash.load(relaxed);
+                if (hash == empty_slot) break;
+                if (hash != key.hash || slot.check.load(relaxed) != key.check) continue;
+
+                const uint64_t meta = slot.meta.load(relaxed);
+                if (generation_of(meta) == 0 && index_of(meta) < capacity_) return index_of(meta);
+            }
+            return std::nullopt;
+        });
+    }
+
+    std::optional<Registration> RegistrationTable::lookup_alias(const Key& key) const {
+        const Shard& shard = shard_of(key);
+        return read_consistent(shard.version, [&]() -> std::optional<Registration> {
+            // Рядом с действующим ключом могут лежать устаревшие и ожидающие копии
+            // того же ключа: подходит та, чей generation совпадает с записью
+            for (size_t i = key.hash & shard.mask, n = 0; n <= shard.mask; ++n, i = (i + 1) & shard.mask) {
+                const KeySlot& slot = shard.slots[i];
+                const uint64_t hash = slot.hash.load(relaxed);
+                if (hash == empty_slot) break;
+                if (hash != key.hash || slot.check.load(relaxed) != key.check) continue;
+
+                const uint64_t meta = slot.meta.load(relaxed);
+                const uint32_t generation = generation_of(meta);
+                if (generation == 0 || index_of(meta) >= capacity_) continue;
+
+                auto state = read_record(index_of(meta));
+                if (state.live && state.generation == generation) return state.snapshot(index_of(meta));
+            }
+            return std::nullopt;
+        });
+    }
+
+    Result<void> RegistrationTable::insert_locked(Shard& shard, const Key& key, uint64_t meta) {
+        if (shard.used + 1 > (shard.mask + 1) * 3 / 4) rebuild_locked(shard);
+
+        std::optional<size_t> free_slot;
+        for (size_t i = key.hash & shard.mask, n = 0; n <= shard.mask; ++n, i = (i + 1) & shard.mask) {
+            KeySlot& slot = shard.slots[i];
+            const uint64_t hash = slot.hash.load(relaxed);
+            if (hash == empty_slot) {
+                if (!free_slot) free_slot = i;
+                break;
+            }
+            if (hash == deleted_slot) {
+                if (!free_slot) free_slot = i;
+                continue;
+            }
+
+            const uint64_t current = slot.meta.load(relaxed);
+            const bool stale = is_stale(current);
+            if (!stale && hash == key.hash && slot.check.load(relaxed) == key.check) {
+                if (index_of(current) != index_of(meta)) {
+                    return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Alias is registered by another endpoint" });
+                }
+                // Тот же псевдоним дважды в одном RRQ
+                if (current == meta) return {};
+            }
+            if (stale && !free_slot) free_slot = i;
+        }
+
+        if (!free_slot) {
+            return std::unexpected(Error{ ErrorCode::BufferOverflow, "Registration index shard is full" });
+        }
+
+        KeySlot& slot = shard.slots[*free_slot];
+        if (slot.hash.load(relaxed) == empty_slot) ++shard.used;
+        WriteSection section(shard.version);
+        slot.hash.store(key.hash, relaxed);
+        slot.check.store(key.check, relaxed);
+        slot.meta.store(meta, relaxed);
+        return {};
+    }
+
+    void RegistrationTable::erase_locked(Shard& shard, const Key& key, uint64_t meta) {
+        for (size_t i = key.hash & shard.mask, n = 0; n <= shard.mask; ++n, i = (i + 1) & shard.mask) {
+            KeySlot& slot = shard.slots[i];
+            const uint64_t hash = slot.hash.load(relaxed);
+            if (hash == empty_slot) return;
+            if (hash == key.hash && slot.check.load(relaxed) == key.check && slot.meta.load(relaxed) == meta) {
+                WriteSection section(shard.version);
+                slot.hash.store(deleted_slot, relaxed);
+                return;
+            }
+        }
+    }
+
+    bool RegistrationTable::erase_owner_locked(Shard& shard, uint64_t owner, uint32_t index) {
+        // Ключ endpointIdentifier записи index: отпечаток целиком не нужен, meta уникальна
+        const uint64_t meta = make_meta(index, 0);
+        for (size_t i = owner & shard.mask, n = 0; n <= shard.mask; ++n, i = (i + 1) & shard.mask) {
+            KeySlot& slot = shard.slots[i];
+            const uint64_t hash = slot.hash.load(relaxed);
+            if (hash == empty_slot) return false;
+            if (hash == owner && slot.meta.load(relaxed) == meta) {
+                WriteSection section(shard.version);
+                slot.hash.store(deleted_slot, relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void RegistrationTable::rebuild_locked(Shard& shard) {
+        // Удаленные и устаревшие слоты выбрасываются, живые раскладываются заново
+        struct Entry { uint64_t hash, check, meta; };
+        std::vector<Entry> live;
+        for (size_t i = 0; i <= shard.mask; ++i) {
+            const KeySlot& slot = shard.slots[i];
+            const uint64_t hash = slot.hash.load(relaxed);
+            if (hash == empty_slot || hash == deleted_slot) continue;
+            const uint64_t meta = slot.meta.load(relaxed);
+            if (!is_stale(meta)) live.push_back(Entry{ hash, slot.check.load(relaxed), meta });
+        }
+
+        WriteSection section(shard.version);
+        for (size_t i = 0; i <= shard.mask; ++i) shard.slots[i].hash.store(empty_slot, relaxed);
+        for (const Entry& entry : live) {
+            size_t i = entry.hash & shard.mask;
+            while (shard.slots[i].hash.load(relaxed) != empty_slot) i = (i + 1) & shard.mask;
+            shard.slots[i].hash.store(entry.hash, relaxed);
+            shard.slots[i].check.store(entry.check, relaxed);
+            shard.slots[i].meta.store(entry.meta, relaxed);
+        }
+        shard.used = static_cast<uint32_t>(live.size());
+    }
+
+    Result<void> RegistrationTable::insert_key(const Key& key, uint64_t meta) {
+        Shard& shard = shard_of(key);
+        std::lock_guard lock(shard.lock);
+        return insert_locked(shard, key, meta);
+    }
+
+    void RegistrationTable::erase_key(const Key& key, uint64_t meta) {
+        Shard& shard = shard_of(key);
+        std::lock_guard lock(shard.lock);
+        erase_locked(shard, key, meta);
+    }
+
+    Result<EndpointRef> RegistrationTable::register_endpoint(
+        std::string_view endpointIdentifier,
+        std::span<const h225::AliasAddress> aliases,
+        const EndpointInfo& info,
+        Clock::time_point now)
+    {
+        const Key endpoint = endpoint_key(endpointIdentifier);
+
+        for (;;) {
+            // Запись конечной точки: найденная по endpointIdentifier или новая
+            uint32_t index = 0;
+            bool created = false;
+            {
+                Shard& shard = shard_of(endpoint);
+                std::lock_guard lock(shard.lock);
+                if (auto found = lookup_endpoint(endpoint)) {
+                    index = *found;
+                }
+                else {
+                    auto fresh = allocate_record();
+                    if (!fresh) return std::unexpected(Error{ ErrorCode::BufferOverflow, "Registration table is full" });
+                    if (auto res = insert_locked(shard, endpoint, make_meta(*fresh, 0)); !res) {
+                        free_record(*fresh);
+                        return std::unexpected(res.error());
+                    }
+                    index = *fresh;
+                    created = true;
+                }
+            }
+
+            // Замок записи берется только после замка шарда: под замком записи
+            // вставляются псевдонимы, то есть берутся замки шардов
+            lock_record(index);
+            RecordState state = read_record(index);
+            if (created) {
+                state.owner = endpoint.hash;
+            }
+            else if (state.owner != endpoint.hash) {
+                // Запись успели снять (URQ) и, возможно, отдать другой конечной точке,
+                // или ее создает параллельный RRQ и еще не назначил владельца
+                unlock_record(index);
+                continue;
+            }
+
+            // Новый набор псевдонимов вставляется с будущим generation и невидим для
+            // читателей, пока запись не получит этот generation
+            const uint32_t generation = next_generation(state.generation);
+            size_t inserted = 0;
+            Result<void> res;
+            for (; inserted < aliases.size(); ++inserted) {
+                res = insert_key(alias_key(aliases[inserted]), make_meta(index, generation));
+                if (!res) break;
+            }
+
+            if (!res) {
+                for (size_t i = 0; i < inserted; ++i) erase_key(alias_key(aliases[i]), make_meta(index, generation));
+                if (created) {
+                    // Запись создана этим вызовом: откатываем ее вместе с ключом endpointIdentifier
+                    erase_key(endpoint, make_meta(index, 0));
+                    state.owner = 0;
+                    write_record(index, state);
+                    unlock_record(index);
+                    free_record(index);
+                }
+                else {
+                    unlock_record(index);
+                }
+                return std::unexpected(res.error());
+            }
+
+            const bool registered = state.live;
+            state.generation = generation;
+            state.live = true;
+            state.callSignalAddress = info.callSignalAddress;
+            state.rasAddress = info.rasAddress;
+            state.timeToLive = info.timeToLive;
+            state.expires = (now + std::chrono::seconds(info.timeToLive)).time_since_epoch();
+            if (!registered) state.bandwidth = 0;
+            write_record(index, state);
+            unlock_record(index);
+
+            if (!registered) size_.fetch_add(1, relaxed);
+            return EndpointRef{ index, generation };
+        }
+    }
+
+    Result<void> RegistrationTable::refresh(EndpointRef endpoint, Clock::time_point now) {
+        if (endpoint.index >= capacity_) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Endpoint is not registered" });
+        }
+
+        lock_record(endpoint.index);
+        RecordState state = read_record(endpoint.index);
+        if (!state.live || state.generation != endpoint.generation) {
+            unlock_record(endpoint.index);
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Endpoint is not registered" });
+        }
+        state.expires = (now + std::chrono::seconds(state.timeToLive)).time_since_epoch();
+        write_record(endpoint.index, state);
+        unlock_record(endpoint.index);
+        return {};
+    }
+
+    bool RegistrationTable::unregister(std::string_view endpointIdentifier) {
+        const Key endpoint = endpoint_key(endpointIdentifier);
+
+        uint32_t index = 0;
+        {
+            Shard& shard = shard_of(endpoint);
+            std::lock_guard lock(shard.lock);
+            auto found = lookup_endpoint(endpoint);
+            if (!found) return false;
+            index = *found;
+            erase_locked(shard, endpoint, make_meta(index, 0));
+        }
+
+        // Псевдонимы не удаляются по одному: новый generation делает их устаревшими
+        lock_record(index);
+        RecordState state = read_record(index);
+        const bool registered = state.live;
+        state.owner = 0;
+        state.live = false;
+        state.generation = next_generation(state.generation);
+        state.bandwidth = 0;
+        write_record(index, state);
+        unlock_record(index);
+
+        free_record(index);
+        if (registered) size_.fetch_sub(1, relaxed);
+        return true;
+    }
+
+    bool RegistrationTable::expire(EndpointRef endpoint, Clock::time_point now) {
+        if (endpoint.index >= capacity_) return false;
+
+        // Срок проверяется под замком записи, и замок держится до снятия ключа
+        // (порядок «запись, затем шард» — как у register_endpoint):
+        // конкурирующий refresh() или RRQ либо успеет продлить запись, либо увидит ее снятой
+        lock_record(endpoint.index);
+        RecordState state = read_record(endpoint.index);
+        if (!state.live || state.generation != endpoint.generation || Clock::time_point(state.expires) > now) {
+            unlock_record(endpoint.index);
+            return false;
+        }
+
+        // Ключ endpointIdentifier снимает и запись освобождает кто-то один: если ключ
+        // уже снял unregister(), запись освободит он
+        bool erased = false;
+        {
+            Shard& shard = shard_of(Key{ state.owner, 0 });
+            std::lock_guard lock(shard.lock);
+            erased = erase_owner_locked(shard, state.owner, endpoint.index);
+        }
+        if (!erased) {
+            unlock_record(endpoint.index);
+            return false;
+        }
+
+        state.owner = 0;
+        state.live = false;
+        state.generation = next_generation(state.generation);
+        state.bandwidth = 0;
+        write_record(endpoint.index, state);
+        unlock_record(endpoint.index);
+
+        free_record(endpoint.index);
+        size_.fetch_sub(1, relaxed);
+        return true;
+    }
+
+    Result<uint32_t> RegistrationTable::adjust_bandwidth(EndpointRef endpoint, int64_t delta, uint32_t limit) {
+        if (endpoint.index >= capacity_) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Endpoint is not registered" });
+        }
+
+        lock_record(endpoint.index);
+        RecordState state = read_record(endpoint.index);
+        if (!state.live || state.generation != endpoint.generation) {
+            unlock_record(endpoint.index);
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Endpoint is not registered" });
+        }
+
+        const int64_t total = std::max<int64_t>(0, static_cast<int64_t>(state.bandwidth) + delta);
+        if (delta > 0 && total > limit) {
+            unlock_record(endpoint.index);
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "Bandwidth limit exceeded" });
+        }
+        state.bandwidth = static_cast<uint32_t>(total);
+        write_record(endpoint.index, state);
+        unlock_record(endpoint.index);
+        return state.bandwidth;
+    }
+
+    std::optional<Registration> RegistrationTable::find_endpoint(std::string_view endpointIdentifier) const {
+        const Key endpoint = endpoint_key(endpointIdentifier);
+        auto index = lookup_endpoint(endpoint);
+        if (!index) return std::nullopt;
+
+        auto state = read_record(*index);
+        if (!state.live || state.owner != endpoint.hash) return std::nullopt;
+        return state.snapshot(*index);
+    }
+
+    std::optional<Registration> RegistrationTable::find_alias(const h225::AliasAddress& alias) const {
+        return lookup_alias(alias_key(alias));
+    }
+
+    std::optional<Registration> RegistrationTable::find(EndpointRef endpoint) const {
+        if (endpoint.index >= capacity_) return std::nullopt;
+        auto state = read_record(endpoint.index);
+        if (!state.live || state.generation != endpoint.generation) return std::nullopt;
+        return state.snapshot(endpoint.index);
+    }
+
+} // namespace h323_26::gk
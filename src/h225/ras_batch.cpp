@@ -0,0 +1,78 @@
+﻿#include <h323_26/h225/ras_batch.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <variant>
+
+namespace h323_26::h225 {
+
+    RasBatchDecoder::RasBatchDecoder(std::pmr::memory_resource* mr, core::WorkerPool* workers, size_t grain)
+        : mr_(mr), workers_(workers), grain_(grain) {
+        headers_.status.reserve(default_batch);
+        headers_.type.reserve(default_batch);
+        headers_.requestSeqNum.reserve(default_batch);
+        messages_.reserve(default_batch);
+    }
+
+    template <typename Fn>
+    void RasBatchDecoder::for_each_chunk(size_t count, Fn&& fn) {
+        auto chunk = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) fn(i);
+        };
+        if (workers_) workers_->parallel_for(count, grain_, chunk);
+        else chunk(0, count);
+    }
+
+    void RasBatchDecoder::peek_one(size_t i, std::span<const std::byte> datagram) {
+        auto header = RasPDU::peek(datagram);
+        if (!header) {
+            headers_.status[i] = header.error().code;
+            return;
+        }
+        headers_.status[i] = ErrorCode::Success;
+        headers_.type[i] = header->type;
+        headers_.requestSeqNum[i] = header->requestSeqNum.value_or(0);
+    }
+
+    void RasBatchDecoder::decode_one(size_t i, std::span<const std::byte> datagram) {
+        auto& slot = messages_[i];
+        core::BitReader reader(datagram);
+        if (slot) {
+            // Сообщение прошлого пакета на этой позиции: перезаписываем на месте
+            if (auto res = RasPDU::decode_into(*slot, reader, mr_); !res) {
+                headers_.status[i] = res.error().code;
+                return;
+            }
+        }
+        else {
+            auto msg = RasPDU::decode(reader, mr_);
+            if (!msg) {
+                headers_.status[i] = msg.error().code;
+                return;
+            }
+            slot.emplace(std::move(*msg));
+        }
+
+        headers_.status[i] = ErrorCode::Success;
+        headers_.type[i] = RasPDU::type_of(*slot);
+        headers_.requestSeqNum[i] = std::visit([](const auto& body) -> uint16_t {
+            if constexpr (requires { body.requestSeqNum; }) return body.requestSeqNum;
+            else return 0;
+        }, *slot);
+    }
+
+    const RasBatchHeaders& RasBatchDecoder::peek(Datagrams datagrams) {
+        headers_.resize(datagrams.size());
+        decoded_ = 0;
+        for_each_chunk(datagrams.size(), [&](size_t i) { peek_one(i, datagrams[i]); });
+        return headers_;
+    }
+
+    const RasBatchHeaders& RasBatchDecoder::decode(Datagrams datagrams) {
+        headers_.resize(datagrams.size());
+        // Сообщения за концом пакета остаются на случай следующего, большего пакета
+        if (messages_.size() < datagrams.size()) messages_.resize(datagrams.size());
+        for_each_chunk(datagrams.size(), [&](size_t i) { decode_one(i, datagrams[i]); });
+        decoded_ = datagrams.size();
+        return headers_;
+    }
+
+} // namespace h323_26::h225
@@ -0,0 +1,99 @@
+﻿#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/asn1/per_decoder.hpp>
+#include <array>
+#include <limits>
+
+namespace h323_26::h225 {
+
+    namespace {
+
+        // Первое по порядку в схеме идентифицирующее поле сообщения
+        template <typename M>
+        constexpr RasIdentifierKind first_identifier() {
+            constexpr size_t none = std::numeric_limits<size_t>::max();
+            size_t gatekeeper = none;
+            size_t endpoint = none;
+            if constexpr (requires { &M::gatekeeperIdentifier; }) {
+                gatekeeper = M::Schema::template field_index<&M::gatekeeperIdentifier>;
+            }
+            if constexpr (requires { &M::endpointIdentifier; }) {
+                endpoint = M::Schema::template field_index<&M::endpointIdentifier>;
+            }
+
+            if (gatekeeper == none && endpoint == none) return RasIdentifierKind::none;
+            return gatekeeper < endpoint ? RasIdentifierKind::gatekeeperIdentifier : RasIdentifierKind::endpointIdentifier;
+        }
+
+        template <typename M, auto Member>
+        Result<void> peek_identifier(core::BitReader body, RasIdentifierKind kind, RasHeader& out) {
+            auto value = M::Schema::template decode_field<Member, asn1::BmpStringView>(body);
+            if (!value) return std::unexpected(value.error());
+            if (*value) {
+                out.identifierKind = kind;
+                out.identifier = **value;
+            }
+            return {};
+        }
+
+        // body стоит на начале тела сообщения (после индекса CHOICE / внутри open type)
+        template <typename M>
+        Result<void> peek_body(core::BitReader body, bool with_identifier, RasHeader& out) {
+            if constexpr (requires { &M::requestSeqNum; }) {
+                static_assert(M::Schema::template field_index<&M::requestSeqNum> == 0, "requestSeqNum must lead the message");
+
+                // За маркером расширения и преамбулой — номер в двух выровненных октетах
+                core::BitReader seq = body;
+                if (auto res = seq.skip_bits(M::Schema::header_bits); !res) return res;
+                auto value = RequestSeqNum::decode_value<uint16_t>(seq, asn1::DecodeContext{});
+                if (!value) return std::unexpected(value.error());
+                out.requestSeqNum = *value;
+            }
+
+            if (with_identifier) {
+                constexpr auto kind = first_identifier<M>();
+                if constexpr (kind == RasIdentifierKind::gatekeeperIdentifier) {
+                    return peek_identifier<M, &M::gatekeeperIdentifier>(body, kind, out);
+                }
+                else if constexpr (kind == RasIdentifierKind::endpointIdentifier) {
+                    return peek_identifier<M, &M::endpointIdentifier>(body, kind, out);
+                }
+            }
+            return {};
+        }
+
+        using PeekFn = Result<void>(*)(core::BitReader, bool, RasHeader&);
+
+        template <typename Variant>
+        struct PeekTable;
+
+        template <typename... Messages>
+        struct PeekTable<std::variant<Messages...>> {
+            static constexpr std::array<PeekFn, sizeof...(Messages)> entries{ &peek_body<Messages>... };
+        };
+
+    } // namespace
+
+    Result<RasHeader> RasPDU::peek(std::span<const std::byte> datagram, bool with_identifier) {
+        const auto& table = PeekTable<RasMessage>::entries;
+
+        core::BitReader reader(datagram);
+        auto index = Choice::decode_index(reader);
+        if (!index) return std::unexpected(index.error());
+        if (*index >= table.size()) {
+            return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Unknown CHOICE extension addition" });
+        }
+
+        RasHeader header{ .type = static_cast<RasMessageType>(*index) };
+        core::BitReader body = reader;
+        if (*index >= root_count) {
+            // Тело дополнения завернуто в open type
+            auto contents = asn1::PerDecoder::decode_open_type(reader);
+            if (!contents) return std::unexpected(contents.error());
+            body = core::BitReader(*contents);
+        }
+
+        if (auto res = table[*index](body, with_identifier, header); !res) return std::unexpected(res.error());
+        return header;
+    }
+
+} // namespace h323_26::h225
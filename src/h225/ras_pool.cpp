@@ -0,0 +1,38 @@
+﻿#include <h323_26/h225/ras_pool.hpp>
+#include <h323_26/core/bit_reader.hpp>
+
+namespace h323_26::h225 {
+
+    Result<RasMessage*> RasMessagePool::decode(std::span<const std::byte> datagram) {
+        core::BitReader reader(datagram);
+        auto index = RasPDU::Choice::decode_index(reader);
+        if (!index) return std::unexpected(index.error());
+        if (*index >= slots_.size()) {
+            return std::unexpected(Error{ ErrorCode::UnsupportedFeature, "Unknown CHOICE extension addition" });
+        }
+
+        const asn1::DecodeContext ctx{ mr_ };
+        auto& slot = slots_[*index];
+        if (slot) {
+            // Сообщение этого типа уже было: перезаписываем его на месте
+            auto res = RasPDU::Choice::decode_alternative_into(*index, *slot, reader, ctx);
+            if (!res) return std::unexpected(res.error());
+        }
+        else {
+            auto msg = RasPDU::Choice::decode_alternative<RasMessage>(*index, reader, ctx);
+            if (!msg) return std::unexpected(msg.error());
+            slot.emplace(std::move(*msg));
+        }
+        return &*slot;
+    }
+
+    void RasMessagePool::clear() {
+        for (auto& slot : slots_) slot.reset();
+    }
+
+    RasMessagePool& RasMessagePool::local() {
+        thread_local RasMessagePool pool;
+        return pool;
+    }
+
+} // namespace h323_26::h225
@@ -0,0 +1,112 @@
+﻿#include <h323_26/h225/ras_reply_cache.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace h323_26::h225 {
+
+    RasReplyCache::RasReplyCache(const Config& config)
+        // Длина в слоте хранится в uint16_t: больший предел молча усекал бы ее
+        : max_reply_(std::min<size_t>(config.max_reply, UINT16_MAX)), ttl_(config.ttl) {
+        const size_t entries = std::bit_ceil(std::max(config.entries, ways));
+        bucket_mask_ = entries / ways - 1;
+        slots_.resize(entries);
+        arena_.resize(entries * max_reply_);
+    }
+
+    std::optional<RasReplyKey> RasReplyCache::key_of(const RasHeader& header, const TransportAddress& source) {
+        if (!header.requestSeqNum) return std::nullopt;
+        return RasReplyKey{ .source = source, .type = header.type, .requestSeqNum = *header.requestSeqNum };
+    }
+
+    uint64_t RasReplyCache::address_of(const RasReplyKey& key) {
+        uint32_t ip = 0;
+        for (std::byte octet : key.source.ip) ip = (ip << 8) | static_cast<uint32_t>(octet);
+        return (static_cast<uint64_t>(ip) << 16) | key.source.port;
+    }
+
+    uint32_t RasReplyCache::request_of(const RasReplyKey& key) {
+        return (static_cast<uint32_t>(key.type) << 16) | key.requestSeqNum;
+    }
+
+    size_t RasReplyCache::bucket_of(uint64_t address, uint32_t request) const {
+        // Перемешивание (splitmix64): соседние номера и адреса расходятся по корзинам
+        uint64_t h = address * 0x9E3779B97F4A7C15ULL ^ request;
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 27;
+        return (static_cast<size_t>(h) & bucket_mask_) * ways;
+    }
+
+    std::optional<std::span<const std::byte>> RasReplyCache::find(const RasReplyKey& key, Clock::time_point now) {
+        const uint64_t address = address_of(key);
+        const uint32_t request = request_of(key);
+        const size_t first = bucket_of(address, request);
+        for (size_t i = first; i < first + ways; ++i) {
+            const Slot& slot = slots_[i];
+            if (slot.used && slot.address == address && slot.request == request && now - slot.stored <= ttl_) {
+                ++stats_.hits;
+                return std::span<const std::byte>(payload(i).first(slot.length));
+            }
+        }
+        ++stats_.misses;
+        return std::nullopt;
+    }
+
+    size_t RasReplyCache::claim(const RasReplyKey& key, Clock::time_point now) {
+        const uint64_t address = address_of(key);
+        const uint32_t request = request_of(key);
+        const size_t first = bucket_of(address, request);
+
+        // Сначала прежний ответ на тот же запрос: ключ не должен занять корзину дважды
+        for (size_t i = first; i < first + ways; ++i) {
+            const Slot& slot = slots_[i];
+            if (slot.used && slot.address == address && slot.request == request) return i;
+        }
+
+        size_t victim = first;
+        for (size_t i = first; i < first + ways; ++i) {
+            const Slot& slot = slots_[i];
+            if (!slot.used) return i;
+            if (slot.stored < slots_[victim].stored) victim = i;
+        }
+        if (now - slots_[victim].stored <= ttl_) ++stats_.evicted;
+        return victim;
+    }
+
+    bool RasReplyCache::store(const RasReplyKey& key, std::span<const std::byte> reply, Clock::time_point now) {
+        if (reply.size() > max_reply_) return false;
+
+        const size_t i = claim(key, now);
+        if (!reply.empty()) std::memcpy(payload(i).data(), reply.data(), reply.size());
+        slots_[i] = Slot{ .address = address_of(key), .request = request_of(key),
+            .length = static_cast<uint16_t>(reply.size()), .used = true, .stored = now };
+        ++stats_.stored;
+        return true;
+    }
+
+    Result<std::span<const std::byte>> RasReplyCache::encode(const RasReplyKey& key, const RasMessage& reply, Clock::time_point now) {
+        // Размер проверяется до выбора слота: отказ не вытесняет чужой ответ
+        auto size = RasPDU::encoded_size(reply);
+        if (!size) return std::unexpected(size.error());
+        if (*size > max_reply_) {
+            return std::unexpected(Error{ ErrorCode::BufferOverflow, "RAS reply exceeds the cache slot" });
+        }
+
+        const size_t i = claim(key, now);
+        slots_[i].used = false;
+        auto written = RasPDU::encode_into(payload(i), reply);
+        if (!written) return std::unexpected(written.error());
+
+        slots_[i] = Slot{ .address = address_of(key), .request = request_of(key),
+            .length = static_cast<uint16_t>(*written), .used = true, .stored = now };
+        ++stats_.stored;
+        return std::span<const std::byte>(payload(i).first(*written));
+    }
+
+    void RasReplyCache::clear() {
+        std::ranges::fill(slots_, Slot{});
+    }
+
+} // namespace h323_26::h225
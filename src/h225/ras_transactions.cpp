@@ -0,0 +1,115 @@
+﻿#include <h323_26/h225/ras_transactions.hpp>
+#include <utility>
+
+namespace h323_26::h225 {
+
+    namespace {
+
+        // Подтверждение и отказ, которыми отвечают на запрос; у остальных сообщений
+        // (nonStandardMessage и сами ответы) парного ответа нет
+        std::optional<std::pair<RasMessageType, RasMessageType>> responses_of(RasMessageType request) {
+            using T = RasMessageType;
+            switch (request) {
+            case T::gatekeeperRequest: return std::pair{ T::gatekeeperConfirm, T::gatekeeperReject };
+            case T::registrationRequest: return std::pair{ T::registrationConfirm, T::registrationReject };
+            case T::unregistrationRequest: return std::pair{ T::unregistrationConfirm, T::unregistrationReject };
+            case T::admissionRequest: return std::pair{ T::admissionConfirm, T::admissionReject };
+            case T::bandwidthRequest: return std::pair{ T::bandwidthConfirm, T::bandwidthReject };
+            case T::disengageRequest: return std::pair{ T::disengageConfirm, T::disengageReject };
+            case T::locationRequest: return std::pair{ T::locationConfirm, T::locationReject };
+            case T::infoRequest: return std::pair{ T::infoRequestResponse, T::infoRequestResponse };
+            case T::resourcesAvailableIndicate: return std::pair{ T::resourcesAvailableConfirm, T::resourcesAvailableConfirm };
+            case T::serviceControlIndication: return std::pair{ T::serviceControlResponse, T::serviceControlResponse };
+            default: return std::nullopt;
+            }
+        }
+
+        // Таймер на 16 бит номера: payload колеса — сам requestSeqNum
+        constexpr size_t sequence_numbers = 65536;
+
+    } // namespace
+
+    RasTransactions::RasTransactions(const RasRetryPolicy& policy, Send send, Complete complete, Clock::time_point now)
+        : policy_(policy), send_(std::move(send)), complete_(std::move(complete)),
+          wheel_(core::TimingWheel::Config{ .tick = std::chrono::milliseconds(10), .capacity = 1024 }, now),
+          transactions_(sequence_numbers) {}
+
+    std::optional<uint16_t> RasTransactions::request_seq_num(const RasMessage& msg) {
+        return std::visit([](const auto& body) -> std::optional<uint16_t> {
+            if constexpr (requires { body.requestSeqNum; }) return body.requestSeqNum;
+            else return std::nullopt;
+        }, msg);
+    }
+
+    Result<void> RasTransactions::send(uint16_t requestSeqNum, RasMessageType request, const TransportAddress& destination,
+        std::span<const std::byte> datagram, Clock::time_point now)
+    {
+        if (!responses_of(request)) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "RAS message has no confirm or reject to wait for" });
+        }
+        Transaction& t = transactions_[requestSeqNum];
+        if (t.active) {
+            return std::unexpected(Error{ ErrorCode::InvalidConstraint, "requestSeqNum is already awaiting a response" });
+        }
+
+        t.datagram.assign(datagram.begin(), datagram.end());
+        t.destination = destination;
+        t.request = request;
+        t.attempts_left = policy_.retries;
+        t.active = true;
+        t.timer = wheel_.arm(now + policy_.timeout, requestSeqNum);
+        (void)send_(destination, t.datagram);
+        return {};
+    }
+
+    bool RasTransactions::on_response(const RasMessage& msg, const TransportAddress& source, Clock::time_point now) {
+        auto seq = request_seq_num(msg);
+        if (!seq) return false;
+
+        Transaction& t = transactions_[*seq];
+        if (!t.active || t.destination != source) return false;
+
+        // Номер и адрес совпадают, но ответить на запрос может только его пара
+        // подтверждение/отказ или RequestInProgress
+        const RasMessageType type = RasPDU::type_of(msg);
+        const auto [confirm, reject] = *responses_of(t.request);
+        if (type != confirm && type != reject && type != RasMessageType::requestInProgress) return false;
+
+        wheel_.cancel(t.timer);
+        if (const auto* rip = std::get_if<RequestInProgress>(&msg)) {
+            // Ответ задерживается: ждем delay, не расходуя повторов
+            t.timer = wheel_.arm(now + std::chrono::milliseconds(rip->delay), *seq);
+            return true;
+        }
+
+        t.active = false;
+        complete_(*seq, &msg);
+        return true;
+    }
+
+    bool RasTransactions::cancel(uint16_t requestSeqNum) {
+        Transaction& t = transactions_[requestSeqNum];
+        if (!t.active) return false;
+        wheel_.cancel(t.timer);
+        t.active = false;
+        return true;
+    }
+
+    void RasTransactions::poll(Clock::time_point now) {
+        wheel_.advance(now, [&](uint64_t payload) { expire(static_cast<uint16_t>(payload), now); });
+    }
+
+    void RasTransactions::expire(uint16_t requestSeqNum, Clock::time_point now) {
+        Transaction& t = transactions_[requestSeqNum];
+        if (t.attempts_left == 0) {
+            t.active = false;
+            complete_(requestSeqNum, nullptr);
+            return;
+        }
+
+        --t.attempts_left;
+        t.timer = wheel_.arm(now + policy_.timeout, requestSeqNum);
+        (void)send_(t.destination, t.datagram);
+    }
+
+} // namespace h323_26::h225
@@ -0,0 +1,305 @@
+﻿#include <h323_26/transport/ras_server.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace h323_26::transport {
+
+    namespace {
+
+        // Наибольшая принимаемая датаграмма: MTU Ethernet без заголовков IP и UDP
+        constexpr size_t max_datagram = 1472;
+
+        // Как часто поток проверяет флаг остановки, если датаграмм нет
+        constexpr timeval poll_period{ .tv_sec = 0, .tv_usec = 50'000 };
+
+        sockaddr_in to_sockaddr(const h225::TransportAddress& address) {
+            sockaddr_in sa{};
+            sa.sin_family = AF_INET;
+            sa.sin_port = htons(address.port);
+            std::memcpy(&sa.sin_addr, address.ip.data(), address.ip.size());
+            return sa;
+        }
+
+        h225::TransportAddress from_sockaddr(const sockaddr_in& sa) {
+            h225::TransportAddress address{ .ip = {}, .port = ntohs(sa.sin_port) };
+            std::memcpy(address.ip.data(), &sa.sin_addr, address.ip.size());
+            return address;
+        }
+
+        Result<int> fail(int fd, std::string_view message) {
+            if (fd >= 0) ::close(fd);
+            return std::unexpected(Error{ ErrorCode::IoError, message });
+        }
+
+        // UDP-сокет с SO_REUSEPORT, привязанный к address
+        Result<int> open_socket(const sockaddr_in& address) {
+            int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+            if (fd < 0) return fail(fd, "socket() failed");
+
+            const int one = 1;
+            if (::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) return fail(fd, "SO_REUSEPORT is not supported");
+            if (::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &poll_period, sizeof(poll_period)) != 0) return fail(fd, "SO_RCVTIMEO failed");
+            if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) return fail(fd, "bind() failed");
+            return fd;
+        }
+
+        // Счетчик с единственным писателем: без атомарного read-modify-write
+        void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+
+    } // namespace
+
+    struct RasServer::Shard {
+        Shard(int socket, size_t batch_size, RasShard state, std::unique_ptr<h225::RasReplyCache> reply_cache)
+            : fd(socket), batch(batch_size), handler(std::move(state.handler)), ticker(std::move(state.tick)),
+              cache(std::move(reply_cache)),
+              rx_buffer(batch * max_datagram), tx_buffer(batch * max_datagram),
+              rx_msgs(batch), tx_msgs(batch), rx_iov(batch), tx_iov(batch), rx_addr(batch), tx_addr(batch), keys(batch) {
+            // Заголовки mmsghdr указывают на свои слоты раз и навсегда
+            for (size_t i = 0; i < batch; ++i) {
+                rx_iov[i] = { rx_buffer.data() + i * max_datagram, max_datagram };
+                rx_msgs[i].msg_hdr.msg_name = &rx_addr[i];
+                rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+                rx_msgs[i].msg_hdr.msg_iovlen = 1;
+
+                tx_iov[i] = { tx_buffer.data() + i * max_datagram, 0 };
+                tx_msgs[i].msg_hdr.msg_name = &tx_addr[i];
+                tx_msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+                tx_msgs[i].msg_hdr.msg_iovlen = 1;
+            }
+            datagrams.reserve(batch);
+            pending.reserve(batch);
+            pending_datagrams.reserve(batch);
+        }
+
+        ~Shard() {
+            if (fd >= 0) ::close(fd);
+        }
+
+        void run(const std::atomic<bool>& stopping) {
+            while (!stopping.load(std::memory_order_acquire)) {
+                for (auto& msg : rx_msgs) msg.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+
+                // Ждем первую датаграмму (не дольше poll_period), остальные забираем без ожидания
+                int count = ::recvmmsg(fd, rx_msgs.data(), static_cast<unsigned>(batch), MSG_WAITFORONE, nullptr);
+                if (count > 0) serve(static_cast<size_t>(count));
+                if (ticker) ticker(h225::RasTransactions::Clock::now());
+            }
+        }
+
+        void serve(size_t count) {
+            datagrams.clear();
+            for (size_t i = 0; i < count; ++i) {
+                // Обрезанная датаграмма разбору не подлежит
+                size_t length = (rx_msgs[i].msg_hdr.msg_flags & MSG_TRUNC) ? 0 : rx_msgs[i].msg_len;
+                datagrams.emplace_back(static_cast<const std::byte*>(rx_iov[i].iov_base), length);
+            }
+
+            size_t malformed = 0;
+            size_t replies = 0;
+            size_t hits = 0;
+
+            // С кэшем сначала только заголовки: повтор запроса получает сохраненный
+            // ответ, а полный разбор и обработчик достаются остальным датаграммам
+            pending.clear();
+            pending_datagrams.clear();
+            const auto now = h225::RasReplyCache::Clock::now();
+            if (cache) {
+                const auto& headers = decoder.peek(datagrams);
+                for (size_t i = 0; i < count; ++i) {
+                    if (headers.status[i] != ErrorCode::Success) {
+                        ++malformed;
+                        continue;
+                    }
+
+                    keys[i] = h225::RasReplyKey{ .source = from_sockaddr(rx_addr[i]), .type = headers.type[i], .requestSeqNum = headers.requestSeqNum[i] };
+                    if (auto cached = cache->find(keys[i], now)) {
+                        const size_t size = std::min(cached->size(), max_datagram);
+                        std::memcpy(tx_iov[replies].iov_base, cached->data(), size);
+                        tx_iov[replies].iov_len = size;
+                        tx_addr[replies] = rx_addr[i];
+                        ++replies;
+                        ++hits;
+                        continue;
+                    }
+                    pending.push_back(i);
+                    pending_datagrams.push_back(datagrams[i]);
+                }
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) pending.push_back(i);
+                pending_datagrams.assign(datagrams.begin(), datagrams.end());
+            }
+
+            const auto& headers = decoder.decode(pending_datagrams);
+            for (size_t j = 0; j < pending.size(); ++j) {
+                if (headers.status[j] != ErrorCode::Success) {
+                    ++malformed;
+                    continue;
+                }
+
+                const size_t i = pending[j];
+                std::span<std::byte> slot(static_cast<std::byte*>(tx_iov[replies].iov_base), max_datagram);
+                size_t size = std::min(handler(*decoder.message(j), from_sockaddr(rx_addr[i]), slot), max_datagram);
+                if (size == 0) continue;
+
+                // Ответ запоминается в том виде, в каком уходит в сеть
+                if (cache) (void)cache->store(keys[i], slot.first(size), now);
+                tx_iov[replies].iov_len = size;
+                tx_addr[replies] = rx_addr[i];
+                ++replies;
+            }
+
+            size_t sent = 0;
+            while (sent < replies) {
+                int res = ::sendmmsg(fd, tx_msgs.data() + sent, static_cast<unsigned>(replies - sent), 0);
+                if (res < 0 && errno == EINTR) continue;
+                // UDP: недоставленный ответ клиент запросит повторно
+                if (res <= 0) break;
+                sent += static_cast<size_t>(res);
+            }
+
+            bump(counters.batches, 1);
+            bump(counters.received, count);
+            bump(counters.malformed, malformed);
+            bump(counters.sent, sent);
+            if (cache) {
+                bump(counters.cache_hits, hits);
+                bump(counters.cache_misses, pending.size());
+            }
+        }
+
+        int fd;
+        size_t batch;
+        RasHandler handler;
+        RasTicker ticker;
+        std::unique_ptr<h225::RasReplyCache> cache; // nullptr — кэш выключен
+        h225::RasBatchDecoder decoder;
+
+        // batch слотов по max_datagram октетов на прием и на отправку
+        std::vector<std::byte> rx_buffer;
+        std::vector<std::byte> tx_buffer;
+        std::vector<mmsghdr> rx_msgs;
+        std::vector<mmsghdr> tx_msgs;
+        std::vector<iovec> rx_iov;
+        std::vector<iovec> tx_iov;
+        std::vector<sockaddr_in> rx_addr;
+        std::vector<sockaddr_in> tx_addr;
+        std::vector<std::span<const std::byte>> datagrams;
+        std::vector<h225::RasReplyKey> keys;                      // Ключ кэша i-й датаграммы
+        std::vector<size_t> pending;                              // Датаграммы без ответа из кэша
+        std::vector<std::span<const std::byte>> pending_datagrams;
+
+        // Своя кэш-линия: читающий stats() поток не мешает писателю соседнего ядра
+        struct alignas(64) Counters {
+            std::atomic<uint64_t> batches{ 0 };
+            std::atomic<uint64_t> received{ 0 };
+            std::atomic<uint64_t> malformed{ 0 };
+            std::atomic<uint64_t> sent{ 0 };
+            std::atomic<uint64_t> cache_hits{ 0 };
+            std::atomic<uint64_t> cache_misses{ 0 };
+        } counters;
+
+        std::thread thread;
+    };
+
+    bool RasSender::send(const h225::TransportAddress& destination, std::span<const std::byte> datagram) const {
+        const sockaddr_in address = to_sockaddr(destination);
+        for (;;) {
+            ssize_t res = ::sendto(fd_, datagram.data(), datagram.size(), 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+            if (res < 0 && errno == EINTR) continue;
+            return res == static_cast<ssize_t>(datagram.size());
+        }
+    }
+
+    Result<std::unique_ptr<RasServer>> RasServer::start(const RasServerConfig& config, const HandlerFactory& make_handler) {
+        return start(config, ShardFactory([&make_handler](size_t shard, RasSender) { return RasShard{ .handler = make_handler(shard), .tick = {} }; }));
+    }
+
+    Result<std::unique_ptr<RasServer>> RasServer::start(const RasServerConfig& config, const ShardFactory& make_shard) {
+        const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        const size_t threads = config.threads != 0 ? config.threads : cores;
+        const size_t batch = std::max<size_t>(config.batch, 1);
+
+        std::unique_ptr<RasServer> server(new RasServer());
+        sockaddr_in address = to_sockaddr(config.bind);
+        for (size_t i = 0; i < threads; ++i) {
+            auto fd = open_socket(address);
+            if (!fd) return std::unexpected(fd.error());
+
+            if (i == 0) {
+                // Остальные сокеты занимают тот же порт, даже если его выбрала ОС
+                socklen_t length = sizeof(address);
+                if (::getsockname(*fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+                    return std::unexpected(fail(*fd, "getsockname() failed").error());
+                }
+                server->port_ = ntohs(address.sin_port);
+            }
+            std::unique_ptr<h225::RasReplyCache> cache;
+            if (config.reply_cache != 0) {
+                cache = std::make_unique<h225::RasReplyCache>(h225::RasReplyCache::Config{
+                    .entries = config.reply_cache, .max_reply = std::min(config.max_cached_reply, max_datagram) });
+            }
+            server->shards_.push_back(std::make_unique<Shard>(*fd, batch, make_shard(i, RasSender(*fd)), std::move(cache)));
+        }
+
+        for (size_t i = 0; i < threads; ++i) {
+            Shard& shard = *server->shards_[i];
+            const bool pin = config.pin_threads;
+            shard.thread = std::thread([&shard, &stopping = server->stopping_, pin, core = i % cores] {
+                if (pin) {
+                    cpu_set_t set;
+                    CPU_ZERO(&set);
+                    CPU_SET(core, &set);
+                    // Без привязки сервер работает, только с худшей локальностью кэша
+                    (void)::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+                }
+                shard.run(stopping);
+            });
+        }
+        return server;
+    }
+
+    RasServer::~RasServer() {
+        stop();
+    }
+
+    void RasServer::stop() {
+        stopping_.store(true, std::memory_order_release);
+        for (auto& shard : shards_) {
+            if (shard->thread.joinable()) shard->thread.join();
+        }
+    }
+
+    RasServerStats RasServer::shard_stats(size_t shard) const {
+        const auto& counters = shards_[shard]->counters;
+        return RasServerStats{
+            .batches = counters.batches.load(std::memory_order_relaxed),
+            .received = counters.received.load(std::memory_order_relaxed),
+            .malformed = counters.malformed.load(std::memory_order_relaxed),
+            .sent = counters.sent.load(std::memory_order_relaxed),
+            .cache_hits = counters.cache_hits.load(std::memory_order_relaxed),
+            .cache_misses = counters.cache_misses.load(std::memory_order_relaxed)
+        };
+    }
+
+    RasServerStats RasServer::stats() const {
+        RasServerStats total;
+        for (size_t i = 0; i < shards_.size(); ++i) total += shard_stats(i);
+        return total;
+    }
+
+} // namespace h323_26::transport
@@ -0,0 +1,119 @@
+﻿#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Минимальный каркас микробенчмарков h323_benchmarks (без внешних зависимостей).
+//
+//     H323_26_BENCHMARK("per/encode_oid/short") {
+//         state.set_bytes_per_op(8);
+//         for ([[maybe_unused]] auto _ : state) { ... }
+//     }
+//
+// Число итераций подбирается так, чтобы замер шел не меньше --min-time.
+// Аллокации считаются заменой глобального operator new на время замера.
+
+namespace h323_26::bench {
+
+    class State {
+    public:
+        explicit State(size_t iterations) : iterations_(iterations) {}
+
+        // Сколько байт полезной нагрузки обрабатывает одна операция (для bytes/s)
+        void set_bytes_per_op(size_t bytes) { bytes_per_op_ = bytes; }
+
+        // Сколько сообщений обрабатывает одна операция (для msgs/s; 0 — не сообщение)
+        void set_messages_per_op(size_t messages) { messages_per_op_ = messages; }
+
+        // Отметка ошибки: замер прекращается, бенчмарк помечается как failed
+        void fail(std::string_view reason);
+
+        // Подготовка внутри цикла, не попадающая в замер
+        void pause_timing();
+        void resume_timing();
+
+        class Iterator {
+        public:
+            explicit Iterator(State* state, size_t left) : state_(state), left_(left) {}
+            // Конец цикла останавливает замер: код после цикла в него не попадает
+            bool operator!=(const Iterator&) {
+                if (left_ != 0 && !state_->failed()) return true;
+                state_->pause_timing();
+                return false;
+            }
+            void operator++() { --left_; }
+            int operator*() const { return 0; }
+
+        private:
+            State* state_;
+            size_t left_;
+        };
+
+        Iterator begin();
+        Iterator end() { return Iterator(this, 0); }
+
+        // Для раннера
+        [[nodiscard]] size_t iterations() const { return iterations_; }
+        [[nodiscard]] size_t bytes_per_op() const { return bytes_per_op_; }
+        [[nodiscard]] size_t messages_per_op() const { return messages_per_op_; }
+        [[nodiscard]] bool failed() const { return !error_.empty(); }
+        [[nodiscard]] const std::string& error() const { return error_; }
+        [[nodiscard]] std::chrono::nanoseconds elapsed() const { return elapsed_; }
+        [[nodiscard]] uint64_t allocations() const { return allocations_; }
+
+        void finish();
+
+    private:
+        size_t iterations_;
+        size_t bytes_per_op_ = 0;
+        size_t messages_per_op_ = 0;
+        std::string error_;
+
+        bool running_ = false;
+        std::chrono::steady_clock::time_point started_{};
+        std::chrono::nanoseconds elapsed_{ 0 };
+        uint64_t allocations_at_start_ = 0;
+        uint64_t allocations_ = 0;
+    };
+
+    using BenchmarkFn = void (*)(State&);
+
+    // Регистрирует бенчмарк при статической инициализации
+    int register_benchmark(std::string_view name, BenchmarkFn fn);
+
+    // Не дает оптимизатору выбросить вычисление value
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(_MSC_VER)
+        const volatile void* sink = &value;
+        (void)sink;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    // Барьер для побочных эффектов в памяти (записи в буфер writer'а и т.п.)
+    inline void clobber_memory() {
+#if defined(_MSC_VER)
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+} // namespace h323_26::bench
+
+#define H323_26_BENCH_CONCAT_IMPL(a, b) a##b
+#define H323_26_BENCH_CONCAT(a, b) H323_26_BENCH_CONCAT_IMPL(a, b)
+
+#define H323_26_BENCHMARK(name)                                                                      \
+    static void H323_26_BENCH_CONCAT(h323_bench_fn_, __LINE__)(::h323_26::bench::State& state);      \
+    [[maybe_unused]] static const int H323_26_BENCH_CONCAT(h323_bench_reg_, __LINE__) =              \
+        ::h323_26::bench::register_benchmark(name, &H323_26_BENCH_CONCAT(h323_bench_fn_, __LINE__)); \
+    static void H323_26_BENCH_CONCAT(h323_bench_fn_, __LINE__)([[maybe_unused]] ::h323_26::bench::State& state)
@@ -0,0 +1,269 @@
+﻿#include "bench.hpp"
+
+#include <h323_26/gk/registration_table.hpp>
+#include <h323_26/gk/prefix_routes.hpp>
+#include <h323_26/core/worker_pool.hpp>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace h323_26;
+using bench::State;
+
+namespace {
+
+    // Гейткипер на 200 тысяч конечных точек: endpointIdentifier и номер у каждой
+    constexpr size_t Endpoints = 200'000;
+
+    // Операций на итерацию смешанной нагрузки: 90% ARQ (поиск по номеру), 10% RRQ
+    constexpr size_t MixedOps = 4096;
+
+    struct Population {
+        std::vector<std::string> ids;
+        std::vector<h225::AliasAddress> numbers;
+        std::vector<gk::EndpointInfo> infos;
+    };
+
+    const Population& population() {
+        static const Population p = [] {
+            Population out;
+            out.ids.reserve(Endpoints);
+            out.numbers.reserve(Endpoints);
+            for (size_t i = 0; i < Endpoints; ++i) {
+                char id[16];
+                std::snprintf(id, sizeof(id), "EP-%06zu", i);
+                out.ids.emplace_back(id);
+                out.numbers.push_back(h225::DialedDigits{ std::pmr::string(std::to_string(74950000000ULL + i)) });
+                const h225::TransportAddress address{
+                    .ip = { std::byte{ 10 }, std::byte{ static_cast<uint8_t>(i >> 16) }, std::byte{ static_cast<uint8_t>(i >> 8) }, std::byte{ static_cast<uint8_t>(i) } },
+                    .port = 1720 };
+                out.infos.push_back(gk::EndpointInfo{ .callSignalAddress = address, .rasAddress = address, .timeToLive = 300 });
+            }
+            return out;
+        }();
+        return p;
+    }
+
+    // Таблица заполняется один раз на процесс: раннер вызывает бенчмарк многократно
+    gk::RegistrationTable& table() {
+        static gk::RegistrationTable* instance = [] {
+            auto* t = new gk::RegistrationTable(gk::RegistrationTable::Config{ .endpoints = Endpoints * 5 / 4, .keys_per_endpoint = 2 });
+            const auto& p = population();
+            for (size_t i = 0; i < Endpoints; ++i) {
+                (void)t->register_endpoint(p.ids[i], std::span(&p.numbers[i], 1), p.infos[i], gk::Clock::now());
+            }
+            return t;
+        }();
+        return *instance;
+    }
+
+    // Для сравнения: строковые ключи в unordered_map под shared_mutex
+    struct LockedMap {
+        std::shared_mutex lock;
+        std::unordered_map<std::string, gk::EndpointInfo> by_alias;
+    };
+
+    LockedMap& locked_map() {
+        static LockedMap* instance = [] {
+            auto* m = new LockedMap;
+            const auto& p = population();
+            for (size_t i = 0; i < Endpoints; ++i) {
+                m->by_alias.emplace(std::get<h225::DialedDigits>(p.numbers[i]).digits, p.infos[i]);
+            }
+            return m;
+        }();
+        return *instance;
+    }
+
+    // Псевдослучайный номер точки: xorshift, чтобы обращения не шли подряд по памяти
+    size_t next_endpoint(uint64_t& seed) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return static_cast<size_t>(seed % Endpoints);
+    }
+
+    unsigned worker_threads() {
+        unsigned cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 1;
+    }
+
+    // План нумерации: 300 тысяч префиксов длиной 4-9 цифр, как в таблице транзитного гейткипера
+    constexpr size_t Prefixes = 300'000;
+
+    const std::vector<std::string>& prefixes() {
+        static const std::vector<std::string> out = [] {
+            std::vector<std::string> v;
+            v.reserve(Prefixes);
+            uint64_t seed = 12345;
+            for (size_t i = 0; i < Prefixes; ++i) {
+                const size_t digits = 4 + next_endpoint(seed) % 6;
+                std::string prefix;
+                for (size_t d = 0; d < digits; ++d) prefix.push_back(static_cast<char>('0' + next_endpoint(seed) % 10));
+                v.push_back(std::move(prefix));
+            }
+            return v;
+        }();
+        return out;
+    }
+
+    std::vector<gk::PrefixRoutes::Entry> prefix_entries() {
+        std::vector<gk::PrefixRoutes::Entry> entries;
+        const auto& v = prefixes();
+        entries.reserve(v.size());
+        for (size_t i = 0; i < v.size(); ++i) entries.push_back({ v[i], static_cast<gk::PrefixRoutes::Route>(i) });
+        return entries;
+    }
+
+    gk::PrefixRoutes& routes() {
+        static gk::PrefixRoutes* instance = [] {
+            auto* r = new gk::PrefixRoutes;
+            (void)r->load(prefix_entries());
+            return r;
+        }();
+        return *instance;
+    }
+
+    void table_mixed_bench(State& state, core::WorkerPool* workers) {
+        auto& t = table();
+        const auto& p = population();
+        state.set_messages_per_op(MixedOps);
+        uint64_t round = 0;
+
+        for ([[maybe_unused]] auto _ : state) {
+            ++round;
+            auto chunk = [&](size_t begin, size_t end) {
+                // Каждая итерация — новые точки, иначе рабочий набор целиком в кэше
+                uint64_t seed = (round << 32) + begin + 1;
+                for (size_t op = begin; op < end; ++op) {
+                    const size_t i = next_endpoint(seed);
+                    if (op % 10 == 0) {
+                        // RRQ с прежним набором псевдонимов
+                        auto ref = t.register_endpoint(p.ids[i], std::span(&p.numbers[i], 1), p.infos[i], gk::Clock::now());
+                        bench::do_not_optimize(ref);
+                    }
+                    else {
+                        auto found = t.find_alias(p.numbers[i]);
+                        bench::do_not_optimize(found);
+                    }
+                }
+            };
+            if (workers) workers->parallel_for(MixedOps, 64, chunk);
+            else chunk(0, MixedOps);
+        }
+    }
+
+    void locked_mixed_bench(State& state, core::WorkerPool* workers) {
+        auto& m = locked_map();
+        const auto& p = population();
+        state.set_messages_per_op(MixedOps);
+        uint64_t round = 0;
+
+        for ([[maybe_unused]] auto _ : state) {
+            ++round;
+            auto chunk = [&](size_t begin, size_t end) {
+                // Каждая итерация — новые точки, иначе рабочий набор целиком в кэше
+                uint64_t seed = (round << 32) + begin + 1;
+                for (size_t op = begin; op < end; ++op) {
+                    const size_t i = next_endpoint(seed);
+                    const std::string key(std::get<h225::DialedDigits>(p.numbers[i]).digits);
+                    if (op % 10 == 0) {
+                        std::unique_lock lock(m.lock);
+                        m.by_alias[key] = p.infos[i];
+                    }
+                    else {
+                        std::shared_lock lock(m.lock);
+                        auto it = m.by_alias.find(key);
+                        bench::do_not_optimize(it);
+                    }
+                }
+            };
+            if (workers) workers->parallel_for(MixedOps, 64, chunk);
+            else chunk(0, MixedOps);
+        }
+    }
+
+} // namespace
+
+H323_26_BENCHMARK("gk/registrations/arq_find_alias") {
+    auto& t = table();
+    const auto& p = population();
+    state.set_messages_per_op(1);
+    uint64_t seed = 42;
+    for ([[maybe_unused]] auto _ : state) {
+        auto found = t.find_alias(p.numbers[next_endpoint(seed)]);
+        if (!found) state.fail("find_alias");
+        bench::do_not_optimize(found);
+    }
+}
+
+H323_26_BENCHMARK("gk/registrations/rrq_reregister") {
+    auto& t = table();
+    const auto& p = population();
+    state.set_messages_per_op(1);
+    uint64_t seed = 7;
+    for ([[maybe_unused]] auto _ : state) {
+        const size_t i = next_endpoint(seed);
+        auto ref = t.register_endpoint(p.ids[i], std::span(&p.numbers[i], 1), p.infos[i], gk::Clock::now());
+        if (!ref) state.fail("register_endpoint");
+        bench::do_not_optimize(ref);
+    }
+}
+
+// 90% ARQ / 10% RRQ: один поток и все ядра; для сравнения — unordered_map под shared_mutex
+H323_26_BENCHMARK("gk/registrations/mixed_1thread") { table_mixed_bench(state, nullptr); }
+H323_26_BENCHMARK("gk/registrations/mixed_all_cores") {
+    core::WorkerPool workers(worker_threads());
+    table_mixed_bench(state, &workers);
+}
+H323_26_BENCHMARK("gk/registrations/shared_mutex_map_1thread") { locked_mixed_bench(state, nullptr); }
+H323_26_BENCHMARK("gk/registrations/shared_mutex_map_all_cores") {
+    core::WorkerPool workers(worker_threads());
+    locked_mixed_bench(state, &workers);
+}
+
+// Поиск по набранному номеру: 11 цифр, половина совпадает с известным префиксом
+H323_26_BENCHMARK("gk/prefix_routes/lookup") {
+    auto& r = routes();
+    const auto& v = prefixes();
+    std::vector<std::string> numbers;
+    uint64_t seed = 99;
+    for (size_t i = 0; i < 4096; ++i) {
+        std::string number = i % 2 ? v[next_endpoint(seed) % v.size()] : std::string();
+        while (number.size() < 11) number.push_back(static_cast<char>('0' + next_endpoint(seed) % 10));
+        numbers.push_back(std::move(number));
+    }
+    state.set_messages_per_op(1);
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        auto match = r.lookup(numbers[i++ % numbers.size()]);
+        bench::do_not_optimize(match);
+    }
+}
+
+H323_26_BENCHMARK("gk/prefix_routes/bulk_load") {
+    const auto entries = prefix_entries();
+    gk::PrefixRoutes r;
+    state.set_messages_per_op(entries.size());
+    for ([[maybe_unused]] auto _ : state) {
+        if (!r.load(entries)) state.fail("load");
+    }
+}
+
+// 100 точечных изменений, слитых в опубликованную таблицу
+H323_26_BENCHMARK("gk/prefix_routes/publish") {
+    auto& r = routes();
+    const auto& v = prefixes();
+    uint64_t seed = 5;
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i = 0; i < 100; ++i) {
+            const size_t k = next_endpoint(seed) % v.size();
+            (void)r.insert(v[k], static_cast<gk::PrefixRoutes::Route>(k));
+        }
+        r.publish();
+    }
+}
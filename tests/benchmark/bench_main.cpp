@@ -0,0 +1,252 @@
+﻿#include "bench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <malloc.h>
+#endif
+
+// Счетчик аллокаций: заменяем глобальные operator new/delete (включая выровненные)
+namespace {
+    std::atomic<uint64_t> g_allocations{ 0 };
+
+    void* counted_alloc(std::size_t size) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        throw std::bad_alloc();
+    }
+
+    void* counted_aligned_alloc(std::size_t size, std::align_val_t align) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        auto alignment = static_cast<std::size_t>(align);
+        size = (size + alignment - 1) / alignment * alignment;
+#if defined(_MSC_VER)
+        if (void* p = _aligned_malloc(size ? size : alignment, alignment)) return p;
+#else
+        if (void* p = std::aligned_alloc(alignment, size ? size : alignment)) return p;
+#endif
+        throw std::bad_alloc();
+    }
+
+    void counted_aligned_free(void* p) noexcept {
+#if defined(_MSC_VER)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+void* operator new(std::size_t size, std::align_val_t align) { return counted_aligned_alloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return counted_aligned_alloc(size, align); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_aligned_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_aligned_free(p); }
+
+namespace h323_26::bench {
+
+    namespace {
+
+        struct Registered {
+            std::string name;
+            BenchmarkFn fn;
+        };
+
+        std::vector<Registered>& registry() {
+            static std::vector<Registered> benchmarks;
+            return benchmarks;
+        }
+
+        struct Options {
+            double min_time = 0.2;   // секунд на замер
+            std::string filter;      // подстрока имени
+            std::string json_path;   // "-" — JSON в stdout вместо таблицы
+            bool list = false;
+        };
+
+        struct Report {
+            std::string name;
+            size_t iterations = 0;
+            double ns_per_op = 0;
+            double msgs_per_sec = 0;
+            double bytes_per_sec = 0;
+            double allocs_per_op = 0;
+            std::string error{};
+        };
+
+        Report run_one(const Registered& bench, const Options& options) {
+            Report report{ .name = bench.name };
+            const auto target = std::chrono::duration<double>(options.min_time);
+
+            // Прогрев + рост числа итераций, пока замер не станет достаточно длинным
+            size_t iterations = 1;
+            for (;;) {
+                State state(iterations);
+                bench.fn(state);
+                state.finish();
+                if (state.failed()) {
+                    report.error = state.error();
+                    return report;
+                }
+
+                auto elapsed = std::chrono::duration<double>(state.elapsed());
+                if (elapsed >= target || iterations >= (size_t{ 1 } << 40)) {
+                    double seconds = elapsed.count();
+                    double ops = static_cast<double>(iterations);
+                    report.iterations = iterations;
+                    report.ns_per_op = seconds * 1e9 / ops;
+                    report.msgs_per_sec = state.messages_per_op() ? ops * static_cast<double>(state.messages_per_op()) / seconds : 0;
+                    report.bytes_per_sec = state.bytes_per_op() ? ops * static_cast<double>(state.bytes_per_op()) / seconds : 0;
+                    report.allocs_per_op = static_cast<double>(state.allocations()) / ops;
+                    return report;
+                }
+
+                // Оценка числа итераций до цели с запасом, не больше чем x10 за шаг
+                double scale = elapsed.count() > 0 ? target / elapsed * 1.4 : 10.0;
+                iterations = static_cast<size_t>(static_cast<double>(iterations) * std::clamp(scale, 2.0, 10.0));
+            }
+        }
+
+        std::string json_escape(std::string_view text) {
+            std::string out;
+            for (char c : text) {
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        void write_json(std::ostream& out, const std::vector<Report>& reports) {
+            out << "{\n  \"benchmarks\": [\n";
+            for (size_t i = 0; i < reports.size(); ++i) {
+                const auto& r = reports[i];
+                out << "    {\"name\": \"" << json_escape(r.name) << "\"";
+                if (!r.error.empty()) {
+                    out << ", \"error\": \"" << json_escape(r.error) << "\"}";
+                }
+                else {
+                    out << ", \"iterations\": " << r.iterations
+                        << ", \"ns_per_op\": " << r.ns_per_op
+                        << ", \"msgs_per_sec\": " << r.msgs_per_sec
+                        << ", \"bytes_per_sec\": " << r.bytes_per_sec
+                        << ", \"allocs_per_op\": " << r.allocs_per_op << "}";
+                }
+                out << (i + 1 < reports.size() ? ",\n" : "\n");
+            }
+            out << "  ]\n}\n";
+        }
+
+        void print_row(const Report& r) {
+            if (!r.error.empty()) {
+                std::printf("%-48s FAILED: %s\n", r.name.c_str(), r.error.c_str());
+                return;
+            }
+            std::printf("%-48s %12.1f %14.0f %14.2f %10.2f\n",
+                r.name.c_str(), r.ns_per_op, r.msgs_per_sec, r.bytes_per_sec / (1024.0 * 1024.0), r.allocs_per_op);
+        }
+
+        bool parse_options(int argc, char** argv, Options& options) {
+            for (int i = 1; i < argc; ++i) {
+                std::string_view arg = argv[i];
+                if (arg.starts_with("--filter=")) options.filter = arg.substr(9);
+                else if (arg.starts_with("--min-time=")) options.min_time = std::atof(std::string(arg.substr(11)).c_str());
+                else if (arg.starts_with("--json=")) options.json_path = arg.substr(7);
+                else if (arg == "--json") options.json_path = "-";
+                else if (arg == "--list") options.list = true;
+                else {
+                    std::cerr << "Usage: h323_benchmarks [--filter=substr] [--min-time=sec] [--json[=file]] [--list]\n";
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    } // namespace
+
+    void State::fail(std::string_view reason) {
+        if (error_.empty()) error_ = reason.empty() ? "failed" : std::string(reason);
+    }
+
+    void State::pause_timing() {
+        if (!running_) return;
+        elapsed_ += std::chrono::steady_clock::now() - started_;
+        allocations_ += g_allocations.load(std::memory_order_relaxed) - allocations_at_start_;
+        running_ = false;
+    }
+
+    void State::resume_timing() {
+        if (running_) return;
+        allocations_at_start_ = g_allocations.load(std::memory_order_relaxed);
+        started_ = std::chrono::steady_clock::now();
+        running_ = true;
+    }
+
+    State::Iterator State::begin() {
+        resume_timing();
+        return Iterator(this, iterations_);
+    }
+
+    void State::finish() {
+        pause_timing();
+    }
+
+    int register_benchmark(std::string_view name, BenchmarkFn fn) {
+        registry().push_back(Registered{ std::string(name), fn });
+        return 0;
+    }
+
+} // namespace h323_26::bench
+
+int main(int argc, char** argv) {
+    using namespace h323_26::bench;
+
+    Options options;
+    if (!parse_options(argc, argv, options)) return 2;
+
+    auto benchmarks = registry();
+    std::ranges::sort(benchmarks, {}, &Registered::name);
+
+    bool to_stdout_json = options.json_path == "-";
+    if (!options.list && !to_stdout_json) {
+        std::printf("%-48s %12s %14s %14s %10s\n", "benchmark", "ns/op", "msgs/s", "MiB/s", "allocs/op");
+    }
+
+    std::vector<Report> reports;
+    for (const auto& bench : benchmarks) {
+        if (!options.filter.empty() && bench.name.find(options.filter) == std::string::npos) continue;
+        if (options.list) {
+            std::printf("%s\n", bench.name.c_str());
+            continue;
+        }
+        reports.push_back(run_one(bench, options));
+        if (!to_stdout_json) print_row(reports.back());
+    }
+
+    if (to_stdout_json) {
+        write_json(std::cout, reports);
+    }
+    else if (!options.json_path.empty()) {
+        std::ofstream file(options.json_path);
+        write_json(file, reports);
+    }
+
+    bool failed = std::ranges::any_of(reports, [](const Report& r) { return !r.error.empty(); });
+    return failed ? 1 : 0;
+}
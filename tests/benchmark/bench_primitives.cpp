@@ -0,0 +1,364 @@
+﻿#include "bench.hpp"
+
+#include <h323_26/asn1/per_decoder.hpp>
+#include <h323_26/asn1/per_encoder.hpp>
+#include <h323_26/asn1/schema.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <h323_26/core/fixed_bit_writer.hpp>
+#include <h323_26/core/octet_kernels.hpp>
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace h323_26;
+using bench::State;
+
+namespace {
+
+    constexpr size_t StreamBytes = 4096;
+
+    std::vector<std::byte> make_stream() {
+        std::vector<std::byte> data(StreamBytes + 16);
+        for (size_t i = 0; i < data.size(); ++i) data[i] = std::byte(static_cast<uint8_t>(i * 131 + 7));
+        return data;
+    }
+
+    // Чтение count-битных полей подряд; offset — сдвиг начала потока (0 — выровнен)
+    void read_bits_bench(State& state, size_t offset, size_t count) {
+        auto data = make_stream();
+        const size_t fields = (StreamBytes * 8 - offset) / count;
+        state.set_bytes_per_op(fields * count / 8);
+
+        for ([[maybe_unused]] auto _ : state) {
+            core::BitReader reader(data);
+            (void)reader.skip_bits(offset);
+            uint64_t sum = 0;
+            for (size_t i = 0; i < fields; ++i) sum += *reader.read_bits(count);
+            bench::do_not_optimize(sum);
+        }
+    }
+
+    // Ширины полей заголовка фиксированной формы: маркер расширения, преамбула, индекс
+    // CHOICE, номер запроса, ENUMERATED, BOOLEAN — как в префиксе RAS-сообщения
+    constexpr std::array<size_t, 6> HeaderFields = { 1, 3, 5, 16, 3, 1 };
+    constexpr size_t HeaderBits = 29;
+
+    // Заголовки подряд: checked — проверка границ и std::expected на каждое поле,
+    // hoisted — одна проверка bits_left() на заголовок и чтения без проверок
+    void read_header_bench(State& state, bool hoisted) {
+        auto data = make_stream();
+        const size_t headers = StreamBytes * 8 / HeaderBits;
+        state.set_bytes_per_op(headers * HeaderBits / 8);
+
+        for ([[maybe_unused]] auto _ : state) {
+            core::BitReader reader(data);
+            uint64_t sum = 0;
+            for (size_t i = 0; i < headers; ++i) {
+                if (hoisted) {
+                    if (reader.bits_left() < HeaderBits) break;
+                    for (size_t bits : HeaderFields) sum += reader.read_bits_unchecked(bits);
+                }
+                else {
+                    for (size_t bits : HeaderFields) {
+                        auto value = reader.read_bits(bits);
+                        if (!value) break;
+                        sum += *value;
+                    }
+                }
+            }
+            bench::do_not_optimize(sum);
+        }
+    }
+
+    template <typename Writer>
+    void write_bits_bench(State& state, Writer& writer, size_t offset, size_t count) {
+        const size_t fields = (StreamBytes * 8 - offset) / count;
+        state.set_bytes_per_op(fields * count / 8);
+
+        for ([[maybe_unused]] auto _ : state) {
+            writer.clear();
+            (void)writer.write_bits(0, offset);
+            for (size_t i = 0; i < fields; ++i) (void)writer.write_bits(i, count);
+            bench::clobber_memory();
+        }
+    }
+
+    void write_bits_growing(State& state, size_t offset, size_t count) {
+        core::BitWriter writer;
+        writer.reserve(StreamBytes + 16);
+        write_bits_bench(state, writer, offset, count);
+    }
+
+    void write_bits_fixed(State& state, size_t offset, size_t count) {
+        std::vector<std::byte> slot(StreamBytes + 16);
+        core::FixedBitWriter writer(slot);
+        write_bits_bench(state, writer, offset, count);
+    }
+
+    const std::vector<uint32_t> ShortOid = { 0, 0, 8, 2250, 0, 7 };
+    const std::vector<uint32_t> LongOid = {
+        1, 3, 6, 1, 4, 1, 311, 21, 20, 4294967295u, 123456789, 2250, 16383, 16384, 2097151,
+        2097152, 268435455, 268435456, 42, 7 };
+
+    std::vector<std::byte> encode_oid_bytes(const std::vector<uint32_t>& oid, size_t offset) {
+        core::BitWriter writer;
+        (void)writer.write_bits(0, offset);
+        (void)asn1::PerEncoder::encode_oid(writer, oid);
+        return writer.data();
+    }
+
+    void encode_oid_bench(State& state, const std::vector<uint32_t>& oid, size_t offset) {
+        core::BitWriter writer;
+        writer.reserve(256);
+        state.set_bytes_per_op(encode_oid_bytes(oid, 0).size());
+
+        for ([[maybe_unused]] auto _ : state) {
+            writer.clear();
+            (void)writer.write_bits(0, offset);
+            if (!asn1::PerEncoder::encode_oid(writer, oid)) state.fail("encode_oid");
+            bench::clobber_memory();
+        }
+    }
+
+    void decode_oid_bench(State& state, const std::vector<uint32_t>& oid, size_t offset, bool arena) {
+        auto data = encode_oid_bytes(oid, offset);
+        state.set_bytes_per_op(data.size());
+        std::array<std::byte, 1024> storage;
+
+        for ([[maybe_unused]] auto _ : state) {
+            std::pmr::monotonic_buffer_resource mono(storage.data(), storage.size(), std::pmr::null_memory_resource());
+            core::BitReader reader(data);
+            (void)reader.skip_bits(offset);
+            auto decoded = asn1::PerDecoder::decode_oid(reader, arena ? &mono : std::pmr::get_default_resource());
+            if (!decoded) state.fail("decode_oid");
+            bench::do_not_optimize(decoded);
+        }
+    }
+
+    void decode_oid_view_bench(State& state, const std::vector<uint32_t>& oid, size_t offset) {
+        auto data = encode_oid_bytes(oid, offset);
+        state.set_bytes_per_op(data.size());
+
+        for ([[maybe_unused]] auto _ : state) {
+            core::BitReader reader(data);
+            (void)reader.skip_bits(offset);
+            auto view = asn1::PerDecoder::decode_oid_view(reader);
+            if (!view) state.fail("decode_oid_view");
+            // Проход по дугам — честное сравнение с владеющим декодером
+            uint64_t sum = 0;
+            for (uint32_t arc : *view) sum += arc;
+            bench::do_not_optimize(sum);
+        }
+    }
+
+    const std::string ShortText = "GK-1";
+    const std::string LongText(1000, 'a');
+
+    std::vector<std::byte> encode_text_bytes(const std::string& text, size_t offset) {
+        core::BitWriter writer;
+        (void)writer.write_bits(0, offset);
+        (void)asn1::PerEncoder::encode_ia5_string(writer, text);
+        return writer.data();
+    }
+
+    void encode_ia5_bench(State& state, const std::string& text, size_t offset) {
+        core::BitWriter writer;
+        writer.reserve(text.size() + 16);
+        state.set_bytes_per_op(text.size());
+
+        for ([[maybe_unused]] auto _ : state) {
+            writer.clear();
+            (void)writer.write_bits(0, offset);
+            if (!asn1::PerEncoder::encode_ia5_string(writer, text)) state.fail("encode_ia5_string");
+            bench::clobber_memory();
+        }
+    }
+
+    void decode_ia5_bench(State& state, const std::string& text, size_t offset, bool arena) {
+        auto data = encode_text_bytes(text, offset);
+        state.set_bytes_per_op(text.size());
+        std::vector<std::byte> storage(text.size() + 256);
+
+        for ([[maybe_unused]] auto _ : state) {
+            std::pmr::monotonic_buffer_resource mono(storage.data(), storage.size(), std::pmr::null_memory_resource());
+            core::BitReader reader(data);
+            (void)reader.skip_bits(offset);
+            auto decoded = asn1::PerDecoder::decode_ia5_string(reader, std::nullopt, arena ? &mono : std::pmr::get_default_resource());
+            if (!decoded) state.fail("decode_ia5_string");
+            bench::do_not_optimize(decoded);
+        }
+    }
+
+    void decode_ia5_view_bench(State& state, const std::string& text, size_t offset) {
+        auto data = encode_text_bytes(text, offset);
+        state.set_bytes_per_op(text.size());
+
+        for ([[maybe_unused]] auto _ : state) {
+            core::BitReader reader(data);
+            (void)reader.skip_bits(offset);
+            auto view = asn1::PerDecoder::decode_ia5_string_view(reader);
+            if (!view) state.fail("decode_ia5_string_view");
+            bench::do_not_optimize(view);
+        }
+    }
+
+    // Ядро заданного набора; на процессоре без него — выбранное по умолчанию
+    // (замер тогда повторяет соседний, но запуск не помечается как failed)
+    const core::OctetKernels& kernels_or_default(core::KernelSet set) {
+        const auto* kernels = core::octet_kernels(set);
+        return kernels ? *kernels : core::octet_kernels();
+    }
+
+    void copy_shifted_bench(State& state, core::KernelSet set) {
+        const auto& kernels = kernels_or_default(set);
+        auto data = make_stream();
+        std::vector<std::byte> out(StreamBytes);
+        state.set_bytes_per_op(out.size());
+
+        for ([[maybe_unused]] auto _ : state) {
+            kernels.copy_shifted(out.data(), data.data(), out.size(), 3);
+            bench::clobber_memory();
+        }
+    }
+
+    void printable_bench(State& state, core::KernelSet set) {
+        const auto& kernels = kernels_or_default(set);
+        std::string text;
+        while (text.size() < 1000) text += "Gatekeeper Zone-7 (Moscow) ";
+        state.set_bytes_per_op(text.size());
+
+        for ([[maybe_unused]] auto _ : state) {
+            bool valid = kernels.is_printable(text.data(), text.size());
+            if (!valid) state.fail("is_printable");
+            bench::do_not_optimize(valid);
+        }
+    }
+
+    // H323-ID из 4 и 200 символов: латиница с редкими кириллическими символами
+    const std::string ShortBmpText = "gw-1";
+    const std::string LongBmpText = [] {
+        std::string text;
+        for (size_t i = 0; i < 200; ++i) text += (i % 40 == 39) ? std::string("\xD0\x96") : std::string(1, static_cast<char>('a' + i % 26));
+        return text;
+    }();
+
+    void decode_bmp_bench(State& state, const std::string& text, size_t offset) {
+        core::BitWriter writer;
+        (void)writer.write_bits(0, offset);
+        (void)asn1::PerEncoder::encode_bmp_string(writer, text);
+        auto data = writer.data();
+        state.set_bytes_per_op(data.size());
+        std::vector<std::byte> storage(text.size() * 2 + 256);
+
+        for ([[maybe_unused]] auto _ : state) {
+            std::pmr::monotonic_buffer_resource mono(storage.data(), storage.size(), std::pmr::null_memory_resource());
+            core::BitReader reader(data);
+            (void)reader.skip_bits(offset);
+            auto decoded = asn1::PerDecoder::decode_bmp_string(reader, std::nullopt, &mono);
+            if (!decoded) state.fail("decode_bmp_string");
+            bench::do_not_optimize(decoded);
+        }
+    }
+
+} // namespace
+
+// BitReader / BitWriter: поля по 8 бит на границе байта и по 13 бит со сдвигом 3
+H323_26_BENCHMARK("core/read_bits/8_aligned") { read_bits_bench(state, 0, 8); }
+H323_26_BENCHMARK("core/read_bits/13_unaligned") { read_bits_bench(state, 3, 13); }
+H323_26_BENCHMARK("core/read_bits/64_unaligned") { read_bits_bench(state, 3, 64); }
+H323_26_BENCHMARK("core/read_bits/header_checked") { read_header_bench(state, false); }
+H323_26_BENCHMARK("core/read_bits/header_hoisted") { read_header_bench(state, true); }
+H323_26_BENCHMARK("core/write_bits/8_aligned") { write_bits_growing(state, 0, 8); }
+H323_26_BENCHMARK("core/write_bits/13_unaligned") { write_bits_growing(state, 3, 13); }
+H323_26_BENCHMARK("core/write_bits/64_unaligned") { write_bits_growing(state, 3, 64); }
+H323_26_BENCHMARK("core/fixed_write_bits/8_aligned") { write_bits_fixed(state, 0, 8); }
+H323_26_BENCHMARK("core/fixed_write_bits/13_unaligned") { write_bits_fixed(state, 3, 13); }
+
+H323_26_BENCHMARK("core/read_bytes/unaligned_4k") {
+    auto data = make_stream();
+    std::vector<std::byte> out(StreamBytes);
+    state.set_bytes_per_op(out.size());
+    for ([[maybe_unused]] auto _ : state) {
+        core::BitReader reader(data);
+        (void)reader.skip_bits(3);
+        if (!reader.read_bytes(out)) state.fail("read_bytes");
+        bench::clobber_memory();
+    }
+}
+
+H323_26_BENCHMARK("core/write_bytes/unaligned_4k") {
+    auto data = make_stream();
+    core::BitWriter writer;
+    writer.reserve(data.size() + 16);
+    state.set_bytes_per_op(StreamBytes);
+    for ([[maybe_unused]] auto _ : state) {
+        writer.clear();
+        (void)writer.write_bits(0, 3);
+        (void)writer.write_bytes(std::span(data).first(StreamBytes));
+        bench::clobber_memory();
+    }
+}
+
+// Ядра сдвига октетов и проверки алфавита: скалярное против SSE2/AVX2
+H323_26_BENCHMARK("core/copy_shifted/scalar_4k") { copy_shifted_bench(state, core::KernelSet::scalar); }
+H323_26_BENCHMARK("core/copy_shifted/sse2_4k") { copy_shifted_bench(state, core::KernelSet::sse2); }
+H323_26_BENCHMARK("core/copy_shifted/avx2_4k") { copy_shifted_bench(state, core::KernelSet::avx2); }
+H323_26_BENCHMARK("core/is_printable/scalar_1k") { printable_bench(state, core::KernelSet::scalar); }
+H323_26_BENCHMARK("core/is_printable/sse2_1k") { printable_bench(state, core::KernelSet::sse2); }
+H323_26_BENCHMARK("core/is_printable/avx2_1k") { printable_bench(state, core::KernelSet::avx2); }
+
+// OID: H.225.0 v7 (6 дуг) и длинный OID с многобайтовыми дугами
+H323_26_BENCHMARK("per/encode_oid/short_aligned") { encode_oid_bench(state, ShortOid, 0); }
+H323_26_BENCHMARK("per/encode_oid/short_unaligned") { encode_oid_bench(state, ShortOid, 3); }
+H323_26_BENCHMARK("per/encode_oid/long_aligned") { encode_oid_bench(state, LongOid, 0); }
+H323_26_BENCHMARK("per/decode_oid/short_heap") { decode_oid_bench(state, ShortOid, 3, false); }
+H323_26_BENCHMARK("per/decode_oid/short_arena") { decode_oid_bench(state, ShortOid, 3, true); }
+H323_26_BENCHMARK("per/decode_oid/long_heap") { decode_oid_bench(state, LongOid, 3, false); }
+H323_26_BENCHMARK("per/decode_oid/long_arena") { decode_oid_bench(state, LongOid, 3, true); }
+H323_26_BENCHMARK("per/decode_oid_view/short") { decode_oid_view_bench(state, ShortOid, 3); }
+H323_26_BENCHMARK("per/decode_oid_view/long") { decode_oid_view_bench(state, LongOid, 3); }
+
+// OID из реестра: memcmp вместо разбора дуг, готовые байты вместо base-128
+H323_26_BENCHMARK("per/encode_oid/interned_unaligned") {
+    const asn1::InternedOid oid(asn1::OidId::h225_v7);
+    core::BitWriter writer;
+    writer.reserve(64);
+    state.set_bytes_per_op(encode_oid_bytes(ShortOid, 0).size());
+    for ([[maybe_unused]] auto _ : state) {
+        writer.clear();
+        (void)writer.write_bits(0, 3);
+        if (!asn1::ObjectIdentifier::encode_value(writer, oid)) state.fail("encode_value");
+        bench::clobber_memory();
+    }
+}
+
+H323_26_BENCHMARK("per/decode_oid/interned") {
+    auto data = encode_oid_bytes(ShortOid, 3);
+    state.set_bytes_per_op(data.size());
+    for ([[maybe_unused]] auto _ : state) {
+        core::BitReader reader(data);
+        (void)reader.skip_bits(3);
+        auto oid = asn1::ObjectIdentifier::decode_value<asn1::InternedOid>(reader, {});
+        if (!oid || !oid->interned()) state.fail("decode_value");
+        bench::do_not_optimize(oid);
+    }
+}
+
+// IA5String: 4 и 1000 символов, начало на границе байта и со сдвигом
+H323_26_BENCHMARK("per/encode_ia5/short_aligned") { encode_ia5_bench(state, ShortText, 0); }
+H323_26_BENCHMARK("per/encode_ia5/short_unaligned") { encode_ia5_bench(state, ShortText, 3); }
+H323_26_BENCHMARK("per/encode_ia5/long_aligned") { encode_ia5_bench(state, LongText, 0); }
+H323_26_BENCHMARK("per/encode_ia5/long_unaligned") { encode_ia5_bench(state, LongText, 3); }
+H323_26_BENCHMARK("per/decode_ia5/short_heap") { decode_ia5_bench(state, ShortText, 3, false); }
+H323_26_BENCHMARK("per/decode_ia5/short_arena") { decode_ia5_bench(state, ShortText, 3, true); }
+H323_26_BENCHMARK("per/decode_ia5/long_heap") { decode_ia5_bench(state, LongText, 3, false); }
+H323_26_BENCHMARK("per/decode_ia5/long_arena") { decode_ia5_bench(state, LongText, 3, true); }
+H323_26_BENCHMARK("per/decode_ia5_view/short") { decode_ia5_view_bench(state, ShortText, 3); }
+H323_26_BENCHMARK("per/decode_ia5_view/long") { decode_ia5_view_bench(state, LongText, 3); }
+
+// BMPString: UTF-16BE -> UTF-8 выбранным ядром, на границе байта и со сдвигом
+H323_26_BENCHMARK("per/decode_bmp/short_unaligned") { decode_bmp_bench(state, ShortBmpText, 3); }
+H323_26_BENCHMARK("per/decode_bmp/long_aligned") { decode_bmp_bench(state, LongBmpText, 0); }
+H323_26_BENCHMARK("per/decode_bmp/long_unaligned") { decode_bmp_bench(state, LongBmpText, 3); }
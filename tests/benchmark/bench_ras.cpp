@@ -0,0 +1,416 @@
+﻿#include "bench.hpp"
+
+#include <h323_26/h225/ras.hpp>
+#include <h323_26/h225/ras_batch.hpp>
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/h225/ras_pool.hpp>
+#include <h323_26/h225/ras_reply_cache.hpp>
+#include <h323_26/h225/ras_template.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <h323_26/core/fixed_bit_writer.hpp>
+#include <h323_26/core/worker_pool.hpp>
+#include <array>
+#include <cstring>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+using namespace h323_26;
+using bench::State;
+
+namespace {
+
+    h225::RasMessage make_grq() {
+        return h225::GatekeeperRequest{
+            .requestSeqNum = 4321,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .gatekeeperIdentifier = "GK-1",
+            .endpointAlias = "H.323.26-Terminal"
+        };
+    }
+
+    h225::RasMessage make_rrq() {
+        using namespace h225;
+        const TransportAddress signalling{ .ip = { std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1} }, .port = 1720 };
+        const TransportAddress ras{ .ip = { std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1} }, .port = 1719 };
+        return RegistrationRequest{
+            .requestSeqNum = 77,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .discoveryComplete = true,
+            .callSignalAddress = { signalling },
+            .rasAddress = { ras },
+            .terminalAlias = AliasList{ DialedDigits{ "1001" }, H323Id{ "terminal-1" } },
+            .gatekeeperIdentifier = "GK-1",
+            .timeToLive = 300
+        };
+    }
+
+    // RRQ шлюза с дюжинами псевдонимов: H323-ID (BMPString) вперемешку с номерами
+    h225::RasMessage make_rrq_many_aliases() {
+        using namespace h225;
+        auto msg = make_rrq();
+        auto& rrq = std::get<RegistrationRequest>(msg);
+        rrq.terminalAlias = AliasList{};
+        for (int i = 0; i < 24; ++i) {
+            if (i % 2 == 0) rrq.terminalAlias->push_back(H323Id{ std::pmr::string("trunk-gateway-" + std::to_string(i) + ".example.net") });
+            else rrq.terminalAlias->push_back(DialedDigits{ std::pmr::string(std::to_string(74951000000LL + i)) });
+        }
+        return msg;
+    }
+
+    h225::RasMessage make_arq() {
+        using namespace h225;
+        const TransportAddress signalling{ .ip = { std::byte{10}, std::byte{0}, std::byte{0}, std::byte{2} }, .port = 1720 };
+        std::array<std::byte, 16> conference{};
+        return AdmissionRequest{
+            .requestSeqNum = 78,
+            .callType = CallType::pointToPoint,
+            .endpointIdentifier = "EP-1",
+            .destinationInfo = AliasList{ DialedDigits{ "2002" } },
+            .destCallSignalAddress = signalling,
+            .srcInfo = { DialedDigits{ "1001" } },
+            .bandWidth = 640,
+            .callReferenceValue = 33,
+            .conferenceID = conference
+        };
+    }
+
+    std::vector<std::byte> encode(const h225::RasMessage& msg) {
+        core::BitWriter writer;
+        (void)h225::RasPDU::encode(writer, msg);
+        return writer.data();
+    }
+
+    void encode_bench(State& state, const h225::RasMessage& msg) {
+        core::BitWriter writer;
+        writer.reserve(512);
+        state.set_bytes_per_op(encode(msg).size());
+        state.set_messages_per_op(1);
+
+        for ([[maybe_unused]] auto _ : state) {
+            writer.clear();
+            if (!h225::RasPDU::encode(writer, msg)) state.fail("RasPDU::encode");
+            bench::clobber_memory();
+        }
+    }
+
+    void encode_fixed_bench(State& state, const h225::RasMessage& msg) {
+        std::array<std::byte, 512> slot;
+        state.set_bytes_per_op(encode(msg).size());
+        state.set_messages_per_op(1);
+
+        for ([[maybe_unused]] auto _ : state) {
+            core::FixedBitWriter writer(slot);
+            if (!h225::RasPDU::encode(writer, msg)) state.fail("RasPDU::encode");
+            bench::clobber_memory();
+        }
+    }
+
+    void decode_bench(State& state, const h225::RasMessage& msg, bool arena) {
+        auto datagram = encode(msg);
+        state.set_bytes_per_op(datagram.size());
+        state.set_messages_per_op(1);
+        // С запасом на RRQ с дюжинами псевдонимов
+        alignas(std::max_align_t) std::array<std::byte, 8192> storage;
+
+        for ([[maybe_unused]] auto _ : state) {
+            std::pmr::monotonic_buffer_resource mono(storage.data(), storage.size(), std::pmr::null_memory_resource());
+            core::BitReader reader(datagram);
+            auto decoded = h225::RasPDU::decode(reader, arena ? &mono : std::pmr::get_default_resource());
+            if (!decoded) state.fail("RasPDU::decode");
+            bench::do_not_optimize(decoded);
+        }
+    }
+
+    // Декодирование в ячейку пула: после первого сообщения память переиспользуется
+    void pool_bench(State& state, const h225::RasMessage& msg) {
+        auto datagram = encode(msg);
+        state.set_bytes_per_op(datagram.size());
+        state.set_messages_per_op(1);
+        h225::RasMessagePool pool;
+
+        for ([[maybe_unused]] auto _ : state) {
+            auto decoded = pool.decode(datagram);
+            if (!decoded) state.fail("RasMessagePool::decode");
+            bench::do_not_optimize(decoded);
+        }
+    }
+
+    // Пакет recvmmsg: GRQ, RRQ и ARQ по кругу
+    struct Batch {
+        std::vector<std::vector<std::byte>> datagrams;
+        std::vector<std::span<const std::byte>> spans;
+        size_t bytes = 0;
+    };
+
+    Batch make_batch() {
+        Batch batch;
+        const std::array<h225::RasMessage, 3> messages{ make_grq(), make_rrq(), make_arq() };
+        for (size_t i = 0; i < h225::RasBatchDecoder::default_batch; ++i) {
+            batch.datagrams.push_back(encode(messages[i % messages.size()]));
+            batch.bytes += batch.datagrams.back().size();
+        }
+        batch.spans.assign(batch.datagrams.begin(), batch.datagrams.end());
+        return batch;
+    }
+
+    // Тот же пакет по одной датаграмме: peek или decode в арену каждой датаграммы
+    void single_batch_bench(State& state, bool full) {
+        auto batch = make_batch();
+        state.set_bytes_per_op(batch.bytes);
+        state.set_messages_per_op(batch.spans.size());
+        alignas(std::max_align_t) std::array<std::byte, 2048> storage;
+
+        for ([[maybe_unused]] auto _ : state) {
+            for (auto datagram : batch.spans) {
+                if (full) {
+                    std::pmr::monotonic_buffer_resource mono(storage.data(), storage.size(), std::pmr::null_memory_resource());
+                    core::BitReader reader(datagram);
+                    auto decoded = h225::RasPDU::decode(reader, &mono);
+                    if (!decoded) state.fail("RasPDU::decode");
+                    bench::do_not_optimize(decoded);
+                }
+                else {
+                    auto header = h225::RasPDU::peek(datagram);
+                    if (!header) state.fail("RasPDU::peek");
+                    bench::do_not_optimize(header);
+                }
+            }
+        }
+    }
+
+    void batch_bench(State& state, bool full, core::WorkerPool* workers) {
+        auto batch = make_batch();
+        state.set_bytes_per_op(batch.bytes);
+        state.set_messages_per_op(batch.spans.size());
+        h225::RasBatchDecoder decoder(std::pmr::get_default_resource(), workers);
+
+        for ([[maybe_unused]] auto _ : state) {
+            const auto& headers = full ? decoder.decode(batch.spans) : decoder.peek(batch.spans);
+            if (headers.status.front() != ErrorCode::Success) state.fail("RasBatchDecoder");
+            bench::do_not_optimize(headers);
+        }
+    }
+
+    void round_trip_bench(State& state, const h225::RasMessage& msg) {
+        auto datagram = encode(msg);
+        core::BitWriter writer;
+        writer.reserve(512);
+        state.set_bytes_per_op(datagram.size() * 2);
+        state.set_messages_per_op(1);
+        alignas(std::max_align_t) std::array<std::byte, 2048> storage;
+
+        for ([[maybe_unused]] auto _ : state) {
+            std::pmr::monotonic_buffer_resource mono(storage.data(), storage.size(), std::pmr::null_memory_resource());
+            core::BitReader reader(datagram);
+            auto decoded = h225::RasPDU::decode(reader, &mono);
+            if (!decoded) state.fail("RasPDU::decode");
+
+            writer.clear();
+            if (!h225::RasPDU::encode(writer, *decoded)) state.fail("RasPDU::encode");
+            bench::clobber_memory();
+        }
+    }
+
+    void peek_bench(State& state, const h225::RasMessage& msg, bool with_identifier) {
+        auto datagram = encode(msg);
+        state.set_bytes_per_op(datagram.size());
+        state.set_messages_per_op(1);
+
+        for ([[maybe_unused]] auto _ : state) {
+            auto header = h225::RasPDU::peek(datagram, with_identifier);
+            if (!header) state.fail("RasPDU::peek");
+            bench::do_not_optimize(header);
+        }
+    }
+
+} // namespace
+
+H323_26_BENCHMARK("ras/encode/grq") { encode_bench(state, make_grq()); }
+H323_26_BENCHMARK("ras/encode/grq_fixed_slot") { encode_fixed_bench(state, make_grq()); }
+H323_26_BENCHMARK("ras/encode/rrq") { encode_bench(state, make_rrq()); }
+H323_26_BENCHMARK("ras/encode/arq") { encode_bench(state, make_arq()); }
+
+// Подсчет размера и кодирование в слот с проверкой до записи
+H323_26_BENCHMARK("ras/encoded_size/rrq") {
+    auto msg = make_rrq();
+    state.set_messages_per_op(1);
+    for ([[maybe_unused]] auto _ : state) {
+        auto size = h225::RasPDU::encoded_size(msg);
+        if (!size) state.fail("RasPDU::encoded_size");
+        bench::do_not_optimize(size);
+    }
+}
+
+H323_26_BENCHMARK("ras/encode_into/rrq") {
+    auto msg = make_rrq();
+    std::array<std::byte, 512> slot;
+    state.set_bytes_per_op(encode(msg).size());
+    state.set_messages_per_op(1);
+    for ([[maybe_unused]] auto _ : state) {
+        if (!h225::RasPDU::encode_into(slot, msg)) state.fail("RasPDU::encode_into");
+        bench::clobber_memory();
+    }
+}
+
+// Ответ из шаблона: memcpy и перезапись requestSeqNum против полного кодирования
+H323_26_BENCHMARK("ras/encode/rcf") {
+    h225::RasMessage msg = h225::RegistrationConfirm{
+        .requestSeqNum = 1,
+        .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+        .callSignalAddress = { h225::TransportAddress{ .ip = { std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1} }, .port = 1720 } },
+        .gatekeeperIdentifier = "GK-1",
+        .endpointIdentifier = "EP-10001",
+        .timeToLive = 300
+    };
+    std::array<std::byte, 512> slot;
+    state.set_messages_per_op(1);
+    uint16_t seq = 1;
+    for ([[maybe_unused]] auto _ : state) {
+        std::get<h225::RegistrationConfirm>(msg).requestSeqNum = seq++ | 1;
+        if (!h225::RasPDU::encode_into(slot, msg)) state.fail("RasPDU::encode_into");
+        bench::clobber_memory();
+    }
+}
+
+H323_26_BENCHMARK("ras/template/rcf") {
+    auto tpl = h225::RasTemplate<h225::RegistrationConfirm>::make(h225::RegistrationConfirm{
+        .requestSeqNum = 1,
+        .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+        .callSignalAddress = { h225::TransportAddress{ .ip = { std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1} }, .port = 1720 } },
+        .gatekeeperIdentifier = "GK-1",
+        .endpointIdentifier = "EP-10001",
+        .timeToLive = 300
+    });
+    if (!tpl) return state.fail("RasTemplate::make");
+
+    std::array<std::byte, 512> slot;
+    state.set_bytes_per_op(tpl->size());
+    state.set_messages_per_op(1);
+    uint16_t seq = 1;
+    for ([[maybe_unused]] auto _ : state) {
+        (void)tpl->stamp(slot);
+        if (!tpl->patch<&h225::RegistrationConfirm::requestSeqNum>(slot, static_cast<uint16_t>(seq++ | 1))) state.fail("patch");
+        bench::clobber_memory();
+    }
+}
+
+H323_26_BENCHMARK("ras/decode/grq_heap") { decode_bench(state, make_grq(), false); }
+H323_26_BENCHMARK("ras/decode/grq_arena") { decode_bench(state, make_grq(), true); }
+H323_26_BENCHMARK("ras/decode/rrq_arena") { decode_bench(state, make_rrq(), true); }
+H323_26_BENCHMARK("ras/decode/arq_arena") { decode_bench(state, make_arq(), true); }
+H323_26_BENCHMARK("ras/decode/rrq_many_aliases") { decode_bench(state, make_rrq_many_aliases(), true); }
+
+H323_26_BENCHMARK("ras/decode_pool/grq") { pool_bench(state, make_grq()); }
+H323_26_BENCHMARK("ras/decode_pool/rrq") { pool_bench(state, make_rrq()); }
+H323_26_BENCHMARK("ras/decode_pool/rrq_many_aliases") { pool_bench(state, make_rrq_many_aliases()); }
+
+// Пакет из 64 датаграмм: по одной против RasBatchDecoder
+H323_26_BENCHMARK("ras/batch/peek_single") { single_batch_bench(state, false); }
+H323_26_BENCHMARK("ras/batch/peek_batch") { batch_bench(state, false, nullptr); }
+H323_26_BENCHMARK("ras/batch/decode_single") { single_batch_bench(state, true); }
+H323_26_BENCHMARK("ras/batch/decode_batch") { batch_bench(state, true, nullptr); }
+H323_26_BENCHMARK("ras/batch/decode_workers") {
+    // Все ядра: фоновые потоки плюс вызывающий
+    unsigned cores = std::thread::hardware_concurrency();
+    core::WorkerPool workers(cores > 1 ? cores - 1 : 1);
+    batch_bench(state, true, &workers);
+}
+
+H323_26_BENCHMARK("ras/decode_view/grq") {
+    auto datagram = encode(make_grq());
+    state.set_bytes_per_op(datagram.size());
+    state.set_messages_per_op(1);
+    for ([[maybe_unused]] auto _ : state) {
+        core::BitReader reader(datagram);
+        (void)reader.skip_bits(6); // Индекс CHOICE
+        auto view = h225::GatekeeperRequestView::decode(reader);
+        if (!view) state.fail("GatekeeperRequestView::decode");
+        bench::do_not_optimize(view);
+    }
+}
+
+H323_26_BENCHMARK("ras/round_trip/grq") { round_trip_bench(state, make_grq()); }
+H323_26_BENCHMARK("ras/round_trip/rrq") { round_trip_bench(state, make_rrq()); }
+H323_26_BENCHMARK("ras/round_trip/arq") { round_trip_bench(state, make_arq()); }
+
+H323_26_BENCHMARK("ras/peek/rrq_header") { peek_bench(state, make_rrq(), false); }
+H323_26_BENCHMARK("ras/peek/rrq_identifier") { peek_bench(state, make_rrq(), true); }
+
+// Повтор RRQ: заголовок, поиск в кэше и копия готового RCF в слот датаграммы;
+// для сравнения — первый запрос: полный разбор, кодирование ответа и сохранение в кэше
+namespace {
+
+    h225::RasMessage make_rcf(uint16_t seq) {
+        return h225::RegistrationConfirm{
+            .requestSeqNum = seq,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .callSignalAddress = { h225::TransportAddress{ .ip = { std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1} }, .port = 1720 } },
+            .gatekeeperIdentifier = "GK-1",
+            .endpointIdentifier = "EP-10001",
+            .timeToLive = 300
+        };
+    }
+
+    // 4096 клиентов, у каждого свой номер запроса в заголовке
+    constexpr size_t CachedClients = 4096;
+
+    h225::TransportAddress client_address(size_t i) {
+        return h225::TransportAddress{ .ip = { std::byte{10}, std::byte{1}, std::byte{ static_cast<uint8_t>(i >> 8) }, std::byte{ static_cast<uint8_t>(i) } }, .port = 1719 };
+    }
+
+} // namespace
+
+H323_26_BENCHMARK("ras/reply_cache/retransmit_hit") {
+    const auto datagram = encode(make_rrq());
+    auto header = h225::RasPDU::peek(datagram);
+    if (!header) return state.fail("peek");
+
+    h225::RasReplyCache cache(h225::RasReplyCache::Config{ .entries = CachedClients * 4 });
+    const auto now = h225::RasReplyCache::Clock::now();
+    for (size_t i = 0; i < CachedClients; ++i) {
+        if (!cache.encode(*h225::RasReplyCache::key_of(*header, client_address(i)), make_rcf(header->requestSeqNum.value_or(0)), now)) {
+            return state.fail("RasReplyCache::encode");
+        }
+    }
+
+    std::array<std::byte, 512> slot;
+    state.set_messages_per_op(1);
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        auto peeked = h225::RasPDU::peek(datagram);
+        if (!peeked) return state.fail("peek");
+        // Единичные промахи — ответы, вытесненные из переполненных корзин
+        auto cached = cache.find(*h225::RasReplyCache::key_of(*peeked, client_address(i++ % CachedClients)), now);
+        if (cached) std::memcpy(slot.data(), cached->data(), cached->size());
+        bench::clobber_memory();
+    }
+    if (cache.stats().misses * 100 > cache.stats().hits) state.fail("hit rate below 99%");
+}
+
+H323_26_BENCHMARK("ras/reply_cache/first_request") {
+    const auto datagram = encode(make_rrq());
+    h225::RasMessagePool pool;
+    h225::RasReplyCache cache(h225::RasReplyCache::Config{ .entries = CachedClients * 4 });
+    const auto now = h225::RasReplyCache::Clock::now();
+    h225::RasMessage rcf = make_rcf(0);
+
+    std::array<std::byte, 512> slot;
+    state.set_messages_per_op(1);
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        auto msg = pool.decode(datagram);
+        if (!msg) return state.fail("decode");
+        const uint16_t seq = std::get<h225::RegistrationRequest>(**msg).requestSeqNum;
+        std::get<h225::RegistrationConfirm>(rcf).requestSeqNum = seq;
+        auto size = h225::RasPDU::encode_into(slot, rcf);
+        if (!size) return state.fail("encode_into");
+        const h225::RasReplyKey key{ .source = client_address(i++ % CachedClients), .type = h225::RasMessageType::registrationRequest, .requestSeqNum = seq };
+        (void)cache.store(key, std::span(slot).first(*size), now);
+        bench::clobber_memory();
+    }
+}
@@ -0,0 +1,134 @@
+﻿#include "bench.hpp"
+
+#include <h323_26/core/timing_wheel.hpp>
+#include <h323_26/h225/ras_transactions.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <queue>
+#include <vector>
+
+using namespace h323_26;
+using bench::State;
+using core::TimingWheel;
+using namespace std::chrono_literals;
+
+namespace {
+
+    // Живых таймеров: повторы RAS и TTL регистраций крупного привратника
+    constexpr size_t Timers = 1 << 20;
+
+    const TimingWheel::Clock::time_point t0{};
+
+    uint64_t next_random(uint64_t& seed) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    }
+
+    // Сроки от 1 с до часа: повторы RAS (секунды) вперемешку с TTL (минуты)
+    TimingWheel::Clock::duration deadline(uint64_t& seed) {
+        return std::chrono::milliseconds(1000 + next_random(seed) % 3'599'000);
+    }
+
+} // namespace
+
+// Установившийся режим: снять случайный из миллиона таймеров и поставить новый
+// (ответ на запрос и следующий запрос); операция — пара cancel + arm
+H323_26_BENCHMARK("timers/wheel/arm_cancel") {
+    TimingWheel wheel(TimingWheel::Config{ .tick = 10ms, .capacity = Timers }, t0);
+    std::vector<TimingWheel::TimerId> ids(Timers);
+    uint64_t seed = 1;
+    for (size_t i = 0; i < Timers; ++i) ids[i] = wheel.arm(t0 + deadline(seed), i);
+
+    state.set_messages_per_op(1);
+    for ([[maybe_unused]] auto _ : state) {
+        const size_t i = next_random(seed) % Timers;
+        if (!wheel.cancel(ids[i])) state.fail("cancel");
+        ids[i] = wheel.arm(t0 + deadline(seed), i);
+    }
+}
+
+// То же на std::multimap — упорядоченный контейнер с O(log n) на операцию
+H323_26_BENCHMARK("timers/multimap/arm_cancel") {
+    using Map = std::multimap<TimingWheel::Clock::time_point, uint64_t>;
+    Map timers;
+    std::vector<Map::iterator> ids(Timers);
+    uint64_t seed = 1;
+    for (size_t i = 0; i < Timers; ++i) ids[i] = timers.emplace(t0 + deadline(seed), i);
+
+    state.set_messages_per_op(1);
+    for ([[maybe_unused]] auto _ : state) {
+        const size_t i = next_random(seed) % Timers;
+        timers.erase(ids[i]);
+        ids[i] = timers.emplace(t0 + deadline(seed), i);
+    }
+}
+
+// Миллион таймеров на 3-9 с: постановка и срабатывание всех; операция — миллион таймеров
+H323_26_BENCHMARK("timers/wheel/arm_expire") {
+    TimingWheel wheel(TimingWheel::Config{ .tick = 10ms, .capacity = Timers }, t0);
+    state.set_messages_per_op(Timers);
+    auto now = t0;
+    uint64_t seed = 1;
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i = 0; i < Timers; ++i) {
+            wheel.arm(now + 3s + std::chrono::milliseconds(next_random(seed) % 6000), i);
+        }
+        uint64_t sum = 0;
+        // Цикл ввода-вывода будит колесо раз в 50 мс
+        for (auto step = now + 50ms; wheel.size() != 0; step += 50ms) {
+            wheel.advance(step, [&](uint64_t payload) { sum += payload; });
+            now = step;
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+H323_26_BENCHMARK("timers/priority_queue/arm_expire") {
+    using Entry = std::pair<TimingWheel::Clock::time_point, uint64_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> timers;
+    state.set_messages_per_op(Timers);
+    auto now = t0;
+    uint64_t seed = 1;
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i = 0; i < Timers; ++i) {
+            timers.emplace(now + 3s + std::chrono::milliseconds(next_random(seed) % 6000), i);
+        }
+        uint64_t sum = 0;
+        for (auto step = now + 50ms; !timers.empty(); step += 50ms) {
+            while (!timers.empty() && timers.top().first <= step) {
+                sum += timers.top().second;
+                timers.pop();
+            }
+            now = step;
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+// Путь отправки RAS: запрос, ответ на него; 64 тысячи номеров в полете
+H323_26_BENCHMARK("timers/ras_transactions/send_response") {
+    const h225::TransportAddress peer{ .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 1 } }, .port = 1719 };
+    const std::vector<std::byte> urq(24, std::byte{ 0x18 });
+    size_t sent = 0;
+    h225::RasTransactions transactions(h225::RasRetryPolicy{},
+        [&](const h225::TransportAddress&, std::span<const std::byte>) { ++sent; return true; },
+        [](uint16_t, const h225::RasMessage*) {},
+        t0);
+
+    for (uint32_t seq = 0; seq < 65536; ++seq) (void)transactions.send(static_cast<uint16_t>(seq), h225::RasMessageType::unregistrationRequest, peer, urq, t0);
+    h225::RasMessage ucf = h225::UnregistrationConfirm{ .requestSeqNum = 0 };
+
+    state.set_messages_per_op(1);
+    uint16_t seq = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        std::get<h225::UnregistrationConfirm>(ucf).requestSeqNum = seq;
+        if (!transactions.on_response(ucf, peer, t0)) state.fail("on_response");
+        if (!transactions.send(seq, h225::RasMessageType::unregistrationRequest, peer, urq, t0)) state.fail("send");
+        ++seq;
+    }
+    bench::do_not_optimize(sent);
+}
@@ -1,6 +1,9 @@
-﻿#include <h323_26/h225/ras.hpp>
+﻿#include "sample_grq.hpp"
+
+#include <h323_26/h225/ras.hpp>
 #include <h323_26/h225/ras_message.hpp>
 #include <h323_26/core/bit_writer.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <filesystem>
@@ -9,11 +12,7 @@
 using namespace h323_26;
 
 int main() {
-    h225::GatekeeperRequest grq{
-        .requestSeqNum = 1,
-        .protocolIdentifier = {0, 0, 8, 2250, 0, 7}
-    };
-    h225::RasMessage msg = grq;
+    h225::RasMessage msg = compliance::make_sample_grq();
 
     core::BitWriter writer;
 
@@ -40,5 +39,13 @@ int main() {
     std::cout << "Generated H225_RAS_GRQ sample.bin ("
         << data.size() << " bytes)" << std::endl;
 
+    // Кодировка, вычисленная при компиляции, обязана совпадать побайтно
+    const auto& precomputed = compliance::sample_grq_datagram;
+    if (!std::ranges::equal(data, precomputed)) {
+        std::cerr << "Fail: constexpr encoding differs from the runtime encoder" << std::endl;
+        return 1;
+    }
+    std::cout << "constexpr encoding matches (" << precomputed.size() << " bytes)" << std::endl;
+
     return 0;
 }
\ No newline at end of file
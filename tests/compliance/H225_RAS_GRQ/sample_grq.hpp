@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include <h323_26/h225/ras.hpp>
+#include <h323_26/h225/ras_message.hpp>
+
+// Эталонный GRQ компилируемого набора: его выводит gen_h225_ras_grq,
+// с ним же сверяются юнит-тесты
+namespace h323_26::compliance {
+
+    constexpr h225::GatekeeperRequest make_sample_grq() {
+        return h225::GatekeeperRequest{
+            .requestSeqNum = 1,
+            .protocolIdentifier = asn1::InternedOid(asn1::OidId::h225_v7)
+        };
+    }
+
+    // Та же датаграмма, закодированная при компиляции
+    inline constexpr auto sample_grq_datagram =
+        h225::RasPDU::encode_static<h225::RasMessageType::gatekeeperRequest, &make_sample_grq>();
+
+} // namespace h323_26::compliance
@@ -0,0 +1,247 @@
+﻿#include <h323_26/h225/ras.hpp>
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/h225/ras_template.hpp>
+#include <h323_26/transport/ras_server.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// Нагрузочный тест UDP-интерфейса RAS на loopback.
+//
+//     h323_ras_load [--max-threads=N] [--clients=C] [--seconds=S] [--window=W]
+//
+// Для 1, 2, 4, ... N потоков сервера клиенты шлют поток GRQ и RRQ вперемешку, держа
+// по W запросов в полете, и сверяют ответы GCF/RCF по requestSeqNum. Отчет: запросы
+// в секунду и задержка (p50/p99) от отправки до ответа. Клиенты работают на тех же
+// ядрах, что и сервер, поэтому цифры — оценка снизу.
+
+using namespace h323_26;
+using namespace h323_26::h225;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    struct Options {
+        size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t clients = 0;     // 0 — по два клиента на поток сервера
+        double seconds = 2.0;   // на каждое число потоков
+        size_t window = 32;     // запросов в полете на клиента
+    };
+
+    const TransportAddress loopback{ .ip = { std::byte{ 127 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 1 } }, .port = 1719 };
+
+    // Шаблоны запросов клиента и ответов сервера: номер вписывается через patch
+    struct Templates {
+        RasTemplate<GatekeeperRequest> grq;
+        RasTemplate<RegistrationRequest> rrq;
+        RasTemplate<GatekeeperConfirm> gcf;
+        RasTemplate<RegistrationConfirm> rcf;
+    };
+
+    Templates make_templates() {
+        auto grq = RasTemplate<GatekeeperRequest>::make(GatekeeperRequest{
+            .requestSeqNum = 1,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .endpointAlias = "load-terminal"
+        });
+        auto rrq = RasTemplate<RegistrationRequest>::make(RegistrationRequest{
+            .requestSeqNum = 1,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .discoveryComplete = true,
+            .callSignalAddress = { loopback },
+            .rasAddress = { loopback },
+            .terminalAlias = AliasList{ DialedDigits{ "1001" }, H323Id{ "load-terminal" } },
+            .timeToLive = 300
+        });
+        auto gcf = RasTemplate<GatekeeperConfirm>::make(GatekeeperConfirm{
+            .requestSeqNum = 1,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .gatekeeperIdentifier = "GK-LOAD",
+            .rasAddress = loopback
+        });
+        auto rcf = RasTemplate<RegistrationConfirm>::make(RegistrationConfirm{
+            .requestSeqNum = 1,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .callSignalAddress = { loopback },
+            .gatekeeperIdentifier = "GK-LOAD",
+            .endpointIdentifier = "EP-00001",
+            .timeToLive = 300
+        });
+        if (!grq || !rrq || !gcf || !rcf) {
+            std::cerr << "Failed to build RAS templates\n";
+            std::exit(1);
+        }
+        return Templates{ *grq, *rrq, *gcf, *rcf };
+    }
+
+    // Сервер отвечает на GRQ и RRQ копией шаблона с номером запроса
+    transport::RasServer::HandlerFactory confirm_handler(const Templates& templates) {
+        return [&templates](size_t) -> transport::RasHandler {
+            return [&templates](const RasMessage& request, const TransportAddress&, std::span<std::byte> reply) -> size_t {
+                if (const auto* grq = std::get_if<GatekeeperRequest>(&request)) {
+                    auto size = templates.gcf.stamp(reply);
+                    if (!size || !templates.gcf.patch<&GatekeeperConfirm::requestSeqNum>(reply, grq->requestSeqNum)) return 0;
+                    return *size;
+                }
+                if (const auto* rrq = std::get_if<RegistrationRequest>(&request)) {
+                    auto size = templates.rcf.stamp(reply);
+                    if (!size || !templates.rcf.patch<&RegistrationConfirm::requestSeqNum>(reply, rrq->requestSeqNum)) return 0;
+                    return *size;
+                }
+                return 0;
+            };
+        };
+    }
+
+    struct ClientResult {
+        uint64_t completed = 0;
+        uint64_t lost = 0;
+        std::vector<uint32_t> latency_ns;
+    };
+
+    // Клиент с окном window запросов: досылает по одному на каждый ответ.
+    // Ответ, не пришедший за таймаут приема, считается потерянным.
+    void run_client(uint16_t port, const Templates& templates, size_t window, Clock::time_point deadline, ClientResult& result) {
+        int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        const timeval timeout{ .tv_sec = 0, .tv_usec = 100'000 };
+        (void)::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        sockaddr_in server{};
+        server.sin_family = AF_INET;
+        server.sin_port = htons(port);
+        server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&server), sizeof(server)) != 0) {
+            std::cerr << "Client socket failed\n";
+            std::exit(1);
+        }
+
+        std::vector<Clock::time_point> sent_at(65536);
+        std::array<std::byte, 512> datagram;
+        std::array<std::byte, 1500> reply;
+        uint16_t next_seq = 1;
+        size_t in_flight = 0;
+
+        auto send_one = [&]() {
+            const uint16_t seq = next_seq++;
+            Result<size_t> size = (seq % 2 == 0) ? templates.grq.stamp(datagram) : templates.rrq.stamp(datagram);
+            if (size) {
+                if (seq % 2 == 0) (void)templates.grq.patch<&GatekeeperRequest::requestSeqNum>(datagram, seq);
+                else (void)templates.rrq.patch<&RegistrationRequest::requestSeqNum>(datagram, seq);
+                sent_at[seq] = Clock::now();
+                if (::send(fd, datagram.data(), *size, 0) > 0) ++in_flight;
+            }
+        };
+
+        while (Clock::now() < deadline) {
+            while (in_flight < window) send_one();
+
+            ssize_t size = ::recv(fd, reply.data(), reply.size(), 0);
+            if (size <= 0) {
+                // Таймаут: окно целиком потеряно
+                result.lost += in_flight;
+                in_flight = 0;
+                continue;
+            }
+            --in_flight;
+
+            auto header = RasPDU::peek(std::span<const std::byte>(reply.data(), static_cast<size_t>(size)));
+            if (!header || !header->requestSeqNum) continue;
+            auto latency = Clock::now() - sent_at[*header->requestSeqNum];
+            result.latency_ns.push_back(static_cast<uint32_t>(std::min<int64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count(), UINT32_MAX)));
+            ++result.completed;
+        }
+        ::close(fd);
+    }
+
+    double percentile_us(std::vector<uint32_t>& samples, double p) {
+        if (samples.empty()) return 0;
+        size_t k = static_cast<size_t>(p * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(k), samples.end());
+        return samples[k] / 1000.0;
+    }
+
+    bool parse_options(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            if (arg.starts_with("--max-threads=")) options.max_threads = std::strtoul(argv[i] + 14, nullptr, 10);
+            else if (arg.starts_with("--clients=")) options.clients = std::strtoul(argv[i] + 10, nullptr, 10);
+            else if (arg.starts_with("--seconds=")) options.seconds = std::atof(argv[i] + 10);
+            else if (arg.starts_with("--window=")) options.window = std::strtoul(argv[i] + 9, nullptr, 10);
+            else {
+                std::cerr << "Usage: h323_ras_load [--max-threads=N] [--clients=C] [--seconds=S] [--window=W]\n";
+                return false;
+            }
+        }
+        options.max_threads = std::max<size_t>(options.max_threads, 1);
+        options.window = std::max<size_t>(options.window, 1);
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) return 2;
+
+    const Templates templates = make_templates();
+    std::printf("%8s %8s %14s %10s %10s %10s %10s\n", "threads", "clients", "requests/s", "p50_us", "p99_us", "lost", "batch");
+
+    // 1, 2, 4, ... и последним — ровно max_threads
+    for (size_t threads = 1;; threads = std::min(threads * 2, options.max_threads)) {
+        // Номера запросов клиента ходят по кругу: без кэша ответов замеряется обработка, а не повторы
+        transport::RasServerConfig config{ .threads = threads, .reply_cache = 0 };
+        config.bind.port = 0;
+        auto server = transport::RasServer::start(config, confirm_handler(templates));
+        if (!server) {
+            std::cerr << "RasServer::start failed: " << server.error().message << "\n";
+            return 1;
+        }
+
+        const size_t clients = options.clients != 0 ? options.clients : threads * 2;
+        std::vector<ClientResult> results(clients);
+        std::vector<std::thread> workers;
+        const auto started = Clock::now();
+        const auto deadline = started + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+        for (size_t i = 0; i < clients; ++i) {
+            workers.emplace_back(run_client, (*server)->port(), std::cref(templates), options.window, deadline, std::ref(results[i]));
+        }
+        for (auto& worker : workers) worker.join();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - started).count();
+
+        uint64_t completed = 0;
+        uint64_t lost = 0;
+        std::vector<uint32_t> latency;
+        for (auto& result : results) {
+            completed += result.completed;
+            lost += result.lost;
+            latency.insert(latency.end(), result.latency_ns.begin(), result.latency_ns.end());
+        }
+
+        // Средний размер пакета recvmmsg показывает, насколько сервер нагружен
+        auto stats = (*server)->stats();
+        (*server)->stop();
+        double batch = stats.batches ? static_cast<double>(stats.received) / static_cast<double>(stats.batches) : 0;
+
+        std::printf("%8zu %8zu %14.0f %10.1f %10.1f %10llu %10.1f\n",
+            threads, clients, static_cast<double>(completed) / elapsed,
+            percentile_us(latency, 0.50), percentile_us(latency, 0.99),
+            static_cast<unsigned long long>(lost), batch);
+        if (threads == options.max_threads) break;
+    }
+    return 0;
+}
@@ -0,0 +1,571 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/asn1/schema.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <array>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace h323_26;
+
+namespace {
+
+    enum class Reason : uint8_t { Busy, Denied, Unknown };
+
+    struct Inner {
+        bool flag;
+        uint32_t value;
+
+        using Schema = asn1::Sequence<Inner, asn1::NotExtensible,
+            asn1::Field<&Inner::flag, asn1::Boolean>,
+            asn1::Field<&Inner::value, asn1::Integer<0, 4294967295ULL>>>;
+    };
+
+    struct Sample {
+        uint16_t seq;
+        std::optional<std::pmr::string> name;
+        Reason reason;
+        std::variant<uint8_t, std::pmr::string, Inner> payload;
+        std::optional<std::pmr::vector<uint32_t>> oid;
+        std::pmr::vector<Inner> items;
+
+        using Schema = asn1::Sequence<Sample, asn1::Extensible,
+            asn1::Field<&Sample::seq, asn1::Integer<1, 65535>>,
+            asn1::Field<&Sample::name, asn1::Optional<asn1::IA5String<1, 32>>>,
+            asn1::Field<&Sample::reason, asn1::Enumerated<3>>,
+            asn1::Field<&Sample::payload, asn1::Choice<asn1::Extensible,
+                asn1::Integer<0, 15>, asn1::IA5String<>, Inner::Schema>>,
+            asn1::Field<&Sample::oid, asn1::Optional<asn1::ObjectIdentifier>>,
+            asn1::Field<&Sample::items, asn1::SequenceOf<Inner::Schema, 0, 4>>>;
+    };
+
+    struct Extended {
+        uint16_t id = 0;
+        std::optional<bool> flag{};
+        asn1::ExtensionAdditions extensions{};
+
+        using Schema = asn1::Sequence<Extended, asn1::Extensible,
+            asn1::Field<&Extended::id, asn1::Integer<0, 1023>>,
+            asn1::Field<&Extended::flag, asn1::Optional<asn1::Boolean>>,
+            asn1::Field<&Extended::extensions, asn1::Additions>>;
+    };
+
+    // Та же корневая часть, но без члена для дополнений — их приходится пропускать
+    struct RootOnly {
+        uint16_t id;
+        std::optional<bool> flag;
+
+        using Schema = asn1::Sequence<RootOnly, asn1::Extensible,
+            asn1::Field<&RootOnly::id, asn1::Integer<0, 1023>>,
+            asn1::Field<&RootOnly::flag, asn1::Optional<asn1::Boolean>>>;
+    };
+
+    struct Pair {
+        RootOnly first;
+        uint8_t trailer;
+
+        using Schema = asn1::Sequence<Pair, asn1::NotExtensible,
+            asn1::Field<&Pair::first, RootOnly::Schema>,
+            asn1::Field<&Pair::trailer, asn1::Integer<0, 255>>>;
+    };
+
+    struct Address {
+        std::array<std::byte, 4> ip;
+        uint16_t port;
+
+        using Schema = asn1::Sequence<Address, asn1::NotExtensible,
+            asn1::Field<&Address::ip, asn1::OctetString<4, 4>>,
+            asn1::Field<&Address::port, asn1::Integer<0, 65535>>>;
+
+        bool operator==(const Address&) const = default;
+    };
+
+    // Префикс фиксированной формы (адрес, приоритет, флаг, причина) перед строкой переменной длины
+    struct Endpoint {
+        Address address;
+        uint8_t priority;
+        std::optional<bool> urgent;
+        Reason reason;
+        std::pmr::string name;
+
+        using Schema = asn1::Sequence<Endpoint, asn1::Extensible,
+            asn1::Field<&Endpoint::address, Address::Schema>,
+            asn1::Field<&Endpoint::priority, asn1::Integer<0, 2>>,
+            asn1::Field<&Endpoint::urgent, asn1::Optional<asn1::Boolean>>,
+            asn1::Field<&Endpoint::reason, asn1::Enumerated<3>>,
+            asn1::Field<&Endpoint::name, asn1::IA5String<1, 16>>>;
+    };
+
+    // Раскладка вычисляется при компиляции
+    static_assert(Sample::Schema::optional_count == 2);
+    static_assert(Sample::Schema::header_bits == 3);
+    static_assert(Inner::Schema::header_bits == 0);
+    static_assert(asn1::Integer<1, 65535>::bits == 16);
+    static_assert(asn1::Integer<5, 5>::bits == 0);
+    static_assert(asn1::Enumerated<3>::bits == 2);
+    static_assert(asn1::Choice<asn1::Extensible, asn1::Boolean, asn1::Boolean, asn1::Boolean>::header_bits == 3);
+    static_assert(asn1::Size<1, 32>::length_bits == 5);
+    static_assert(!asn1::Size<0, asn1::Unbounded>::constrained);
+    static_assert(Sample::Schema::field_index<&Sample::seq> == 0);
+    static_assert(Sample::Schema::field_index<&Sample::oid> == 4);
+
+    // Границы префикса фиксированной формы: выравнивание считается по худшему случаю
+    static_assert(Address::Schema::max_bits == 7 + 32 + 7 + 16);
+    static_assert(Endpoint::Schema::prefix_fields == 4);
+    static_assert(Endpoint::Schema::prefix_bits == 2 + 62 + 2 + 1 + 3);
+    static_assert(Endpoint::Schema::max_bits == asn1::Unbounded);
+    static_assert(Sample::Schema::prefix_fields == 1);
+    static_assert(Inner::Schema::prefix_fields == 1);   // 32-битное value — indefinite-форма
+
+} // namespace
+
+TEST_CASE("ASN.1 schema: SEQUENCE round trip", "[asn1][schema]") {
+    Sample original{
+        .seq = 500,
+        .name = "endpoint",
+        .reason = Reason::Denied,
+        .payload = Inner{ .flag = true, .value = 123456789 },
+        .oid = std::pmr::vector<uint32_t>{ 0, 0, 8, 2250, 0, 7 },
+        .items = { Inner{ false, 1 }, Inner{ true, 2 } }
+    };
+
+    core::BitWriter writer;
+    REQUIRE(Sample::Schema::encode(writer, original).has_value());
+
+    core::BitReader reader(writer.data());
+    auto decoded = Sample::Schema::decode(reader);
+    REQUIRE(decoded.has_value());
+
+    CHECK(decoded->seq == 500);
+    CHECK(decoded->name == "endpoint");
+    CHECK(decoded->reason == Reason::Denied);
+    REQUIRE(std::holds_alternative<Inner>(decoded->payload));
+    CHECK(std::get<Inner>(decoded->payload).flag);
+    CHECK(std::get<Inner>(decoded->payload).value == 123456789);
+    REQUIRE(decoded->oid.has_value());
+    CHECK(*decoded->oid == *original.oid);
+    REQUIRE(decoded->items.size() == 2);
+    CHECK(decoded->items[1].value == 2);
+    CHECK(reader.bits_left() < 8);
+}
+
+TEST_CASE("ASN.1 schema: header layout", "[asn1][schema]") {
+    Sample sample{
+        .seq = 1,
+        .name = std::nullopt,
+        .reason = Reason::Busy,
+        .payload = uint8_t{ 9 },
+        .oid = std::pmr::vector<uint32_t>{ 1, 2 },
+        .items = {}
+    };
+
+    core::BitWriter writer;
+    REQUIRE(Sample::Schema::encode(writer, sample).has_value());
+
+    // ext=0, name absent=0, oid present=1 | выравнивание | seq-1 = 0 (два октета) | ...
+    core::BitReader reader(writer.data());
+    CHECK(reader.read_bits(3).value() == 0b001);
+    CHECK(reader.read_bits(5).value() == 0);
+    CHECK(reader.read_bits(16).value() == 0);
+    CHECK(reader.read_bits(3).value() == 0);         // Enumerated: ext=0, index 0
+    CHECK(reader.read_bits(3).value() == 0b000);     // Choice: ext=0, index 0
+    CHECK(reader.read_bits(4).value() == 9);
+}
+
+TEST_CASE("ASN.1 schema: constraint violations", "[asn1][schema]") {
+    Sample sample{
+        .seq = 1,
+        .name = std::pmr::string(40, 'x'),
+        .reason = Reason::Busy,
+        .payload = uint8_t{ 0 },
+        .oid = std::nullopt,
+        .items = {}
+    };
+
+    SECTION("SIZE upper bound is enforced on encode") {
+        core::BitWriter writer;
+        auto res = Sample::Schema::encode(writer, sample);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::InvalidConstraint);
+    }
+
+    SECTION("Out of range INTEGER is rejected") {
+        sample.name = std::nullopt;
+        sample.seq = 0;
+        core::BitWriter writer;
+        auto res = Sample::Schema::encode(writer, sample);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::InvalidConstraint);
+    }
+
+    SECTION("Invalid CHOICE index on decode") {
+        // Заголовок: ext=0, преамбула 00, выровненный seq, enum, затем CHOICE с индексом 3 (из трех вариантов)
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(0, 3 + 5 + 16 + 3).has_value());
+        REQUIRE(writer.write_bits(0b011, 3).has_value());
+        REQUIRE(writer.write_bits(0, 16).has_value());
+
+        core::BitReader reader(writer.data());
+        auto res = Sample::Schema::decode(reader);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::InvalidConstraint);
+    }
+
+    SECTION("Truncated input reports EndOfStream") {
+        sample.name = std::nullopt;
+        core::BitWriter writer;
+        REQUIRE(Sample::Schema::encode(writer, sample).has_value());
+        auto bytes = writer.data();
+        bytes.resize(2);
+
+        core::BitReader reader(bytes);
+        auto res = Sample::Schema::decode(reader);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::EndOfStream);
+    }
+}
+
+TEST_CASE("ASN.1 schema: skipping and single-field decode", "[asn1][schema]") {
+    Sample original{
+        .seq = 9,
+        .name = std::nullopt,
+        .reason = Reason::Busy,
+        .payload = std::pmr::string("text payload"),
+        .oid = std::pmr::vector<uint32_t>{ 0, 0, 8, 2250, 0, 7 },
+        .items = { Inner{ true, 7 } }
+    };
+
+    core::BitWriter writer;
+    REQUIRE(Sample::Schema::encode(writer, original).has_value());
+    REQUIRE(writer.write_bits(0x2A, 8).has_value()); // Данные после SEQUENCE
+
+    SECTION("skip_value stops exactly at the end of the SEQUENCE") {
+        core::BitReader reader(writer.data());
+        REQUIRE(Sample::Schema::skip_value(reader).has_value());
+        CHECK(reader.read_bits(8).value() == 0x2A);
+    }
+
+    SECTION("decode_field skips the fields in front of the member") {
+        core::BitReader reader(writer.data());
+        auto oid = Sample::Schema::decode_field<&Sample::oid, asn1::OidView>(reader);
+        REQUIRE(oid.has_value());
+        REQUIRE(oid->has_value());
+        CHECK((*oid)->equals(std::vector<uint32_t>{ 0, 0, 8, 2250, 0, 7 }));
+    }
+
+    SECTION("decode_field reports an absent OPTIONAL as nullopt") {
+        core::BitReader reader(writer.data());
+        auto name = Sample::Schema::decode_field<&Sample::name, std::string_view>(reader);
+        REQUIRE(name.has_value());
+        CHECK_FALSE(name->has_value());
+    }
+}
+
+TEST_CASE("ASN.1 schema: SEQUENCE extension additions", "[asn1][schema]") {
+    // Кодировки дополнений готовятся заранее: Inner и IA5String
+    core::BitWriter inner_bits;
+    REQUIRE(Inner::Schema::encode(inner_bits, Inner{ true, 99 }).has_value());
+    inner_bits.align_to_byte();
+    core::BitWriter text_bits;
+    REQUIRE(asn1::IA5String<>::encode_value(text_bits, std::string_view("feature")).has_value());
+    text_bits.align_to_byte();
+
+    Extended original{ .id = 512, .flag = false };
+    original.extensions.set_raw(0, inner_bits.data());
+    original.extensions.set_raw(2, text_bits.data()); // Дополнение 1 отсутствует
+
+    core::BitWriter writer;
+    REQUIRE(Extended::Schema::encode(writer, original).has_value());
+
+    SECTION("Additions are captured as raw spans and decoded on access") {
+        core::BitReader reader(writer.data());
+        auto decoded = Extended::Schema::decode(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(decoded->id == 512);
+        CHECK(decoded->flag == false);
+        CHECK(reader.bits_left() == 0);
+
+        const auto& ext = decoded->extensions;
+        REQUIRE(ext.size() == 3);
+        CHECK(ext.has(0));
+        CHECK_FALSE(ext.has(1));
+        CHECK(ext.has(2));
+        CHECK_FALSE(ext.has(7));
+
+        auto inner = ext.get<Inner::Schema, Inner>(0);
+        REQUIRE(inner.has_value());
+        REQUIRE(inner->has_value());
+        CHECK((*inner)->value == 99);
+
+        auto text = ext.get<asn1::IA5String<>, std::string_view>(2);
+        REQUIRE(text.has_value());
+        CHECK(*text == "feature");
+
+        auto absent = ext.get<asn1::Boolean, bool>(1);
+        REQUIRE(absent.has_value());
+        CHECK_FALSE(absent->has_value());
+    }
+
+    SECTION("Absent additions leave the extension bit clear") {
+        core::BitWriter plain;
+        REQUIRE(Extended::Schema::encode(plain, Extended{ .id = 1 }).has_value());
+        core::BitReader reader(plain.data());
+        CHECK(reader.read_bits(1).value() == 0);
+    }
+
+    SECTION("A type without an additions member skips them") {
+        core::BitWriter pair_bits;
+        REQUIRE(Extended::Schema::encode(pair_bits, original).has_value());
+        REQUIRE(pair_bits.write_bits(0xA5, 8).has_value());
+
+        core::BitReader reader(pair_bits.data());
+        auto pair = Pair::Schema::decode(reader);
+        REQUIRE(pair.has_value());
+        CHECK(pair->first.id == 512);
+        CHECK(pair->trailer == 0xA5);
+
+        core::BitReader skipper(pair_bits.data());
+        REQUIRE(Pair::Schema::skip_value(skipper).has_value());
+        CHECK(skipper.bits_left() == 0);
+    }
+}
+
+TEST_CASE("ASN.1 schema: unbounded OCTET STRING above 16K", "[asn1][schema]") {
+    using Blob = asn1::OctetString<>;
+    std::pmr::vector<std::byte> payload(50000);
+    for (size_t i = 0; i < payload.size(); ++i) payload[i] = std::byte(static_cast<uint8_t>(i));
+
+    core::BitWriter writer;
+    REQUIRE(writer.write_bits(1, 3).has_value()); // Невыровненное начало
+    REQUIRE(Blob::encode_value(writer, payload).has_value());
+
+    core::BitReader reader(writer.data());
+    REQUIRE(reader.skip_bits(3).has_value());
+    auto decoded = Blob::decode_value<std::pmr::vector<std::byte>>(reader, {});
+    REQUIRE(decoded.has_value());
+    CHECK(*decoded == payload);
+
+    core::BitReader skipper(writer.data());
+    REQUIRE(skipper.skip_bits(3).has_value());
+    REQUIRE(Blob::skip_value(skipper).has_value());
+    CHECK(skipper.bits_left() == 0);
+}
+
+TEST_CASE("ASN.1 schema: hoisted bounds check for a fixed-shape prefix", "[asn1][schema]") {
+    Endpoint original{
+        .address = Address{ .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 7 } }, .port = 1719 },
+        .priority = 2,
+        .urgent = true,
+        .reason = Reason::Unknown,
+        .name = "gw-1"
+    };
+
+    core::BitWriter writer;
+    REQUIRE(Endpoint::Schema::encode(writer, original).has_value());
+    auto bytes = writer.data();
+
+    SECTION("The prefix decodes the same as field-by-field reads") {
+        core::BitReader reader(bytes);
+        auto decoded = Endpoint::Schema::decode(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(decoded->address == original.address);
+        CHECK(decoded->priority == 2);
+        CHECK(decoded->urgent == true);
+        CHECK(decoded->reason == Reason::Unknown);
+        CHECK(decoded->name == "gw-1");
+        CHECK(reader.bits_left() == 0);
+    }
+
+    SECTION("Every truncation still reports EndOfStream") {
+        for (size_t length = 0; length < bytes.size(); ++length) {
+            core::BitReader reader(std::span<const std::byte>(bytes).first(length));
+            auto res = Endpoint::Schema::decode(reader);
+            REQUIRE_FALSE(res.has_value());
+            CHECK(res.error().code == ErrorCode::EndOfStream);
+        }
+    }
+
+    SECTION("Constraint errors are the same on both paths") {
+        // priority (0..2) — старшие биты октета 7: заголовок дополняется до октета, за ним 4 + 2 октета адреса
+        bytes[7] |= std::byte{ 0xC0 };
+
+        core::BitReader full(bytes);
+        auto hoisted = Endpoint::Schema::decode(full);
+        REQUIRE_FALSE(hoisted.has_value());
+
+        // Восемь октетов короче prefix_bits — разбор идет с проверкой каждого чтения
+        core::BitReader shorter(std::span<const std::byte>(bytes).first(8));
+        auto checked = Endpoint::Schema::decode(shorter);
+        REQUIRE_FALSE(checked.has_value());
+
+        CHECK(hoisted.error().code == ErrorCode::InvalidConstraint);
+        CHECK(checked.error().code == hoisted.error().code);
+        CHECK(checked.error().message == hoisted.error().message);
+    }
+}
+
+TEST_CASE("ASN.1 schema: character sets and BIT STRING", "[asn1][schema][strings]") {
+    SECTION("BMPString keeps UTF-8 in the program and counts characters in SIZE") {
+        using Name = asn1::BMPString<1, 4>;
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(1, 5).has_value()); // Невыровненное начало
+        REQUIRE(Name::encode_value(writer, std::string_view("\xD0\x96\xC3\xBC" "ab")).has_value());
+
+        core::BitReader reader(writer.data());
+        REQUIRE(reader.skip_bits(5).has_value());
+        auto decoded = Name::decode_value<std::pmr::string>(reader, {});
+        REQUIRE(decoded.has_value());
+        CHECK(*decoded == "\xD0\x96\xC3\xBC" "ab");
+
+        core::BitReader skipper(writer.data());
+        REQUIRE(skipper.skip_bits(5).has_value());
+        REQUIRE(Name::skip_value(skipper).has_value());
+        CHECK(skipper.bit_offset() == reader.bit_offset());
+
+        // Пять символов при восьми октетах UTF-8 и символ вне BMP
+        core::BitWriter rejected;
+        CHECK(Name::encode_value(rejected, std::string_view("abcde")).error().code == ErrorCode::InvalidConstraint);
+        CHECK_FALSE(Name::encode_value(rejected, std::string_view("\xF0\x9F\x98\x80")).has_value());
+    }
+
+    SECTION("PrintableString and IA5String reject characters outside the alphabet") {
+        using Label = asn1::PrintableString<0, 16>;
+        core::BitWriter writer;
+        REQUIRE(Label::encode_value(writer, std::string_view("Zone A-1")).has_value());
+        CHECK(Label::encode_value(writer, std::string_view("a*b")).error().code == ErrorCode::InvalidConstraint);
+        CHECK(Label::encode_value(writer, std::string_view("x@y")).error().code == ErrorCode::InvalidConstraint);
+
+        // Тот же текст как IA5String на проводе, но с символом, которого нет в PrintableString
+        core::BitWriter ia5;
+        REQUIRE(asn1::IA5String<0, 16>::encode_value(ia5, std::string_view("a*b")).has_value());
+        core::BitReader reader(ia5.data());
+        auto res = Label::decode_value<std::string_view>(reader, {});
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::InvalidConstraint);
+
+        // Октет за пределами IA5 (0x80 и выше) в полученной строке
+        std::vector<std::byte> bytes{ std::byte{ 0x03 }, std::byte{ 'a' }, std::byte{ 0xE9 }, std::byte{ 'b' } };
+        core::BitReader high(bytes);
+        CHECK(asn1::IA5String<>::decode_value<std::pmr::string>(high, {}).error().code == ErrorCode::InvalidConstraint);
+
+        static_assert(Label::permitted("0-9 (a,b) ./:=?+'") && !Label::permitted("a_b"));
+    }
+
+    SECTION("Fixed and unconstrained BIT STRING") {
+        using Flags = asn1::BitString<12, 12>;
+        static_assert(Flags::max_bits == 12);
+
+        asn1::BitStringValue flags(std::pmr::vector<std::byte>{ std::byte{ 0xA5 }, std::byte{ 0x30 } }, 12);
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(1, 3).has_value());
+        REQUIRE(Flags::encode_value(writer, flags).has_value());
+        REQUIRE(asn1::BitString<>::encode_value(writer, flags).has_value());
+        // Фиксированная — без длины и выравнивания; у неограниченной — выравнивание и октет длины
+        CHECK(writer.bit_offset() == 3 + 12 + 1 + 8 + 12);
+
+        core::BitReader reader(writer.data());
+        REQUIRE(reader.skip_bits(3).has_value());
+        auto fixed = Flags::decode_value<asn1::BitStringValue>(reader, {});
+        REQUIRE(fixed.has_value());
+        CHECK(*fixed == flags);
+        CHECK(fixed->test(0));
+        CHECK_FALSE(fixed->test(1));
+        CHECK(fixed->test(10));
+        CHECK_FALSE(fixed->test(12));
+
+        auto open = asn1::BitString<>::decode_value<asn1::BitStringValue>(reader, {});
+        REQUIRE(open.has_value());
+        CHECK(*open == flags);
+        CHECK(reader.bits_left() < 8);
+
+        core::BitReader skipper(writer.data());
+        REQUIRE(skipper.skip_bits(3).has_value());
+        REQUIRE(Flags::skip_value(skipper).has_value());
+        REQUIRE(asn1::BitString<>::skip_value(skipper).has_value());
+        CHECK(skipper.bit_offset() == reader.bit_offset());
+    }
+}
+
+TEST_CASE("ASN.1 schema: decode_into overwrites an existing value", "[asn1][schema]") {
+    auto encode = [](const Sample& sample) {
+        core::BitWriter writer;
+        REQUIRE(Sample::Schema::encode(writer, sample).has_value());
+        return writer.data();
+    };
+
+    Sample first{
+        .seq = 1,
+        .name = "endpoint-name-on-the-heap-000001",
+        .reason = Reason::Busy,
+        .payload = std::pmr::string("text payload that does not fit SSO"),
+        .oid = std::pmr::vector<uint32_t>{ 0, 0, 8, 2250, 0, 7 },
+        .items = { Inner{ true, 1 }, Inner{ false, 2 }, Inner{ true, 3 } }
+    };
+    Sample second{
+        .seq = 2,
+        .name = "shorter-name-on-the-heap",
+        .reason = Reason::Unknown,
+        .payload = std::pmr::string("another text payload"),
+        .oid = std::nullopt,
+        .items = { Inner{ false, 7 } }
+    };
+
+    auto first_bytes = encode(first);
+    auto second_bytes = encode(second);
+
+    Sample target{};
+    core::BitReader reader(first_bytes);
+    REQUIRE(Sample::Schema::decode_into(target, reader).has_value());
+    CHECK(target.name == first.name);
+    CHECK(target.items.size() == 3);
+
+    SECTION("Strings and vectors keep their storage") {
+        const char* name_storage = target.name->data();
+        const char* payload_storage = std::get<std::pmr::string>(target.payload).data();
+        const Inner* items_storage = target.items.data();
+
+        core::BitReader again(second_bytes);
+        REQUIRE(Sample::Schema::decode_into(target, again).has_value());
+        CHECK(again.bits_left() < 8);
+
+        CHECK(target.seq == 2);
+        CHECK(target.name == second.name);
+        CHECK(target.reason == Reason::Unknown);
+        CHECK(std::get<std::pmr::string>(target.payload) == "another text payload");
+        CHECK_FALSE(target.oid.has_value());
+        REQUIRE(target.items.size() == 1);
+        CHECK(target.items[0].value == 7);
+
+        CHECK(target.name->data() == name_storage);
+        CHECK(std::get<std::pmr::string>(target.payload).data() == payload_storage);
+        CHECK(target.items.data() == items_storage);
+    }
+
+    SECTION("A different CHOICE alternative and longer lists are rebuilt") {
+        second.payload = Inner{ .flag = true, .value = 99 };
+        second.items = { Inner{ true, 4 }, Inner{ true, 5 }, Inner{ false, 6 }, Inner{ true, 7 } };
+        auto bytes = encode(second);
+
+        core::BitReader again(bytes);
+        REQUIRE(Sample::Schema::decode_into(target, again).has_value());
+        REQUIRE(std::holds_alternative<Inner>(target.payload));
+        CHECK(std::get<Inner>(target.payload).value == 99);
+        REQUIRE(target.items.size() == 4);
+        for (size_t i = 0; i < 4; ++i) CHECK(target.items[i].value == second.items[i].value);
+    }
+
+    SECTION("Errors are the same as for decode") {
+        second_bytes.resize(3);
+        core::BitReader fresh(second_bytes);
+        auto expected = Sample::Schema::decode(fresh);
+        REQUIRE_FALSE(expected.has_value());
+
+        core::BitReader again(second_bytes);
+        auto res = Sample::Schema::decode_into(target, again);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == expected.error().code);
+    }
+}
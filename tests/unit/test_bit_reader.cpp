@@ -36,3 +36,96 @@ TEST_CASE("BitReader basic functionality", "[core]") {
         CHECK(val.error().code == ErrorCode::EndOfStream);
     }
 }
+
+TEST_CASE("BitReader word-at-a-time reads", "[core]") {
+    std::vector<std::byte> data;
+    for (int i = 0; i < 20; ++i) data.push_back(static_cast<std::byte>(0x11 * (i % 16)));
+    core::BitReader reader(data);
+
+    SECTION("64-bit read at an unaligned offset spans nine bytes") {
+        REQUIRE(reader.read_bits(4).has_value());
+        auto val = reader.read_bits(64);
+        REQUIRE(val.has_value());
+        CHECK(val.value() == 0x0112233445566778ULL);
+        CHECK(reader.bits_left() == 20 * 8 - 68);
+    }
+
+    SECTION("Peek does not advance, skip does") {
+        REQUIRE(reader.skip_bits(12).has_value());
+        auto peeked = reader.peek_bits(16);
+        REQUIRE(peeked.has_value());
+        CHECK(peeked.value() == 0x1223);
+        CHECK(reader.bit_offset() == 12);
+
+        auto val = reader.read_bits(16);
+        REQUIRE(val.has_value());
+        CHECK(val.value() == peeked.value());
+    }
+
+    SECTION("Skip past the end fails without moving the cursor") {
+        auto res = reader.skip_bits(20 * 8 + 1);
+        CHECK_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::EndOfStream);
+        CHECK(reader.bit_offset() == 0);
+    }
+
+    SECTION("Unchecked accessors match the checked ones") {
+        for (size_t offset = 0; offset < 20 * 8; ++offset) {
+            for (size_t count = 1; count <= 64 && offset + count <= 20 * 8; ++count) {
+                core::BitReader checked(data);
+                core::BitReader unchecked(data);
+                REQUIRE(checked.skip_bits(offset).has_value());
+                unchecked.skip_bits_unchecked(offset);
+
+                CHECK(unchecked.peek_bits_unchecked(count) == checked.peek_bits(count).value());
+                CHECK(unchecked.read_bits_unchecked(count) == checked.read_bits(count).value());
+                CHECK(unchecked.bit_offset() == checked.bit_offset());
+            }
+        }
+    }
+
+    SECTION("Tail reads near the end of the buffer") {
+        REQUIRE(reader.skip_bits(20 * 8 - 12).has_value());
+        auto val = reader.read_bits(12);
+        REQUIRE(val.has_value());
+        CHECK(val.value() == 0x233);
+        CHECK(reader.bits_left() == 0);
+    }
+}
+
+TEST_CASE("BitReader bulk read_bytes", "[core]") {
+    std::vector<std::byte> data;
+    for (int i = 0; i < 24; ++i) data.push_back(static_cast<std::byte>(i * 7));
+
+    SECTION("Aligned run") {
+        core::BitReader reader(data);
+        std::vector<std::byte> out(24);
+        REQUIRE(reader.read_bytes(out).has_value());
+        CHECK(out == data);
+    }
+
+    SECTION("Unaligned run matches byte-by-byte reads") {
+        core::BitReader bulk(data);
+        core::BitReader slow(data);
+        REQUIRE(bulk.skip_bits(3).has_value());
+        REQUIRE(slow.skip_bits(3).has_value());
+
+        std::vector<std::byte> out(20);
+        REQUIRE(bulk.read_bytes(out).has_value());
+        for (auto b : out) {
+            auto val = slow.read_bits(8);
+            REQUIRE(val.has_value());
+            CHECK(static_cast<uint64_t>(b) == val.value());
+        }
+        CHECK(bulk.bit_offset() == slow.bit_offset());
+    }
+
+    SECTION("Overrun is reported") {
+        core::BitReader reader(data);
+        REQUIRE(reader.skip_bits(1).has_value());
+        std::vector<std::byte> out(24);
+        auto res = reader.read_bytes(out);
+        CHECK_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::EndOfStream);
+    }
+}
@@ -0,0 +1,173 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <h323_26/core/fixed_bit_writer.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <array>
+#include <vector>
+#include <cstddef>
+
+using namespace h323_26;
+
+TEST_CASE("BitWriter basic functionality", "[core]") {
+    core::BitWriter writer;
+
+    SECTION("Bits are packed MSB first") {
+        REQUIRE(writer.write_bits(1, 1).has_value());
+        REQUIRE(writer.write_bits(0b010, 3).has_value());
+        REQUIRE(writer.write_bits(0xAB, 8).has_value());
+        // 1 010 1010 1011 (0000) -> 0xAA 0xB0
+        REQUIRE(writer.data().size() == 2);
+        CHECK(writer.data()[0] == std::byte{ 0xAA });
+        CHECK(writer.data()[1] == std::byte{ 0xB0 });
+    }
+
+    SECTION("Value is masked to count bits") {
+        REQUIRE(writer.write_bits(0xFF, 4).has_value());
+        REQUIRE(writer.data().size() == 1);
+        CHECK(writer.data()[0] == std::byte{ 0xF0 });
+    }
+
+    SECTION("64-bit write at an unaligned offset") {
+        REQUIRE(writer.write_bits(0b101, 3).has_value());
+        REQUIRE(writer.write_bits(0x0123456789ABCDEFULL, 64).has_value());
+
+        core::BitReader reader(writer.data());
+        CHECK(reader.read_bits(3).value() == 0b101);
+        CHECK(reader.read_bits(64).value() == 0x0123456789ABCDEFULL);
+    }
+
+    SECTION("More than 64 bits is rejected") {
+        auto res = writer.write_bits(0, 65);
+        CHECK_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::InvalidConstraint);
+    }
+}
+
+TEST_CASE("BitWriter round trip through BitReader", "[core]") {
+    core::BitWriter writer;
+    std::vector<std::pair<uint64_t, size_t>> fields;
+
+    // Детерминированный набор полей разной ширины, чтобы пройти все сдвиги
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < 500; ++i) {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        size_t width = 1 + (state % 64);
+        uint64_t value = width == 64 ? state : state & ((1ULL << width) - 1);
+        fields.emplace_back(value, width);
+        REQUIRE(writer.write_bits(value, width).has_value());
+    }
+
+    core::BitReader reader(writer.data());
+    for (auto [value, width] : fields) {
+        auto res = reader.read_bits(width);
+        REQUIRE(res.has_value());
+        CHECK(*res == value);
+    }
+    CHECK(reader.bits_left() < 8);
+}
+
+TEST_CASE("BitWriter write_bytes", "[core]") {
+    std::vector<std::byte> payload;
+    for (int i = 0; i < 21; ++i) payload.push_back(static_cast<std::byte>(0x30 + i));
+
+    SECTION("Aligned payload is appended as is") {
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(0x7F, 8).has_value());
+        REQUIRE(writer.write_bytes(payload).has_value());
+        REQUIRE(writer.data().size() == 22);
+        CHECK(std::equal(payload.begin(), payload.end(), writer.data().begin() + 1));
+    }
+
+    SECTION("Unaligned payload matches per-byte writes") {
+        core::BitWriter bulk;
+        core::BitWriter slow;
+        REQUIRE(bulk.write_bits(0b11, 2).has_value());
+        REQUIRE(slow.write_bits(0b11, 2).has_value());
+
+        REQUIRE(bulk.write_bytes(payload).has_value());
+        for (auto b : payload) {
+            REQUIRE(slow.write_bits(static_cast<uint8_t>(b), 8).has_value());
+        }
+        CHECK(bulk.data() == slow.data());
+    }
+
+    SECTION("Repeated unaligned writes grow the buffer geometrically") {
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(0b1, 1).has_value());
+
+        const std::vector<std::byte> chunk(10, std::byte{ 0xA5 });
+        size_t reallocations = 0;
+        size_t capacity = writer.data().capacity();
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(writer.write_bytes(chunk).has_value());
+            if (writer.data().capacity() != capacity) {
+                ++reallocations;
+                capacity = writer.data().capacity();
+            }
+        }
+        CHECK(writer.data().size() == 10001);
+        CHECK(reallocations <= 32);
+    }
+}
+
+TEST_CASE("BitWriter reuse across messages", "[core]") {
+    core::BitWriter writer;
+    writer.reserve(64);
+    REQUIRE(writer.write_bits(0x1234, 16).has_value());
+    writer.align_to_byte();
+    const auto* storage = writer.data().data();
+
+    writer.clear();
+    CHECK(writer.data().empty());
+
+    REQUIRE(writer.write_bits(1, 1).has_value());
+    writer.align_to_byte();
+    REQUIRE(writer.write_bits(0xCD, 8).has_value());
+    REQUIRE(writer.data().size() == 2);
+    CHECK(writer.data()[0] == std::byte{ 0x80 });
+    CHECK(writer.data()[1] == std::byte{ 0xCD });
+    CHECK(writer.data().data() == storage); // Буфер не перевыделялся
+}
+
+TEST_CASE("FixedBitWriter over a caller buffer", "[core]") {
+    std::array<std::byte, 4> slot;
+    slot.fill(std::byte{ 0xEE }); // Мусор от предыдущей датаграммы
+    core::FixedBitWriter writer(slot);
+
+    SECTION("Same bytes as the growing writer") {
+        core::BitWriter reference;
+        REQUIRE(writer.write_bits(0b101, 3).has_value());
+        REQUIRE(reference.write_bits(0b101, 3).has_value());
+        writer.align_to_byte();
+        reference.align_to_byte();
+        REQUIRE(writer.write_bits(0x1234, 16).has_value());
+        REQUIRE(reference.write_bits(0x1234, 16).has_value());
+
+        REQUIRE(writer.data().size() == reference.data().size());
+        CHECK(std::equal(writer.data().begin(), writer.data().end(), reference.data().begin()));
+    }
+
+    SECTION("Overflow is reported and keeps written data") {
+        REQUIRE(writer.write_bits(0xABCDEF, 24).has_value());
+        REQUIRE(writer.write_bits(0x1, 4).has_value());
+
+        auto res = writer.write_bits(0x1F, 5);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::BufferOverflow);
+
+        std::array<std::byte, 2> bytes{};
+        CHECK(writer.write_bytes(bytes).error().code == ErrorCode::BufferOverflow);
+
+        REQUIRE(writer.data().size() == 4);
+        CHECK(writer.data()[0] == std::byte{ 0xAB });
+        CHECK(writer.data()[3] == std::byte{ 0x10 });
+    }
+
+    SECTION("clear() restarts at the beginning of the slot") {
+        REQUIRE(writer.write_bits(0xFFFFFFFF, 32).has_value());
+        writer.clear();
+        REQUIRE(writer.write_bits(0b1, 1).has_value());
+        REQUIRE(writer.data().size() == 1);
+        CHECK(writer.data()[0] == std::byte{ 0x80 });
+    }
+}
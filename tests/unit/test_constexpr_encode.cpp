@@ -0,0 +1,103 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/h225/ras.hpp>
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/asn1/per_encoder.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <h323_26/core/static_bit_writer.hpp>
+#include "../compliance/H225_RAS_GRQ/sample_grq.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+using namespace h323_26;
+using namespace h323_26::h225;
+
+namespace {
+
+    template <size_t N>
+    constexpr bool same_bytes(const std::array<std::byte, N>& actual, std::array<uint8_t, N> expected) {
+        return std::ranges::equal(actual, expected, [](std::byte a, uint8_t b) { return a == std::byte{ b }; });
+    }
+
+    std::vector<std::byte> runtime_encode(const RasMessage& msg) {
+        core::BitWriter writer;
+        REQUIRE(RasPDU::encode(writer, msg).has_value());
+        return writer.data();
+    }
+
+    // "GK-1" в BMPString: символы UCS-2, старший октет первым
+    constexpr std::array<std::byte, 8> gk1_bmp = {
+        std::byte{ 0 }, std::byte{ 'G' }, std::byte{ 0 }, std::byte{ 'K' }, std::byte{ 0 }, std::byte{ '-' }, std::byte{ 0 }, std::byte{ '1' } };
+
+    // Постоянные сообщения: вычисляются целиком при компиляции
+    constexpr auto discovery_grq = RasPDU::encode_static<RasMessageType::gatekeeperRequest, [] {
+        return GatekeeperRequestView{
+            .requestSeqNum = 1,
+            .protocolIdentifier = asn1::OidView(asn1::OidRegistry::find(asn1::OidId::h225_v7)->ber),
+            .gatekeeperIdentifier = asn1::BmpStringView(gk1_bmp),
+            .endpointAlias = "H.323.26-Terminal"
+        };
+    }>();
+
+    constexpr auto canned_grj = RasPDU::encode_static<RasMessageType::gatekeeperReject, [] {
+        return GatekeeperReject{ 1, asn1::InternedOid(asn1::OidId::h225_v7), std::nullopt, GatekeeperRejectReason::terminalExcluded };
+    }>();
+
+    constexpr auto canned_arj = RasPDU::encode_static<RasMessageType::admissionReject, [] {
+        return AdmissionReject{ 7, AdmissionRejectReason::resourceUnavailable };
+    }>();
+
+} // namespace
+
+TEST_CASE("constexpr encoding: sample GRQ matches gen_h225_ras_grq", "[h225][constexpr]") {
+    // Вывод gen_h225_ras_grq: 00 00 00 00 06 00 08 91 4a 00 07
+    static_assert(same_bytes(compliance::sample_grq_datagram,
+        { 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x08, 0x91, 0x4A, 0x00, 0x07 }));
+
+    auto runtime = runtime_encode(compliance::make_sample_grq());
+    CHECK(std::ranges::equal(runtime, compliance::sample_grq_datagram));
+}
+
+TEST_CASE("constexpr encoding: constant messages equal runtime output", "[h225][constexpr]") {
+    SECTION("Discovery GRQ with identifiers, through the view type") {
+        GatekeeperRequest grq{
+            .requestSeqNum = 1,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .gatekeeperIdentifier = "GK-1",
+            .endpointAlias = "H.323.26-Terminal"
+        };
+        CHECK(std::ranges::equal(runtime_encode(grq), discovery_grq));
+    }
+
+    SECTION("Canned rejects") {
+        CHECK(std::ranges::equal(runtime_encode(GatekeeperReject{ 1, { 0, 0, 8, 2250, 0, 7 }, std::nullopt, GatekeeperRejectReason::terminalExcluded }), canned_grj));
+        CHECK(std::ranges::equal(runtime_encode(AdmissionReject{ 7, AdmissionRejectReason::resourceUnavailable }), canned_arj));
+    }
+}
+
+TEST_CASE("constexpr encoding: StaticBitWriter", "[core][constexpr]") {
+    constexpr auto bytes = [] {
+        core::StaticBitWriter<4> writer;
+        (void)writer.write_bits(0b101, 3);
+        (void)writer.write_bits(0x1FF, 9);
+        writer.align_to_byte();
+        (void)asn1::PerEncoder::encode_constrained_integer(writer, 1000, 1, 65535);
+        return writer.bytes();
+    }();
+    static_assert(same_bytes(bytes, { 0xBF, 0xF0, 0x03, 0xE7 }));
+
+    constexpr auto overflow = [] {
+        core::StaticBitWriter<1> writer;
+        (void)writer.write_bits(0, 7);
+        return writer.write_bits(0, 2).error().code;
+    }();
+    static_assert(overflow == ErrorCode::BufferOverflow);
+
+    // Те же примитивы во время выполнения
+    core::BitWriter writer;
+    REQUIRE(writer.write_bits(0b101, 3).has_value());
+    REQUIRE(writer.write_bits(0x1FF, 9).has_value());
+    writer.align_to_byte();
+    REQUIRE(asn1::PerEncoder::encode_constrained_integer(writer, 1000, 1, 65535).has_value());
+    CHECK(std::ranges::equal(writer.data(), bytes));
+}
@@ -2,8 +2,14 @@
 #include <h323_26/h225/ras.hpp>
 #include <h323_26/h225/ras_message.hpp>
 #include <h323_26/asn1/per_decoder.hpp>
+#include <h323_26/asn1/per_encoder.hpp>
 #include <h323_26/core/bit_reader.hpp>
 #include <h323_26/core/bit_writer.hpp>
+#include <h323_26/core/fixed_bit_writer.hpp>
+#include <array>
+#include <algorithm>
+#include <string>
+#include <utility>
 #include <vector>
 #include <cstddef>
 
@@ -23,7 +29,7 @@ TEST_CASE("H.225.0 RAS: Global Symmetry", "[h225]") {
 
     REQUIRE(decoded.has_value());
     CHECK(decoded->requestSeqNum == 1234);
-    CHECK(decoded->protocolIdentifier == std::vector<uint32_t>{0, 0, 8, 2250, 0, 7});
+    CHECK(std::ranges::equal(decoded->protocolIdentifier, std::vector<uint32_t>{0, 0, 8, 2250, 0, 7}));
     //REQUIRE(decoded->endpointAlias.has_value());
     //CHECK(*decoded->endpointAlias == "H.323.26-Terminal");
 }
@@ -46,3 +52,415 @@ TEST_CASE("H.225.0 RAS: Optional field absence", "[h225]") {
     CHECK_FALSE(decoded->endpointAlias.has_value()); // Проверяем отсутствие
 }
 
+
+TEST_CASE("H.225.0 RAS: Encode into a fixed datagram slot", "[h225]") {
+    h225::RasMessage msg = h225::GatekeeperRequest{
+        .requestSeqNum = 77,
+        .protocolIdentifier = {0, 0, 8, 2250, 0, 7}
+    };
+
+    core::BitWriter growing;
+    REQUIRE(h225::RasPDU::encode(growing, msg).has_value());
+
+    SECTION("Output matches the growing writer") {
+        std::array<std::byte, 64> slot{};
+        core::FixedBitWriter fixed(slot);
+        REQUIRE(h225::RasPDU::encode(fixed, msg).has_value());
+        REQUIRE(fixed.data().size() == growing.data().size());
+        CHECK(std::equal(fixed.data().begin(), fixed.data().end(), growing.data().begin()));
+    }
+
+    SECTION("Too small slot reports BufferOverflow") {
+        std::array<std::byte, 4> slot{};
+        core::FixedBitWriter fixed(slot);
+        auto res = h225::RasPDU::encode(fixed, msg);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::BufferOverflow);
+    }
+}
+
+TEST_CASE("H.225.0 RAS: GatekeeperRequestView borrows from the datagram", "[h225]") {
+    std::vector<uint32_t> h225_v7 = {0, 0, 8, 2250, 0, 7};
+    h225::GatekeeperRequest grq{
+        .requestSeqNum = 4321,
+        .protocolIdentifier = {0, 0, 8, 2250, 0, 7},
+        .gatekeeperIdentifier = "GK-\u0416",
+        .endpointAlias = "H.323.26-Terminal"
+    };
+    core::BitWriter writer;
+    REQUIRE(grq.encode(writer).has_value());
+
+    core::BitReader reader(writer.data());
+    auto view = h225::GatekeeperRequestView::decode(reader);
+    REQUIRE(view.has_value());
+    CHECK(view->requestSeqNum == 4321);
+    CHECK(view->protocolIdentifier.equals(h225_v7));
+    REQUIRE(view->endpointAlias.has_value());
+    CHECK(*view->endpointAlias == "H.323.26-Terminal");
+
+    // BMPString не перекодируется: view смотрит на символы UCS-2 в датаграмме
+    REQUIRE(view->gatekeeperIdentifier.has_value());
+    CHECK(view->gatekeeperIdentifier->size() == 4);
+    CHECK(view->gatekeeperIdentifier->equals("GK-\u0416"));
+    CHECK_FALSE(view->gatekeeperIdentifier->equals("GK-"));
+    CHECK_FALSE(view->gatekeeperIdentifier->equals("GK-\u0416!"));
+
+    auto owned = view->to_owned();
+    CHECK(owned.requestSeqNum == 4321);
+    CHECK(std::ranges::equal(owned.protocolIdentifier, h225_v7));
+    CHECK(owned.gatekeeperIdentifier == "GK-\u0416");
+    CHECK(owned.endpointAlias == "H.323.26-Terminal");
+
+    // Обратно view кодируется теми же октетами
+    core::BitWriter again;
+    REQUIRE(view->encode(again).has_value());
+    CHECK(again.data() == writer.data());
+}
+
+TEST_CASE("H.225.0 RAS: identifiers are BMPString on the wire", "[h225]") {
+    // Символы идут выровненными парами октетов UCS-2, а не октетами IA5
+    h225::GatekeeperConfirm gcf{
+        .requestSeqNum = 1,
+        .protocolIdentifier = {0, 0, 8, 2250, 0, 7},
+        .gatekeeperIdentifier = "GK",
+        .rasAddress = { .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 1 } }, .port = 1719 }
+    };
+    core::BitWriter writer;
+    REQUIRE(gcf.encode(writer).has_value());
+
+    const std::array<std::byte, 4> gk = { std::byte{ 0x00 }, std::byte{ 'G' }, std::byte{ 0x00 }, std::byte{ 'K' } };
+    auto found = std::ranges::search(writer.data(), gk);
+    CHECK_FALSE(found.empty());
+
+    core::BitReader reader(writer.data());
+    auto decoded = h225::GatekeeperConfirm::decode(reader);
+    REQUIRE(decoded.has_value());
+    CHECK(decoded->gatekeeperIdentifier == "GK");
+
+    // Символ вне IA5 проходит туда и обратно
+    h225::RasMessage rcf = h225::RegistrationConfirm{
+        .requestSeqNum = 2,
+        .protocolIdentifier = {0, 0, 8, 2250, 0, 7},
+        .endpointIdentifier = "EP-\u00E9"
+    };
+    core::BitWriter rcf_bits;
+    REQUIRE(h225::RasPDU::encode(rcf_bits, rcf).has_value());
+    core::BitReader rcf_reader(rcf_bits.data());
+    auto rcf_decoded = h225::RasPDU::decode(rcf_reader);
+    REQUIRE(rcf_decoded.has_value());
+    CHECK(std::get<h225::RegistrationConfirm>(*rcf_decoded).endpointIdentifier == "EP-\u00E9");
+}
+
+TEST_CASE("H.225.0 RAS: GRQ/GCF symmetry through the schema", "[h225]") {
+    SECTION("GRQ with alias") {
+        h225::GatekeeperRequest grq{
+            .requestSeqNum = 65535,
+            .protocolIdentifier = {0, 0, 8, 2250, 0, 7},
+            .endpointAlias = "H.323.26-Terminal"
+        };
+
+        core::BitWriter writer;
+        REQUIRE(grq.encode(writer).has_value());
+
+        core::BitReader reader(writer.data());
+        auto decoded = h225::GatekeeperRequest::decode(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(decoded->requestSeqNum == 65535);
+        CHECK(decoded->endpointAlias == "H.323.26-Terminal");
+    }
+
+    SECTION("GCF with gatekeeperIdentifier") {
+        h225::GatekeeperConfirm gcf{
+            .requestSeqNum = 7,
+            .protocolIdentifier = {0, 0, 8, 2250, 0, 7},
+            .gatekeeperIdentifier = "GK-1"
+        };
+
+        core::BitWriter writer;
+        REQUIRE(gcf.encode(writer).has_value());
+
+        core::BitReader reader(writer.data());
+        auto decoded = h225::GatekeeperConfirm::decode(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(decoded->requestSeqNum == 7);
+        CHECK(decoded->protocolIdentifier == gcf.protocolIdentifier);
+        CHECK(decoded->gatekeeperIdentifier == "GK-1");
+    }
+
+    SECTION("View and owning types share one layout") {
+        h225::GatekeeperRequest grq{
+            .requestSeqNum = 12,
+            .protocolIdentifier = {0, 0, 8, 2250, 0, 4},
+            .endpointAlias = "alias"
+        };
+        core::BitWriter owning;
+        REQUIRE(grq.encode(owning).has_value());
+
+        core::BitReader reader(owning.data());
+        auto view = h225::GatekeeperRequestView::decode(reader);
+        REQUIRE(view.has_value());
+
+        core::BitWriter from_view;
+        REQUIRE(view->encode(from_view).has_value());
+        CHECK(from_view.data() == owning.data());
+    }
+}
+
+namespace {
+
+    // По одному сообщению каждого варианта RasMessage, в порядке CHOICE
+    std::vector<h225::RasMessage> make_every_ras_message() {
+        using namespace h225;
+        const asn1::InternedOid v7(asn1::OidId::h225_v7);
+        const TransportAddress ras{ .ip = { std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1} }, .port = 1719 };
+        const TransportAddress signalling{ .ip = { std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1} }, .port = 1720 };
+        const AliasList aliases = { DialedDigits{ "1001" }, H323Id{ "terminal-1" } };
+        std::array<std::byte, 16> conference{};
+        conference.fill(std::byte{0x5A});
+
+        std::vector<RasMessage> all;
+        all.emplace_back(GatekeeperRequest{ 1, v7, "GK", "alias" });
+        all.emplace_back(GatekeeperConfirm{ 2, v7, "GK", ras });
+        all.emplace_back(GatekeeperReject{ 3, v7, std::nullopt, GatekeeperRejectReason::terminalExcluded });
+        all.emplace_back(RegistrationRequest{ 4, v7, true, { signalling }, { ras }, aliases, "GK", 300, std::nullopt, false });
+        all.emplace_back(RegistrationConfirm{ 5, v7, { signalling }, aliases, "GK", "EP-1", 300 });
+        all.emplace_back(RegistrationReject{ 6, v7, RegistrationRejectReason::duplicateAlias, "GK" });
+        all.emplace_back(UnregistrationRequest{ 7, { signalling }, aliases, "EP-1", std::nullopt });
+        all.emplace_back(UnregistrationConfirm{ 8 });
+        all.emplace_back(UnregistrationReject{ 9, UnregRejectReason::callInProgress });
+        all.emplace_back(AdmissionRequest{ 10, CallType::pointToPoint, "EP-1", aliases, signalling, aliases, 640, 33, conference, false, true });
+        all.emplace_back(AdmissionConfirm{ 11, 640, CallModel::gatekeeperRouted, signalling, 30 });
+        all.emplace_back(AdmissionReject{ 12, AdmissionRejectReason::resourceUnavailable });
+        all.emplace_back(BandwidthRequest{ 13, "EP-1", conference, 33, 1280 });
+        all.emplace_back(BandwidthConfirm{ 14, 1280 });
+        all.emplace_back(BandwidthReject{ 15, BandRejectReason::insufficientResources, 640 });
+        all.emplace_back(DisengageRequest{ 16, "EP-1", conference, 33, DisengageReason::normalDrop });
+        all.emplace_back(DisengageConfirm{ 17 });
+        all.emplace_back(DisengageReject{ 18, DisengageRejectReason::requestToDropOther });
+        all.emplace_back(LocationRequest{ 19, "EP-1", aliases, ras });
+        all.emplace_back(LocationConfirm{ 20, signalling, ras });
+        all.emplace_back(LocationReject{ 21, LocationRejectReason::requestDenied });
+        all.emplace_back(InfoRequest{ 22, 33, ras });
+        all.emplace_back(InfoRequestResponse{ 23, "EP-1", ras, { signalling }, aliases });
+        all.emplace_back(NonStandardMessage{ 24, { { 1, 2, 3 }, { std::byte{0xDE}, std::byte{0xAD} } } });
+        all.emplace_back(UnknownMessageResponse{ 25 });
+        all.emplace_back(RequestInProgress{ 26, 5000 });
+        all.emplace_back(ResourcesAvailableIndicate{ 27, v7, "EP-1", true });
+        all.emplace_back(ResourcesAvailableConfirm{ 28, v7 });
+        all.emplace_back(InfoRequestAck{ 29 });
+        all.emplace_back(InfoRequestNak{ 30, InfoRequestNakReason::securityDenial });
+        all.emplace_back(ServiceControlIndication{ 31, std::nullopt });
+        all.emplace_back(ServiceControlResponse{ 32, ServiceControlResult::started });
+        all.emplace_back(AdmissionConfirmSequence{ { AdmissionConfirm{ 33, 640, CallModel::direct, signalling, std::nullopt } } });
+        return all;
+    }
+}
+
+TEST_CASE("H.225.0 RAS: RasPDU round-trips every alternative", "[h225]") {
+    auto messages = make_every_ras_message();
+    REQUIRE(messages.size() == std::variant_size_v<h225::RasMessage>);
+
+    for (size_t i = 0; i < messages.size(); ++i) {
+        INFO("RasMessage alternative " << i);
+        REQUIRE(messages[i].index() == i);
+
+        core::BitWriter writer;
+        REQUIRE(h225::RasPDU::encode(writer, messages[i]).has_value());
+
+        core::BitReader reader(writer.data());
+        auto decoded = h225::RasPDU::decode(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(decoded->index() == i);
+
+        // Повторное кодирование дает те же байты — декодер ничего не потерял
+        core::BitWriter again;
+        REQUIRE(h225::RasPDU::encode(again, *decoded).has_value());
+        CHECK(again.data() == writer.data());
+    }
+}
+
+TEST_CASE("H.225.0 RAS: encoded_size matches the encoder", "[h225][size]") {
+    auto messages = make_every_ras_message();
+
+    for (size_t i = 0; i < messages.size(); ++i) {
+        INFO("RasMessage alternative " << i);
+
+        auto size = h225::RasPDU::encoded_size(messages[i]);
+        REQUIRE(size.has_value());
+
+        core::BitWriter writer;
+        writer.reserve(*size);
+        const std::byte* storage = writer.data().data();
+        REQUIRE(h225::RasPDU::encode(writer, messages[i]).has_value());
+        CHECK(writer.data().size() == *size);
+        CHECK(writer.data().data() == storage); // Одного reserve хватило, реаллокаций не было
+
+        // Слот ровно по размеру принимает сообщение, на октет меньше — нет
+        std::vector<std::byte> slot(*size);
+        auto written = h225::RasPDU::encode_into(slot, messages[i]);
+        REQUIRE(written.has_value());
+        CHECK(*written == *size);
+        CHECK(slot == writer.data());
+
+        if (*size > 0) {
+            std::vector<std::byte> small(*size - 1, std::byte{ 0xEE });
+            auto res = h225::RasPDU::encode_into(small, messages[i]);
+            REQUIRE_FALSE(res.has_value());
+            CHECK(res.error().code == ErrorCode::BufferOverflow);
+            // Проверка до записи: слот остался нетронутым
+            CHECK(std::ranges::all_of(small, [](std::byte b) { return b == std::byte{ 0xEE }; }));
+        }
+    }
+
+    SECTION("Per-message encoded_size agrees with RasPDU minus the CHOICE header") {
+        h225::GatekeeperRequest grq{ .requestSeqNum = 9, .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 }, .endpointAlias = "ep" };
+        core::BitWriter body;
+        REQUIRE(grq.encode(body).has_value());
+        CHECK(*grq.encoded_size() == body.data().size());
+    }
+
+    SECTION("Constraint violations surface from the size pass") {
+        h225::RasMessage bad = h225::GatekeeperRequest{ .requestSeqNum = 0, .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 } };
+        auto size = h225::RasPDU::encoded_size(bad);
+        REQUIRE_FALSE(size.has_value());
+        CHECK(size.error().code == ErrorCode::InvalidConstraint);
+    }
+}
+
+TEST_CASE("H.225.0 RAS: RasPDU CHOICE header", "[h225]") {
+    SECTION("Root index is the variant index in 5 bits after the extension bit") {
+        h225::RasMessage msg = h225::RegistrationRequest{ .requestSeqNum = 1, .protocolIdentifier = {0, 0, 8, 2250, 0, 7} };
+        core::BitWriter writer;
+        REQUIRE(h225::RasPDU::encode(writer, msg).has_value());
+
+        core::BitReader reader(writer.data());
+        CHECK(reader.read_bits(6).value() == 3);
+    }
+
+    SECTION("Extension additions carry their number and an open type") {
+        h225::RasMessage msg = h225::InfoRequestAck{ 7 };
+        core::BitWriter writer;
+        REQUIRE(h225::RasPDU::encode(writer, msg).has_value());
+
+        core::BitReader reader(writer.data());
+        CHECK(reader.read_bits(1).value() == 1);
+        CHECK(asn1::PerDecoder::decode_normally_small_number(reader).value() == 3);
+        auto body = asn1::PerDecoder::decode_open_type(reader);
+        REQUIRE(body.has_value());
+        CHECK(reader.bits_left() == 0);
+
+        core::BitReader inner(*body);
+        auto iack = h225::InfoRequestAck::decode(inner);
+        REQUIRE(iack.has_value());
+        CHECK(iack->requestSeqNum == 7);
+    }
+
+    SECTION("Root index past the root alternatives is rejected") {
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(0b0'11111, 6).has_value());
+        REQUIRE(writer.write_bits(0, 16).has_value());
+
+        core::BitReader reader(writer.data());
+        auto decoded = h225::RasPDU::decode(reader);
+        REQUIRE_FALSE(decoded.has_value());
+        CHECK(decoded.error().code == ErrorCode::InvalidConstraint);
+    }
+
+    SECTION("Unknown extension addition is skipped and reported") {
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(1, 1).has_value());
+        REQUIRE(asn1::PerEncoder::encode_normally_small_number(writer, 40).has_value());
+        std::array<std::byte, 2> body{ std::byte{0x12}, std::byte{0x34} };
+        REQUIRE(asn1::PerEncoder::encode_open_type(writer, body).has_value());
+
+        core::BitReader reader(writer.data());
+        auto decoded = h225::RasPDU::decode(reader);
+        REQUIRE_FALSE(decoded.has_value());
+        CHECK(decoded.error().code == ErrorCode::UnsupportedFeature);
+        CHECK(reader.bits_left() == 0);
+    }
+}
+
+TEST_CASE("H.225.0 RAS: Header peek without a full decode", "[h225]") {
+    auto messages = make_every_ras_message();
+
+    SECTION("Type and requestSeqNum of every alternative") {
+        for (size_t i = 0; i < messages.size(); ++i) {
+            INFO("RasMessage alternative " << i);
+            core::BitWriter writer;
+            REQUIRE(h225::RasPDU::encode(writer, messages[i]).has_value());
+
+            auto header = h225::RasPDU::peek(writer.data());
+            REQUIRE(header.has_value());
+            CHECK(header->type == h225::RasPDU::type_of(messages[i]));
+            if (header->type == h225::RasMessageType::admissionConfirmSequence) {
+                CHECK_FALSE(header->requestSeqNum.has_value());
+            }
+            else {
+                // Номера в make_every_ras_message идут по порядку с 1
+                CHECK(header->requestSeqNum == i + 1);
+            }
+            CHECK(header->identifierKind == h225::RasIdentifierKind::none);
+        }
+    }
+
+    SECTION("First identifying field") {
+        auto peek_identifier = [&](h225::RasMessageType type) {
+            core::BitWriter writer;
+            REQUIRE(h225::RasPDU::encode(writer, messages[static_cast<size_t>(type)]).has_value());
+            auto header = h225::RasPDU::peek(writer.data(), true);
+            REQUIRE(header.has_value());
+            return std::pair{ header->identifierKind, std::string(header->identifier.to_string()) };
+        };
+
+        using h225::RasIdentifierKind;
+        using h225::RasMessageType;
+        CHECK(peek_identifier(RasMessageType::gatekeeperRequest) == std::pair{ RasIdentifierKind::gatekeeperIdentifier, std::string("GK") });
+        CHECK(peek_identifier(RasMessageType::registrationRequest) == std::pair{ RasIdentifierKind::gatekeeperIdentifier, std::string("GK") });
+        CHECK(peek_identifier(RasMessageType::admissionRequest) == std::pair{ RasIdentifierKind::endpointIdentifier, std::string("EP-1") });
+        CHECK(peek_identifier(RasMessageType::resourcesAvailableIndicate) == std::pair{ RasIdentifierKind::endpointIdentifier, std::string("EP-1") });
+        CHECK(peek_identifier(RasMessageType::gatekeeperReject).first == RasIdentifierKind::none); // OPTIONAL отсутствует
+        CHECK(peek_identifier(RasMessageType::disengageConfirm).first == RasIdentifierKind::none);
+    }
+
+    SECTION("Truncated datagram") {
+        core::BitWriter writer;
+        REQUIRE(h225::RasPDU::encode(writer, messages[3]).has_value());
+        std::span<const std::byte> head(writer.data().data(), 1);
+
+        auto header = h225::RasPDU::peek(head);
+        REQUIRE_FALSE(header.has_value());
+        CHECK(header.error().code == ErrorCode::EndOfStream);
+    }
+}
+
+TEST_CASE("H.225.0 RAS: RRQ extension additions survive RasPDU", "[h225]") {
+    core::BitWriter alias_bits;
+    REQUIRE(h225::AliasListCodec::encode_value(alias_bits, h225::AliasList{ h225::H323Id{ "extra" } }).has_value());
+    alias_bits.align_to_byte();
+
+    h225::RegistrationRequest rrq{ .requestSeqNum = 100, .protocolIdentifier = {0, 0, 8, 2250, 0, 7} };
+    rrq.extensions.set_raw(4, alias_bits.data());
+    h225::RasMessage msg = std::move(rrq);
+
+    core::BitWriter writer;
+    REQUIRE(h225::RasPDU::encode(writer, msg).has_value());
+
+    core::BitReader reader(writer.data());
+    auto decoded = h225::RasPDU::decode(reader);
+    REQUIRE(decoded.has_value());
+
+    const auto& ext = std::get<h225::RegistrationRequest>(*decoded).extensions;
+    CHECK(ext.size() == 5);
+    CHECK(ext.raw(4).size() == alias_bits.data().size());
+
+    auto aliases = ext.get<h225::AliasListCodec, h225::AliasList>(4);
+    REQUIRE(aliases.has_value());
+    REQUIRE(aliases->has_value());
+    CHECK((*aliases)->front() == h225::AliasAddress{ h225::H323Id{ "extra" } });
+
+    // Неглубокий разбор не зависит от бита расширения
+    auto header = h225::RasPDU::peek(writer.data());
+    REQUIRE(header.has_value());
+    CHECK(header->requestSeqNum == 100);
+}
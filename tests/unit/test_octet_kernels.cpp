@@ -0,0 +1,148 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/core/octet_kernels.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace h323_26;
+
+namespace {
+
+    // Все реализации, которые поддерживает этот процессор (скалярная есть всегда)
+    std::vector<const core::OctetKernels*> available_kernels() {
+        std::vector<const core::OctetKernels*> sets;
+        for (auto set : { core::KernelSet::scalar, core::KernelSet::sse2, core::KernelSet::avx2 }) {
+            if (const auto* kernels = core::octet_kernels(set)) sets.push_back(kernels);
+        }
+        return sets;
+    }
+
+    std::vector<std::byte> pattern(size_t size) {
+        std::vector<std::byte> data(size);
+        for (size_t i = 0; i < size; ++i) data[i] = std::byte(static_cast<uint8_t>(i * 73 + 29));
+        return data;
+    }
+
+    // Символ в UTF-16BE
+    void put_unit(std::vector<std::byte>& out, uint16_t unit) {
+        out.push_back(std::byte(static_cast<uint8_t>(unit >> 8)));
+        out.push_back(std::byte(static_cast<uint8_t>(unit)));
+    }
+
+} // namespace
+
+TEST_CASE("Octet kernels: dispatch", "[core][kernels]") {
+    REQUIRE(core::octet_kernels(core::KernelSet::scalar) != nullptr);
+    // Выбранная реализация — одна из поддерживаемых
+    const auto& selected = core::octet_kernels();
+    CHECK(core::octet_kernels(selected.set) == &selected);
+}
+
+TEST_CASE("Octet kernels: vector implementations match the scalar one", "[core][kernels]") {
+    const auto& scalar = *core::octet_kernels(core::KernelSet::scalar);
+
+    for (const auto* kernels : available_kernels()) {
+        INFO("kernel set " << static_cast<int>(kernels->set));
+
+        SECTION("Shifted copy of every length and shift") {
+            auto src = pattern(200);
+            for (unsigned shift = 1; shift < 8; ++shift) {
+                for (size_t count = 0; count < src.size(); ++count) {
+                    std::vector<std::byte> expected(count), actual(count);
+                    scalar.copy_shifted(expected.data(), src.data(), count, shift);
+                    kernels->copy_shifted(actual.data(), src.data(), count, shift);
+                    CHECK(actual == expected);
+                }
+            }
+
+            // Скалярная реализация — по определению: октет из двух соседних
+            std::vector<std::byte> out(1);
+            scalar.copy_shifted(out.data(), src.data(), 1, 3);
+            CHECK(out[0] == std::byte(static_cast<uint8_t>((static_cast<unsigned>(src[0]) << 3) | (static_cast<unsigned>(src[1]) >> 5))));
+        }
+
+        SECTION("IA5 and PrintableString alphabets") {
+            // Строка из допустимых символов; затем каждый байт 0..255 в каждой позиции
+            std::string text(70, 'a');
+            for (size_t pos = 0; pos < text.size(); pos += 13) {
+                for (int c = 0; c < 256; ++c) {
+                    std::string probe = text;
+                    probe[pos] = static_cast<char>(c);
+                    CHECK(kernels->is_ia5(probe.data(), probe.size()) == (c < 128));
+                    CHECK(kernels->is_printable(probe.data(), probe.size()) == core::is_printable_char(static_cast<char>(c)));
+                }
+            }
+
+            std::string printable = "Gatekeeper 01 (zone-A) 'x'+y,z./:=?";
+            CHECK(kernels->is_printable(printable.data(), printable.size()));
+            CHECK_FALSE(kernels->is_printable("a*b", 3));
+            CHECK(kernels->is_ia5(nullptr, 0));
+        }
+
+        SECTION("UTF-16BE to UTF-8") {
+            // ASCII-блоки (векторный путь) вперемешку с двух- и трехоктетными символами
+            std::vector<std::byte> units;
+            std::string expected;
+            for (size_t i = 0; i < 150; ++i) {
+                if (i % 50 == 49) {
+                    put_unit(units, 0x00FC);
+                    expected += "\xC3\xBC";
+                }
+                else if (i % 70 == 69) {
+                    put_unit(units, 0x6771);
+                    expected += "\xE6\x9D\xB1";
+                }
+                else {
+                    char c = static_cast<char>('A' + i % 26);
+                    put_unit(units, static_cast<uint16_t>(c));
+                    expected += c;
+                }
+            }
+
+            for (size_t count = 0; count <= units.size() / 2; ++count) {
+                std::string out(count * 3, '\0');
+                size_t written = kernels->utf16be_to_utf8(units.data(), count, out.data());
+                std::string reference(count * 3, '\0');
+                size_t reference_written = scalar.utf16be_to_utf8(units.data(), count, reference.data());
+                REQUIRE(written == reference_written);
+                CHECK(out.substr(0, written) == reference.substr(0, written));
+            }
+
+            std::string out(units.size() / 2 * 3, '\0');
+            size_t written = kernels->utf16be_to_utf8(units.data(), units.size() / 2, out.data());
+            CHECK(out.substr(0, written) == expected);
+
+            // Суррогат в любом месте (в том числе в ASCII-блоке) — ошибка
+            for (size_t pos = 0; pos < 64; pos += 7) {
+                auto broken = units;
+                broken[2 * pos] = std::byte{ 0xDC };
+                CHECK(kernels->utf16be_to_utf8(broken.data(), broken.size() / 2, out.data()) == core::Utf16Invalid);
+            }
+        }
+    }
+}
+
+TEST_CASE("Octet kernels: UTF-8 characters of the BMP", "[core][kernels]") {
+    auto decode_all = [](std::string_view text) {
+        std::vector<uint32_t> chars;
+        for (size_t pos = 0; pos < text.size();) {
+            uint32_t c = core::next_bmp_char(text, pos);
+            chars.push_back(c);
+            if (c == core::InvalidBmpChar) break;
+        }
+        return chars;
+    };
+
+    CHECK(decode_all("A\xC3\xBC\xE6\x9D\xB1") == std::vector<uint32_t>{ 0x41, 0xFC, 0x6771 });
+    CHECK(decode_all("\xEF\xBF\xBF") == std::vector<uint32_t>{ 0xFFFF });
+
+    // Вне BMP, суррогат, избыточная форма, обрыв последовательности
+    for (std::string_view bad : { "\xF0\x9F\x98\x80", "\xED\xA0\x80", "\xC0\x80", "\xE0\x80\x80", "\xE6\x9D", "\x80" }) {
+        CHECK(decode_all(bad).back() == core::InvalidBmpChar);
+    }
+
+    static_assert([] {
+        size_t pos = 0;
+        return core::next_bmp_char("\xC3\xBC", pos) == 0xFC && pos == 2;
+    }());
+}
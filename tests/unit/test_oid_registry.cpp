@@ -0,0 +1,105 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/asn1/oid_registry.hpp>
+#include <h323_26/asn1/per_decoder.hpp>
+#include <h323_26/asn1/per_encoder.hpp>
+#include <h323_26/asn1/schema.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <vector>
+
+using namespace h323_26;
+using namespace h323_26::asn1;
+
+TEST_CASE("OID registry: compile-time encodings match the generic encoder", "[asn1][oid]") {
+    for (const auto& entry : OidRegistry::entries) {
+        INFO(entry.name);
+        CHECK(OidRegistry::find(entry.id) == &entry);
+
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_oid(writer, entry.arcs).has_value());
+        REQUIRE(writer.data().size() == entry.ber.size() + 1);
+        CHECK(writer.data()[0] == std::byte(entry.ber.size()));
+        CHECK(std::ranges::equal(std::span(writer.data()).subspan(1), entry.ber));
+
+        CHECK(OidRegistry::match(entry.ber) == entry.id);
+        CHECK(OidRegistry::match(entry.arcs) == entry.id);
+    }
+
+    constexpr std::array<std::byte, 6> h225_v7 = {
+        std::byte{ 0x00 }, std::byte{ 0x08 }, std::byte{ 0x91 }, std::byte{ 0x4A }, std::byte{ 0x00 }, std::byte{ 0x07 } };
+    static_assert(std::ranges::equal(OidRegistry::find(OidId::h225_v7)->ber, h225_v7));
+    static_assert(OidRegistry::find(OidId::unknown) == nullptr);
+}
+
+TEST_CASE("OID registry: InternedOid through the schema codec", "[asn1][oid]") {
+    auto round_trip = [](const InternedOid& oid, std::pmr::memory_resource* mr) {
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(0b101, 3).has_value()); // Unaligned start
+        REQUIRE(ObjectIdentifier::encode_value(writer, oid).has_value());
+
+        core::BitWriter generic;
+        REQUIRE(generic.write_bits(0b101, 3).has_value());
+        REQUIRE(PerEncoder::encode_oid(generic, oid.arcs()).has_value());
+        CHECK(writer.data() == generic.data());
+
+        core::BitReader reader(writer.data());
+        REQUIRE(reader.skip_bits(3).has_value());
+        auto decoded = ObjectIdentifier::decode_value<InternedOid>(reader, DecodeContext{ mr });
+        REQUIRE(decoded.has_value());
+        CHECK(reader.bits_left() == 0);
+        return *decoded;
+    };
+
+    SECTION("Well-known OID decodes to an ID without touching the resource") {
+        InternedOid oid = { 0, 0, 8, 2250, 0, 7 };
+        CHECK(oid.interned());
+        CHECK(oid.id() == OidId::h225_v7);
+
+        std::pmr::monotonic_buffer_resource arena(std::pmr::null_memory_resource());
+        auto decoded = round_trip(oid, &arena);
+        CHECK(decoded.id() == OidId::h225_v7);
+        CHECK(decoded == oid);
+        CHECK(std::ranges::equal(decoded, std::vector<uint32_t>{ 0, 0, 8, 2250, 0, 7 }));
+    }
+
+    SECTION("Unknown OID falls back to the generic path") {
+        InternedOid oid = { 1, 3, 6, 1, 4, 1, 311, 21, 20 };
+        CHECK_FALSE(oid.interned());
+
+        auto decoded = round_trip(oid, std::pmr::get_default_resource());
+        CHECK(decoded.id() == OidId::unknown);
+        CHECK(decoded == oid);
+        CHECK(decoded.size() == 9);
+        CHECK(decoded[6] == 311);
+    }
+
+    SECTION("Unknown OID with a one-octet encoding keeps both arcs") {
+        // {1 3} целиком в одном октете 0x2B
+        InternedOid oid = { 1, 3 };
+        CHECK_FALSE(oid.interned());
+
+        auto decoded = round_trip(oid, std::pmr::get_default_resource());
+        CHECK(decoded.id() == OidId::unknown);
+        CHECK(decoded == oid);
+        CHECK(std::ranges::equal(decoded, std::vector<uint32_t>{ 1, 3 }));
+
+        // То же через decode_into: assign поверх ранее известного OID
+        core::BitWriter writer;
+        REQUIRE(ObjectIdentifier::encode_value(writer, oid).has_value());
+        InternedOid reused = { 0, 0, 8, 2250, 0, 7 };
+        core::BitReader reader(writer.data());
+        REQUIRE(ObjectIdentifier::decode_into(reused, reader, DecodeContext{}).has_value());
+        CHECK(reused == oid);
+        CHECK(reused.size() == 2);
+    }
+
+    SECTION("Near misses are not interned") {
+        CHECK(InternedOid{ 0, 0, 8, 2250, 0, 8 }.id() == OidId::unknown);
+        CHECK(InternedOid{ 0, 0, 8, 2250, 0 }.id() == OidId::unknown);
+        CHECK(InternedOid{ 0, 0, 8, 2250, 0, 7, 0 }.id() == OidId::unknown);
+        CHECK(InternedOid{ 0, 0, 8, 2250, 0, 7 } != InternedOid{ 0, 0, 8, 245, 0, 7 });
+    }
+}
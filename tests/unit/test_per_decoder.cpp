@@ -1,7 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 #include <h323_26/asn1/per_decoder.hpp>
 #include <h323_26/asn1/per_encoder.hpp>
+#include <h323_26/core/bit_counter.hpp>
 #include <h323_26/core/bit_writer.hpp>
+#include <h323_26/core/octet_stream.hpp>
+#include <algorithm>
+#include <iterator>
+#include <string>
 #include <vector>
 
 using namespace h323_26;
@@ -56,18 +61,40 @@ TEST_CASE("PER Extensible Constrained Integer", "[asn1]") {
         CHECK(reader.bits_left() == 5); // 1   + 2   = 3  
     }
 
-    SECTION("Extension bit is 1 (Normally Small Integer)") {
-        //       .
-        //  : 1
-        // Normally Small Integer ( 0 + 6  ): 0 000111 ( 7)
-        // : 1 0 000111 -> 10000111 (0x87)
-        std::vector<std::byte> data = { std::byte{0x87} };
+    SECTION("Extension bit is 1 (unconstrained whole number)") {
+        // Outside the root the value is encoded as if unconstrained (X.691, 13.1):
+        // marker 1 | ALIGNED pad to octet | length 1 | two's complement octet 7
+        std::vector<std::byte> data = { std::byte{0x80}, std::byte{0x01}, std::byte{0x07} };
         core::BitReader reader(data);
 
         auto res = PerDecoder::decode_extensible_constrained_integer(reader, 1, 4);
         REQUIRE(res.has_value());
         CHECK(*res == 7);
-        CHECK(reader.bits_left() == 0); // 1   + 1   + 6  = 8 
+        CHECK(reader.bits_left() == 0);
+
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_extensible_constrained_integer(writer, 7, 1, 4).has_value());
+        CHECK(writer.data() == data);
+    }
+
+    SECTION("Values with the top bit set get a leading sign octet") {
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_extensible_constrained_integer(writer, 200, 1, 4).has_value());
+        std::vector<std::byte> expected = { std::byte{0x80}, std::byte{0x02}, std::byte{0x00}, std::byte{0xC8} };
+        CHECK(writer.data() == expected);
+
+        core::BitReader reader(writer.data());
+        auto res = PerDecoder::decode_extensible_constrained_integer(reader, 1, 4);
+        REQUIRE(res.has_value());
+        CHECK(*res == 200);
+    }
+
+    SECTION("Negative extension values are rejected") {
+        std::vector<std::byte> data = { std::byte{0x80}, std::byte{0x01}, std::byte{0xFF} };
+        core::BitReader reader(data);
+        auto res = PerDecoder::decode_extensible_constrained_integer(reader, 1, 4);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::UnsupportedFeature);
     }
 }
 
@@ -85,8 +112,608 @@ TEST_CASE("ASN.1 PER: OID Symmetry Test", "[asn1][oid]") {
     auto dec_res = asn1::PerDecoder::decode_oid(reader);
 
     REQUIRE(dec_res.has_value());
-    CHECK(dec_res.value() == original_oid);
+    CHECK(std::ranges::equal(dec_res.value(), original_oid));
 
     //     
     CHECK(dec_res.value()[3] == 2250);
 }
+
+TEST_CASE("ASN.1 PER: Zero-copy views", "[asn1][view]") {
+    using namespace h323_26;
+
+    std::vector<uint32_t> expected = { 0, 0, 8, 2250, 0, 7 };
+
+    core::BitWriter writer;
+    REQUIRE(asn1::PerEncoder::encode_extension_marker(writer, true).has_value());
+    REQUIRE(asn1::PerEncoder::encode_ia5_string(writer, "gk-alias").has_value());
+    REQUIRE(asn1::PerEncoder::encode_oid(writer, expected).has_value());
+    const auto& data = writer.data();
+
+    core::BitReader reader(data);
+    REQUIRE(asn1::PerDecoder::decode_extension_marker(reader).has_value());
+
+    SECTION("IA5String view points into the source buffer") {
+        auto str = asn1::PerDecoder::decode_ia5_string_view(reader);
+        REQUIRE(str.has_value());
+        CHECK(*str == "gk-alias");
+        auto* first = reinterpret_cast<const std::byte*>(str->data());
+        CHECK(first >= data.data());
+        CHECK(first + str->size() <= data.data() + data.size());
+    }
+
+    SECTION("OID view iterates arcs lazily") {
+        REQUIRE(asn1::PerDecoder::decode_ia5_string_view(reader).has_value());
+        auto oid = asn1::PerDecoder::decode_oid_view(reader);
+        REQUIRE(oid.has_value());
+
+        CHECK(oid->size() == expected.size());
+        CHECK(oid->equals(expected));
+        CHECK(std::ranges::equal(oid->to_vector(), expected));
+        CHECK(reader.bits_left() == 0);
+    }
+
+    SECTION("View requires an aligned cursor") {
+        auto res = reader.view_bytes(1);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::AlignmentError);
+    }
+}
+
+TEST_CASE("ASN.1 PER: Truncated OID is rejected by the view decoder", "[asn1][view]") {
+    using namespace h323_26;
+
+    // Length 2, contents 0x00 0x91 (last arc still has the continuation bit)
+    std::vector<std::byte> data = { std::byte{0x02}, std::byte{0x00}, std::byte{0x91} };
+    core::BitReader reader(data);
+
+    auto res = asn1::PerDecoder::decode_oid_view(reader);
+    REQUIRE_FALSE(res.has_value());
+    CHECK(res.error().code == ErrorCode::InvalidConstraint);
+}
+
+TEST_CASE("ASN.1 PER: OID view of a single content octet", "[asn1][view]") {
+    using namespace h323_26;
+
+    // {1 3}: both arcs live in the one octet 0x2B
+    const std::vector<uint32_t> expected = { 1, 3 };
+    core::BitWriter writer;
+    REQUIRE(asn1::PerEncoder::encode_oid(writer, expected).has_value());
+    core::BitReader reader(writer.data());
+    auto oid = asn1::PerDecoder::decode_oid_view(reader);
+    REQUIRE(oid.has_value());
+    REQUIRE(oid->bytes().size() == 1);
+
+    CHECK(oid->size() == 2);
+    CHECK(oid->equals(expected));
+    CHECK(std::ranges::equal(oid->to_vector(), expected));
+    CHECK(std::ranges::distance(oid->begin(), oid->end()) == 2);
+
+    // Iterators at the first arc, the second arc and end() are all distinct
+    auto first = oid->begin();
+    auto second = std::next(first);
+    CHECK(first != second);
+    CHECK(second != oid->end());
+    CHECK(std::next(second) == oid->end());
+
+    // Mid-range iterators of a longer OID stay distinct as well
+    const std::vector<uint32_t> longer = { 1, 3, 6 };
+    core::BitWriter long_writer;
+    REQUIRE(asn1::PerEncoder::encode_oid(long_writer, longer).has_value());
+    core::BitReader long_reader(long_writer.data());
+    auto long_oid = asn1::PerDecoder::decode_oid_view(long_reader);
+    REQUIRE(long_oid.has_value());
+    auto arc2 = std::next(long_oid->begin());
+    auto arc3 = std::next(arc2);
+    CHECK(arc2 != arc3);
+    CHECK(*arc2 == 3);
+    CHECK(*arc3 == 6);
+    CHECK(long_oid->equals(longer));
+}
+
+TEST_CASE("ASN.1 PER: Normally small number short and long forms", "[asn1]") {
+    for (uint64_t value : { uint64_t{0}, uint64_t{63}, uint64_t{64}, uint64_t{300}, uint64_t{70000} }) {
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_normally_small_number(writer, value).has_value());
+
+        core::BitReader reader(writer.data());
+        auto decoded = PerDecoder::decode_normally_small_number(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(*decoded == value);
+        CHECK(reader.bits_left() < 8);
+    }
+
+    SECTION("Long form: marker bit, octet count, aligned value octets") {
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_normally_small_number(writer, 300).has_value());
+        // 1 | pad to octet | length 2 | 0x01 0x2C
+        std::vector<std::byte> expected = { std::byte{0x80}, std::byte{0x02}, std::byte{0x01}, std::byte{0x2C} };
+        CHECK(writer.data() == expected);
+    }
+
+    SECTION("UNALIGNED long form has no padding") {
+        core::BitWriter writer;
+        REQUIRE(UnalignedPerEncoder::encode_normally_small_number(writer, 300).has_value());
+        // 1 | length 2 (8 bits) | 0x01 0x2C, packed back to back
+        std::vector<std::byte> expected = { std::byte{0x81}, std::byte{0x00}, std::byte{0x96}, std::byte{0x00} };
+        CHECK(writer.data() == expected);
+
+        core::BitReader reader(writer.data());
+        auto decoded = UnalignedPerDecoder::decode_normally_small_number(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(*decoded == 300);
+    }
+}
+
+namespace {
+
+    // Source that hands out a generated payload in small pieces, never as one buffer
+    class PatternSource {
+    public:
+        PatternSource(size_t total, size_t piece) : left_(total), piece_(piece), buffer_(piece) {}
+
+        size_t remaining() const { return left_; }
+
+        std::span<const std::byte> next(size_t max) {
+            size_t n = std::min({ max, piece_, left_ });
+            for (size_t i = 0; i < n; ++i) buffer_[i] = std::byte(static_cast<uint8_t>((produced_ + i) * 7));
+            produced_ += n;
+            left_ -= n;
+            return std::span<const std::byte>(buffer_.data(), n);
+        }
+
+    private:
+        size_t left_;
+        size_t piece_;
+        size_t produced_ = 0;
+        std::vector<std::byte> buffer_;
+    };
+
+    std::vector<std::byte> make_pattern(size_t total) {
+        std::vector<std::byte> out(total);
+        for (size_t i = 0; i < total; ++i) out[i] = std::byte(static_cast<uint8_t>(i * 7));
+        return out;
+    }
+}
+
+TEST_CASE("ASN.1 PER: Length determinant forms", "[asn1][length]") {
+    SECTION("128..16383 uses the two-octet form") {
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_length_determinant(writer, 200).has_value());
+        CHECK(writer.data() == std::vector<std::byte>{ std::byte{0x80}, std::byte{0xC8} });
+
+        core::BitReader reader(writer.data());
+        CHECK(PerDecoder::decode_length_determinant(reader).value() == 200);
+    }
+
+    SECTION("16K and above cannot be a single length") {
+        core::BitWriter writer;
+        auto res = PerEncoder::encode_length_determinant(writer, 16384);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::InvalidConstraint);
+    }
+
+    SECTION("Fragment header is reported by the single-length decoder") {
+        std::vector<std::byte> data = { std::byte{0xC2} };
+        core::BitReader reader(data);
+        auto res = PerDecoder::decode_length_determinant(reader);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::UnsupportedFeature);
+    }
+}
+
+TEST_CASE("ASN.1 PER: Fragmented octet strings", "[asn1][length]") {
+    SECTION("Exactly 16K ends with a zero length") {
+        auto payload = make_pattern(16384);
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_octet_string(writer, payload).has_value());
+        REQUIRE(writer.data().size() == 1 + 16384 + 1);
+        CHECK(writer.data().front() == std::byte{0xC1});
+        CHECK(writer.data().back() == std::byte{0x00});
+    }
+
+    SECTION("64K + 32K fragments and a two-octet tail, streamed both ways") {
+        const size_t total = 100000;
+        PatternSource source(total, 1000);
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_octet_stream(writer, source).has_value());
+
+        // C4 | 64K | C2 | 32K | 10 + 14-bit tail length | tail
+        const auto& out = writer.data();
+        REQUIRE(out.size() == 1 + 65536 + 1 + 32768 + 2 + 1696);
+        CHECK(out[0] == std::byte{0xC4});
+        CHECK(out[1 + 65536] == std::byte{0xC2});
+        CHECK(out[2 + 65536 + 32768] == std::byte{0x86});
+        CHECK(out[3 + 65536 + 32768] == std::byte{0xA0});
+
+        std::vector<std::byte> received;
+        size_t chunks = 0;
+        struct CountingSink {
+            std::vector<std::byte>& out;
+            size_t& chunks;
+            Result<void> write(std::span<const std::byte> chunk) {
+                ++chunks;
+                out.insert(out.end(), chunk.begin(), chunk.end());
+                return {};
+            }
+        } sink{ received, chunks };
+
+        core::BitReader reader(out);
+        auto length = PerDecoder::decode_octet_stream(reader, sink);
+        REQUIRE(length.has_value());
+        CHECK(*length == total);
+        CHECK(chunks == 3);
+        CHECK(received == make_pattern(total));
+        CHECK(reader.bits_left() == 0);
+    }
+
+    SECTION("Owning IA5String decode gathers fragments") {
+        std::string text(40000, 'x');
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_ia5_string(writer, text).has_value());
+
+        core::BitReader reader(writer.data());
+        auto decoded = PerDecoder::decode_ia5_string(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(std::string_view(*decoded) == text);
+
+        core::BitReader view_reader(writer.data());
+        CHECK_FALSE(PerDecoder::decode_ia5_string_view(view_reader).has_value());
+    }
+
+    SECTION("Source shorter than it claims") {
+        struct LyingSource {
+            size_t remaining() const { return 20000; }
+            std::span<const std::byte> next(size_t) { return {}; }
+        } source;
+        core::BitWriter writer;
+        auto res = PerEncoder::encode_octet_stream(writer, source);
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::EndOfStream);
+    }
+}
+
+namespace {
+
+    // Closed-form sizes of one PER variant against its encoder, from every bit phase
+    template <typename Encoder>
+    void check_closed_form_sizes() {
+        // Writes `lead` padding bits, then runs `encode`; returns the bits it produced
+        auto measure = [](size_t lead, auto&& encode) {
+            core::BitWriter writer;
+            REQUIRE(writer.write_bits(0, lead).has_value());
+            REQUIRE(encode(writer).has_value());
+
+            core::BitCounter counter(lead);
+            REQUIRE(encode(counter).has_value());
+            CHECK(counter.bit_size() == writer.bit_offset() - lead);
+            return writer.bit_offset() - lead;
+        };
+
+        for (size_t lead = 0; lead < 8; ++lead) {
+            INFO("lead bits " << lead);
+
+            for (uint64_t value : { 0ULL, 63ULL, 64ULL, 255ULL, 256ULL, 70000ULL, ~0ULL }) {
+                CHECK(measure(lead, [&](auto& w) { return Encoder::encode_normally_small_number(w, value); })
+                    == Encoder::normally_small_number_bits(value, lead));
+                CHECK(measure(lead, [&](auto& w) { return Encoder::encode_extensible_constrained_integer(w, value, 0, 15); })
+                    == Encoder::extensible_constrained_integer_bits(value, 0, 15, lead));
+            }
+
+            for (uint32_t index : { 0u, 5u, 24u, 25u, 32u, 100u }) {
+                CHECK(measure(lead, [&](auto& w) { return Encoder::encode_choice_index(w, index, 25, true); })
+                    == Encoder::choice_index_bits(index, 25, true, lead));
+            }
+
+            // Every constrained whole number form: bit-field, one octet, two octets, indefinite length
+            struct Range { uint64_t value, min, max; };
+            for (Range r : { Range{ 5, 5, 5 }, Range{ 7, 0, 15 }, Range{ 200, 0, 255 }, Range{ 1000, 1, 65535 },
+                             Range{ 0, 0, 65536 }, Range{ 70000, 0, 4294967295ULL }, Range{ ~0ULL, 0, ~0ULL } }) {
+                CHECK(measure(lead, [&](auto& w) { return Encoder::encode_constrained_integer(w, r.value, r.min, r.max); })
+                    == Encoder::constrained_integer_bits(r.value, r.min, r.max, lead));
+            }
+
+            for (size_t length : { size_t{ 0 }, size_t{ 1 }, size_t{ 127 }, size_t{ 128 }, size_t{ 16383 },
+                                   size_t{ 16384 }, size_t{ 65536 }, size_t{ 65536 + 16384 + 5 } }) {
+                std::vector<std::byte> contents(length, std::byte{ 0x5A });
+                CHECK(measure(lead, [&](auto& w) { return Encoder::encode_octet_string(w, contents); })
+                    == Encoder::octet_string_bits(length, lead));
+            }
+
+            for (size_t length : { size_t{ 0 }, size_t{ 8 }, size_t{ 16384 + 3 } }) {
+                std::string text(length, 'a');
+                CHECK(measure(lead, [&](auto& w) { return Encoder::encode_ia5_string(w, text); })
+                    == Encoder::ia5_string_bits(text.size(), lead));
+            }
+
+            std::vector<uint32_t> oid = { 1, 3, 6, 1, 4, 1, 0, 127, 128, 16383, 16384, 4294967295u };
+            CHECK(measure(lead, [&](auto& w) { return Encoder::encode_oid(w, oid); })
+                == Encoder::oid_bits(oid, lead));
+
+            for (size_t length : { size_t{ 0 }, size_t{ 3 }, size_t{ 16384 + 3 } }) {
+                std::string text(length, 'a');
+                CHECK(measure(lead, [&](auto& w) { return Encoder::encode_bmp_string(w, text); })
+                    == Encoder::bmp_string_bits(text.size(), lead));
+            }
+
+            for (size_t bits : { size_t{ 0 }, size_t{ 5 }, size_t{ 16 }, size_t{ 16384 + 9 } }) {
+                std::vector<std::byte> contents((bits + 7) / 8, std::byte{ 0xA5 });
+                CHECK(measure(lead, [&](auto& w) { return Encoder::encode_bit_string(w, contents, bits); })
+                    == Encoder::bit_string_bits(bits, lead));
+            }
+        }
+    }
+
+} // namespace
+
+TEST_CASE("ASN.1 PER: Closed-form sizes match the encoder", "[asn1][size]") {
+    SECTION("ALIGNED") { check_closed_form_sizes<PerEncoder>(); }
+    SECTION("UNALIGNED") { check_closed_form_sizes<UnalignedPerEncoder>(); }
+}
+
+namespace {
+
+    std::vector<std::byte> bytes_of(std::initializer_list<uint8_t> values) {
+        std::vector<std::byte> out;
+        for (uint8_t v : values) out.push_back(std::byte{ v });
+        return out;
+    }
+
+    // One marker bit, then `encode`: shows whether the field starts on an octet boundary
+    template <typename Encode>
+    std::vector<std::byte> after_one_bit(Encode&& encode) {
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(1, 1).has_value());
+        REQUIRE(encode(writer).has_value());
+        return writer.data();
+    }
+
+} // namespace
+
+TEST_CASE("ASN.1 PER: ALIGNED and UNALIGNED variants", "[asn1][variant]") {
+    SECTION("Constrained whole numbers") {
+        // Range <= 255: bit-field in both variants
+        CHECK(after_one_bit([](auto& w) { return PerEncoder::encode_constrained_integer(w, 5, 0, 14); }) == bytes_of({ 0xA8 }));
+        CHECK(after_one_bit([](auto& w) { return UnalignedPerEncoder::encode_constrained_integer(w, 5, 0, 14); }) == bytes_of({ 0xA8 }));
+
+        // Range 256: one aligned octet vs 8 bits in place
+        CHECK(after_one_bit([](auto& w) { return PerEncoder::encode_constrained_integer(w, 200, 0, 255); }) == bytes_of({ 0x80, 0xC8 }));
+        CHECK(after_one_bit([](auto& w) { return UnalignedPerEncoder::encode_constrained_integer(w, 200, 0, 255); }) == bytes_of({ 0xE4, 0x00 }));
+
+        // Range 64K: two aligned octets vs 16 bits in place
+        CHECK(after_one_bit([](auto& w) { return PerEncoder::encode_constrained_integer(w, 1000, 1, 65535); }) == bytes_of({ 0x80, 0x03, 0xE7 }));
+        CHECK(after_one_bit([](auto& w) { return UnalignedPerEncoder::encode_constrained_integer(w, 1000, 1, 65535); }) == bytes_of({ 0x81, 0xF3, 0x80 }));
+
+        // Range 2^32: 2-bit octet count (3 - 1), pad, three octets vs 32 bits in place
+        CHECK(after_one_bit([](auto& w) { return PerEncoder::encode_constrained_integer(w, 70000, 0, 4294967295ULL); })
+            == bytes_of({ 0xC0, 0x01, 0x11, 0x70 }));
+        CHECK(after_one_bit([](auto& w) { return UnalignedPerEncoder::encode_constrained_integer(w, 70000, 0, 4294967295ULL); })
+            == bytes_of({ 0x80, 0x00, 0x88, 0xB8, 0x00 }));
+
+        for (uint64_t value : { 0ULL, 1ULL, 255ULL, 256ULL, 70000ULL, 4294967295ULL }) {
+            INFO("value " << value);
+            auto aligned = after_one_bit([&](auto& w) { return PerEncoder::encode_constrained_integer(w, value, 0, 4294967295ULL); });
+            core::BitReader reader(aligned);
+            REQUIRE(reader.skip_bits(1).has_value());
+            CHECK(PerDecoder::decode_constrained_integer(reader, 0, 4294967295ULL) == value);
+
+            auto unaligned = after_one_bit([&](auto& w) { return UnalignedPerEncoder::encode_constrained_integer(w, value, 0, 4294967295ULL); });
+            core::BitReader unaligned_reader(unaligned);
+            REQUIRE(unaligned_reader.skip_bits(1).has_value());
+            CHECK(UnalignedPerDecoder::decode_constrained_integer(unaligned_reader, 0, 4294967295ULL) == value);
+        }
+    }
+
+    SECTION("Length determinants and octet strings") {
+        auto contents = bytes_of({ 0xDE, 0xAD });
+        CHECK(after_one_bit([&](auto& w) { return PerEncoder::encode_octet_string(w, contents); })
+            == bytes_of({ 0x80, 0x02, 0xDE, 0xAD }));
+        CHECK(after_one_bit([&](auto& w) { return UnalignedPerEncoder::encode_octet_string(w, contents); })
+            == bytes_of({ 0x81, 0x6F, 0x56, 0x80 }));
+
+        auto unaligned = after_one_bit([&](auto& w) { return UnalignedPerEncoder::encode_octet_string(w, contents); });
+        core::BitReader reader(unaligned);
+        REQUIRE(reader.skip_bits(1).has_value());
+        std::vector<std::byte> decoded;
+        core::AppendOctetSink sink(decoded);
+        CHECK(UnalignedPerDecoder::decode_octet_stream(reader, sink) == size_t{ 2 });
+        CHECK(decoded == contents);
+    }
+
+    SECTION("IA5String: 8-bit aligned vs 7-bit packed characters") {
+        CHECK(after_one_bit([](auto& w) { return PerEncoder::encode_ia5_string(w, "AB"); })
+            == bytes_of({ 0x80, 0x02, 0x41, 0x42 }));
+        // 1 | length 00000010 | 1000001 1000010
+        CHECK(after_one_bit([](auto& w) { return UnalignedPerEncoder::encode_ia5_string(w, "AB"); })
+            == bytes_of({ 0x81, 0x41, 0x84 }));
+
+        for (size_t lead = 0; lead < 8; ++lead) {
+            INFO("lead bits " << lead);
+            std::string text = "gatekeeper.example";
+            core::BitWriter writer;
+            REQUIRE(writer.write_bits(0, lead).has_value());
+            REQUIRE(UnalignedPerEncoder::encode_ia5_string(writer, text).has_value());
+            CHECK(writer.bit_offset() == lead + 8 + 7 * text.size());
+
+            core::BitReader reader(writer.data());
+            REQUIRE(reader.skip_bits(lead).has_value());
+            auto decoded = UnalignedPerDecoder::decode_ia5_string(reader);
+            REQUIRE(decoded.has_value());
+            CHECK(std::string_view(*decoded) == text);
+        }
+
+        core::BitWriter writer;
+        auto res = UnalignedPerEncoder::encode_ia5_string(writer, "caf\xE9");
+        REQUIRE_FALSE(res.has_value());
+        CHECK(res.error().code == ErrorCode::InvalidConstraint);
+    }
+
+    SECTION("Object identifiers") {
+        std::vector<uint32_t> oid = { 0, 0, 8, 2250, 0, 7 };
+        CHECK(after_one_bit([&](auto& w) { return PerEncoder::encode_oid(w, oid); })
+            == bytes_of({ 0x80, 0x06, 0x00, 0x08, 0x91, 0x4A, 0x00, 0x07 }));
+
+        auto unaligned = after_one_bit([&](auto& w) { return UnalignedPerEncoder::encode_oid(w, oid); });
+        CHECK(unaligned.size() == 8); // 1 + 8 + 48 bits
+        core::BitReader reader(unaligned);
+        REQUIRE(reader.skip_bits(1).has_value());
+        auto decoded = UnalignedPerDecoder::decode_oid(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(std::ranges::equal(*decoded, oid));
+    }
+}
+
+namespace {
+
+    // "Gr\u00FC\u00DFe \u6771\u4EAC": one-, two- and three-octet UTF-8 characters
+    constexpr std::string_view MixedText = "Gr\xC3\xBC\xC3\x9F" "e \xE6\x9D\xB1\xE4\xBA\xAC";
+
+    // Writes `lead` bits, then `encode`; the reader is left positioned after the lead bits
+    template <typename Encode>
+    std::vector<std::byte> encode_after(size_t lead, Encode&& encode) {
+        core::BitWriter writer;
+        REQUIRE(writer.write_bits(0, lead).has_value());
+        REQUIRE(encode(writer).has_value());
+        return writer.data();
+    }
+
+    // BMPString, BIT STRING and owning OCTET STRING round trips from every bit phase
+    template <typename Encoder, typename Decoder>
+    void check_string_round_trips() {
+        std::string long_ascii;
+        for (size_t i = 0; i < 100; ++i) long_ascii.push_back(static_cast<char>('a' + i % 26));
+        std::string fragmented;
+        while (fragmented.size() < 40000) fragmented += MixedText;
+
+        for (size_t lead = 0; lead < 8; ++lead) {
+            INFO("lead bits " << lead);
+
+            for (std::string_view text : { std::string_view{}, MixedText, std::string_view(long_ascii), std::string_view(fragmented) }) {
+                auto data = encode_after(lead, [&](auto& w) { return Encoder::encode_bmp_string(w, text); });
+                core::BitReader reader(data);
+                REQUIRE(reader.skip_bits(lead).has_value());
+                auto decoded = Decoder::decode_bmp_string(reader);
+                REQUIRE(decoded.has_value());
+                CHECK(std::string_view(*decoded) == text);
+            }
+
+            for (size_t bits : { size_t{ 0 }, size_t{ 1 }, size_t{ 7 }, size_t{ 8 }, size_t{ 9 }, size_t{ 100 }, size_t{ 16384 + 3 } }) {
+                BitStringValue value;
+                value.bits = bits;
+                for (size_t i = 0; i < (bits + 7) / 8; ++i) value.octets.push_back(std::byte(static_cast<uint8_t>(i * 37 + 11)));
+                if (bits % 8 != 0) value.octets.back() &= std::byte(static_cast<uint8_t>(0xFF << (8 - bits % 8)));
+
+                auto data = encode_after(lead, [&](auto& w) { return Encoder::encode_bit_string(w, value.octets, bits); });
+                core::BitReader reader(data);
+                REQUIRE(reader.skip_bits(lead).has_value());
+                auto decoded = Decoder::decode_bit_string(reader);
+                REQUIRE(decoded.has_value());
+                CHECK(*decoded == value);
+            }
+
+            std::vector<std::byte> contents;
+            for (size_t i = 0; i < 100; ++i) contents.push_back(std::byte(static_cast<uint8_t>(i * 7)));
+            auto data = encode_after(lead, [&](auto& w) { return Encoder::encode_octet_string(w, contents); });
+            core::BitReader reader(data);
+            REQUIRE(reader.skip_bits(lead).has_value());
+            auto decoded = Decoder::decode_octet_string(reader);
+            REQUIRE(decoded.has_value());
+            CHECK(std::ranges::equal(*decoded, contents));
+        }
+    }
+
+} // namespace
+
+TEST_CASE("ASN.1 PER: BMPString, BIT STRING and owning OCTET STRING", "[asn1][strings]") {
+    SECTION("ALIGNED round trips") { check_string_round_trips<PerEncoder, PerDecoder>(); }
+    SECTION("UNALIGNED round trips") { check_string_round_trips<UnalignedPerEncoder, UnalignedPerDecoder>(); }
+
+    SECTION("BMPString wire format") {
+        // 1 | pad | length 2 | 0x0041 0x00FC
+        CHECK(after_one_bit([](auto& w) { return PerEncoder::encode_bmp_string(w, "A\xC3\xBC"); })
+            == bytes_of({ 0x80, 0x02, 0x00, 0x41, 0x00, 0xFC }));
+        CHECK(after_one_bit([](auto& w) { return UnalignedPerEncoder::encode_bmp_string(w, "A\xC3\xBC"); })
+            == bytes_of({ 0x81, 0x00, 0x20, 0x80, 0x7E, 0x00 }));
+    }
+
+    SECTION("BMPString outside the BMP or with surrogates is rejected") {
+        core::BitWriter writer;
+        for (std::string_view bad : { std::string_view("\xF0\x9F\x98\x80"), std::string_view("\xED\xA0\x80"),
+                                      std::string_view("\xC3"), std::string_view("\xC0\x80") }) {
+            auto res = PerEncoder::encode_bmp_string(writer, bad);
+            REQUIRE_FALSE(res.has_value());
+            CHECK(res.error().code == ErrorCode::InvalidConstraint);
+        }
+
+        // Length 1, then a lone high surrogate
+        auto data = bytes_of({ 0x01, 0xD8, 0x00 });
+        core::BitReader reader(data);
+        auto decoded = PerDecoder::decode_bmp_string(reader);
+        REQUIRE_FALSE(decoded.has_value());
+        CHECK(decoded.error().code == ErrorCode::InvalidConstraint);
+    }
+
+    SECTION("Fixed sizes up to 16 bits are not aligned") {
+        // BIT STRING (SIZE(12)) right after the marker bit: 1 + 12 bits, no padding
+        auto data = bytes_of({ 0xD5, 0x58 });
+        core::BitReader reader(data);
+        REQUIRE(reader.skip_bits(1).has_value());
+        auto bits = PerDecoder::decode_bit_string(reader, 12);
+        REQUIRE(bits.has_value());
+        CHECK(bits->bits == 12);
+        CHECK(bits->octets == std::pmr::vector<std::byte>{ std::byte{ 0xAA }, std::byte{ 0xB0 } });
+        CHECK(bits->test(0));
+        CHECK_FALSE(bits->test(1));
+        CHECK(reader.bit_offset() == 13);
+
+        // BMPString (SIZE(1)) is 16 bits in place; SIZE(2) starts on the next octet: U+2080, 'B'
+        auto chars = bytes_of({ 0x80, 0x20, 0x80, 0x00, 0x42 });
+        core::BitReader one(chars);
+        REQUIRE(one.skip_bits(1).has_value());
+        CHECK(PerDecoder::decode_bmp_string(one, 1).value() == "A");
+        CHECK(one.bit_offset() == 17);
+        core::BitReader two(chars);
+        REQUIRE(two.skip_bits(1).has_value());
+        CHECK(PerDecoder::decode_bmp_string(two, 2).value() == "\xE2\x82\x80" "B");
+    }
+
+    SECTION("Truncated contents report EndOfStream") {
+        auto data = bytes_of({ 0x03, 0x00, 0x41, 0x00 });
+        core::BitReader bmp(data);
+        CHECK(PerDecoder::decode_bmp_string(bmp).error().code == ErrorCode::EndOfStream);
+        core::BitReader bits(data);
+        CHECK(PerDecoder::decode_bit_string(bits, 40).error().code == ErrorCode::EndOfStream);
+    }
+}
+
+TEST_CASE("ASN.1 PER: Single-pass OID encoding", "[asn1][oid]") {
+    SECTION("Multi-octet arcs round-trip") {
+        std::vector<uint32_t> oid = { 2, 39, 0, 127, 128, 16383, 16384, 2097151, 2097152, 4294967295u };
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_oid(writer, oid).has_value());
+        CHECK(writer.data()[0] == std::byte(PerEncoder::oid_content_octets(oid)));
+
+        core::BitReader reader(writer.data());
+        auto decoded = PerDecoder::decode_oid(reader);
+        REQUIRE(decoded.has_value());
+        CHECK(std::ranges::equal(*decoded, oid));
+    }
+
+    SECTION("Base-128 layout of a two-octet arc") {
+        // 2250 = 0x8CA -> 0x91 0x4A
+        std::vector<uint32_t> oid = { 0, 0, 8, 2250, 0, 7 };
+        core::BitWriter writer;
+        REQUIRE(PerEncoder::encode_oid(writer, oid).has_value());
+        const std::vector<std::byte> expected = { std::byte{ 0x06 }, std::byte{ 0x00 }, std::byte{ 0x08 },
+            std::byte{ 0x91 }, std::byte{ 0x4A }, std::byte{ 0x00 }, std::byte{ 0x07 } };
+        CHECK(writer.data() == expected);
+    }
+
+    SECTION("First arcs that do not fit one octet are rejected") {
+        core::BitWriter writer;
+        for (auto oid : { std::vector<uint32_t>{ 3, 0 }, std::vector<uint32_t>{ 1, 40 }, std::vector<uint32_t>{ 0 } }) {
+            auto res = PerEncoder::encode_oid(writer, oid);
+            REQUIRE_FALSE(res.has_value());
+            CHECK(res.error().code == ErrorCode::InvalidConstraint);
+        }
+    }
+}
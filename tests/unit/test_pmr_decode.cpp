@@ -0,0 +1,291 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/h225/ras.hpp>
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/h225/ras_pool.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <variant>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+// Счетчик глобальных аллокаций для всего бинарника unit_tests
+namespace {
+    std::atomic<size_t> g_global_allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    g_global_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    g_global_allocations.fetch_add(1, std::memory_order_relaxed);
+    auto alignment = static_cast<std::size_t>(align);
+#ifdef _MSC_VER
+    if (void* p = _aligned_malloc(size ? size : 1, alignment)) return p;
+#else
+    if (void* p = std::aligned_alloc(alignment, (size + alignment) / alignment * alignment)) return p;
+#endif
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#ifdef _MSC_VER
+void operator delete(void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { _aligned_free(p); }
+#else
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
+
+using namespace h323_26;
+
+namespace {
+    // GRQ с alias длиннее SSO-буфера строки
+    std::vector<std::byte> make_grq_datagram(uint16_t seq) {
+        h225::GatekeeperRequest grq{
+            .requestSeqNum = seq,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .endpointAlias = "H.323.26-Terminal-with-a-long-alias"
+        };
+        core::BitWriter writer;
+        (void)grq.encode(writer);
+        return writer.data();
+    }
+
+    // Тот же GRQ, но в обертке RasMessage — для пула
+    std::vector<std::byte> make_grq_pdu(uint16_t seq) {
+        h225::RasMessage msg = h225::GatekeeperRequest{
+            .requestSeqNum = seq,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .endpointAlias = "H.323.26-Terminal-with-a-long-alias"
+        };
+        core::BitWriter writer;
+        (void)h225::RasPDU::encode(writer, msg);
+        return writer.data();
+    }
+
+    // RRQ с count псевдонимами (H323-ID и номера вперемешку) длиннее SSO-буфера
+    std::vector<std::byte> make_rrq_datagram(uint16_t seq, int count) {
+        const h225::TransportAddress address{ .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 1 } }, .port = 1720 };
+        h225::AliasList aliases;
+        for (int i = 0; i < count; ++i) {
+            if (i % 2 == 0) aliases.push_back(h225::H323Id{ std::pmr::string("gateway-alias-number-" + std::to_string(i)) });
+            else aliases.push_back(h225::DialedDigits{ std::pmr::string("74951234567" + std::to_string(i)) });
+        }
+        h225::RasMessage msg = h225::RegistrationRequest{
+            .requestSeqNum = seq,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .discoveryComplete = true,
+            .callSignalAddress = { address },
+            .rasAddress = { address },
+            .terminalAlias = std::move(aliases),
+            .gatekeeperIdentifier = "gatekeeper-with-a-long-identifier",
+            .timeToLive = 300
+        };
+        core::BitWriter writer;
+        (void)h225::RasPDU::encode(writer, msg);
+        return writer.data();
+    }
+}
+
+TEST_CASE("H.225.0 RAS: Arena decode performs no global allocations", "[h225][pmr]") {
+    auto datagram = make_grq_datagram(42);
+
+    SECTION("Default resource allocates from the global heap") {
+        size_t before = g_global_allocations.load();
+        {
+            core::BitReader reader(datagram);
+            auto grq = h225::GatekeeperRequest::decode(reader);
+            REQUIRE(grq.has_value());
+        }
+        // OID H.225.0 v7 интернирован и памяти не требует — остается строка alias
+        CHECK(g_global_allocations.load() - before >= 1);
+    }
+
+    SECTION("Per-datagram monotonic arena") {
+        alignas(std::max_align_t) std::array<std::byte, 1024> storage;
+        for (uint16_t seq = 1; seq <= 8; ++seq) {
+            auto message = make_grq_datagram(seq);
+
+            size_t before = g_global_allocations.load();
+            {
+                // Вышестоящий ресурс — null: любая попытка выйти за арену бросит bad_alloc
+                std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+                core::BitReader reader(message);
+                auto grq = h225::GatekeeperRequest::decode(reader, &arena);
+
+                REQUIRE(grq.has_value());
+                CHECK(grq->requestSeqNum == seq);
+                CHECK(grq->protocolIdentifier.size() == 6);
+                REQUIRE(grq->endpointAlias.has_value());
+                CHECK(*grq->endpointAlias == "H.323.26-Terminal-with-a-long-alias");
+                CHECK(grq->endpointAlias->get_allocator().resource() == &arena);
+            }
+            CHECK(g_global_allocations.load() - before == 0);
+        }
+    }
+}
+
+TEST_CASE("H.225.0 RAS: a hostile list length does not drive allocation", "[h225][pmr]") {
+    // AliasList без ограничения размера: длина 16383 и два октета вместо элементов
+    const std::array<std::byte, 4> hostile{ std::byte{ 0xBF }, std::byte{ 0xFF }, std::byte{ 0x00 }, std::byte{ 0x00 } };
+
+    alignas(std::max_align_t) std::array<std::byte, 4096> storage;
+    std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+    core::BitReader reader(hostile);
+
+    // Резерв под 16383 псевдонима не поместился бы в арену и бросил бы bad_alloc
+    auto list = h225::AliasListCodec::decode_value<h225::AliasList>(reader, asn1::DecodeContext{ &arena });
+    CHECK_FALSE(list.has_value());
+
+    // То же на месте: раздутая емкость осталась бы у сообщения пула навсегда
+    h225::AliasList reused(&arena);
+    core::BitReader again(hostile);
+    CHECK_FALSE(h225::AliasListCodec::decode_into(reused, again, asn1::DecodeContext{ &arena }).has_value());
+    CHECK(reused.capacity() <= hostile.size() * 8);
+}
+
+TEST_CASE("ASN.1 PER: a hostile OID length does not drive allocation", "[asn1][pmr]") {
+    // Длина OID 16383 октета, а на входе всего два
+    const std::array<std::byte, 4> hostile{ std::byte{ 0xBF }, std::byte{ 0xFF }, std::byte{ 0x06 }, std::byte{ 0x00 } };
+
+    alignas(std::max_align_t) std::array<std::byte, 4096> storage;
+    std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+    std::pmr::vector<uint32_t> nodes(&arena);
+    core::BitReader reader(hostile);
+
+    // Резерв под 16384 дуги не поместился бы в арену и бросил бы bad_alloc
+    CHECK_FALSE(asn1::PerDecoder::decode_oid_into(nodes, reader).has_value());
+    CHECK(nodes.capacity() == 0);
+}
+
+TEST_CASE("H.225.0 RAS: Header peek performs no global allocations", "[h225][pmr]") {
+    h225::RasMessage msg = h225::GatekeeperRequest{
+        .requestSeqNum = 42,
+        .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+        .gatekeeperIdentifier = "gatekeeper-with-a-long-identifier"
+    };
+    core::BitWriter writer;
+    REQUIRE(h225::RasPDU::encode(writer, msg).has_value());
+
+    size_t before = g_global_allocations.load();
+    auto header = h225::RasPDU::peek(writer.data(), true);
+    CHECK(g_global_allocations.load() - before == 0);
+
+    REQUIRE(header.has_value());
+    CHECK(header->type == h225::RasMessageType::gatekeeperRequest);
+    CHECK(header->requestSeqNum == 42);
+    CHECK(header->identifier.equals("gatekeeper-with-a-long-identifier"));
+}
+
+TEST_CASE("H.225.0 RAS: decode_into and the message pool reuse capacity", "[h225][pmr]") {
+    SECTION("decode_into a GRQ allocates only on the first message") {
+        h225::GatekeeperRequest grq{};
+        for (uint16_t seq = 1; seq <= 4; ++seq) {
+            auto message = make_grq_datagram(seq);
+            size_t before = g_global_allocations.load();
+            core::BitReader reader(message);
+            REQUIRE(h225::GatekeeperRequest::decode_into(grq, reader).has_value());
+            size_t allocations = g_global_allocations.load() - before;
+
+            CHECK(grq.requestSeqNum == seq);
+            CHECK(grq.endpointAlias == "H.323.26-Terminal-with-a-long-alias");
+            if (seq > 1) CHECK(allocations == 0);
+        }
+    }
+
+    SECTION("A pool decodes a steady stream without allocations") {
+        h225::RasMessagePool pool;
+        auto first = make_rrq_datagram(1, 12);
+        auto second = make_rrq_datagram(2, 12);
+        auto grq = make_grq_pdu(3);
+
+        // Разогрев: по сообщению каждого вида
+        REQUIRE(pool.decode(first).has_value());
+        REQUIRE(pool.decode(grq).has_value());
+
+        size_t before = g_global_allocations.load();
+        for (int round = 0; round < 4; ++round) {
+            for (const auto* datagram : { &second, &grq, &first }) {
+                auto msg = pool.decode(*datagram);
+                REQUIRE(msg.has_value());
+            }
+        }
+        CHECK(g_global_allocations.load() - before == 0);
+    }
+
+    SECTION("Pooled messages match a fresh decode") {
+        h225::RasMessagePool pool;
+        for (int count : { 5, 1, 8, 2 }) {
+            auto datagram = make_rrq_datagram(static_cast<uint16_t>(count), count);
+            auto pooled = pool.decode(datagram);
+            REQUIRE(pooled.has_value());
+
+            core::BitReader reader(datagram);
+            auto fresh = h225::RasPDU::decode(reader);
+            REQUIRE(fresh.has_value());
+
+            const auto& a = std::get<h225::RegistrationRequest>(**pooled);
+            const auto& b = std::get<h225::RegistrationRequest>(*fresh);
+            CHECK(a.requestSeqNum == b.requestSeqNum);
+            CHECK((a.terminalAlias == b.terminalAlias));
+            CHECK(a.gatekeeperIdentifier == b.gatekeeperIdentifier);
+            CHECK((a.callSignalAddress == b.callSignalAddress));
+        }
+
+        // Сообщения разных типов живут в разных ячейках пула
+        auto rrq = pool.decode(make_rrq_datagram(9, 2));
+        auto grq = pool.decode(make_grq_pdu(10));
+        REQUIRE(rrq.has_value());
+        REQUIRE(grq.has_value());
+        CHECK(*rrq != *grq);
+        CHECK(std::get<h225::RegistrationRequest>(**rrq).requestSeqNum == 9);
+        CHECK(std::get<h225::GatekeeperRequest>(**grq).requestSeqNum == 10);
+    }
+
+    SECTION("Pooled extension additions borrow the datagram") {
+        core::BitWriter alias_bits;
+        REQUIRE(h225::AliasListCodec::encode_value(alias_bits, h225::AliasList{ h225::H323Id{ "extra" } }).has_value());
+        alias_bits.align_to_byte();
+
+        h225::RegistrationRequest rrq{
+            .requestSeqNum = 77,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .gatekeeperIdentifier = "gatekeeper-with-a-long-identifier"
+        };
+        rrq.extensions.set_raw(4, alias_bits.data());
+        core::BitWriter writer;
+        REQUIRE(h225::RasPDU::encode(writer, h225::RasMessage{ std::move(rrq) }).has_value());
+        std::vector<std::byte> datagram = writer.data();
+
+        h225::RasMessagePool pool;
+        auto pooled = pool.decode(datagram);
+        REQUIRE(pooled.has_value());
+        const auto& msg = std::get<h225::RegistrationRequest>(**pooled);
+        const auto raw = msg.extensions.raw(4);
+        REQUIRE(raw.size() == alias_bits.data().size());
+        CHECK(raw.data() >= datagram.data());
+        CHECK(raw.data() + raw.size() <= datagram.data() + datagram.size());
+
+        // Буфер приема отдан под следующую датаграмму: собственные поля сообщения
+        // уцелели, а дополнения видят уже новые октеты
+        std::ranges::fill(datagram, std::byte{ 0 });
+        CHECK(msg.requestSeqNum == 77);
+        CHECK(msg.gatekeeperIdentifier == "gatekeeper-with-a-long-identifier");
+        CHECK(std::ranges::all_of(msg.extensions.raw(4), [](std::byte b) { return b == std::byte{ 0 }; }));
+    }
+}
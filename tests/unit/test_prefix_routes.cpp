@@ -0,0 +1,170 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/gk/prefix_routes.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace h323_26;
+using namespace h323_26::gk;
+
+namespace {
+
+    std::optional<PrefixRoutes::Route> route_of(const PrefixRoutes& routes, std::string_view digits) {
+        auto match = routes.lookup(digits);
+        if (!match) return std::nullopt;
+        return match->route;
+    }
+
+} // namespace
+
+TEST_CASE("gk::PrefixRoutes: longest prefix wins", "[gk][prefix]") {
+    PrefixRoutes routes;
+    const std::vector<PrefixRoutes::Entry> entries{
+        { "7", 1 }, { "749", 2 }, { "7495", 3 }, { "812", 4 }, { "*99#", 5 },
+    };
+    REQUIRE(routes.load(entries).has_value());
+    CHECK(routes.size() == 5);
+
+    auto match = routes.lookup("74951234567");
+    REQUIRE(match.has_value());
+    CHECK(match->route == 3);
+    CHECK(match->length == 4);
+
+    CHECK(route_of(routes, "7496") == 2);
+    CHECK(route_of(routes, "7") == 1);
+    CHECK(route_of(routes, "70") == 1);
+    CHECK(route_of(routes, "8121") == 4);
+    CHECK(route_of(routes, "*99#1") == 5);
+    CHECK_FALSE(routes.lookup("81").has_value());
+    CHECK_FALSE(routes.lookup("").has_value());
+
+    // Символ вне алфавита dialedDigits обрывает поиск
+    CHECK(route_of(routes, "749x5") == 2);
+}
+
+TEST_CASE("gk::PrefixRoutes: empty prefix is the default route", "[gk][prefix]") {
+    PrefixRoutes routes;
+    const std::vector<PrefixRoutes::Entry> entries{ { "", 9 }, { "1", 1 } };
+    REQUIRE(routes.load(entries).has_value());
+
+    auto match = routes.lookup("555");
+    REQUIRE(match.has_value());
+    CHECK(match->route == 9);
+    CHECK(match->length == 0);
+    CHECK(route_of(routes, "15") == 1);
+}
+
+TEST_CASE("gk::PrefixRoutes: aliases from the decoder", "[gk][prefix]") {
+    PrefixRoutes routes;
+    const std::vector<PrefixRoutes::Entry> entries{ { "1", 1 } };
+    REQUIRE(routes.load(entries).has_value());
+
+    CHECK(routes.lookup(h225::AliasAddress{ h225::DialedDigits{ std::pmr::string("123") } })->route == 1);
+    CHECK_FALSE(routes.lookup(h225::AliasAddress{ h225::H323Id{ std::pmr::string("123") } }).has_value());
+}
+
+TEST_CASE("gk::PrefixRoutes: invalid input is rejected", "[gk][prefix]") {
+    PrefixRoutes routes;
+    const std::vector<PrefixRoutes::Entry> bad_digit{ { "1", 1 }, { "12a", 2 } };
+    auto res = routes.load(bad_digit);
+    REQUIRE_FALSE(res.has_value());
+    CHECK(res.error().code == ErrorCode::InvalidConstraint);
+    CHECK(routes.size() == 0);
+
+    CHECK(routes.insert("1", PrefixRoutes::no_route).error().code == ErrorCode::InvalidConstraint);
+    CHECK(routes.erase("1 ").error().code == ErrorCode::InvalidConstraint);
+}
+
+TEST_CASE("gk::PrefixRoutes: bulk load keeps the last duplicate", "[gk][prefix]") {
+    PrefixRoutes routes;
+    const std::vector<PrefixRoutes::Entry> entries{ { "42", 1 }, { "4", 2 }, { "42", 3 }, { "42", 4 }, { "4", 5 } };
+    REQUIRE(routes.load(entries).has_value());
+    CHECK(routes.size() == 2);
+    CHECK(route_of(routes, "421") == 4);
+    CHECK(route_of(routes, "43") == 5);
+
+    // Повторная загрузка заменяет таблицу целиком
+    const std::vector<PrefixRoutes::Entry> other{ { "5", 6 } };
+    REQUIRE(routes.load(other).has_value());
+    CHECK(routes.size() == 1);
+    CHECK_FALSE(routes.lookup("421").has_value());
+    CHECK(route_of(routes, "5") == 6);
+}
+
+TEST_CASE("gk::PrefixRoutes: staged changes become visible on publish", "[gk][prefix]") {
+    PrefixRoutes routes;
+    const std::vector<PrefixRoutes::Entry> entries{ { "1", 1 }, { "12", 2 }, { "3", 3 } };
+    REQUIRE(routes.load(entries).has_value());
+
+    REQUIRE(routes.insert("123", 4).has_value());
+    REQUIRE(routes.insert("3", 30).has_value());
+    REQUIRE(routes.erase("12").has_value());
+    REQUIRE(routes.erase("999").has_value());
+    REQUIRE(routes.insert("#", 5).has_value());
+
+    CHECK(route_of(routes, "1234") == 2);
+    CHECK(routes.size() == 3);
+
+    routes.publish();
+    CHECK(routes.size() == 4);
+    CHECK(route_of(routes, "1234") == 4);
+    CHECK(route_of(routes, "125") == 1);
+    CHECK(route_of(routes, "3") == 30);
+    CHECK(route_of(routes, "#1") == 5);
+    CHECK_FALSE(routes.lookup("9").has_value());
+
+    // Удаление последнего префикса и вставка в пустую таблицу
+    for (std::string_view prefix : { "1", "123", "3", "#" }) REQUIRE(routes.erase(prefix).has_value());
+    routes.publish();
+    CHECK(routes.size() == 0);
+    CHECK_FALSE(routes.lookup("1234").has_value());
+
+    REQUIRE(routes.insert("12", 7).has_value());
+    routes.publish();
+    CHECK(route_of(routes, "129") == 7);
+}
+
+TEST_CASE("gk::PrefixRoutes: lookups run concurrently with publish", "[gk][prefix]") {
+    // Маршрут каждого префикса кодирует поколение: читатель должен видеть
+    // согласованную таблицу одного из поколений, а не смесь или мусор
+    constexpr uint32_t prefixes = 512;
+    constexpr uint32_t generations = 200;
+
+    PrefixRoutes routes;
+    std::vector<std::string> keys;
+    std::vector<PrefixRoutes::Entry> entries;
+    for (uint32_t i = 0; i < prefixes; ++i) keys.push_back("7" + std::to_string(1000 + i));
+    for (uint32_t i = 0; i < prefixes; ++i) entries.push_back({ keys[i], i });
+    REQUIRE(routes.load(entries).has_value());
+
+    std::atomic<bool> done{ false };
+    std::atomic<size_t> errors{ 0 };
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&, r] {
+            uint32_t last = 0;
+            for (uint32_t i = r; !done.load(std::memory_order_relaxed); i = (i + 7) % prefixes) {
+                auto match = routes.lookup(keys[i] + "55");
+                if (!match || match->route % prefixes != i || match->length != keys[i].size()) {
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                // Поколения у одного читателя не идут назад
+                const uint32_t generation = match->route / prefixes;
+                if (generation < last) errors.fetch_add(1, std::memory_order_relaxed);
+                last = generation;
+            }
+        });
+    }
+
+    for (uint32_t g = 1; g <= generations; ++g) {
+        for (uint32_t i = 0; i < prefixes; ++i) (void)routes.insert(keys[i], g * prefixes + i);
+        routes.publish();
+    }
+    done.store(true);
+    for (auto& reader : readers) reader.join();
+
+    CHECK(errors.load() == 0);
+    CHECK(route_of(routes, keys[5]) == generations * prefixes + 5);
+}
@@ -0,0 +1,169 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/h225/ras.hpp>
+#include <h323_26/h225/ras_batch.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <h323_26/core/worker_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace h323_26;
+using namespace h323_26::h225;
+
+namespace {
+
+    RasMessage make_grq(uint16_t seq) {
+        return GatekeeperRequest{
+            .requestSeqNum = seq,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .endpointAlias = std::pmr::string("terminal-with-a-long-alias-" + std::to_string(seq))
+        };
+    }
+
+    RasMessage make_rrq(uint16_t seq) {
+        const TransportAddress address{ .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 1 } }, .port = 1720 };
+        return RegistrationRequest{
+            .requestSeqNum = seq,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .discoveryComplete = true,
+            .callSignalAddress = { address },
+            .rasAddress = { address },
+            .terminalAlias = AliasList{ DialedDigits{ "1001" }, H323Id{ std::pmr::string("gateway-" + std::to_string(seq)) } },
+            .timeToLive = 300
+        };
+    }
+
+    std::vector<std::byte> encode(const RasMessage& msg) {
+        core::BitWriter writer;
+        REQUIRE(RasPDU::encode(writer, msg).has_value());
+        return writer.data();
+    }
+
+    // Пакет вперемешку: GRQ, RRQ и каждая седьмая датаграмма обрезана
+    std::vector<std::vector<std::byte>> make_batch(size_t count) {
+        std::vector<std::vector<std::byte>> batch;
+        for (size_t i = 0; i < count; ++i) {
+            auto seq = static_cast<uint16_t>(i + 1);
+            auto datagram = encode(i % 2 == 0 ? make_grq(seq) : make_rrq(seq));
+            if (i % 7 == 6) datagram.resize(3);
+            batch.push_back(std::move(datagram));
+        }
+        return batch;
+    }
+
+    std::vector<std::span<const std::byte>> spans(const std::vector<std::vector<std::byte>>& batch) {
+        return { batch.begin(), batch.end() };
+    }
+
+    // Сверяет результат пакета с разбором датаграмм по одной; сообщения
+    // сравниваются по повторной кодировке
+    void check_against_single(const RasBatchDecoder& decoder, const std::vector<std::vector<std::byte>>& batch, bool full) {
+        const auto& headers = decoder.headers();
+        REQUIRE(headers.size() == batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            INFO("datagram " << i);
+            core::BitReader reader(batch[i]);
+            auto single = RasPDU::decode(reader);
+            if (!single) {
+                CHECK(headers.status[i] == single.error().code);
+                CHECK(decoder.message(i) == nullptr);
+                continue;
+            }
+
+            REQUIRE(headers.status[i] == ErrorCode::Success);
+            CHECK(headers.type[i] == RasPDU::type_of(*single));
+            CHECK(headers.requestSeqNum[i] == i + 1);
+            if (full) {
+                REQUIRE(decoder.message(i) != nullptr);
+                CHECK(encode(*decoder.message(i)) == batch[i]);
+            }
+        }
+    }
+
+} // namespace
+
+TEST_CASE("core::WorkerPool: parallel_for visits every index once", "[core][batch]") {
+    for (size_t threads : { 0, 1, 3 }) {
+        INFO("threads " << threads);
+        core::WorkerPool pool(threads);
+        CHECK(pool.concurrency() == threads + 1);
+
+        // Несколько вызовов подряд на одних и тех же потоках
+        for (size_t count : { 0, 1, 5, 64, 1000 }) {
+            // Проверки Catch не потокобезопасны: фоновые потоки только считают
+            std::vector<std::atomic<int>> visits(count);
+            std::atomic<size_t> longest{ 0 };
+            pool.parallel_for(count, 7, [&](size_t begin, size_t end) {
+                size_t length = end - begin;
+                size_t seen = longest.load();
+                while (length > seen && !longest.compare_exchange_weak(seen, length)) {}
+                for (size_t i = begin; i < end; ++i) visits[i].fetch_add(1);
+            });
+            CHECK(longest.load() <= 7);
+            for (size_t i = 0; i < count; ++i) CHECK(visits[i].load() == 1);
+        }
+    }
+}
+
+TEST_CASE("H.225.0 RAS: batch decode of datagram arrays", "[h225][batch]") {
+    auto batch = make_batch(64);
+    auto datagrams = spans(batch);
+
+    SECTION("peek fills the header arrays") {
+        RasBatchDecoder decoder;
+        decoder.peek(datagrams);
+        check_against_single(decoder, batch, false);
+        CHECK(decoder.message(0) == nullptr);
+    }
+
+    SECTION("decode matches single-message decoding") {
+        RasBatchDecoder decoder;
+        decoder.decode(datagrams);
+        check_against_single(decoder, batch, true);
+
+        // peek после decode: сообщения прошлого пакета больше не выдаются
+        decoder.peek(datagrams);
+        CHECK(decoder.message(0) == nullptr);
+        decoder.decode(datagrams);
+        CHECK(decoder.message(0) != nullptr);
+
+        // Следующий пакет другой длины и другого состава переиспользует сообщения
+        auto next = make_batch(80);
+        std::rotate(next.begin(), next.begin() + 1, next.end());
+        for (size_t i = 0; i < next.size(); ++i) {
+            core::BitReader reader(next[i]);
+            if (auto msg = RasPDU::decode(reader)) {
+                std::visit([&](auto& body) {
+                    if constexpr (requires { body.requestSeqNum; }) body.requestSeqNum = static_cast<uint16_t>(i + 1);
+                }, *msg);
+                next[i] = encode(*msg);
+            }
+        }
+        decoder.decode(spans(next));
+        check_against_single(decoder, next, true);
+
+        decoder.decode(datagrams);
+        check_against_single(decoder, batch, true);
+    }
+
+    SECTION("A worker pool gives the same results") {
+        core::WorkerPool pool(3);
+        RasBatchDecoder decoder(std::pmr::get_default_resource(), &pool, 5);
+        for (int round = 0; round < 3; ++round) {
+            decoder.peek(datagrams);
+            check_against_single(decoder, batch, false);
+            decoder.decode(datagrams);
+            check_against_single(decoder, batch, true);
+        }
+    }
+
+    SECTION("An empty batch") {
+        RasBatchDecoder decoder;
+        CHECK(decoder.decode({}).size() == 0);
+        CHECK(decoder.message(0) == nullptr);
+    }
+}
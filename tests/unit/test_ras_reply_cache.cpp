@@ -0,0 +1,146 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/h225/ras_reply_cache.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <chrono>
+#include <vector>
+
+using namespace h323_26;
+using namespace h323_26::h225;
+using namespace std::chrono_literals;
+
+namespace {
+
+    const RasReplyCache::Clock::time_point t0{};
+
+    TransportAddress endpoint(uint8_t host, uint16_t port = 1719) {
+        return TransportAddress{ .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ host } }, .port = port };
+    }
+
+    RasReplyKey rrq(uint8_t host, uint16_t seq) {
+        return RasReplyKey{ .source = endpoint(host), .type = RasMessageType::registrationRequest, .requestSeqNum = seq };
+    }
+
+    std::vector<std::byte> bytes(std::initializer_list<int> values) {
+        std::vector<std::byte> out;
+        for (int v : values) out.push_back(static_cast<std::byte>(v));
+        return out;
+    }
+
+    std::vector<std::byte> copy(std::span<const std::byte> view) { return { view.begin(), view.end() }; }
+
+} // namespace
+
+TEST_CASE("h225::RasReplyCache: a retransmitted request finds its reply", "[cache]") {
+    RasReplyCache cache(RasReplyCache::Config{ .entries = 64, .max_reply = 16, .ttl = 10s });
+    const auto rcf = bytes({ 0x14, 0x00, 0x2A });
+
+    CHECK_FALSE(cache.find(rrq(1, 42), t0).has_value());
+    REQUIRE(cache.store(rrq(1, 42), rcf, t0));
+
+    auto hit = cache.find(rrq(1, 42), t0 + 3s);
+    REQUIRE(hit.has_value());
+    CHECK(copy(*hit) == rcf);
+
+    // Другой номер, тип, адрес или порт — другой запрос
+    CHECK_FALSE(cache.find(rrq(1, 43), t0).has_value());
+    CHECK_FALSE(cache.find(rrq(2, 42), t0).has_value());
+    CHECK_FALSE(cache.find(RasReplyKey{ .source = endpoint(1), .type = RasMessageType::admissionRequest, .requestSeqNum = 42 }, t0).has_value());
+    CHECK_FALSE(cache.find(RasReplyKey{ .source = endpoint(1, 5000), .type = RasMessageType::registrationRequest, .requestSeqNum = 42 }, t0).has_value());
+
+    // Ответ того же запроса перезаписывается на месте
+    const auto rrj = bytes({ 0x18, 0x00, 0x2A, 0x01 });
+    REQUIRE(cache.store(rrq(1, 42), rrj, t0 + 4s));
+    CHECK(copy(*cache.find(rrq(1, 42), t0 + 4s)) == rrj);
+
+    CHECK(cache.stats().hits == 2);
+    CHECK(cache.stats().misses == 5);
+    CHECK(cache.stats().stored == 2);
+    CHECK(cache.stats().evicted == 0);
+}
+
+TEST_CASE("h225::RasReplyCache: age, size and capacity limits", "[cache]") {
+    RasReplyCache cache(RasReplyCache::Config{ .entries = 8, .max_reply = 4, .ttl = 10s });
+    CHECK(cache.capacity() == 8);
+
+    SECTION("Replies expire after ttl") {
+        REQUIRE(cache.store(rrq(1, 1), bytes({ 1 }), t0));
+        CHECK(cache.find(rrq(1, 1), t0 + 10s).has_value());
+        CHECK_FALSE(cache.find(rrq(1, 1), t0 + 11s).has_value());
+    }
+
+    SECTION("Oversized replies are not cached") {
+        CHECK_FALSE(cache.store(rrq(1, 1), bytes({ 1, 2, 3, 4, 5 }), t0));
+        CHECK_FALSE(cache.find(rrq(1, 1), t0).has_value());
+        CHECK(cache.stats().stored == 0);
+    }
+
+    SECTION("max_reply is clamped to the 16-bit slot length") {
+        RasReplyCache wide(RasReplyCache::Config{ .entries = 4, .max_reply = 100000, .ttl = 10s });
+        const std::vector<std::byte> largest(UINT16_MAX, std::byte{ 0x5A });
+        const std::vector<std::byte> oversized(UINT16_MAX + 1, std::byte{ 0x5A });
+
+        REQUIRE(wide.store(rrq(1, 1), largest, t0));
+        CHECK(wide.find(rrq(1, 1), t0)->size() == UINT16_MAX);
+        CHECK_FALSE(wide.store(rrq(1, 2), oversized, t0));
+    }
+
+    SECTION("A full cache evicts the oldest reply of the bucket") {
+        for (uint16_t seq = 0; seq < 1000; ++seq) {
+            REQUIRE(cache.store(rrq(1, seq), bytes({ seq & 0xFF }), t0 + std::chrono::milliseconds(seq)));
+        }
+        CHECK(cache.stats().evicted == 1000 - 8);
+
+        // Последний ответ всегда на месте, а найденные ответы — свои
+        size_t found = 0;
+        for (uint16_t seq = 0; seq < 1000; ++seq) {
+            auto hit = cache.find(rrq(1, seq), t0 + 1s);
+            if (!hit) continue;
+            ++found;
+            CHECK(copy(*hit) == bytes({ seq & 0xFF }));
+        }
+        CHECK(found <= 8);
+        CHECK(cache.find(rrq(1, 999), t0 + 1s).has_value());
+
+        cache.clear();
+        CHECK_FALSE(cache.find(rrq(1, 999), t0 + 1s).has_value());
+    }
+}
+
+TEST_CASE("h225::RasReplyCache: encode path and header keys", "[cache]") {
+    RasReplyCache cache;
+    const RasMessage gcf = GatekeeperConfirm{
+        .requestSeqNum = 77,
+        .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+        .gatekeeperIdentifier = "GK-77",
+        .rasAddress = endpoint(1)
+    };
+
+    // Ключ строится по заголовку запроса, без полного разбора
+    core::BitWriter writer;
+    REQUIRE(RasPDU::encode(writer, GatekeeperRequest{ .requestSeqNum = 77, .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 } }).has_value());
+    auto header = RasPDU::peek(writer.data());
+    REQUIRE(header.has_value());
+    auto key = RasReplyCache::key_of(*header, endpoint(7));
+    REQUIRE(key.has_value());
+    CHECK(*key == RasReplyKey{ .source = endpoint(7), .type = RasMessageType::gatekeeperRequest, .requestSeqNum = 77 });
+
+    auto encoded = cache.encode(*key, gcf, t0);
+    REQUIRE(encoded.has_value());
+    auto expected = RasPDU::encoded_size(gcf);
+    REQUIRE(expected.has_value());
+    CHECK(encoded->size() == *expected);
+
+    auto hit = cache.find(*key, t0 + 1s);
+    REQUIRE(hit.has_value());
+    core::BitReader reader(*hit);
+    auto decoded = RasPDU::decode(reader);
+    REQUIRE(decoded.has_value());
+    CHECK(std::get<GatekeeperConfirm>(*decoded).gatekeeperIdentifier == "GK-77");
+
+    RasReplyCache tiny(RasReplyCache::Config{ .entries = 4, .max_reply = 2 });
+    auto overflow = tiny.encode(*key, gcf, t0);
+    REQUIRE_FALSE(overflow.has_value());
+    CHECK(overflow.error().code == ErrorCode::BufferOverflow);
+    CHECK(tiny.stats().stored == 0);
+}
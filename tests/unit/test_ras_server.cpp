@@ -0,0 +1,251 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/h225/ras.hpp>
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/h225/ras_transactions.hpp>
+#include <h323_26/transport/ras_server.hpp>
+#include <h323_26/core/bit_reader.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using namespace h323_26;
+using namespace h323_26::h225;
+
+namespace {
+
+    // Клиентский сокет, соединенный с портом сервера на 127.0.0.1
+    class Client {
+    public:
+        explicit Client(uint16_t port) : fd_(::socket(AF_INET, SOCK_DGRAM, 0)) {
+            REQUIRE(fd_ >= 0);
+            const timeval timeout{ .tv_sec = 2, .tv_usec = 0 };
+            REQUIRE(::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0);
+
+            sockaddr_in server{};
+            server.sin_family = AF_INET;
+            server.sin_port = htons(port);
+            server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            REQUIRE(::connect(fd_, reinterpret_cast<const sockaddr*>(&server), sizeof(server)) == 0);
+        }
+
+        ~Client() { ::close(fd_); }
+
+        void send(std::span<const std::byte> datagram) {
+            REQUIRE(::send(fd_, datagram.data(), datagram.size(), 0) == static_cast<ssize_t>(datagram.size()));
+        }
+
+        // Ответ сервера или nullopt по таймауту
+        std::optional<std::vector<std::byte>> receive() {
+            std::array<std::byte, 1500> buffer;
+            ssize_t size = ::recv(fd_, buffer.data(), buffer.size(), 0);
+            if (size < 0) return std::nullopt;
+            return std::vector<std::byte>(buffer.begin(), buffer.begin() + size);
+        }
+
+    private:
+        int fd_;
+    };
+
+    // Счетчики ядра обновляются после sendmmsg, то есть чуть позже прихода ответа
+    transport::RasServerStats settled_stats(const transport::RasServer& server, uint64_t sent) {
+        for (int attempt = 0; attempt < 200 && server.stats().sent < sent; ++attempt) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return server.stats();
+    }
+
+    const std::array<std::byte, 4> loopback{ std::byte{ 127 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 1 } };
+
+    std::vector<std::byte> encode(const RasMessage& msg) {
+        core::BitWriter writer;
+        REQUIRE(RasPDU::encode(writer, msg).has_value());
+        return writer.data();
+    }
+
+    RasMessage make_grq(uint16_t seq) {
+        return GatekeeperRequest{ .requestSeqNum = seq, .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 } };
+    }
+
+    // Отвечает на GRQ подтверждением с тем же номером и номером ядра в rasAddress.port
+    transport::RasServer::HandlerFactory gcf_handler(std::atomic<int>& created) {
+        return [&created](size_t shard) -> transport::RasHandler {
+            created.fetch_add(1);
+            return [shard](const RasMessage& request, const TransportAddress& source, std::span<std::byte> reply) -> size_t {
+                const auto* grq = std::get_if<GatekeeperRequest>(&request);
+                if (!grq) return 0;
+                RasMessage gcf = GatekeeperConfirm{
+                    .requestSeqNum = grq->requestSeqNum,
+                    .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+                    .rasAddress = TransportAddress{ .ip = source.ip, .port = static_cast<uint16_t>(shard) }
+                };
+                auto size = RasPDU::encode_into(reply, gcf);
+                return size ? *size : 0;
+            };
+        };
+    }
+
+} // namespace
+
+TEST_CASE("transport::RasServer: loopback GRQ/GCF exchange", "[transport]") {
+    std::atomic<int> created{ 0 };
+    transport::RasServerConfig config{ .threads = 3, .pin_threads = false };
+    config.bind.port = 0;
+    auto server = transport::RasServer::start(config, gcf_handler(created));
+    REQUIRE(server.has_value());
+    CHECK(created.load() == 3);
+    CHECK((*server)->shards() == 3);
+    REQUIRE((*server)->port() != 0);
+
+    Client client((*server)->port());
+
+    SECTION("Every request gets a confirm with its sequence number") {
+        for (uint16_t seq = 1; seq <= 20; ++seq) {
+            client.send(encode(make_grq(seq)));
+            auto reply = client.receive();
+            REQUIRE(reply.has_value());
+
+            core::BitReader reader(*reply);
+            auto msg = RasPDU::decode(reader);
+            REQUIRE(msg.has_value());
+            const auto* gcf = std::get_if<GatekeeperConfirm>(&*msg);
+            REQUIRE(gcf != nullptr);
+            CHECK(gcf->requestSeqNum == seq);
+            CHECK(gcf->rasAddress.ip == loopback);
+        }
+
+        // Один клиент — один сокет SO_REUSEPORT, значит, и одно ядро
+        auto stats = settled_stats(**server, 20);
+        CHECK(stats.received == 20);
+        CHECK(stats.sent == 20);
+        size_t busy_shards = 0;
+        for (size_t i = 0; i < (*server)->shards(); ++i) {
+            if ((*server)->shard_stats(i).received != 0) ++busy_shards;
+        }
+        CHECK(busy_shards == 1);
+    }
+
+    SECTION("Malformed datagrams are counted and left unanswered") {
+        const std::array<std::byte, 2> garbage{ std::byte{ 0x7F }, std::byte{ 0xFF } };
+        client.send(garbage);
+        client.send(encode(make_grq(7)));
+
+        auto reply = client.receive();
+        REQUIRE(reply.has_value());
+        core::BitReader reader(*reply);
+        auto msg = RasPDU::decode(reader);
+        REQUIRE(msg.has_value());
+        CHECK(std::get<GatekeeperConfirm>(*msg).requestSeqNum == 7);
+
+        auto stats = settled_stats(**server, 1);
+        CHECK(stats.received == 2);
+        CHECK(stats.malformed == 1);
+        CHECK(stats.sent == 1);
+    }
+
+    (*server)->stop();
+    (*server)->stop();
+}
+
+TEST_CASE("transport::RasServer: retransmitted requests are answered from the reply cache", "[transport]") {
+    std::atomic<int> created{ 0 };
+    std::atomic<int> handled{ 0 };
+    auto factory = [&](size_t shard) -> transport::RasHandler {
+        return [&, inner = gcf_handler(created)(shard)](const RasMessage& request, const TransportAddress& source, std::span<std::byte> reply) {
+            handled.fetch_add(1);
+            return inner(request, source, reply);
+        };
+    };
+
+    transport::RasServerConfig config{ .threads = 1, .pin_threads = false };
+    config.bind.port = 0;
+    auto server = transport::RasServer::start(config, factory);
+    REQUIRE(server.has_value());
+    Client client((*server)->port());
+
+    // Исходный запрос, два его повтора и новый запрос
+    const auto first = encode(make_grq(11));
+    client.send(first);
+    auto original = client.receive();
+    REQUIRE(original.has_value());
+    for (int copy = 0; copy < 2; ++copy) {
+        client.send(first);
+        auto repeated = client.receive();
+        REQUIRE(repeated.has_value());
+        CHECK(*repeated == *original);
+    }
+    client.send(encode(make_grq(12)));
+    REQUIRE(client.receive().has_value());
+
+    auto stats = settled_stats(**server, 4);
+    CHECK(handled.load() == 2);
+    CHECK(stats.sent == 4);
+    CHECK(stats.cache_hits == 2);
+    CHECK(stats.cache_misses == 2);
+    (*server)->stop();
+}
+
+TEST_CASE("transport::RasServer: shard requests are retransmitted until answered", "[transport]") {
+    // На GRQ ядро отвечает собственным URQ клиенту и повторяет его по таймеру,
+    // пока клиент не пришлет UCF
+    std::atomic<int> completed{ 0 };
+    std::atomic<int> timed_out{ 0 };
+    // Кодируется заранее: проверки Catch из потоков ядер недопустимы
+    const auto urq = encode(UnregistrationRequest{ .requestSeqNum = 500 });
+    auto make_shard = [&](size_t, transport::RasSender sender) {
+        auto transactions = std::make_shared<RasTransactions>(
+            RasRetryPolicy{ .timeout = std::chrono::milliseconds(100), .retries = 5 },
+            [sender](const TransportAddress& destination, std::span<const std::byte> datagram) {
+                return sender.send(destination, datagram);
+            },
+            [&](uint16_t, const RasMessage* response) { (response ? completed : timed_out).fetch_add(1); },
+            RasTransactions::Clock::now());
+
+        transport::RasShard shard;
+        shard.handler = [transactions, &urq](const RasMessage& msg, const TransportAddress& source, std::span<std::byte>) -> size_t {
+            const auto now = RasTransactions::Clock::now();
+            if (transactions->on_response(msg, source, now)) return 0;
+            if (std::holds_alternative<GatekeeperRequest>(msg)) (void)transactions->send(500, RasMessageType::unregistrationRequest, source, urq, now);
+            return 0;
+        };
+        shard.tick = [transactions](RasTransactions::Clock::time_point now) { transactions->poll(now); };
+        return shard;
+    };
+
+    transport::RasServerConfig config{ .threads = 2, .pin_threads = false };
+    config.bind.port = 0;
+    auto server = transport::RasServer::start(config, make_shard);
+    REQUIRE(server.has_value());
+
+    Client client((*server)->port());
+    client.send(encode(make_grq(1)));
+
+    // Сам запрос и хотя бы один его повтор
+    for (int copy = 0; copy < 2; ++copy) {
+        auto datagram = client.receive();
+        REQUIRE(datagram.has_value());
+        core::BitReader reader(*datagram);
+        auto msg = RasPDU::decode(reader);
+        REQUIRE(msg.has_value());
+        CHECK(std::get<UnregistrationRequest>(*msg).requestSeqNum == 500);
+    }
+
+    client.send(encode(UnregistrationConfirm{ .requestSeqNum = 500 }));
+    for (int attempt = 0; attempt < 200 && completed.load() == 0; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    CHECK(completed.load() == 1);
+    CHECK(timed_out.load() == 0);
+    (*server)->stop();
+}
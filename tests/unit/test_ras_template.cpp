@@ -0,0 +1,143 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/h225/ras.hpp>
+#include <h323_26/h225/ras_message.hpp>
+#include <h323_26/h225/ras_template.hpp>
+#include <h323_26/core/bit_writer.hpp>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace h323_26;
+using namespace h323_26::h225;
+
+namespace {
+
+    TransportAddress address(uint8_t host, uint16_t port) {
+        return TransportAddress{ .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ host } }, .port = port };
+    }
+
+    RegistrationConfirm make_rcf(uint16_t seq, uint8_t host, std::string endpoint) {
+        return RegistrationConfirm{
+            .requestSeqNum = seq,
+            .protocolIdentifier = { 0, 0, 8, 2250, 0, 7 },
+            .callSignalAddress = { address(host, 1720) },
+            .terminalAlias = AliasList{ DialedDigits{ "1001" } },
+            .gatekeeperIdentifier = "GK-1",
+            .endpointIdentifier = std::pmr::string(endpoint),
+            .timeToLive = 300
+        };
+    }
+
+    // Идентификаторы одной длины: "EP-" + 5 цифр
+    std::string endpoint_id(uint16_t seq) {
+        return "EP-" + std::to_string(10000 + seq);
+    }
+
+    std::vector<std::byte> encode(RasMessage msg) {
+        core::BitWriter writer;
+        REQUIRE(RasPDU::encode(writer, msg).has_value());
+        return writer.data();
+    }
+
+} // namespace
+
+TEST_CASE("H.225.0 RAS: response template patching", "[h225][template]") {
+    auto tpl = RasTemplate<RegistrationConfirm>::make(make_rcf(1, 1, endpoint_id(1)));
+    REQUIRE(tpl.has_value());
+    CHECK(std::ranges::equal(tpl->bytes(), encode(make_rcf(1, 1, endpoint_id(1)))));
+
+    SECTION("Stamped and patched datagrams equal a full encode") {
+        std::array<std::byte, 256> slot;
+        for (uint16_t seq : { 1, 2, 255, 256, 4660, 65535 }) {
+            INFO("requestSeqNum " << seq);
+            slot.fill(std::byte{ 0xA5 });
+
+            auto size = tpl->stamp(slot);
+            REQUIRE(size.has_value());
+            REQUIRE(tpl->patch<&RegistrationConfirm::requestSeqNum>(slot, seq).has_value());
+            REQUIRE(tpl->patch<&RegistrationConfirm::endpointIdentifier>(slot, endpoint_id(seq)).has_value());
+            REQUIRE(tpl->patch<&RegistrationConfirm::callSignalAddress>(slot, TransportAddressList{ address(static_cast<uint8_t>(seq), 1720) }).has_value());
+            REQUIRE(tpl->patch<&RegistrationConfirm::timeToLive>(slot, uint32_t{ 600 }).has_value());
+
+            auto expected_rcf = make_rcf(seq, static_cast<uint8_t>(seq), endpoint_id(seq));
+            expected_rcf.timeToLive = 600;
+            auto expected = encode(expected_rcf);
+            REQUIRE(*size == expected.size());
+            CHECK(std::ranges::equal(std::span(slot).first(*size), expected));
+        }
+    }
+
+    SECTION("Fields that would change width are refused") {
+        std::array<std::byte, 256> slot;
+        REQUIRE(tpl->stamp(slot).has_value());
+        auto before = slot;
+
+        auto longer = tpl->patch<&RegistrationConfirm::endpointIdentifier>(slot, std::string_view("EP-100001"));
+        REQUIRE_FALSE(longer.has_value());
+        CHECK(longer.error().code == ErrorCode::InvalidConstraint);
+
+        // timeToLive (1..2^32-1) передается числом октетов: 300 — два октета, 60 — один
+        auto shorter = tpl->patch<&RegistrationConfirm::timeToLive>(slot, uint32_t{ 60 });
+        REQUIRE_FALSE(shorter.has_value());
+        CHECK(shorter.error().code == ErrorCode::InvalidConstraint);
+
+        auto out_of_range = tpl->patch<&RegistrationConfirm::requestSeqNum>(slot, uint16_t{ 0 });
+        REQUIRE_FALSE(out_of_range.has_value());
+        CHECK(out_of_range.error().code == ErrorCode::InvalidConstraint);
+        CHECK(slot == before);
+    }
+
+    SECTION("Identifiers of the maximum BMPString size are patched") {
+        // 128 символов по 2 октета — шире прежнего буфера перезаписи
+        const std::string longest(128, 'A');
+        auto wide = RasTemplate<RegistrationConfirm>::make(make_rcf(1, 1, longest));
+        REQUIRE(wide.has_value());
+
+        std::vector<std::byte> slot(wide->size());
+        REQUIRE(wide->stamp(slot).has_value());
+        const std::string other(128, 'Z');
+        REQUIRE(wide->patch<&RegistrationConfirm::endpointIdentifier>(slot, other).has_value());
+        CHECK(slot == encode(make_rcf(1, 1, other)));
+    }
+
+    SECTION("Short buffers are rejected") {
+        std::vector<std::byte> small(tpl->size() - 1);
+        auto stamped = tpl->stamp(small);
+        REQUIRE_FALSE(stamped.has_value());
+        CHECK(stamped.error().code == ErrorCode::BufferOverflow);
+        CHECK_FALSE(tpl->patch<&RegistrationConfirm::requestSeqNum>(small, uint16_t{ 2 }).has_value());
+    }
+}
+
+TEST_CASE("H.225.0 RAS: templates for other responses", "[h225][template]") {
+    SECTION("ACF: sequence number, bandwidth and destination") {
+        AdmissionConfirm prototype{ 1, 640, CallModel::direct, address(1, 1720), std::nullopt };
+        auto tpl = RasTemplate<AdmissionConfirm>::make(prototype);
+        REQUIRE(tpl.has_value());
+
+        std::vector<std::byte> slot(tpl->size());
+        REQUIRE(tpl->stamp(slot).has_value());
+        REQUIRE(tpl->patch<&AdmissionConfirm::requestSeqNum>(slot, uint16_t{ 777 }).has_value());
+        REQUIRE(tpl->patch<&AdmissionConfirm::bandWidth>(slot, uint32_t{ 1280 }).has_value());
+        REQUIRE(tpl->patch<&AdmissionConfirm::destCallSignalAddress>(slot, address(99, 1721)).has_value());
+        CHECK(slot == encode(AdmissionConfirm{ 777, 1280, CallModel::direct, address(99, 1721), std::nullopt }));
+
+        // irrFrequency в прототипе нет — ее бит в преамбуле не выставлен
+        auto absent = tpl->patch<&AdmissionConfirm::irrFrequency>(slot, uint16_t{ 10 });
+        REQUIRE_FALSE(absent.has_value());
+        CHECK(absent.error().code == ErrorCode::InvalidConstraint);
+    }
+
+    SECTION("Extension-addition alternatives patch inside the open type") {
+        auto tpl = RasTemplate<RequestInProgress>::make(RequestInProgress{ 1, 500 });
+        REQUIRE(tpl.has_value());
+        CHECK(tpl->location<&RequestInProgress::requestSeqNum>().bit_offset % 8 == 1); // После бита расширения
+
+        std::vector<std::byte> slot(tpl->size());
+        REQUIRE(tpl->stamp(slot).has_value());
+        REQUIRE(tpl->patch<&RequestInProgress::requestSeqNum>(slot, uint16_t{ 4242 }).has_value());
+        REQUIRE(tpl->patch<&RequestInProgress::delay>(slot, uint16_t{ 9 }).has_value());
+        CHECK(slot == encode(RequestInProgress{ 4242, 9 }));
+    }
+}
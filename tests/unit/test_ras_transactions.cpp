@@ -0,0 +1,137 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/h225/ras_transactions.hpp>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using namespace h323_26;
+using namespace h323_26::h225;
+using namespace std::chrono_literals;
+
+namespace {
+
+    const RasTransactions::Clock::time_point t0{};
+
+    TransportAddress endpoint(uint8_t host) {
+        return TransportAddress{ .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ host } }, .port = 1719 };
+    }
+
+    struct Harness {
+        struct Sent {
+            TransportAddress destination;
+            std::vector<std::byte> datagram;
+        };
+
+        std::vector<Sent> sent;
+        std::vector<std::pair<uint16_t, std::optional<RasMessageType>>> completed;
+        RasTransactions transactions;
+
+        explicit Harness(RasRetryPolicy policy = {})
+            : transactions(policy,
+                [this](const TransportAddress& destination, std::span<const std::byte> datagram) {
+                    sent.push_back(Sent{ destination, { datagram.begin(), datagram.end() } });
+                    return true;
+                },
+                [this](uint16_t seq, const RasMessage* response) {
+                    completed.emplace_back(seq, response ? std::optional(RasPDU::type_of(*response)) : std::nullopt);
+                },
+                t0) {}
+    };
+
+    const std::vector<std::byte> urq{ std::byte{ 0x18 }, std::byte{ 0x00 }, std::byte{ 0x2A } };
+
+} // namespace
+
+TEST_CASE("h225::RasTransactions: retransmits, then gives up", "[timers]") {
+    Harness h(RasRetryPolicy{ .timeout = 3000ms, .retries = 2 });
+    REQUIRE(h.transactions.send(42, RasMessageType::unregistrationRequest, endpoint(1), urq, t0).has_value());
+    REQUIRE(h.sent.size() == 1);
+    CHECK(h.sent[0].destination == endpoint(1));
+    CHECK(h.sent[0].datagram == urq);
+    CHECK(h.transactions.outstanding() == 1);
+    CHECK(h.transactions.next_wakeup() <= t0 + 3000ms);
+
+    // Ответ ждать не на что
+    CHECK(h.transactions.send(43, RasMessageType::unregistrationConfirm, endpoint(1), urq, t0).error().code == ErrorCode::InvalidConstraint);
+    CHECK(h.transactions.send(43, RasMessageType::nonStandardMessage, endpoint(1), urq, t0).error().code == ErrorCode::InvalidConstraint);
+    CHECK(h.transactions.outstanding() == 1);
+
+    // Номер занят, пока ждем ответа
+    CHECK(h.transactions.send(42, RasMessageType::unregistrationRequest, endpoint(2), urq, t0).error().code == ErrorCode::InvalidConstraint);
+
+    h.transactions.poll(t0 + 2999ms);
+    CHECK(h.sent.size() == 1);
+    h.transactions.poll(t0 + 3000ms);
+    CHECK(h.sent.size() == 2);
+    h.transactions.poll(t0 + 6000ms);
+    CHECK(h.sent.size() == 3);
+    CHECK(h.sent[2].datagram == urq);
+    CHECK(h.completed.empty());
+
+    h.transactions.poll(t0 + 9000ms);
+    CHECK(h.sent.size() == 3);
+    REQUIRE(h.completed.size() == 1);
+    CHECK(h.completed[0].first == 42);
+    CHECK_FALSE(h.completed[0].second.has_value());
+    CHECK(h.transactions.outstanding() == 0);
+
+    // Номер снова свободен
+    CHECK(h.transactions.send(42, RasMessageType::unregistrationRequest, endpoint(2), urq, t0 + 9000ms).has_value());
+}
+
+TEST_CASE("h225::RasTransactions: responses complete the matching request", "[timers]") {
+    Harness h;
+    REQUIRE(h.transactions.send(1, RasMessageType::unregistrationRequest, endpoint(1), urq, t0).has_value());
+    REQUIRE(h.transactions.send(2, RasMessageType::unregistrationRequest, endpoint(2), urq, t0).has_value());
+
+    // Запрос с тем же номером, ответ на запрос другого типа, ответ с чужого адреса
+    // и ответ на неизвестный номер не в счет
+    CHECK_FALSE(h.transactions.on_response(UnregistrationRequest{ .requestSeqNum = 1 }, endpoint(1), t0 + 1ms));
+    CHECK_FALSE(h.transactions.on_response(RegistrationConfirm{ .requestSeqNum = 1 }, endpoint(1), t0 + 1ms));
+    CHECK_FALSE(h.transactions.on_response(GatekeeperReject{ .requestSeqNum = 2 }, endpoint(2), t0 + 1ms));
+    CHECK_FALSE(h.transactions.on_response(UnknownMessageResponse{ .requestSeqNum = 1 }, endpoint(1), t0 + 1ms));
+    CHECK_FALSE(h.transactions.on_response(UnregistrationConfirm{ .requestSeqNum = 1 }, endpoint(9), t0 + 1ms));
+    CHECK_FALSE(h.transactions.on_response(UnregistrationConfirm{ .requestSeqNum = 3 }, endpoint(1), t0 + 1ms));
+    CHECK(h.completed.empty());
+
+    CHECK(h.transactions.on_response(UnregistrationConfirm{ .requestSeqNum = 1 }, endpoint(1), t0 + 1ms));
+    CHECK(h.transactions.on_response(UnregistrationReject{ .requestSeqNum = 2 }, endpoint(2), t0 + 2ms));
+    REQUIRE(h.completed.size() == 2);
+    CHECK(h.completed[0] == std::pair{ uint16_t{ 1 }, std::optional(RasMessageType::unregistrationConfirm) });
+    CHECK(h.completed[1] == std::pair{ uint16_t{ 2 }, std::optional(RasMessageType::unregistrationReject) });
+
+    // Повторный ответ уже ничего не завершает, повторов по таймеру нет
+    CHECK_FALSE(h.transactions.on_response(UnregistrationConfirm{ .requestSeqNum = 1 }, endpoint(1), t0 + 3ms));
+    h.transactions.poll(t0 + 60s);
+    CHECK(h.sent.size() == 2);
+    CHECK(h.completed.size() == 2);
+}
+
+TEST_CASE("h225::RasTransactions: RequestInProgress postpones the timer", "[timers]") {
+    Harness h(RasRetryPolicy{ .timeout = 3000ms, .retries = 1 });
+    REQUIRE(h.transactions.send(7, RasMessageType::unregistrationRequest, endpoint(1), urq, t0).has_value());
+
+    CHECK(h.transactions.on_response(RequestInProgress{ .requestSeqNum = 7, .delay = 10000 }, endpoint(1), t0 + 1000ms));
+    h.transactions.poll(t0 + 10999ms);
+    CHECK(h.sent.size() == 1);
+
+    // По истечении delay — обычный повтор, число попыток не расходовалось
+    h.transactions.poll(t0 + 11000ms);
+    CHECK(h.sent.size() == 2);
+    CHECK(h.completed.empty());
+    h.transactions.poll(t0 + 14000ms);
+    REQUIRE(h.completed.size() == 1);
+    CHECK_FALSE(h.completed[0].second.has_value());
+}
+
+TEST_CASE("h225::RasTransactions: cancel drops the request silently", "[timers]") {
+    Harness h;
+    REQUIRE(h.transactions.send(5, RasMessageType::unregistrationRequest, endpoint(1), urq, t0).has_value());
+    CHECK(h.transactions.cancel(5));
+    CHECK_FALSE(h.transactions.cancel(5));
+    h.transactions.poll(t0 + 60s);
+    CHECK(h.sent.size() == 1);
+    CHECK(h.completed.empty());
+    CHECK(h.transactions.outstanding() == 0);
+}
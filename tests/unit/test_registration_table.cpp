@@ -0,0 +1,264 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/gk/registration_table.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace h323_26;
+using namespace h323_26::gk;
+
+namespace {
+
+    h225::TransportAddress address(uint8_t host, uint16_t port) {
+        return h225::TransportAddress{ .ip = { std::byte{ 10 }, std::byte{ 0 }, std::byte{ 1 }, std::byte{ host } }, .port = port };
+    }
+
+    EndpointInfo info(uint8_t host, uint32_t ttl = 300) {
+        return EndpointInfo{ .callSignalAddress = address(host, 1720), .rasAddress = address(host, 1719), .timeToLive = ttl };
+    }
+
+    h225::AliasAddress digits(std::string text) { return h225::DialedDigits{ std::pmr::string(text) }; }
+    h225::AliasAddress name(std::string text) { return h225::H323Id{ std::pmr::string(text) }; }
+
+    const Clock::time_point t0{};
+
+} // namespace
+
+TEST_CASE("gk::RegistrationTable: register, find and unregister", "[gk]") {
+    RegistrationTable table(RegistrationTable::Config{ .endpoints = 64, .shards = 4 });
+    const std::vector<h225::AliasAddress> aliases{ digits("1001"), name("terminal-1") };
+
+    auto ref = table.register_endpoint("EP-1", aliases, info(1), t0);
+    REQUIRE(ref.has_value());
+    CHECK(table.size() == 1);
+
+    auto by_id = table.find_endpoint("EP-1");
+    REQUIRE(by_id.has_value());
+    CHECK(by_id->endpoint == *ref);
+    CHECK(by_id->callSignalAddress == address(1, 1720));
+    CHECK(by_id->rasAddress == address(1, 1719));
+    CHECK(by_id->timeToLive == 300);
+    CHECK(by_id->expires == t0 + std::chrono::seconds(300));
+
+    auto by_digits = table.find_alias(digits("1001"));
+    REQUIRE(by_digits.has_value());
+    CHECK(by_digits->endpoint == *ref);
+    CHECK(table.find_alias(name("terminal-1")).has_value());
+
+    // Вид псевдонима входит в ключ
+    CHECK_FALSE(table.find_alias(name("1001")).has_value());
+    CHECK_FALSE(table.find_alias(digits("1002")).has_value());
+    CHECK_FALSE(table.find_endpoint("EP-2").has_value());
+
+    SECTION("Re-registration switches the alias set") {
+        const std::vector<h225::AliasAddress> next{ digits("1001"), digits("2002") };
+        auto again = table.register_endpoint("EP-1", next, info(2, 60), t0 + std::chrono::seconds(10));
+        REQUIRE(again.has_value());
+        CHECK(again->index == ref->index);
+        CHECK(again->generation != ref->generation);
+        CHECK(table.size() == 1);
+
+        CHECK_FALSE(table.find_alias(name("terminal-1")).has_value());
+        auto moved = table.find_alias(digits("2002"));
+        REQUIRE(moved.has_value());
+        CHECK(moved->callSignalAddress == address(2, 1720));
+        CHECK(moved->expires == t0 + std::chrono::seconds(70));
+        CHECK(table.find_alias(digits("1001"))->endpoint == *again);
+
+        // Старая ссылка устарела
+        CHECK_FALSE(table.find(*ref).has_value());
+        CHECK_FALSE(table.refresh(*ref, t0).has_value());
+        CHECK(table.refresh(*again, t0 + std::chrono::seconds(100)).has_value());
+        CHECK(table.find(*again)->expires == t0 + std::chrono::seconds(160));
+    }
+
+    SECTION("A duplicate alias is rejected without side effects") {
+        const std::vector<h225::AliasAddress> clash{ digits("3003"), name("terminal-1") };
+        auto other = table.register_endpoint("EP-2", clash, info(3), t0);
+        REQUIRE_FALSE(other.has_value());
+        CHECK(other.error().code == ErrorCode::InvalidConstraint);
+        CHECK(table.size() == 1);
+        CHECK_FALSE(table.find_endpoint("EP-2").has_value());
+        CHECK_FALSE(table.find_alias(digits("3003")).has_value());
+        CHECK(table.find_alias(name("terminal-1"))->endpoint == *ref);
+
+        // Отказ при перерегистрации оставляет прежний набор
+        const std::vector<h225::AliasAddress> second{ digits("4004") };
+        REQUIRE(table.register_endpoint("EP-2", second, info(4), t0).has_value());
+        const std::vector<h225::AliasAddress> steal{ digits("5005"), digits("1001") };
+        CHECK_FALSE(table.register_endpoint("EP-2", steal, info(4), t0).has_value());
+        CHECK(table.find_alias(digits("4004")).has_value());
+        CHECK_FALSE(table.find_alias(digits("5005")).has_value());
+    }
+
+    SECTION("Unregistration drops the endpoint and its aliases") {
+        CHECK(table.unregister("EP-1"));
+        CHECK_FALSE(table.unregister("EP-1"));
+        CHECK(table.size() == 0);
+        CHECK_FALSE(table.find_endpoint("EP-1").has_value());
+        CHECK_FALSE(table.find_alias(digits("1001")).has_value());
+        CHECK_FALSE(table.find(*ref).has_value());
+
+        // Псевдоним снова свободен
+        const std::vector<h225::AliasAddress> reuse{ digits("1001") };
+        CHECK(table.register_endpoint("EP-9", reuse, info(9), t0).has_value());
+    }
+
+    SECTION("Bandwidth is reserved up to the limit") {
+        CHECK(table.adjust_bandwidth(*ref, 640, 1000).value() == 640);
+        auto over = table.adjust_bandwidth(*ref, 640, 1000);
+        REQUIRE_FALSE(over.has_value());
+        CHECK(over.error().code == ErrorCode::InvalidConstraint);
+        CHECK(table.adjust_bandwidth(*ref, -640, 1000).value() == 0);
+        CHECK(table.adjust_bandwidth(*ref, -10, 1000).value() == 0);
+        CHECK(table.adjust_bandwidth(*ref, 300, 1000).value() == 300);
+        CHECK(table.find_alias(digits("1001"))->bandwidth == 300);
+    }
+
+    SECTION("timeToLive expiry removes the registration unless it was refreshed") {
+        CHECK_FALSE(table.expire(*ref, t0 + std::chrono::seconds(299)));
+        REQUIRE(table.refresh(*ref, t0 + std::chrono::seconds(200)).has_value());
+
+        // Таймер, поставленный на прежний срок, срабатывает впустую
+        CHECK_FALSE(table.expire(*ref, t0 + std::chrono::seconds(300)));
+        CHECK(table.find(*ref).has_value());
+
+        CHECK(table.expire(*ref, t0 + std::chrono::seconds(500)));
+        CHECK(table.size() == 0);
+        CHECK_FALSE(table.find_endpoint("EP-1").has_value());
+        CHECK_FALSE(table.find_alias(digits("1001")).has_value());
+        CHECK_FALSE(table.expire(*ref, t0 + std::chrono::seconds(500)));
+        CHECK_FALSE(table.unregister("EP-1"));
+        CHECK(table.register_endpoint("EP-1", aliases, info(1), t0).has_value());
+    }
+}
+
+TEST_CASE("gk::RegistrationTable: capacity and churn", "[gk]") {
+    RegistrationTable table(RegistrationTable::Config{ .endpoints = 8, .keys_per_endpoint = 2, .shards = 1 });
+
+    SECTION("A full table rejects new endpoints until one leaves") {
+        for (int i = 0; i < 8; ++i) {
+            const std::vector<h225::AliasAddress> aliases{ digits(std::to_string(100 + i)) };
+            REQUIRE(table.register_endpoint("EP-" + std::to_string(i), aliases, info(1), t0).has_value());
+        }
+        auto full = table.register_endpoint("EP-8", {}, info(1), t0);
+        REQUIRE_FALSE(full.has_value());
+        CHECK(full.error().code == ErrorCode::BufferOverflow);
+
+        CHECK(table.unregister("EP-3"));
+        CHECK(table.register_endpoint("EP-8", {}, info(1), t0).has_value());
+        CHECK(table.size() == 8);
+    }
+
+    SECTION("Stale keys are reused by later registrations") {
+        // Много перерегистраций со сменой псевдонима в индексе на 32 слота
+        for (int round = 0; round < 200; ++round) {
+            INFO("round " << round);
+            for (int i = 0; i < 4; ++i) {
+                const std::vector<h225::AliasAddress> aliases{ digits(std::to_string(round * 10 + i)) };
+                REQUIRE(table.register_endpoint("EP-" + std::to_string(i), aliases, info(static_cast<uint8_t>(i)), t0).has_value());
+            }
+            for (int i = 0; i < 4; ++i) {
+                auto found = table.find_alias(digits(std::to_string(round * 10 + i)));
+                REQUIRE(found.has_value());
+                CHECK(found->callSignalAddress == address(static_cast<uint8_t>(i), 1720));
+                if (round > 0) CHECK_FALSE(table.find_alias(digits(std::to_string((round - 1) * 10 + i))).has_value());
+            }
+        }
+        CHECK(table.size() == 4);
+    }
+}
+
+TEST_CASE("gk::RegistrationTable: expiry races with URQ", "[gk]") {
+    // Запись освобождает ровно один из двух: иначе емкость таблицы «утечет» или задвоится
+    constexpr int endpoints = 256;
+    RegistrationTable table(RegistrationTable::Config{ .endpoints = endpoints, .keys_per_endpoint = 2, .shards = 4 });
+
+    for (int round = 0; round < 20; ++round) {
+        std::vector<EndpointRef> refs;
+        for (int i = 0; i < endpoints; ++i) {
+            const std::vector<h225::AliasAddress> aliases{ digits(std::to_string(5000 + i)) };
+            auto ref = table.register_endpoint("EP-" + std::to_string(i), aliases, info(1, 1), t0);
+            REQUIRE(ref.has_value());
+            refs.push_back(*ref);
+        }
+
+        std::atomic<int> removed{ 0 };
+        std::thread expirer([&] {
+            for (const EndpointRef& ref : refs) {
+                if (table.expire(ref, t0 + std::chrono::seconds(1))) removed.fetch_add(1);
+            }
+        });
+        for (int i = endpoints - 1; i >= 0; --i) {
+            if (table.unregister("EP-" + std::to_string(i))) removed.fetch_add(1);
+        }
+        expirer.join();
+
+        CHECK(removed.load() == endpoints);
+        CHECK(table.size() == 0);
+    }
+}
+
+TEST_CASE("gk::RegistrationTable: lookups stay consistent under concurrent RRQs", "[gk]") {
+    RegistrationTable table(RegistrationTable::Config{ .endpoints = 4096, .shards = 16 });
+
+    // Стабильные точки: RRQ с тем же набором псевдонимов не должен делать их невидимыми
+    constexpr int stable = 64;
+    for (int i = 0; i < stable; ++i) {
+        const std::vector<h225::AliasAddress> aliases{ digits(std::to_string(1000 + i)) };
+        REQUIRE(table.register_endpoint("S-" + std::to_string(i), aliases, info(static_cast<uint8_t>(i)), t0).has_value());
+    }
+
+    std::atomic<bool> done{ false };
+    std::atomic<uint64_t> misses{ 0 };
+    std::atomic<uint64_t> torn{ 0 };
+    std::atomic<uint64_t> failed_writes{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < 3; ++r) {
+        threads.emplace_back([&, r] {
+            uint64_t n = r;
+            while (!done.load(std::memory_order_relaxed)) {
+                const int i = static_cast<int>(n++ % stable);
+                auto found = table.find_alias(digits(std::to_string(1000 + i)));
+                if (!found) {
+                    misses.fetch_add(1);
+                    continue;
+                }
+                // Писатели держат callSignal и ras согласованными: порт ras = порт callSignal - 1
+                if (found->callSignalAddress.ip != found->rasAddress.ip ||
+                    found->callSignalAddress.port != found->rasAddress.port + 1) torn.fetch_add(1);
+            }
+        });
+    }
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back([&, w] {
+            for (int round = 0; round < 300; ++round) {
+                const int i = (round * 7 + w) % stable;
+                const std::vector<h225::AliasAddress> same{ digits(std::to_string(1000 + i)) };
+                const auto port = static_cast<uint16_t>(2000 + round);
+                const EndpointInfo moved{ .callSignalAddress = address(static_cast<uint8_t>(round), port),
+                                          .rasAddress = address(static_cast<uint8_t>(round), static_cast<uint16_t>(port - 1)),
+                                          .timeToLive = 60 };
+                if (!table.register_endpoint("S-" + std::to_string(i), same, moved, t0)) failed_writes.fetch_add(1);
+
+                // Текучка: временные точки приходят и уходят
+                const std::string id = "T-" + std::to_string(w) + "-" + std::to_string(round);
+                const std::vector<h225::AliasAddress> temp{ name(id), digits(std::to_string(900000 + w * 1000 + round)) };
+                if (!table.register_endpoint(id, temp, info(7), t0)) failed_writes.fetch_add(1);
+                if (round % 2 == 0 && !table.unregister(id)) failed_writes.fetch_add(1);
+            }
+        });
+    }
+
+    threads[3].join();
+    threads[4].join();
+    done.store(true);
+    for (int r = 0; r < 3; ++r) threads[r].join();
+
+    CHECK(misses.load() == 0);
+    CHECK(torn.load() == 0);
+    CHECK(failed_writes.load() == 0);
+    CHECK(table.size() == stable + 2 * 150);
+}
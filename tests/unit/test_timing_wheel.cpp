@@ -0,0 +1,124 @@
+﻿#include <catch2/catch_test_macros.hpp>
+#include <h323_26/core/timing_wheel.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace h323_26;
+using core::TimingWheel;
+using namespace std::chrono_literals;
+
+namespace {
+
+    const TimingWheel::Clock::time_point t0{};
+
+    std::vector<uint64_t> advance(TimingWheel& wheel, TimingWheel::Clock::time_point now) {
+        std::vector<uint64_t> fired;
+        wheel.advance(now, [&](uint64_t payload) { fired.push_back(payload); });
+        return fired;
+    }
+
+} // namespace
+
+TEST_CASE("core::TimingWheel: timers fire at their deadline, never earlier", "[timers]") {
+    TimingWheel wheel(TimingWheel::Config{ .tick = 10ms }, t0);
+    wheel.arm(t0 + 30ms, 1);
+    wheel.arm(t0 + 25ms, 2);  // Округляется вверх до 30 мс
+    wheel.arm(t0 + 100ms, 3);
+    wheel.arm(t0, 4);         // Уже наступил: первый же тик
+    CHECK(wheel.size() == 4);
+
+    CHECK(advance(wheel, t0 + 9ms).empty());
+    CHECK(advance(wheel, t0 + 10ms) == std::vector<uint64_t>{ 4 });
+    CHECK(advance(wheel, t0 + 29ms).empty());
+
+    auto fired = advance(wheel, t0 + 30ms);
+    std::ranges::sort(fired);
+    CHECK(fired == std::vector<uint64_t>{ 1, 2 });
+    CHECK(advance(wheel, t0 + 99ms).empty());
+    CHECK(advance(wheel, t0 + 5s) == std::vector<uint64_t>{ 3 });
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("core::TimingWheel: cancel and stale ids", "[timers]") {
+    TimingWheel wheel(TimingWheel::Config{ .tick = 1ms }, t0);
+    auto a = wheel.arm(t0 + 5ms, 1);
+    auto b = wheel.arm(t0 + 5ms, 2);
+    auto c = wheel.arm(t0 + 5ms, 3);
+
+    CHECK(wheel.cancel(b));
+    CHECK_FALSE(wheel.cancel(b));
+    CHECK(wheel.size() == 2);
+
+    auto fired = advance(wheel, t0 + 5ms);
+    std::ranges::sort(fired);
+    CHECK(fired == std::vector<uint64_t>{ 1, 3 });
+    CHECK_FALSE(wheel.cancel(a));
+    CHECK_FALSE(wheel.cancel(c));
+
+    // Узел снятого таймера переиспользуется, но старая ссылка на него недействительна
+    auto d = wheel.arm(t0 + 10ms, 4);
+    CHECK((d.index == a.index || d.index == b.index || d.index == c.index));
+    CHECK_FALSE(wheel.cancel(a));
+    CHECK_FALSE(wheel.cancel(b));
+    CHECK(wheel.cancel(d));
+    CHECK(wheel.next_wakeup() == TimingWheel::Clock::time_point::max());
+}
+
+TEST_CASE("core::TimingWheel: handler may re-arm and cancel", "[timers]") {
+    TimingWheel wheel(TimingWheel::Config{ .tick = 1ms }, t0);
+    TimingWheel::TimerId victim = wheel.arm(t0 + 3ms, 99);
+    wheel.arm(t0 + 3ms, 1);
+
+    std::vector<uint64_t> fired;
+    size_t count = wheel.advance(t0 + 20ms, [&](uint64_t payload) {
+        fired.push_back(payload);
+        if (payload == 1) {
+            // Повтор через 5 мс, как у запроса RAS; из того же слота снимается сосед
+            (void)wheel.cancel(victim);
+            wheel.arm(t0 + 8ms, 2);
+        }
+    });
+
+    // victim мог сработать раньше соседа в том же слоте, тогда cancel() вернул false
+    CHECK(std::ranges::find(fired, 2) != fired.end());
+    CHECK(count == fired.size());
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("core::TimingWheel: long timeouts cascade through the levels", "[timers]") {
+    // Тики по 1 мс: сроки от миллисекунд до суток проходят все уровни колеса
+    TimingWheel wheel(TimingWheel::Config{ .tick = 1ms }, t0);
+    std::mt19937_64 random(7);
+    std::vector<std::pair<int64_t, uint64_t>> expected;
+    for (uint64_t i = 0; i < 5000; ++i) {
+        const int64_t ms = static_cast<int64_t>(1 + random() % (24 * 3600 * 1000ULL >> (random() % 24)));
+        wheel.arm(t0 + std::chrono::milliseconds(ms), i);
+        expected.emplace_back(ms, i);
+    }
+    // Срок за горизонтом 64^6 тиков (~2 года при 1 мс)
+    wheel.arm(t0 + std::chrono::hours(24 * 365 * 3), 1'000'000);
+
+    // Неравномерные шаги: каждый таймер срабатывает в шаге, накрывшем его срок
+    int64_t now = 0;
+    size_t fired_total = 0;
+    while (fired_total < expected.size()) {
+        const int64_t step = 1 + static_cast<int64_t>(random() % 40'000);
+        const int64_t next = now + step;
+        wheel.advance(t0 + std::chrono::milliseconds(next), [&](uint64_t payload) {
+            REQUIRE(payload < expected.size());
+            const int64_t deadline = expected[payload].first;
+            CHECK(deadline > now);
+            CHECK(deadline <= next);
+            ++fired_total;
+        });
+        now = next;
+    }
+    CHECK(wheel.size() == 1);
+    CHECK(wheel.next_wakeup() > t0 + std::chrono::milliseconds(now));
+
+    CHECK(advance(wheel, t0 + std::chrono::hours(24 * 365 * 3) - 1ms).empty());
+    CHECK(advance(wheel, t0 + std::chrono::hours(24 * 365 * 3)) == std::vector<uint64_t>{ 1'000'000 });
+}